@@ -0,0 +1,23 @@
+#include <iostream>
+#include "benchmark_all.hpp"
+
+// 性能基准，建议以 -O2 -march=native 编译后单独运行
+int main()
+{
+    using namespace DSA;
+
+	Hashing::BenchHashFunction::Run();
+	Collections::ArrayLike::BenchVector::Run();
+	Collections::ArrayLike::BenchDeque::Run();
+	Collections::ArrayLike::BenchRingBuffer::Run();
+	Collections::Concurrent::BenchConcurrentQueue::Run();
+	Parallel::BenchParallel::Run();
+	Collections::ListOrForwardlist::BenchList::Run();
+	Collections::ListOrForwardlist::BenchUnrolledList::Run();
+	Collections::BenchIntrusive::Run();
+	Collections::BenchOrderStatistic::Run();
+	Tree::BTree::BenchBPlusTree::Run();
+	Collections::BenchBulkBuild::Run();
+	Hashing::BenchHashTableBulk::Run();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include "../collections/set_multiset.hpp"
+namespace DSA
+{
+    namespace Tree
+    {
+        namespace BTree
+        {
+            /**
+             * @brief 红黑树与 B+ 树作为 Set 后端的对比：随机插入、随机查找、区间扫描、全表遍历，以及有序数据的批量建树。
+             */
+            struct BenchBPlusTree
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                static std::vector<int> Keys(size_t n)
+                {
+                    std::vector<int> res(n);
+                    size_t x = 2049;
+                    for (auto &k : res)
+                    {
+                        x = x * 6364136223846793005ull + 1442695040888963407ull;
+                        k = int(x >> 33);
+                    }
+                    return res;
+                }
+                template <template <typename, typename, typename> class Implement>
+                static void Case(const char *name, const std::vector<int> &keys)
+                {
+                    Collections::SetOrMultiset::Set<int, std::less<int>, Implement> s;
+                    double tins = Seconds([&]
+                                          {
+                                              for (int k : keys)
+                                                  s.insert(k);
+                                          });
+                    size_t hit = 0;
+                    double tfind = Seconds([&]
+                                           {
+                                               for (int k : keys)
+                                                   hit += s.find(k ^ 1) != s.end();
+                                           });
+                    long long sum = 0;
+                    // 1000 次区间扫描，每次从随机键开始顺序读 256 个元素
+                    double trange = Seconds([&]
+                                            {
+                                                for (size_t i = 0; i < 1000; ++i)
+                                                {
+                                                    auto it = s.lower_bound(keys[i]);
+                                                    for (int j = 0; j < 256 && it != s.end(); ++j, ++it)
+                                                        sum += *it;
+                                                }
+                                            });
+                    double tscan = Seconds([&]
+                                           {
+                                               for (int k : s)
+                                                   sum += k;
+                                           });
+                    std::printf("  %-10s x%zu: insert %8.2f ms, find %8.2f ms, range scan %7.2f ms, full scan %6.2f ms (hit %zu, sum %lld)\n",
+                                name, keys.size(), tins * 1e3, tfind * 1e3, trange * 1e3, tscan * 1e3, hit, sum);
+                }
+                static void Run()
+                {
+                    std::printf("[B+ tree]\n");
+                    auto keys = Keys(size_t(1) << 20);
+                    Case<Collections::SetOrMultiset::RBTreeLinked>("RB tree", keys);
+                    Case<BPlusTree>("B+ tree", keys);
+                    std::sort(keys.begin(), keys.end());
+                    BPlusTree<int> t;
+                    double tbulk = Seconds([&]
+                                           { t.assign_sorted_unique(keys.begin(), keys.end()); });
+                    std::printf("  B+ tree bulk load of %zu sorted keys: %.2f ms\n", t.size(), tbulk * 1e3);
+                }
+            };
+        }
+    }
+}
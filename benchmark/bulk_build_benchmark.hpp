@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include "../collections/set_multiset.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        /**
+         * @brief 重建索引的基准：逐个 insert 与区间构造（有序时 O(N) 批量建树，无序时先稳定排序）对比。
+         */
+        struct BenchBulkBuild
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            template <template <typename, typename, typename> class Implement>
+            static void Case(const char *name, const std::vector<int> &keys, const char *order)
+            {
+                size_t n1 = 0, n2 = 0;
+                double tins = Seconds([&]
+                                      {
+                                          SetOrMultiset::Set<int, std::less<int>, Implement> s;
+                                          for (int k : keys)
+                                              s.insert(k);
+                                          n1 = s.size();
+                                      });
+                double tbulk = Seconds([&]
+                                       {
+                                           SetOrMultiset::Set<int, std::less<int>, Implement> s(keys.begin(), keys.end());
+                                           n2 = s.size();
+                                       });
+                std::printf("  %-8s %-8s x%zu: insert loop %8.2f ms, range ctor %8.2f ms (size %zu/%zu)\n", name, order, keys.size(), tins * 1e3, tbulk * 1e3, n1, n2);
+            }
+            static void Run()
+            {
+                std::printf("[bulk build]\n");
+                std::vector<int> keys(size_t(1) << 20);
+                size_t x = 2050;
+                for (auto &k : keys)
+                {
+                    x = x * 6364136223846793005ull + 1442695040888963407ull;
+                    k = int(x >> 33);
+                }
+                Case<SetOrMultiset::RBTreeLinked>("RB", keys, "random");
+                Case<SetOrMultiset::AVLTreeLinked>("AVL", keys, "random");
+                std::sort(keys.begin(), keys.end());
+                Case<SetOrMultiset::RBTreeLinked>("RB", keys, "sorted");
+                Case<SetOrMultiset::AVLTreeLinked>("AVL", keys, "sorted");
+                Case<SetOrMultiset::BPlusTree>("B+", keys, "sorted");
+            }
+        };
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../collections/concurrent_queue.hpp"
+#include "../collections/queue_stack.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace Concurrent
+        {
+            /**
+             * @brief 无锁 SPSC / MPMC 队列与互斥量保护的 Queue 的吞吐量和往返延迟对比。
+             */
+            struct BenchConcurrentQueue
+            {
+                // 对照组：用一把互斥量保护的有界 Queue，接口与无锁队列相同
+                template <typename T>
+                struct MutexQueue
+                {
+                    using value_type = T;
+                    using size_type = size_t;
+                    explicit MutexQueue(size_type capacity) : cap(capacity) { q.reserve(capacity); }
+                    bool try_push(const T &v)
+                    {
+                        std::lock_guard<std::mutex> lk(m);
+                        if (q.size() == cap)
+                            return false;
+                        q.push(v);
+                        return true;
+                    }
+                    bool try_pop(T &out)
+                    {
+                        std::lock_guard<std::mutex> lk(m);
+                        if (q.empty())
+                            return false;
+                        out = q.front();
+                        q.pop();
+                        return true;
+                    }
+                    size_type try_push_n(const T *src, size_type n)
+                    {
+                        std::lock_guard<std::mutex> lk(m);
+                        size_type k = 0;
+                        for (; k < n && q.size() < cap; ++k)
+                            q.push(src[k]);
+                        return k;
+                    }
+                    size_type try_pop_n(T *dst, size_type n)
+                    {
+                        std::lock_guard<std::mutex> lk(m);
+                        size_type k = 0;
+                        for (; k < n && !q.empty(); ++k)
+                        {
+                            dst[k] = q.front();
+                            q.pop();
+                        }
+                        return k;
+                    }
+                    size_type cap;
+                    std::mutex m;
+                    RingQueue<T> q;
+                };
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                // producers 个生产者各写入 per_producer 个元素，consumers 个消费者取完；batch > 1 时使用批量接口
+                template <typename Q>
+                static void Throughput(const char *name, int producers, int consumers, size_t per_producer, size_t batch)
+                {
+                    Q q(1024);
+                    std::atomic<size_t> remaining{per_producer * producers};
+                    double t = Seconds([&]
+                                       {
+                                           std::vector<std::thread> threads;
+                                           for (int p = 0; p < producers; ++p)
+                                               threads.emplace_back([&]
+                                                                    {
+                                                                        std::vector<long long> buf(batch, 1);
+                                                                        for (size_t i = 0; i < per_producer;)
+                                                                        {
+                                                                            size_t k = batch > 1 ? q.try_push_n(buf.data(), std::min(batch, per_producer - i)) : size_t(q.try_push(1));
+                                                                            if (!k)
+                                                                                std::this_thread::yield();
+                                                                            i += k;
+                                                                        } });
+                                           for (int c = 0; c < consumers; ++c)
+                                               threads.emplace_back([&]
+                                                                    {
+                                                                        std::vector<long long> buf(batch);
+                                                                        while (remaining.load(std::memory_order_relaxed))
+                                                                        {
+                                                                            size_t k = batch > 1 ? q.try_pop_n(buf.data(), batch) : size_t(q.try_pop(buf[0]));
+                                                                            if (!k)
+                                                                                std::this_thread::yield();
+                                                                            else
+                                                                                remaining -= k;
+                                                                        } });
+                                           for (auto &th : threads)
+                                               th.join(); });
+                    double total = double(per_producer * producers);
+                    std::printf("  %-22s %dP%dC batch %-3zu: %8.2f M items/s\n", name, producers, consumers, batch, total / t / 1e6);
+                }
+                // 两个线程通过一对队列来回传递一个令牌，测量单次往返的平均时间
+                template <typename Q>
+                static void PingPong(const char *name, size_t rounds)
+                {
+                    Q to(16), back(16);
+                    std::thread echo([&]
+                                     {
+                                         long long v;
+                                         for (size_t i = 0; i < rounds; ++i)
+                                         {
+                                             while (!to.try_pop(v))
+                                                 std::this_thread::yield();
+                                             while (!back.try_push(v))
+                                                 std::this_thread::yield();
+                                         } });
+                    double t = Seconds([&]
+                                       {
+                                           long long v = 0;
+                                           for (size_t i = 0; i < rounds; ++i)
+                                           {
+                                               while (!to.try_push(v))
+                                                   std::this_thread::yield();
+                                               while (!back.try_pop(v))
+                                                   std::this_thread::yield();
+                                           } });
+                    echo.join();
+                    std::printf("  %-22s round trip: %8.1f ns\n", name, t / double(rounds) * 1e9);
+                }
+                static void Run()
+                {
+                    const size_t n = size_t(1) << 22;
+                    std::printf("[concurrent queue] throughput\n");
+                    Throughput<MutexQueue<long long>>("mutex Queue", 1, 1, n, 1);
+                    Throughput<SPSCQueue<long long>>("SPSCQueue", 1, 1, n, 1);
+                    Throughput<MPMCQueue<long long>>("MPMCQueue", 1, 1, n, 1);
+                    Throughput<MutexQueue<long long>>("mutex Queue", 1, 1, n, 64);
+                    Throughput<SPSCQueue<long long>>("SPSCQueue", 1, 1, n, 64);
+                    Throughput<MPMCQueue<long long>>("MPMCQueue", 1, 1, n, 64);
+                    Throughput<MutexQueue<long long>>("mutex Queue", 4, 4, n / 4, 1);
+                    Throughput<MPMCQueue<long long>>("MPMCQueue", 4, 4, n / 4, 1);
+                    Throughput<MutexQueue<long long>>("mutex Queue", 4, 4, n / 4, 64);
+                    Throughput<MPMCQueue<long long>>("MPMCQueue", 4, 4, n / 4, 64);
+                    std::printf("[concurrent queue] latency\n");
+                    const size_t rounds = size_t(1) << 16;
+                    PingPong<MutexQueue<long long>>("mutex Queue", rounds);
+                    PingPong<SPSCQueue<long long>>("SPSCQueue", rounds);
+                    PingPong<MPMCQueue<long long>>("MPMCQueue", rounds);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include "../collections/deque.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            /**
+             * @brief Deque 的两端操作、队列式滑动窗口与随机访问基准，与 std::deque 对比。
+             */
+            struct BenchDeque
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                template <typename Dq>
+                static void Ends(const char *name, size_t n)
+                {
+                    size_t sink = 0;
+                    double t = Seconds([&]
+                                       {
+                                           Dq d;
+                                           for (size_t i = 0; i < n; ++i)
+                                           {
+                                               if (i & 1)
+                                                   d.push_back(int(i));
+                                               else
+                                                   d.push_front(int(i));
+                                           }
+                                           while (!d.empty())
+                                           {
+                                               sink += size_t(d.front());
+                                               d.pop_front();
+                                           } });
+                    std::printf("  %-24s push both ends + drain x%zu: %8.2f ms (%zu)\n", name, n, t * 1e3, sink);
+                }
+                // 固定长度的窗口：每步弹出最旧的、压入最新的，考察块的循环复用
+                template <typename Dq>
+                static void SlidingWindow(const char *name, size_t window, size_t steps)
+                {
+                    Dq d;
+                    for (size_t i = 0; i < window; ++i)
+                        d.push_back(int(i));
+                    size_t sink = 0;
+                    double t = Seconds([&]
+                                       {
+                                           for (size_t i = 0; i < steps; ++i)
+                                           {
+                                               sink += size_t(d.front());
+                                               d.pop_front();
+                                               d.push_back(int(i));
+                                           } });
+                    std::printf("  %-24s window %zu, %zu steps: %8.2f ms (%zu)\n", name, window, steps, t * 1e3, sink);
+                }
+                template <typename Dq>
+                static void RandomAccess(const char *name, size_t n)
+                {
+                    Dq d;
+                    for (size_t i = 0; i < n; ++i)
+                        d.push_back(int(i));
+                    size_t sink = 0, x = 12345;
+                    double t = Seconds([&]
+                                       {
+                                           for (size_t i = 0; i < n; ++i)
+                                           {
+                                               x = x * 6364136223846793005ull + 1442695040888963407ull;
+                                               sink += size_t(d[(x >> 33) % n]);
+                                           } });
+                    std::printf("  %-24s %zu random operator[]: %8.2f ms (%zu)\n", name, n, t * 1e3, sink);
+                }
+                static void Run()
+                {
+                    std::printf("[deque]\n");
+                    const size_t n = size_t(1) << 24;
+                    Ends<std::deque<int>>("std::deque<int>", n);
+                    Ends<Deque<int>>("Deque<int>", n);
+                    SlidingWindow<std::deque<int>>("std::deque<int>", 1000, n);
+                    SlidingWindow<Deque<int>>("Deque<int>", 1000, n);
+                    RandomAccess<std::deque<int>>("std::deque<int>", n);
+                    RandomAccess<Deque<int>>("Deque<int>", n);
+                }
+            };
+        }
+    }
+}
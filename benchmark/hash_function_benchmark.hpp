@@ -0,0 +1,158 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../collections/hash_function.hpp"
+#include "../collections/hashtable.hpp"
+namespace DSA
+{
+    namespace Hashing
+    {
+        /**
+         * @brief 对比 FastHash 与 std::hash 的吞吐量和分布质量。
+         *
+         * 分布质量用两种指标衡量：
+         * - 把键放进 2 的幂个桶（只看哈希值低位）后的卡方值与最长桶，期望卡方约等于桶数；
+         * - 雪崩偏差：翻转输入的任意一位，输出每一位翻转概率与 0.5 的最大偏差。
+         */
+        struct BenchHashFunction
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            template <typename Hash>
+            static void StringThroughput(const char *name, size_t len)
+            {
+                std::mt19937_64 rng(len);
+                std::string buf(len + 64, '\0');
+                for (auto &c : buf)
+                    c = char(rng());
+                size_t rounds = std::max<size_t>(1, (size_t(256) << 20) / (len + 8)); // 每组约 256MB
+                size_t sink = 0;
+                Hash h;
+                double t = Seconds([&]
+                                   {
+                                       for (size_t i = 0; i < rounds; ++i)
+                                           sink += h(std::string_view(buf.data() + (i & 63), len)); });
+                std::printf("  %-12s len=%-6zu %9.1f MB/s %8.2f ns/hash  (%zx)\n", name, len, double(rounds) * len / t / 1e6, t * 1e9 / rounds, sink & 0xf);
+            }
+            template <typename Hash>
+            static void IntegerThroughput(const char *name)
+            {
+                size_t rounds = size_t(1) << 26, sink = 0;
+                Hash h;
+                double t = Seconds([&]
+                                   {
+                                       for (size_t i = 0; i < rounds; ++i)
+                                           sink += h(uint64_t(i)); });
+                std::printf("  %-12s %8.2f ns/hash  (%zx)\n", name, t * 1e9 / rounds, sink & 0xf);
+            }
+            // keys 放进 nbucket（2 的幂）个桶，输出卡方值与最长桶
+            template <typename Hash, typename Key>
+            static void Distribution(const char *name, const char *pattern, const std::vector<Key> &keys, size_t nbucket)
+            {
+                std::vector<size_t> cnt(nbucket);
+                Hash h;
+                for (auto &k : keys)
+                    ++cnt[h(k) & (nbucket - 1)];
+                double expect = double(keys.size()) / nbucket, chi = 0;
+                size_t longest = 0;
+                for (size_t c : cnt)
+                {
+                    chi += (c - expect) * (c - expect) / expect;
+                    longest = std::max(longest, c);
+                }
+                std::printf("  %-12s %-14s chi2/buckets=%8.3f longest=%zu\n", name, pattern, chi / nbucket, longest);
+            }
+            template <typename Hash>
+            static void Avalanche(const char *name, size_t len, size_t samples = 2000)
+            {
+                std::mt19937_64 rng(42);
+                std::vector<std::vector<size_t>> flips(len * 8, std::vector<size_t>(64));
+                Hash h;
+                std::string s(len, '\0');
+                for (size_t n = 0; n < samples; ++n)
+                {
+                    for (auto &c : s)
+                        c = char(rng());
+                    uint64_t base = h(std::string_view(s));
+                    for (size_t bit = 0; bit < len * 8; ++bit)
+                    {
+                        s[bit / 8] ^= char(1 << (bit % 8));
+                        uint64_t d = base ^ uint64_t(h(std::string_view(s)));
+                        s[bit / 8] ^= char(1 << (bit % 8));
+                        for (size_t ob = 0; ob < 64; ++ob)
+                            flips[bit][ob] += (d >> ob) & 1;
+                    }
+                }
+                double worst = 0;
+                for (auto &row : flips)
+                    for (size_t c : row)
+                        worst = std::max(worst, std::fabs(double(c) / samples - 0.5));
+                std::printf("  %-12s len=%-4zu worst bit bias=%.4f\n", name, len, worst);
+            }
+            template <typename Hash>
+            static void TableInsertFind(const char *name, const std::vector<uint64_t> &keys)
+            {
+                HashTable<uint64_t, uint64_t, Hash, std::equal_to<uint64_t>, Utils::IdentityKeyOfValue<uint64_t>, Pow2ReHash> ht;
+                size_t hit = 0;
+                double t = Seconds([&]
+                                   {
+                                       for (auto k : keys)
+                                           ht.insert_unique(k);
+                                       for (auto k : keys)
+                                           hit += ht.count_unique(k); });
+                std::printf("  %-12s pow2 buckets, strided keys: %8.2f ns/op (hit=%zu)\n", name, t * 1e9 / (2 * keys.size()), hit);
+            }
+            static void Run()
+            {
+                std::printf("[hash function] string throughput\n");
+                for (size_t len : {8, 16, 32, 64, 256, 1024, 4096, 65536})
+                {
+                    StringThroughput<std::hash<std::string_view>>("std::hash", len);
+                    StringThroughput<FastHash<std::string_view>>("FastHash", len);
+                }
+                std::printf("[hash function] integer throughput\n");
+                IntegerThroughput<std::hash<uint64_t>>("std::hash");
+                IntegerThroughput<FastHash<uint64_t>>("FastHash");
+
+                std::printf("[hash function] distribution over 2^16 buckets (low bits only)\n");
+                const size_t nkey = size_t(1) << 20, nbucket = size_t(1) << 16;
+                std::vector<uint64_t> seq(nkey), strided(nkey);
+                std::vector<std::string> words(nkey);
+                for (size_t i = 0; i < nkey; ++i)
+                {
+                    seq[i] = i;
+                    strided[i] = i << 16; // 低 16 位全为 0，恒等哈希会全部落入同一个桶
+                    words[i] = "user:" + std::to_string(i);
+                }
+                Distribution<std::hash<uint64_t>>("std::hash", "sequential", seq, nbucket);
+                Distribution<FastHash<uint64_t>>("FastHash", "sequential", seq, nbucket);
+                Distribution<std::hash<uint64_t>>("std::hash", "stride 2^16", strided, nbucket);
+                Distribution<FastHash<uint64_t>>("FastHash", "stride 2^16", strided, nbucket);
+                Distribution<std::hash<std::string>>("std::hash", "user:<n>", words, nbucket);
+                Distribution<FastHash<std::string>>("FastHash", "user:<n>", words, nbucket);
+
+                std::printf("[hash function] avalanche\n");
+                for (size_t len : {4, 16, 64})
+                {
+                    Avalanche<std::hash<std::string_view>>("std::hash", len);
+                    Avalanche<FastHash<std::string_view>>("FastHash", len);
+                }
+
+                std::printf("[hash function] HashTable with Pow2ReHash\n");
+                std::vector<uint64_t> keys(strided.begin(), strided.begin() + (1 << 14));
+                TableInsertFind<std::hash<uint64_t>>("std::hash", keys);
+                TableInsertFind<FastHash<uint64_t>>("FastHash", keys);
+            }
+        };
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../collections/hashtable.hpp"
+namespace DSA
+{
+    namespace Hashing
+    {
+        /**
+         * @brief 哈希表批量插入的基准：逐个 insert 与 insert_range（一次扩容、按桶分组后整段接入）对比，
+         * 分别测键几乎不重复与大量重复两种分布。
+         */
+        struct BenchHashTableBulk
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            static void Case(const char *name, const std::vector<int> &keys)
+            {
+                size_t n1 = 0, n2 = 0, n3 = 0, n4 = 0;
+                double tuniq = Seconds([&]
+                                       {
+                                           HashTable<int> ht;
+                                           for (int k : keys)
+                                               ht.insert_unique(k);
+                                           n1 = ht.size();
+                                       });
+                double trange_uniq = Seconds([&]
+                                             {
+                                                 HashTable<int> ht;
+                                                 ht.insert_range_unique(keys.begin(), keys.end());
+                                                 n2 = ht.size();
+                                             });
+                double tmulti = Seconds([&]
+                                        {
+                                            HashTable<int> ht;
+                                            for (int k : keys)
+                                                ht.insert_multi(k);
+                                            n3 = ht.size();
+                                        });
+                double trange_multi = Seconds([&]
+                                              {
+                                                  HashTable<int> ht;
+                                                  ht.insert_range_multi(keys.begin(), keys.end());
+                                                  n4 = ht.size();
+                                              });
+                std::printf("  %-10s x%zu: unique loop %8.2f ms, range %8.2f ms (size %zu/%zu); multi loop %8.2f ms, range %8.2f ms (size %zu/%zu)\n",
+                            name, keys.size(), tuniq * 1e3, trange_uniq * 1e3, n1, n2, tmulti * 1e3, trange_multi * 1e3, n3, n4);
+            }
+            static void Run()
+            {
+                std::printf("[hashtable bulk insert]\n");
+                std::vector<int> keys(size_t(1) << 20);
+                size_t x = 2050;
+                for (auto &k : keys)
+                {
+                    x = x * 6364136223846793005ull + 1442695040888963407ull;
+                    k = int(x >> 33);
+                }
+                Case("distinct", keys);
+                // 每个键平均重复 64 次
+                for (auto &k : keys)
+                    k &= (1 << 14) - 1;
+                Case("dup x64", keys);
+            }
+        };
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../collections/list_forwardlist.hpp"
+#include "../collections/map_multimap.hpp"
+#include "../collections/intrusive_list.hpp"
+#include "../tree/binary_tree/binary_search_tree/intrusive_RB_tree.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        /**
+         * @brief LRU 缓存基准：List + Map（每次未命中都要分配链表节点和树节点）与预先分配槽位的侵入式链表 + 侵入式红黑树对比。
+         */
+        struct BenchIntrusive
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            struct Entry : ListOrForwardlist::ListHook<>, Tree::BinaryTree::BinarySearchTree::RBTree::RBTreeHook<>
+            {
+                int key = 0;
+            };
+            struct EntryKey
+            {
+                const int &operator()(const Entry &e) const { return e.key; }
+            };
+            static std::vector<int> Keys(size_t n, int range)
+            {
+                std::vector<int> res(n);
+                size_t x = 12345;
+                for (auto &k : res)
+                {
+                    x = x * 6364136223846793005ull + 1442695040888963407ull;
+                    k = int((x >> 33) % size_t(range));
+                }
+                return res;
+            }
+            static void Owning(const std::vector<int> &keys, size_t capacity)
+            {
+                using Ls = ListOrForwardlist::List<int>;
+                Ls lru;
+                MapOrMultimap::Map<int, Ls::iterator> index;
+                size_t hits = 0;
+                double t = Seconds([&]
+                                   {
+                                       for (int k : keys)
+                                       {
+                                           auto it = index.find(k);
+                                           if (it != index.end())
+                                           {
+                                               ++hits;
+                                               lru.erase(it->second);
+                                               lru.push_front(k);
+                                               it->second = lru.begin();
+                                               continue;
+                                           }
+                                           if (lru.size() == capacity)
+                                           {
+                                               index.erase(lru.back());
+                                               lru.pop_back();
+                                           }
+                                           lru.push_front(k);
+                                           index.insert({k, lru.begin()});
+                                       } });
+                std::printf("  %-28s x%zu cap %zu: %8.2f ms (hits %zu)\n", "List + Map", keys.size(), capacity, t * 1e3, hits);
+            }
+            static void Intrusive(const std::vector<int> &keys, size_t capacity)
+            {
+                std::vector<Entry> slots(capacity);
+                ListOrForwardlist::IntrusiveList<Entry> lru;
+                Tree::BinaryTree::BinarySearchTree::RBTree::IntrusiveRBTree<Entry, int, std::less<int>, EntryKey> index;
+                for (auto &e : slots)
+                    lru.push_back(e);
+                size_t hits = 0;
+                double t = Seconds([&]
+                                   {
+                                       for (int k : keys)
+                                       {
+                                           auto it = index.find(k);
+                                           if (it != index.end())
+                                           {
+                                               ++hits;
+                                               lru.splice(lru.begin(), lru, lru.iterator_to(*it));
+                                               continue;
+                                           }
+                                           Entry &victim = lru.back();
+                                           if (victim.RBTreeHook<>::is_linked())
+                                               index.erase(victim);
+                                           victim.key = k;
+                                           index.insert_unique(victim);
+                                           lru.splice(lru.begin(), lru, lru.iterator_to(victim));
+                                       } });
+                std::printf("  %-28s x%zu cap %zu: %8.2f ms (hits %zu)\n", "Intrusive list + tree", keys.size(), capacity, t * 1e3, hits);
+            }
+            static void Run()
+            {
+                std::printf("[intrusive]\n");
+                auto keys = Keys(size_t(1) << 21, 1 << 14);
+                Owning(keys, 4096);
+                Intrusive(keys, 4096);
+            }
+        };
+    }
+}
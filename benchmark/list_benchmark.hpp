@@ -0,0 +1,100 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include "../collections/list_forwardlist.hpp"
+#include "../collections/node_pool.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            /**
+             * @brief List 的建表、遍历、清空基准：逐个 new 的节点与 NodePoolAllocator 从 slab 切出的节点对比。
+             */
+            struct BenchList
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                template <typename Ls>
+                static void BuildIterateClear(const char *name, size_t n)
+                {
+                    Ls ls;
+                    size_t sink = 0;
+                    double build = Seconds([&]
+                                           {
+                                               for (size_t i = 0; i < n; ++i)
+                                                   ls.push_back(int(i)); });
+                    double iterate = Seconds([&]
+                                             {
+                                                 for (int v : ls)
+                                                     sink += size_t(v); });
+                    double clear = Seconds([&]
+                                           { ls.clear(); });
+                    std::printf("  %-28s x%zu build %8.2f ms, iterate %7.2f ms, clear %7.2f ms (%zu)\n", name, n, build * 1e3, iterate * 1e3, clear * 1e3, sink);
+                }
+                // 两个链表交替插入，再删掉其中一个：留下的节点在 malloc 堆中相互隔开，考察遍历时的缓存表现
+                template <typename Ls>
+                static void Interleaved(const char *name, size_t n)
+                {
+                    Ls a, b;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        a.push_back(int(i));
+                        b.push_back(int(i));
+                    }
+                    b.clear();
+                    for (size_t i = 0; i < n; ++i)
+                        b.push_front(int(i));
+                    size_t sink = 0;
+                    double t = Seconds([&]
+                                       {
+                                           for (int r = 0; r < 4; ++r)
+                                               for (int v : b)
+                                                   sink += size_t(v); });
+                    std::printf("  %-28s x%zu iterate after churn x4: %8.2f ms (%zu)\n", name, n, t * 1e3, sink);
+                }
+                // 随机整数排序；List 超过阈值后走收集-排序-重新链接（整数用基数排序）
+                template <typename Ls, typename SortFn>
+                static void Sort(const char *name, size_t n, SortFn sort)
+                {
+                    Ls ls;
+                    size_t x = 12345;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        x = x * 6364136223846793005ull + 1442695040888963407ull;
+                        ls.push_back(int(x >> 33));
+                    }
+                    double t = Seconds([&]
+                                       { sort(ls); });
+                    std::printf("  %-28s x%zu sort: %8.2f ms (%d)\n", name, n, t * 1e3, ls.front());
+                }
+                static void Run()
+                {
+                    std::printf("[list]\n");
+                    const size_t n = size_t(1) << 22;
+                    BuildIterateClear<std::list<int>>("std::list<int>", n);
+                    BuildIterateClear<List<int>>("List<int>", n);
+                    BuildIterateClear<List<int, NodePoolAllocator<int>>>("List<int, NodePoolAllocator>", n);
+                    Interleaved<std::list<int>>("std::list<int>", n);
+                    Interleaved<List<int>>("List<int>", n);
+                    Interleaved<List<int, NodePoolAllocator<int>>>("List<int, NodePoolAllocator>", n);
+                    auto sort = [](auto &ls)
+                    { ls.sort(); };
+                    Sort<std::list<int>>("std::list<int>", n / 4, sort);
+                    Sort<List<int>>("List<int>", n / 4, sort);
+                    Sort<List<int>>("List<int> greater", n / 4, [](auto &ls)
+                                    { ls.sort(std::greater<int>{}); });
+                    Sort<List<int>>("List<int> parallel_sort", n / 4, [](auto &ls)
+                                    { ls.parallel_sort(); });
+                }
+            };
+        }
+    }
+}
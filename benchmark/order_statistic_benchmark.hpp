@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+#include "../collections/set_multiset.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        /**
+         * @brief 百分位/名次查询基准：普通红黑树上 std::distance/std::next 的线性扫描与顺序统计树的 rank/select 对比，
+         * 同时给出维护子树大小给插入带来的额外开销。
+         */
+        struct BenchOrderStatistic
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            static std::vector<int> Keys(size_t n, int range)
+            {
+                std::vector<int> res(n);
+                size_t x = 2024;
+                for (auto &k : res)
+                {
+                    x = x * 6364136223846793005ull + 1442695040888963407ull;
+                    k = int((x >> 33) % size_t(range));
+                }
+                return res;
+            }
+            template <template <typename, typename, typename> class Implement, typename Rank, typename Select>
+            static void Case(const char *name, const std::vector<int> &keys, size_t queries, Rank &&rank, Select &&select)
+            {
+                SetOrMultiset::MultiSet<int, std::less<int>, Implement> ms;
+                double tins = Seconds([&]
+                                      {
+                                          for (int k : keys)
+                                              ms.insert(k);
+                                      });
+                size_t sum = 0;
+                double tq = Seconds([&]
+                                    {
+                                        for (size_t i = 0; i < queries; ++i)
+                                        {
+                                            sum += rank(ms, keys[i]);
+                                            sum += size_t(*select(ms, (i * 7919) % ms.size()));
+                                        }
+                                    });
+                std::printf("  %-28s x%zu: insert %8.2f ms, %zu rank+select %8.2f ms (sum %zu)\n", name, keys.size(), tins * 1e3, queries, tq * 1e3, sum);
+            }
+            static void Run()
+            {
+                std::printf("[order statistic]\n");
+                auto keys = Keys(size_t(1) << 16, 1 << 20);
+                Case<SetOrMultiset::RBTreeLinked>(
+                    "RB tree + linear scan", keys, 300,
+                    [](auto &ms, int k)
+                    { return size_t(std::distance(ms.begin(), ms.lower_bound(k))); },
+                    [](auto &ms, size_t i)
+                    { return std::next(ms.begin(), std::ptrdiff_t(i)); });
+                Case<SetOrMultiset::OrderStatisticRBTreeLinked>(
+                    "Order statistic RB tree", keys, 300,
+                    [](auto &ms, int k)
+                    { return ms.rank(k); },
+                    [](auto &ms, size_t i)
+                    { return ms.select(i); });
+            }
+        };
+    }
+}
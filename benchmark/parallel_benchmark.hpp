@@ -0,0 +1,73 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../parallel/scheduler.hpp"
+namespace DSA
+{
+    namespace Parallel
+    {
+        /**
+         * @brief 调度器开销与加速比：串行循环与 parallel_reduce 对比，以及细粒度 spawn/sync 的递归。
+         */
+        struct BenchParallel
+        {
+            template <typename F>
+            static double Seconds(F &&f)
+            {
+                auto t0 = std::chrono::steady_clock::now();
+                f();
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            }
+            static long long Fib(int n)
+            {
+                return n < 2 ? n : Fib(n - 1) + Fib(n - 2);
+            }
+            static long long ParallelFib(int n, int cutoff)
+            {
+                if (n < cutoff)
+                    return Fib(n);
+                long long a = 0;
+                TaskGroup g;
+                g.spawn([&]
+                        { a = ParallelFib(n - 1, cutoff); });
+                long long b = ParallelFib(n - 2, cutoff);
+                g.sync();
+                return a + b;
+            }
+            static void Run()
+            {
+                std::printf("[parallel] %u workers\n", default_scheduler().num_workers());
+                const size_t n = size_t(1) << 26;
+                std::vector<double> data(n);
+                parallel_for(0, n, 0, [&](size_t i)
+                             { data[i] = double(i % 1000) * 0.5; });
+                double serial_sum = 0, parallel_sum = 0;
+                double t_serial = Seconds([&]
+                                          {
+                                              for (double v : data)
+                                                  serial_sum += v * v; });
+                double t_parallel = Seconds([&]
+                                            { parallel_sum = parallel_reduce(
+                                                  size_t(0), n, size_t(0), 0.0, [&](size_t lo, size_t hi)
+                                                  {
+                                                      double r = 0;
+                                                      for (size_t i = lo; i < hi; ++i)
+                                                          r += data[i] * data[i];
+                                                      return r; },
+                                                  [](double a, double b)
+                                                  { return a + b; }); });
+                std::printf("  sum of squares x%zu: serial %8.2f ms, parallel_reduce %8.2f ms (%g, %g)\n", n, t_serial * 1e3, t_parallel * 1e3, serial_sum, parallel_sum);
+                for (int cutoff : {25, 15})
+                {
+                    long long serial = 0, parallel = 0;
+                    double ts = Seconds([&]
+                                        { serial = Fib(32); });
+                    double tp = Seconds([&]
+                                        { parallel = ParallelFib(32, cutoff); });
+                    std::printf("  fib(32) cutoff %d: serial %8.2f ms, spawn/sync %8.2f ms (%lld, %lld)\n", cutoff, ts * 1e3, tp * 1e3, serial, parallel);
+                }
+            }
+        };
+    }
+}
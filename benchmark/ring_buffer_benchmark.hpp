@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "../collections/ring_buffer.hpp"
+#include "../collections/queue_stack.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            /**
+             * @brief Queue 的三种底层容器对比：std::deque、分段 Deque 与环形缓冲区 RingBuffer。
+             */
+            struct BenchRingBuffer
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                // 网格图上的 BFS：队列的进出占主要开销。队列不按节点数预留：峰值只有一层前沿，
+                // 让环形缓冲区按需增长，循环使用的那段内存一直留在缓存里
+                template <typename Q>
+                static void GridBFS(const char *name, int side)
+                {
+                    int n = side * side;
+                    std::vector<int> dist(n);
+                    size_t sink = 0;
+                    double t = Seconds([&]
+                                       {
+                                           for (int round = 0; round < 4; ++round)
+                                           {
+                                               std::fill(dist.begin(), dist.end(), -1);
+                                               Q q;
+                                               q.push(0);
+                                               dist[0] = 0;
+                                               while (!q.empty())
+                                               {
+                                                   int u = q.front();
+                                                   q.pop();
+                                                   int x = u % side, y = u / side;
+                                                   int nb[4] = {x > 0 ? u - 1 : -1, x + 1 < side ? u + 1 : -1, y > 0 ? u - side : -1, y + 1 < side ? u + side : -1};
+                                                   for (int v : nb)
+                                                       if (v >= 0 && dist[v] < 0)
+                                                       {
+                                                           dist[v] = dist[u] + 1;
+                                                           q.push(v);
+                                                       }
+                                               }
+                                               sink += size_t(dist[n - 1]);
+                                           } });
+                    std::printf("  %-32s BFS on %dx%d grid x4: %8.2f ms (%zu)\n", name, side, side, t * 1e3, sink);
+                }
+                // 成批的生产者/消费者：push_n / pop_n 与逐个 push / pop 对比
+                static void Bulk(size_t batches, size_t batch)
+                {
+                    std::vector<int> src(batch), dst(batch);
+                    for (size_t i = 0; i < batch; ++i)
+                        src[i] = int(i);
+                    size_t sink = 0;
+                    RingBuffer<int> rb(batch * 2);
+                    double t_single = Seconds([&]
+                                              {
+                                                  for (size_t b = 0; b < batches; ++b)
+                                                  {
+                                                      for (int v : src)
+                                                          rb.push_back(v);
+                                                      for (size_t i = 0; i < batch; ++i)
+                                                      {
+                                                          dst[i] = rb.front();
+                                                          rb.pop_front();
+                                                      }
+                                                      sink += size_t(dst[b % batch]);
+                                                  } });
+                    double t_bulk = Seconds([&]
+                                            {
+                                                for (size_t b = 0; b < batches; ++b)
+                                                {
+                                                    rb.push_n(src.data(), batch);
+                                                    rb.pop_n(dst.data(), batch);
+                                                    sink += size_t(dst[b % batch]);
+                                                } });
+                    std::printf("  RingBuffer<int> %zu batches of %zu: single %8.2f ms, push_n/pop_n %8.2f ms (%zu)\n", batches, batch, t_single * 1e3, t_bulk * 1e3, sink);
+                }
+                static void Run()
+                {
+                    std::printf("[ring buffer] queue backends\n");
+                    GridBFS<Queue<int, std::deque<int>>>("Queue<int, std::deque<int>>", 2048);
+                    GridBFS<Queue<int, Deque<int>>>("Queue<int, Deque<int>>", 2048);
+                    GridBFS<RingQueue<int>>("RingQueue<int>", 2048);
+                    Bulk(size_t(1) << 16, 1000);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include "../collections/list_forwardlist.hpp"
+#include "../collections/unrolled_list.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            /**
+             * @brief UnrolledList 与 List、std::list 的遍历、逐个插入、remove_if、排序、unique 基准。
+             */
+            struct BenchUnrolledList
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                template <typename Ls>
+                static void Ops(const char *name, size_t n)
+                {
+                    Ls ls;
+                    size_t x = 12345;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        x = x * 6364136223846793005ull + 1442695040888963407ull;
+                        ls.push_back(int((x >> 33) % 1000));
+                    }
+                    size_t sink = 0;
+                    double iterate = Seconds([&]
+                                             {
+                                                 for (int r = 0; r < 4; ++r)
+                                                     for (int v : ls)
+                                                         sink += size_t(v); });
+                    // 每个元素前插入一个新元素，节点随之分裂、重新分布
+                    double insert = Seconds([&]
+                                            {
+                                                for (auto it = ls.begin(); it != ls.end(); ++it)
+                                                    it = std::next(ls.insert(it, int(sink & 7))); });
+                    double remove = Seconds([&]
+                                            { sink += ls.remove_if([](int v)
+                                                                   { return v % 3 == 1; }); });
+                    double sort = Seconds([&]
+                                          { ls.sort(); });
+                    double uniq = Seconds([&]
+                                          { sink += ls.unique(); });
+                    std::printf("  %-18s x%zu iterate x4 %7.2f ms, insert %7.2f ms, remove_if %6.2f ms, sort %7.2f ms, unique %6.2f ms (%zu)\n", name, n, iterate * 1e3, insert * 1e3, remove * 1e3, sort * 1e3, uniq * 1e3, sink);
+                }
+                static void Run()
+                {
+                    std::printf("[unrolled list]\n");
+                    const size_t n = size_t(1) << 21;
+                    Ops<std::list<int>>("std::list<int>", n);
+                    Ops<List<int>>("List<int>", n);
+                    Ops<UnrolledList<int>>("UnrolledList<int>", n);
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include "../collections/vector.hpp"
+#if defined(__linux__)
+#include "../collections/mmap_allocator.hpp"
+#endif
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            /**
+             * @brief Vector 的增长与中间插入/删除基准，与 std::vector 对比。
+             */
+            struct BenchVector
+            {
+                template <typename F>
+                static double Seconds(F &&f)
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    f();
+                    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                }
+                template <typename Vec, typename Make>
+                static void Growth(const char *name, size_t n, Make make)
+                {
+                    size_t sink = 0;
+                    double t = Seconds([&]
+                                       {
+                                           Vec v;
+                                           for (size_t i = 0; i < n; ++i)
+                                               v.push_back(make(i));
+                                           sink += v.size(); });
+                    std::printf("  %-38s push_back x%zu: %8.2f ms (%zu)\n", name, n, t * 1e3, sink);
+                }
+                template <typename Vec>
+                static void MiddleInsertErase(const char *name, size_t n)
+                {
+                    Vec v;
+                    for (size_t i = 0; i < n; ++i)
+                        v.push_back(int(i));
+                    double t = Seconds([&]
+                                       {
+                                           for (size_t i = 0; i < 2000; ++i)
+                                           {
+                                               v.insert(v.begin() + v.size() / 2, int(i));
+                                               v.erase(v.begin() + v.size() / 3);
+                                           } });
+                    std::printf("  %-38s 2000 middle insert+erase on %zu: %8.2f ms\n", name, n, t * 1e3);
+                }
+                // 模拟每个请求建几个短生命周期的小 vector：默认分配器与请求级 monotonic 内存池对比
+                static void PerRequest(size_t requests)
+                {
+                    size_t sink = 0;
+                    double t_heap = Seconds([&]
+                                            {
+                                                for (size_t r = 0; r < requests; ++r)
+                                                    for (int k = 0; k < 4; ++k)
+                                                    {
+                                                        Vector<int> v;
+                                                        for (int i = 0; i < 24; ++i)
+                                                            v.push_back(i + k);
+                                                        sink += v.size();
+                                                    } });
+                    std::byte buffer[16384];
+                    double t_arena = Seconds([&]
+                                             {
+                                                 for (size_t r = 0; r < requests; ++r)
+                                                 {
+                                                     std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+                                                     for (int k = 0; k < 4; ++k)
+                                                     {
+                                                         pmr::Vector<int> v(&arena);
+                                                         for (int i = 0; i < 24; ++i)
+                                                             v.push_back(i + k);
+                                                         sink += v.size();
+                                                     }
+                                                 } });
+                    std::printf("  per-request vectors x%zu: heap %8.2f ms, monotonic arena %8.2f ms (%zu)\n", requests, t_heap * 1e3, t_arena * 1e3, sink);
+                }
+                // 大缓冲区随后会被整体覆盖：value-init 的 resize 与 resize_for_overwrite 对比（含覆盖写入的时间）
+                static void OverwriteBuffer(size_t n)
+                {
+                    size_t sink = 0;
+                    auto fill = [&](auto &v)
+                    {
+                        for (size_t i = 0; i < n; ++i)
+                            v[i] = int(i);
+                        sink += size_t(v[n / 2]);
+                    };
+                    double t_resize = Seconds([&]
+                                              {
+                                                  Vector<int> v;
+                                                  v.resize(n);
+                                                  fill(v); });
+                    double t_single = Seconds([&]
+                                              {
+                                                  Vector<int> v;
+                                                  v.resize_for_overwrite(n, 1);
+                                                  fill(v); });
+                    double t_touch = Seconds([&]
+                                             {
+                                                 Vector<int> v;
+                                                 v.resize_for_overwrite(n);
+                                                 fill(v); });
+                    std::printf("  fill %zu ints: resize %8.2f ms, resize_for_overwrite %8.2f ms, + parallel first-touch %8.2f ms (%zu)\n",
+                                n, t_resize * 1e3, t_single * 1e3, t_touch * 1e3, sink);
+                }
+                static void Run()
+                {
+                    std::printf("[vector] growth\n");
+                    const size_t n = size_t(1) << 24;
+                    auto make_int = [](size_t i)
+                    { return int(i); };
+                    Growth<std::vector<int>>("std::vector<int>", n, make_int);
+                    Growth<Vector<int>>("Vector<int>", n, make_int);
+                    auto make_ptr = [](size_t i)
+                    { return std::make_unique<int>(int(i)); };
+                    Growth<std::vector<std::unique_ptr<int>>>("std::vector<unique_ptr<int>>", n / 8, make_ptr);
+                    Growth<Vector<std::unique_ptr<int>>>("Vector<unique_ptr<int>>", n / 8, make_ptr);
+                    std::printf("[vector] middle insert/erase\n");
+                    MiddleInsertErase<std::vector<int>>("std::vector<int>", size_t(1) << 20);
+                    MiddleInsertErase<Vector<int>>("Vector<int>", size_t(1) << 20);
+#if defined(__linux__)
+                    std::printf("[vector] huge arrays (mremap growth)\n");
+                    const size_t huge = size_t(1) << 26;
+                    Growth<std::vector<long long>>("std::vector<long long>", huge, make_int);
+                    Growth<Vector<long long>>("Vector<long long> (realloc)", huge, make_int);
+                    Growth<Vector<long long, MmapAllocator<long long>>>("Vector<long long, Mmap>", huge, make_int);
+                    Growth<Vector<long long, MmapAllocator<long long>, PageRoundedGrowth<>>>("Vector<long long, Mmap, PageRounded>", huge, make_int);
+#endif
+                    std::printf("[vector] uninitialized resize\n");
+                    OverwriteBuffer(size_t(1) << 27);
+                    std::printf("[vector] allocators\n");
+                    PerRequest(size_t(1) << 18);
+                }
+            };
+        }
+    }
+}
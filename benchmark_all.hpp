@@ -0,0 +1,14 @@
+#pragma once
+#include "benchmark/hash_function_benchmark.hpp"
+#include "benchmark/vector_benchmark.hpp"
+#include "benchmark/deque_benchmark.hpp"
+#include "benchmark/ring_buffer_benchmark.hpp"
+#include "benchmark/concurrent_queue_benchmark.hpp"
+#include "benchmark/parallel_benchmark.hpp"
+#include "benchmark/list_benchmark.hpp"
+#include "benchmark/unrolled_list_benchmark.hpp"
+#include "benchmark/intrusive_benchmark.hpp"
+#include "benchmark/order_statistic_benchmark.hpp"
+#include "benchmark/bplus_tree_benchmark.hpp"
+#include "benchmark/bulk_build_benchmark.hpp"
+#include "benchmark/hashtable_benchmark.hpp"
\ No newline at end of file
@@ -1,22 +1,33 @@
 #pragma once
-#include "queue_stack.hpp"
-#include "list_forwardlist.hpp"
-#include "priority_queue.hpp"
-#include "set_multiset.hpp"
-#include "map_multimap.hpp"
-#include "vector.hpp"
+#include "collections/queue_stack.hpp"
+#include "collections/list_forwardlist.hpp"
+#include "collections/node_pool.hpp"
+#include "collections/unrolled_list.hpp"
+#include "collections/intrusive_list.hpp"
+#include "tree/binary_tree/binary_search_tree/intrusive_RB_tree.hpp"
+#include "tree/heap/priority_queue.hpp"
+#include "collections/set_multiset.hpp"
+#include "collections/map_multimap.hpp"
+#include "collections/vector.hpp"
+#include "collections/small_vector.hpp"
+#include "collections/deque.hpp"
 namespace DSA
 {
     namespace Collections
     {
         using ListOrForwardlist::List;
+        using ListOrForwardlist::UnrolledList;
+        using ListOrForwardlist::ListHook;
+        using ListOrForwardlist::IntrusiveList;
+        using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::RBTreeHook;
+        using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::IntrusiveRBTree;
         using DSA::Tree::Heap::PriorityQueue;
         using SetOrMultiset::Set;
         using SetOrMultiset::MultiSet;
         using MapOrMultimap::Map;
         using MapOrMultimap::MultiMap;
-        using Queue=Queue;
-        using Stack=Stack;
         using ArrayLike::Vector;
+        using ArrayLike::SmallVector;
+        using ArrayLike::Deque;
     }
 }
\ No newline at end of file
@@ -0,0 +1,442 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace Concurrent
+        {
+            // 缓存行大小；不同线程频繁写入的变量放在不同的缓存行上，避免伪共享
+            inline constexpr size_t cache_line_size = 64;
+
+            namespace detail
+            {
+                inline size_t round_capacity(size_t n) { return std::bit_ceil(std::max<size_t>(n, 2)); }
+                // 忙等时提示 CPU 当前在自旋，降低功耗并让出超线程的执行资源
+                inline void cpu_relax()
+                {
+#if defined(__x86_64__) || defined(__i386__)
+                    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+                    asm volatile("yield");
+#endif
+                }
+            }
+
+            /**
+             * @brief 单生产者单消费者的有界无锁队列（环形缓冲区）。
+             *
+             * head 只由消费者写、tail 只由生产者写，两者分处不同的缓存行。
+             * 每一端还缓存一份对端下标的副本（生产者缓存 head，消费者缓存 tail），只有副本显示“满”或“空”时才去读对端的原子变量，
+             * 大部分操作只访问本线程独占的缓存行，不产生跨核的缓存行传递。
+             * 容量向上取整到 2 的幂，下标单调递增、按位与取模，所有槽都可以使用。
+             *
+             * try_push* 只能由一个生产者线程调用，try_pop* 只能由一个消费者线程调用。
+             */
+            template <typename T>
+            class SPSCQueue
+            {
+            public:
+                using value_type = T;
+                using size_type = size_t;
+
+                explicit SPSCQueue(size_type capacity)
+                    : cap(detail::round_capacity(capacity)), mask(cap - 1), slots(std::allocator<T>{}.allocate(cap)) {}
+                ~SPSCQueue()
+                {
+                    size_type h = head.load(std::memory_order_relaxed), t = tail.load(std::memory_order_relaxed);
+                    for (; h != t; ++h)
+                        std::destroy_at(slots + (h & mask));
+                    std::allocator<T>{}.deallocate(slots, cap);
+                }
+                SPSCQueue(const SPSCQueue &) = delete;
+                SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+                size_type capacity() const { return cap; }
+                // 并发时只是一个近似值
+                size_type size_approx() const
+                {
+                    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+                }
+                bool empty_approx() const { return size_approx() == 0; }
+
+                // --- 生产者 ---
+                template <typename... Args>
+                bool try_emplace(Args &&...args)
+                {
+                    size_type t = tail.load(std::memory_order_relaxed);
+                    if (t - cached_head == cap)
+                    {
+                        cached_head = head.load(std::memory_order_acquire);
+                        if (t - cached_head == cap)
+                            return false;
+                    }
+                    std::construct_at(slots + (t & mask), std::forward<Args>(args)...);
+                    tail.store(t + 1, std::memory_order_release);
+                    return true;
+                }
+                bool try_push(const T &v) { return try_emplace(v); }
+                bool try_push(T &&v) { return try_emplace(std::move(v)); }
+                /**
+                 * @brief 尽量多地写入 [src, src + n)，返回实际写入的个数；
+                 * 整批只读一次对端下标、只发布一次 tail，消费者一次看到整批数据。
+                 */
+                size_type try_push_n(const T *src, size_type n)
+                {
+                    size_type t = tail.load(std::memory_order_relaxed);
+                    if (cap - (t - cached_head) < n)
+                        cached_head = head.load(std::memory_order_acquire);
+                    n = std::min(n, cap - (t - cached_head));
+                    for (size_type i = 0; i < n; ++i)
+                        std::construct_at(slots + ((t + i) & mask), src[i]);
+                    tail.store(t + n, std::memory_order_release);
+                    return n;
+                }
+
+                // --- 消费者 ---
+                bool try_pop(T &out)
+                {
+                    size_type h = head.load(std::memory_order_relaxed);
+                    if (h == cached_tail)
+                    {
+                        cached_tail = tail.load(std::memory_order_acquire);
+                        if (h == cached_tail)
+                            return false;
+                    }
+                    T *p = slots + (h & mask);
+                    out = std::move(*p);
+                    std::destroy_at(p);
+                    head.store(h + 1, std::memory_order_release);
+                    return true;
+                }
+                // 尽量多地取出至多 n 个元素，移动赋值到 [dst, dst + k)，返回 k
+                size_type try_pop_n(T *dst, size_type n)
+                {
+                    size_type h = head.load(std::memory_order_relaxed);
+                    if (cached_tail - h < n)
+                        cached_tail = tail.load(std::memory_order_acquire);
+                    n = std::min(n, cached_tail - h);
+                    for (size_type i = 0; i < n; ++i)
+                    {
+                        T *p = slots + ((h + i) & mask);
+                        dst[i] = std::move(*p);
+                        std::destroy_at(p);
+                    }
+                    head.store(h + n, std::memory_order_release);
+                    return n;
+                }
+
+            private:
+                const size_type cap, mask;
+                T *const slots;
+                alignas(cache_line_size) std::atomic<size_type> head{0}; // 消费者写
+                size_type cached_tail = 0;                               // 消费者本地的 tail 副本
+                alignas(cache_line_size) std::atomic<size_type> tail{0}; // 生产者写
+                size_type cached_head = 0;                               // 生产者本地的 head 副本
+            };
+
+            /**
+             * @brief 多生产者多消费者的有界无锁队列（Dmitry Vyukov 的逐槽序号设计）。
+             *
+             * 每个槽带一个序号 seq：seq == pos 表示该槽空闲、可供第 pos 次入队使用；seq == pos + 1 表示已写好、可供第 pos 次出队使用。
+             * 生产者用 CAS 推进 enqueue_pos 抢占一个槽，写入后把 seq 置为 pos + 1；消费者对称地推进 dequeue_pos，取出后把 seq 置为 pos + cap，
+             * 留给下一轮。竞争只发生在两个位置计数器上，读写元素本身不需要互斥。
+             * 每个槽独占一条缓存行，相邻槽上的生产者和消费者互不干扰。
+             *
+             * 批量操作先检查从当前位置起连续多少个槽就绪，再用一次 CAS 把位置一次推进这么多，一批元素只竞争一次计数器。
+             */
+            template <typename T>
+            class MPMCQueue
+            {
+                struct alignas(cache_line_size) Cell
+                {
+                    std::atomic<size_t> seq;
+                    alignas(T) unsigned char storage[sizeof(T)];
+                    T *value() { return std::launder(reinterpret_cast<T *>(storage)); }
+                };
+
+            public:
+                using value_type = T;
+                using size_type = size_t;
+
+                explicit MPMCQueue(size_type capacity)
+                    : cap(detail::round_capacity(capacity)), mask(cap - 1), cells(new Cell[cap])
+                {
+                    for (size_type i = 0; i < cap; ++i)
+                        cells[i].seq.store(i, std::memory_order_relaxed);
+                }
+                ~MPMCQueue()
+                {
+                    size_type h = dequeue_pos.load(std::memory_order_relaxed), t = enqueue_pos.load(std::memory_order_relaxed);
+                    for (; h != t; ++h)
+                        std::destroy_at(cells[h & mask].value());
+                }
+                MPMCQueue(const MPMCQueue &) = delete;
+                MPMCQueue &operator=(const MPMCQueue &) = delete;
+
+                size_type capacity() const { return cap; }
+                // 并发时只是一个近似值
+                size_type size_approx() const
+                {
+                    size_type t = enqueue_pos.load(std::memory_order_acquire), h = dequeue_pos.load(std::memory_order_acquire);
+                    return t > h ? t - h : 0;
+                }
+                bool empty_approx() const { return size_approx() == 0; }
+
+                template <typename... Args>
+                bool try_emplace(Args &&...args)
+                {
+                    size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+                    Cell *cell;
+                    for (;;)
+                    {
+                        cell = &cells[pos & mask];
+                        size_type seq = cell->seq.load(std::memory_order_acquire);
+                        auto diff = std::ptrdiff_t(seq - pos);
+                        if (diff == 0)
+                        {
+                            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if (diff < 0)
+                            return false; // 该槽上一轮的元素还没被取走：队列已满
+                        else
+                            pos = enqueue_pos.load(std::memory_order_relaxed);
+                    }
+                    std::construct_at(cell->value(), std::forward<Args>(args)...);
+                    cell->seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                bool try_push(const T &v) { return try_emplace(v); }
+                bool try_push(T &&v) { return try_emplace(std::move(v)); }
+                bool try_pop(T &out)
+                {
+                    size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+                    Cell *cell;
+                    for (;;)
+                    {
+                        cell = &cells[pos & mask];
+                        size_type seq = cell->seq.load(std::memory_order_acquire);
+                        auto diff = std::ptrdiff_t(seq - (pos + 1));
+                        if (diff == 0)
+                        {
+                            if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                                break;
+                        }
+                        else if (diff < 0)
+                            return false; // 该槽还没写好：队列为空
+                        else
+                            pos = dequeue_pos.load(std::memory_order_relaxed);
+                    }
+                    out = std::move(*cell->value());
+                    std::destroy_at(cell->value());
+                    cell->seq.store(pos + cap, std::memory_order_release);
+                    return true;
+                }
+                // 一次抢占至多 n 个连续的空闲槽并写入，返回实际写入的个数
+                size_type try_push_n(const T *src, size_type n)
+                {
+                    size_type pos, k;
+                    if (!(k = claim(enqueue_pos, pos, n, 0)))
+                        return 0;
+                    for (size_type i = 0; i < k; ++i)
+                    {
+                        Cell &cell = cells[(pos + i) & mask];
+                        std::construct_at(cell.value(), src[i]);
+                        cell.seq.store(pos + i + 1, std::memory_order_release);
+                    }
+                    return k;
+                }
+                // 一次抢占至多 n 个连续的已写好的槽并取出，返回实际取出的个数
+                size_type try_pop_n(T *dst, size_type n)
+                {
+                    size_type pos, k;
+                    if (!(k = claim(dequeue_pos, pos, n, 1)))
+                        return 0;
+                    for (size_type i = 0; i < k; ++i)
+                    {
+                        Cell &cell = cells[(pos + i) & mask];
+                        dst[i] = std::move(*cell.value());
+                        std::destroy_at(cell.value());
+                        cell.seq.store(pos + i + cap, std::memory_order_release);
+                    }
+                    return k;
+                }
+
+            private:
+                const size_type cap, mask;
+                std::unique_ptr<Cell[]> cells;
+                alignas(cache_line_size) std::atomic<size_type> enqueue_pos{0};
+                alignas(cache_line_size) std::atomic<size_type> dequeue_pos{0};
+
+                /**
+                 * @brief 从计数器 counter 的当前位置起数出连续就绪（seq == pos + i + offset）的槽，至多 n 个，
+                 * 用一次 CAS 把计数器推进这么多；成功后 pos 为起始位置，返回抢占的个数（0 表示满或空）。
+                 */
+                size_type claim(std::atomic<size_type> &counter, size_type &pos, size_type n, size_type offset)
+                {
+                    pos = counter.load(std::memory_order_relaxed);
+                    for (;;)
+                    {
+                        size_type k = 0;
+                        bool stale = false;
+                        for (; k < n && k < cap; ++k)
+                        {
+                            auto diff = std::ptrdiff_t(cells[(pos + k) & mask].seq.load(std::memory_order_acquire) - (pos + k + offset));
+                            if (diff != 0)
+                            {
+                                // 第一个槽就已被别的线程用过，说明 pos 过时了
+                                stale = k == 0 && diff > 0;
+                                break;
+                            }
+                        }
+                        if (stale)
+                        {
+                            pos = counter.load(std::memory_order_relaxed);
+                            continue;
+                        }
+                        if (!k)
+                            return 0;
+                        if (counter.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                            return k;
+                    }
+                }
+            };
+
+            /**
+             * @brief 为 SPSCQueue / MPMCQueue 加上阻塞等待的包装。
+             *
+             * 快路径完全无锁：先直接 try_*，失败后自旋若干次；仍然失败才登记为等待者并在条件变量上睡眠。
+             * 另一端只有在确实有等待者时才去加锁 notify，没有线程睡眠时不碰互斥量。
+             * “登记等待者后再检查一次队列”与“操作队列后再检查等待者”之间都有 seq_cst 栅栏，不会丢失唤醒。
+             *
+             * close() 之后 push 返回 false，pop 取完剩余元素后返回 false，供流水线的下游退出。
+             */
+            template <typename Queue>
+            class BlockingQueue
+            {
+            public:
+                using value_type = typename Queue::value_type;
+                using size_type = typename Queue::size_type;
+                static constexpr int spin_count = 128;
+
+                explicit BlockingQueue(size_type capacity) : q(capacity) {}
+
+                Queue &queue() { return q; }
+                size_type capacity() const { return q.capacity(); }
+                size_type size_approx() const { return q.size_approx(); }
+
+                bool try_push(const value_type &v) { return after_push(q.try_push(v)); }
+                bool try_pop(value_type &out) { return after_pop(q.try_pop(out)); }
+
+                // 阻塞直到写入成功；队列已关闭时返回 false
+                bool push(const value_type &v)
+                {
+                    bool pushed = false;
+                    wait_for(push_waiters, not_full, [&]
+                             { return (pushed = q.try_push(v)) || is_closed(); });
+                    return after_push(pushed);
+                }
+                // 阻塞直到取出一个元素；队列已关闭且为空时返回 false
+                bool pop(value_type &out)
+                {
+                    bool got = false;
+                    wait_for(pop_waiters, not_empty, [&]
+                             { return (got = q.try_pop(out)) || is_closed(); });
+                    // 关闭前放入的元素要取完，再尝试一次
+                    return after_pop(got || q.try_pop(out));
+                }
+                // 阻塞直到 [src, src + n) 全部写入，返回写入的个数；队列关闭时可能少于 n
+                size_type push_n(const value_type *src, size_type n)
+                {
+                    size_type done = 0;
+                    while (done < n && !is_closed())
+                    {
+                        size_type k = 0;
+                        wait_for(push_waiters, not_full, [&]
+                                 { return (k = q.try_push_n(src + done, n - done)) > 0 || is_closed(); });
+                        after_push(k > 0);
+                        done += k;
+                    }
+                    return done;
+                }
+                // 阻塞直到至少取出一个元素，返回取出的个数（至多 n）；队列已关闭且为空时返回 0
+                size_type pop_n(value_type *dst, size_type n)
+                {
+                    size_type k = 0;
+                    wait_for(pop_waiters, not_empty, [&]
+                             { return (k = q.try_pop_n(dst, n)) > 0 || is_closed(); });
+                    if (!k)
+                        k = q.try_pop_n(dst, n);
+                    after_pop(k > 0);
+                    return k;
+                }
+                void close()
+                {
+                    closed.store(true, std::memory_order_release);
+                    std::lock_guard<std::mutex> lk(m);
+                    not_empty.notify_all();
+                    not_full.notify_all();
+                }
+                bool is_closed() const { return closed.load(std::memory_order_acquire); }
+
+            private:
+                Queue q;
+                std::mutex m;
+                std::condition_variable not_empty, not_full;
+                std::atomic<int> push_waiters{0}, pop_waiters{0};
+                std::atomic<bool> closed{false};
+
+                // 写入成功后唤醒可能在等待的消费者
+                bool after_push(bool ok)
+                {
+                    if (ok)
+                        wake(pop_waiters, not_empty);
+                    return ok;
+                }
+                bool after_pop(bool ok)
+                {
+                    if (ok)
+                        wake(push_waiters, not_full);
+                    return ok;
+                }
+                void wake(std::atomic<int> &waiters, std::condition_variable &cv)
+                {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (waiters.load(std::memory_order_relaxed) > 0)
+                    {
+                        std::lock_guard<std::mutex> lk(m);
+                        cv.notify_all();
+                    }
+                }
+                // 先自旋，再登记为等待者后睡眠，直到 ready() 为真；ready() 可能在持有互斥量时被调用，不能再去唤醒另一端
+                template <typename Ready>
+                void wait_for(std::atomic<int> &waiters, std::condition_variable &cv, Ready ready)
+                {
+                    for (int i = 0; i < spin_count; ++i)
+                    {
+                        if (ready())
+                            return;
+                        detail::cpu_relax();
+                    }
+                    waiters.fetch_add(1, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    {
+                        std::unique_lock<std::mutex> lk(m);
+                        cv.wait(lk, ready);
+                    }
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                }
+            };
+        }
+    }
+}
@@ -1,22 +1,600 @@
 #pragma once
 #include <memory>
 #include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 #include <string>
 #include <sstream>
 namespace DSA
 {
     namespace Collections
     {
-        namespace Deque
+        namespace ArrayLike
         {
+            /**
+             * @brief Deque 每个块容纳的元素个数。
+             *
+             * 小元素的块取一页（4096 字节，64 条缓存行）：块内顺序访问完全连续，一个块只占一个页表项，
+             * 块数也足够少，中控数组（map）常驻缓存。大元素至少 16 个一块，保证每块的分配能被摊还。
+             */
+            template <typename T>
+            inline constexpr size_t deque_block_size = sizeof(T) <= 256 ? size_t(4096) / sizeof(T) : 16;
+
             namespace detail
             {
-                template<typename T>
-                struct DequeMapBase{
-                    
+                template <typename T, typename Alloc>
+                struct DequeMapBase;
+
+                /**
+                 * @brief Deque 的随机访问迭代器。
+                 *
+                 * 持有中控数组的地址和元素的逻辑下标，解引用时用 下标 / 块大小 找块、下标 % 块大小 找块内位置；
+                 * 块大小是编译期常量，除法会被编译成乘法和移位。
+                 * 中控数组重新分配后迭代器失效（与 std::deque 相同），但元素本身从不移动，引用和指针一直有效。
+                 */
+                template <typename T, bool IsConst>
+                struct DequeIterator
+                {
+                    static constexpr size_t block_size = deque_block_size<T>;
+                    using value_type = T;
+                    using reference = std::conditional_t<IsConst, const T &, T &>;
+                    using pointer = std::conditional_t<IsConst, const T *, T *>;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::random_access_iterator_tag;
+
+                    DequeIterator() = default;
+                    DequeIterator(T *const *m, size_t i) : map(m), index(i) {}
+                    // 允许从可变迭代器构造常量迭代器
+                    template <bool FromConst = IsConst>
+                        requires FromConst
+                    DequeIterator(const DequeIterator<T, false> &other) : map(other.map), index(other.index)
+                    {
+                    }
+
+                    reference operator*() const { return map[index / block_size][index % block_size]; }
+                    pointer operator->() const { return &**this; }
+                    reference operator[](difference_type n) const { return *(*this + n); }
+
+                    DequeIterator &operator++()
+                    {
+                        ++index;
+                        return *this;
+                    }
+                    DequeIterator operator++(int)
+                    {
+                        auto tmp = *this;
+                        ++index;
+                        return tmp;
+                    }
+                    DequeIterator &operator--()
+                    {
+                        --index;
+                        return *this;
+                    }
+                    DequeIterator operator--(int)
+                    {
+                        auto tmp = *this;
+                        --index;
+                        return tmp;
+                    }
+                    DequeIterator &operator+=(difference_type n)
+                    {
+                        index += n;
+                        return *this;
+                    }
+                    DequeIterator &operator-=(difference_type n)
+                    {
+                        index -= n;
+                        return *this;
+                    }
+                    friend DequeIterator operator+(DequeIterator it, difference_type n) { return it += n; }
+                    friend DequeIterator operator+(difference_type n, DequeIterator it) { return it += n; }
+                    friend DequeIterator operator-(DequeIterator it, difference_type n) { return it -= n; }
+                    friend difference_type operator-(const DequeIterator &lhs, const DequeIterator &rhs)
+                    {
+                        return difference_type(lhs.index) - difference_type(rhs.index);
+                    }
+                    bool operator==(const DequeIterator &other) const { return index == other.index; }
+                    bool operator!=(const DequeIterator &other) const { return index != other.index; }
+                    bool operator<(const DequeIterator &other) const { return index < other.index; }
+                    bool operator<=(const DequeIterator &other) const { return index <= other.index; }
+                    bool operator>(const DequeIterator &other) const { return index > other.index; }
+                    bool operator>=(const DequeIterator &other) const { return index >= other.index; }
+
+                protected:
+                    T *const *map = nullptr;
+                    size_t index = 0;
+                    friend DequeIterator<T, true>;
+                    template <typename, typename>
+                    friend struct DequeMapBase;
                 };
 
+                /**
+                 * @brief Deque 的内存管理基类：中控数组、定长块与空闲块缓存。
+                 *
+                 * 元素占据一段逻辑下标 [head, head + count)，下标 i 位于块 map[i / block_size] 的第 i % block_size 格。
+                 * 只有被元素占用的块才分配内存，其余 map 槽为空指针；两端增长都只是在 map 里挂上新块，已有元素从不移动。
+                 * map 的一端用尽时，若 map 足够空闲就把块指针平移回中间，否则扩为两倍——只搬指针，不搬元素。
+                 *
+                 * 弹出使块变空时，块先放进一个很小的空闲块缓存，下次需要新块时优先复用。
+                 * 像队列那样一端进一端出时，块在两端之间循环使用，稳态下不再调用分配器。
+                 * 这个类只管理内存，不负责构造和析构元素。
+                 */
+                template <typename T, typename Alloc>
+                struct DequeMapBase
+                {
+                    using value_type = T;
+                    using reference = T &;
+                    using const_reference = const T &;
+                    using pointer = T *;
+                    using const_pointer = const T *;
+                    using size_type = size_t;
+                    using difference_type = std::ptrdiff_t;
+                    using allocator_type = Alloc;
+                    using traits = std::allocator_traits<allocator_type>;
+                    using map_allocator_type = typename traits::template rebind_alloc<T *>;
+                    using map_traits = std::allocator_traits<map_allocator_type>;
+                    static constexpr size_type block_size = deque_block_size<T>;
+                    static constexpr size_type initial_map_size = 8;
+                    static constexpr size_type max_spare_blocks = 4;
+
+                    DequeMapBase() = default;
+                    explicit DequeMapBase(const allocator_type &a) : alloc(a) {}
+                    ~DequeMapBase() { release_all(); }
+                    DequeMapBase(const DequeMapBase &) = delete;
+                    DequeMapBase &operator=(const DequeMapBase &) = delete;
+                    // 移动构造只转移 map、空闲块和几个下标，O(1)
+                    DequeMapBase(DequeMapBase &&other) noexcept : alloc(std::move(other.alloc))
+                    {
+                        steal(other);
+                    }
+
+                protected:
+                    T **map = nullptr;
+                    size_type map_size = 0;
+                    size_type head = 0;  // 第一个元素的逻辑下标
+                    size_type count = 0; // 元素个数
+                    T *spare[max_spare_blocks] = {};
+                    size_type spare_count = 0;
+                    [[no_unique_address]] allocator_type alloc;
+
+                    T *slot(size_type i) const { return map[i / block_size] + i % block_size; }
+
+                    // 在 map 的第 b 格挂上一个块，优先取空闲块缓存
+                    void acquire_block(size_type b)
+                    {
+                        map[b] = spare_count ? spare[--spare_count] : traits::allocate(alloc, block_size);
+                    }
+                    // 取下 map 的第 b 格的块：缓存未满时留作备用，否则归还分配器
+                    void release_block(size_type b)
+                    {
+                        if (spare_count < max_spare_blocks)
+                            spare[spare_count++] = map[b];
+                        else
+                            traits::deallocate(alloc, map[b], block_size);
+                        map[b] = nullptr;
+                    }
+                    void release_spare()
+                    {
+                        while (spare_count)
+                            traits::deallocate(alloc, spare[--spare_count], block_size);
+                    }
+                    // 释放 map 上的所有块、空闲块和 map 本身；调用前元素应已全部析构
+                    void release_all()
+                    {
+                        if (map)
+                        {
+                            for (size_type b = 0; b < map_size; ++b)
+                                if (map[b])
+                                    traits::deallocate(alloc, map[b], block_size);
+                            map_allocator_type map_alloc(alloc);
+                            map_traits::deallocate(map_alloc, map, map_size);
+                        }
+                        release_spare();
+                        map = nullptr;
+                        map_size = head = count = 0;
+                    }
+                    void steal(DequeMapBase &other) noexcept
+                    {
+                        map = std::exchange(other.map, nullptr);
+                        map_size = std::exchange(other.map_size, 0);
+                        head = std::exchange(other.head, 0);
+                        count = std::exchange(other.count, 0);
+                        spare_count = std::exchange(other.spare_count, 0);
+                        std::copy(other.spare, other.spare + max_spare_blocks, spare);
+                    }
+                    void swap_storage(DequeMapBase &other) noexcept
+                    {
+                        std::swap(map, other.map);
+                        std::swap(map_size, other.map_size);
+                        std::swap(head, other.head);
+                        std::swap(count, other.count);
+                        std::swap(spare, other.spare);
+                        std::swap(spare_count, other.spare_count);
+                    }
+                    // 容器变空后把起点放回 map 中间，两端都留出余量，避免只进不出的一端很快碰到 map 边界
+                    void recenter_if_empty()
+                    {
+                        if (!count)
+                            head = map_size / 2 * block_size;
+                    }
+
+                    /**
+                     * @brief 保证 map 在 at_front 指定的一端至少还有一个空槽。
+                     * 已用块数不到 map 的一半时原地把块指针平移到中间，否则换成两倍大小的新 map。
+                     */
+                    void grow_map(bool at_front)
+                    {
+                        size_type first = count ? head / block_size : 0;
+                        size_type used = count ? (head + count - 1) / block_size - first + 1 : 0;
+                        size_type needed = used + 1;
+                        size_type new_first;
+                        if (map && map_size >= 2 * needed + 2)
+                        {
+                            new_first = (map_size - needed) / 2 + (at_front ? 1 : 0);
+                            std::memmove(static_cast<void *>(map + new_first), map + first, used * sizeof(T *));
+                            std::fill(map, map + new_first, nullptr);
+                            std::fill(map + new_first + used, map + map_size, nullptr);
+                        }
+                        else
+                        {
+                            size_type new_size = std::max({map_size * 2, needed * 2 + 2, initial_map_size});
+                            map_allocator_type map_alloc(alloc);
+                            T **new_map = map_traits::allocate(map_alloc, new_size);
+                            std::fill(new_map, new_map + new_size, nullptr);
+                            new_first = (new_size - needed) / 2 + (at_front ? 1 : 0);
+                            if (used)
+                                std::copy(map + first, map + first + used, new_map + new_first);
+                            if (map)
+                                map_traits::deallocate(map_alloc, map, map_size);
+                            map = new_map;
+                            map_size = new_size;
+                        }
+                        head = count ? new_first * block_size + head % block_size : new_first * block_size;
+                    }
+                };
             }
+
+            /**
+             * @brief 分段双端队列：定长块 + 中控数组（map）。
+             *
+             * - 两端的 push / pop 都是 O(1)（map 扩容摊还），增长时元素从不重定位，指向元素的引用和指针在两端插入后依然有效；
+             * - 支持随机访问迭代器，operator[] 只需一次除法（编译期常量）和两次访存；
+             * - 块大小见 deque_block_size，空闲块缓存让队列式的使用在稳态下不再分配内存；
+             * - 中间插入/删除移动较近一端的元素，O(min(i, n - i))。
+             * @tparam Alloc 分配器，遵循 propagate_on_container_* 传播规则。
+             */
+            template <typename T, typename Alloc = std::allocator<T>>
+            struct Deque final : detail::DequeMapBase<T, Alloc>
+            {
+                using Base = detail::DequeMapBase<T, Alloc>;
+                using allocator_type = Base::allocator_type;
+                using value_type = Base::value_type;
+                using reference = Base::reference;
+                using const_reference = Base::const_reference;
+                using pointer = Base::pointer;
+                using const_pointer = Base::const_pointer;
+                using size_type = Base::size_type;
+                using difference_type = Base::difference_type;
+                using iterator = detail::DequeIterator<T, false>;
+                using const_iterator = detail::DequeIterator<T, true>;
+                using reverse_iterator = std::reverse_iterator<iterator>;
+                using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+                using traits = Base::traits;
+                using Base::block_size;
+
+                Deque() = default;
+                explicit Deque(const allocator_type &a) : Base(a) {}
+                explicit Deque(size_type n, const allocator_type &a = allocator_type()) : Base(a)
+                {
+                    resize(n);
+                }
+                Deque(size_type n, const T &v, const allocator_type &a = allocator_type()) : Base(a)
+                {
+                    resize(n, v);
+                }
+                template <class InputIt>
+                    requires std::input_iterator<InputIt>
+                Deque(InputIt first, InputIt last, const allocator_type &a = allocator_type()) : Base(a)
+                {
+                    for (; first != last; ++first)
+                        emplace_back(*first);
+                }
+                Deque(std::initializer_list<T> il, const allocator_type &a = allocator_type()) : Deque(il.begin(), il.end(), a) {}
+                Deque(const Deque &other)
+                    : Deque(other, traits::select_on_container_copy_construction(other.alloc)) {}
+                Deque(const Deque &other, const allocator_type &a) : Deque(other.begin(), other.end(), a) {}
+                Deque(Deque &&other) noexcept : Base(std::move(other)) {}
+                ~Deque() { clear(); }
+
+                Deque &operator=(const Deque &other)
+                {
+                    if (this == std::addressof(other))
+                        return *this;
+                    if constexpr (traits::propagate_on_container_copy_assignment::value)
+                    {
+                        if (this->alloc != other.alloc)
+                        {
+                            // 旧分配器分配的内存必须由旧分配器释放
+                            clear();
+                            this->release_all();
+                        }
+                        this->alloc = other.alloc;
+                    }
+                    assign(other.begin(), other.end());
+                    return *this;
+                }
+                Deque &operator=(Deque &&other) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value)
+                {
+                    if (this == std::addressof(other))
+                        return *this;
+                    if constexpr (traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value)
+                    {
+                        clear();
+                        this->release_all();
+                        if constexpr (traits::propagate_on_container_move_assignment::value)
+                            this->alloc = std::move(other.alloc);
+                        this->steal(other);
+                    }
+                    else if (this->alloc == other.alloc)
+                    {
+                        clear();
+                        this->release_all();
+                        this->steal(other);
+                    }
+                    else
+                    {
+                        // 分配器不同且不传播，只能逐个移动元素
+                        assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                    }
+                    return *this;
+                }
+                Deque &operator=(std::initializer_list<T> il)
+                {
+                    assign(il.begin(), il.end());
+                    return *this;
+                }
+
+                allocator_type get_allocator() const { return this->alloc; }
+                size_type size() const { return this->count; }
+                bool empty() const { return !this->count; }
+
+                reference at(size_type index)
+                {
+                    check_index(index);
+                    return (*this)[index];
+                }
+                const_reference at(size_type index) const
+                {
+                    check_index(index);
+                    return (*this)[index];
+                }
+                reference operator[](size_type index) { return *this->slot(this->head + index); }
+                const_reference operator[](size_type index) const { return *this->slot(this->head + index); }
+                reference front() { return *this->slot(this->head); }
+                const_reference front() const { return *this->slot(this->head); }
+                reference back() { return *this->slot(this->head + this->count - 1); }
+                const_reference back() const { return *this->slot(this->head + this->count - 1); }
+
+                iterator begin() { return iterator{this->map, this->head}; }
+                const_iterator begin() const { return const_iterator{this->map, this->head}; }
+                iterator end() { return iterator{this->map, this->head + this->count}; }
+                const_iterator end() const { return const_iterator{this->map, this->head + this->count}; }
+                reverse_iterator rbegin() { return reverse_iterator{end()}; }
+                const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+                reverse_iterator rend() { return reverse_iterator{begin()}; }
+                const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+                const_iterator cbegin() const { return begin(); }
+                const_iterator cend() const { return end(); }
+                const_reverse_iterator crbegin() const { return rbegin(); }
+                const_reverse_iterator crend() const { return rend(); }
+
+                // --- 两端的插入与删除 ---
+                template <typename... Args>
+                reference emplace_back(Args &&...args)
+                {
+                    size_type i = this->head + this->count;
+                    if (!this->count || i % block_size == 0)
+                    {
+                        // 需要一个新块
+                        if (!this->map || i / block_size >= this->map_size)
+                        {
+                            this->grow_map(false);
+                            i = this->head + this->count;
+                        }
+                        this->acquire_block(i / block_size);
+                        try
+                        {
+                            traits::construct(this->alloc, this->slot(i), std::forward<Args>(args)...);
+                        }
+                        catch (...)
+                        {
+                            this->release_block(i / block_size);
+                            throw;
+                        }
+                    }
+                    else
+                        traits::construct(this->alloc, this->slot(i), std::forward<Args>(args)...);
+                    ++this->count;
+                    return *this->slot(i);
+                }
+                template <typename... Args>
+                reference emplace_front(Args &&...args)
+                {
+                    if (!this->count)
+                        return emplace_back(std::forward<Args>(args)...);
+                    if (this->head % block_size == 0)
+                    {
+                        if (!this->head)
+                            this->grow_map(true);
+                        size_type b = (this->head - 1) / block_size;
+                        this->acquire_block(b);
+                        try
+                        {
+                            traits::construct(this->alloc, this->slot(this->head - 1), std::forward<Args>(args)...);
+                        }
+                        catch (...)
+                        {
+                            this->release_block(b);
+                            throw;
+                        }
+                    }
+                    else
+                        traits::construct(this->alloc, this->slot(this->head - 1), std::forward<Args>(args)...);
+                    --this->head;
+                    ++this->count;
+                    return front();
+                }
+                void push_back(const T &v) { emplace_back(v); }
+                void push_back(T &&v) { emplace_back(std::move(v)); }
+                void push_front(const T &v) { emplace_front(v); }
+                void push_front(T &&v) { emplace_front(std::move(v)); }
+                void pop_back()
+                {
+                    size_type i = this->head + this->count - 1;
+                    traits::destroy(this->alloc, this->slot(i));
+                    --this->count;
+                    if (!this->count || i % block_size == 0)
+                        this->release_block(i / block_size);
+                    this->recenter_if_empty();
+                }
+                void pop_front()
+                {
+                    size_type i = this->head;
+                    traits::destroy(this->alloc, this->slot(i));
+                    ++this->head;
+                    --this->count;
+                    if (!this->count || this->head % block_size == 0)
+                        this->release_block(i / block_size);
+                    this->recenter_if_empty();
+                }
+
+                // --- 中间的插入与删除：移动离插入/删除点较近的那一端 ---
+                template <typename... Args>
+                iterator emplace(const_iterator pos, Args &&...args)
+                {
+                    size_type index = pos - cbegin();
+                    if (index == size())
+                    {
+                        emplace_back(std::forward<Args>(args)...);
+                        return begin() + index;
+                    }
+                    if (index == 0)
+                    {
+                        emplace_front(std::forward<Args>(args)...);
+                        return begin();
+                    }
+                    // 参数可能引用容器内的元素，先构造出新值
+                    T tmp(std::forward<Args>(args)...);
+                    if (index < size() / 2)
+                    {
+                        emplace_front(std::move(front()));
+                        std::move(begin() + 2, begin() + index + 1, begin() + 1);
+                    }
+                    else
+                    {
+                        emplace_back(std::move(back()));
+                        std::move_backward(begin() + index, end() - 2, end() - 1);
+                    }
+                    (*this)[index] = std::move(tmp);
+                    return begin() + index;
+                }
+                iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+                iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
+                iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+                iterator erase(const_iterator first, const_iterator last)
+                {
+                    size_type index = first - cbegin(), n = last - first;
+                    if (!n)
+                        return begin() + index;
+                    if (index < (size() - n) / 2)
+                    {
+                        // 前面的元素较少：整体后移，再从前端弹出
+                        std::move_backward(begin(), begin() + index, begin() + index + n);
+                        for (; n; --n)
+                            pop_front();
+                    }
+                    else
+                    {
+                        std::move(begin() + index + n, end(), begin() + index);
+                        for (; n; --n)
+                            pop_back();
+                    }
+                    return begin() + index;
+                }
+
+                void clear()
+                {
+                    while (this->count)
+                        pop_back();
+                }
+                void resize(size_type n)
+                {
+                    while (size() > n)
+                        pop_back();
+                    while (size() < n)
+                        emplace_back();
+                }
+                void resize(size_type n, const T &v)
+                {
+                    while (size() > n)
+                        pop_back();
+                    while (size() < n)
+                        emplace_back(v);
+                }
+                void assign(size_type n, const T &v)
+                {
+                    clear();
+                    resize(n, v);
+                }
+                template <class InputIt>
+                    requires std::input_iterator<InputIt>
+                void assign(InputIt first, InputIt last)
+                {
+                    clear();
+                    for (; first != last; ++first)
+                        emplace_back(*first);
+                }
+                // 归还空闲块缓存；容器为空时连同 map 一起释放
+                void shrink_to_fit()
+                {
+                    if (empty())
+                        this->release_all();
+                    else
+                        this->release_spare();
+                }
+
+                // 分配器不随 swap 传播时，要求两个容器的分配器相等（与标准库相同）
+                void swap(Deque &other) noexcept
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    this->swap_storage(other);
+                    if constexpr (traits::propagate_on_container_swap::value)
+                        std::swap(this->alloc, other.alloc);
+                }
+                friend void swap(Deque &lhs, Deque &rhs) noexcept { lhs.swap(rhs); }
+                friend bool operator==(const Deque &lhs, const Deque &rhs)
+                {
+                    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+                }
+
+            protected:
+                void check_index(size_type index) const
+                {
+                    if (index >= size())
+                    {
+                        std::ostringstream ss;
+                        ss << "Deque::at(index): index (" << index << ") >= this->size() (" << size() << ") ";
+                        throw std::out_of_range(ss.str());
+                    }
+                }
+            };
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+namespace DSA
+{
+    namespace Hashing
+    {
+        namespace detail
+        {
+            // wyhash 使用的 4 个常数
+            inline constexpr uint64_t wy_secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+            // 长输入批量路径使用的 8 路累加器密钥，以及每个 block 结束时打乱累加器用的乘数
+            inline constexpr uint64_t lane_secret[8] = {0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+                                                        0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull};
+            inline constexpr uint64_t lane_prime = 0x9E3779B1ull;
+            // 每个 stripe 64 字节，每个 block 16 个 stripe
+            inline constexpr size_t stripe_bytes = 64;
+            inline constexpr size_t block_stripes = 16;
+            inline constexpr size_t bulk_threshold = 256;
+
+            inline uint64_t read64(const unsigned char *p)
+            {
+                uint64_t v;
+                std::memcpy(&v, p, 8);
+                return v;
+            }
+            inline uint64_t read32(const unsigned char *p)
+            {
+                uint32_t v;
+                std::memcpy(&v, p, 4);
+                return v;
+            }
+            // 1~3 字节的短输入：首、中、尾各取一个字节
+            inline uint64_t read_small(const unsigned char *p, size_t k)
+            {
+                return (uint64_t(p[0]) << 16) | (uint64_t(p[k >> 1]) << 8) | p[k - 1];
+            }
+            // 64x64 -> 128 位乘法，结果的高低两半分别写回 a 和 b
+            inline void wy_mum(uint64_t &a, uint64_t &b)
+            {
+#if defined(__SIZEOF_INT128__)
+                unsigned __int128 r = (unsigned __int128)a * b;
+                a = uint64_t(r);
+                b = uint64_t(r >> 64);
+#else
+                uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+                uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+                uint64_t lo = t + (rm1 << 32);
+                c += lo < t;
+                uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+                a = lo;
+                b = hi;
+#endif
+            }
+            // 乘法折叠：128 位乘积的高低两半异或，是整个哈希族的基本混合步骤
+            inline uint64_t wy_mix(uint64_t a, uint64_t b)
+            {
+                wy_mum(a, b);
+                return a ^ b;
+            }
+
+            /**
+             * @brief 长输入的批量累加：8 路 64 位累加器，每个 64 字节的 stripe 更新一次。
+             *
+             * 每一路做 acc[j ^ 1] += data[j]，acc[j] += lo32(data[j] ^ key[j]) * hi32(data[j] ^ key[j])，
+             * 各路之间互不依赖，正好对应 SIMD 的 32x32->64 位乘法（pmuludq）。
+             * 下面的标量版本是参考实现，AVX2 / SSE2 版本逐位与它一致，所以哈希值不随指令集改变。
+             */
+            inline void accumulate_stripe_scalar(uint64_t *acc, const unsigned char *p)
+            {
+                for (size_t j = 0; j < 8; ++j)
+                {
+                    uint64_t data = read64(p + 8 * j);
+                    uint64_t key = data ^ lane_secret[j];
+                    acc[j ^ 1] += data;
+                    acc[j] += (key & 0xffffffffull) * (key >> 32);
+                }
+            }
+            inline void accumulate_scalar(uint64_t *acc, const unsigned char *p, size_t nstripes)
+            {
+                for (size_t i = 0; i < nstripes; ++i, p += stripe_bytes)
+                    accumulate_stripe_scalar(acc, p);
+            }
+            inline void accumulate(uint64_t *acc, const unsigned char *p, size_t nstripes)
+            {
+#if defined(__AVX2__)
+                __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+                __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4));
+                const __m256i k0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lane_secret));
+                const __m256i k1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lane_secret + 4));
+                for (size_t i = 0; i < nstripes; ++i, p += stripe_bytes)
+                {
+                    __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                    __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+                    __m256i x0 = _mm256_xor_si256(d0, k0), x1 = _mm256_xor_si256(d1, k1);
+                    // 交换相邻两个 64 位元素，实现 acc[j ^ 1] += data[j]
+                    a0 = _mm256_add_epi64(a0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+                    a1 = _mm256_add_epi64(a1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+                    a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(x0, _mm256_srli_epi64(x0, 32)));
+                    a1 = _mm256_add_epi64(a1, _mm256_mul_epu32(x1, _mm256_srli_epi64(x1, 32)));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), a0);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4), a1);
+#elif defined(__SSE2__)
+                __m128i a[4], k[4];
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    a[j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + 2 * j));
+                    k[j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lane_secret + 2 * j));
+                }
+                for (size_t i = 0; i < nstripes; ++i, p += stripe_bytes)
+                {
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * j));
+                        __m128i x = _mm_xor_si128(d, k[j]);
+                        a[j] = _mm_add_epi64(a[j], _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+                        a[j] = _mm_add_epi64(a[j], _mm_mul_epu32(x, _mm_srli_epi64(x, 32)));
+                    }
+                }
+                for (size_t j = 0; j < 4; ++j)
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + 2 * j), a[j]);
+#else
+                accumulate_scalar(acc, p, nstripes);
+#endif
+            }
+            // 每个 block 结束时打乱累加器，防止高位长期得不到扩散
+            inline void scramble(uint64_t *acc)
+            {
+                for (size_t j = 0; j < 8; ++j)
+                    acc[j] = ((acc[j] ^ (acc[j] >> 47)) ^ lane_secret[j]) * lane_prime;
+            }
+            template <bool UseSimd>
+            inline uint64_t hash_long(const unsigned char *p, size_t len, uint64_t seed)
+            {
+                uint64_t acc[8] = {seed, wy_secret[0], wy_secret[1], wy_secret[2], wy_secret[3], lane_prime, ~seed, lane_secret[0]};
+                size_t nstripes = (len - 1) / stripe_bytes; // 最后一个（可能不完整的）stripe 留给尾部处理
+                const unsigned char *q = p;
+                for (size_t done = 0; done < nstripes;)
+                {
+                    size_t n = std::min(block_stripes, nstripes - done);
+                    if constexpr (UseSimd)
+                        accumulate(acc, q, n);
+                    else
+                        accumulate_scalar(acc, q, n);
+                    q += n * stripe_bytes;
+                    done += n;
+                    if (n == block_stripes)
+                        scramble(acc);
+                }
+                // 尾部：总是把最后 64 字节当作一个完整的 stripe（与前面可能重叠）
+                accumulate_stripe_scalar(acc, p + len - stripe_bytes);
+                uint64_t res = len * wy_secret[1];
+                for (size_t j = 0; j < 8; j += 2)
+                    res += wy_mix(acc[j] ^ wy_secret[j / 2], acc[j + 1] ^ lane_secret[j]);
+                return wy_mix(res ^ wy_secret[0], res ^ (res >> 29) ^ wy_secret[3]);
+            }
+
+            /**
+             * @brief wyhash 风格的字节串哈希。
+             * 短输入（<= 16 字节）只做一次 128 位乘法；中等长度每 16 / 48 字节一次；
+             * 达到 bulk_threshold 的长输入走 8 路 SIMD 累加的批量路径。
+             */
+            template <bool UseSimd = true>
+            inline uint64_t hash_bytes_impl(const void *key, size_t len, uint64_t seed)
+            {
+                const unsigned char *p = static_cast<const unsigned char *>(key);
+                seed ^= wy_mix(seed ^ wy_secret[0], wy_secret[1]);
+                if (len >= bulk_threshold)
+                    return hash_long<UseSimd>(p, len, seed);
+                uint64_t a, b;
+                if (len <= 16)
+                {
+                    if (len >= 4)
+                    {
+                        a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+                        b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+                    }
+                    else if (len > 0)
+                    {
+                        a = read_small(p, len);
+                        b = 0;
+                    }
+                    else
+                    {
+                        a = b = 0;
+                    }
+                }
+                else
+                {
+                    size_t i = len;
+                    if (i > 48)
+                    {
+                        uint64_t see1 = seed, see2 = seed;
+                        do
+                        {
+                            seed = wy_mix(read64(p) ^ wy_secret[1], read64(p + 8) ^ seed);
+                            see1 = wy_mix(read64(p + 16) ^ wy_secret[2], read64(p + 24) ^ see1);
+                            see2 = wy_mix(read64(p + 32) ^ wy_secret[3], read64(p + 40) ^ see2);
+                            p += 48;
+                            i -= 48;
+                        } while (i > 48);
+                        seed ^= see1 ^ see2;
+                    }
+                    while (i > 16)
+                    {
+                        seed = wy_mix(read64(p) ^ wy_secret[1], read64(p + 8) ^ seed);
+                        i -= 16;
+                        p += 16;
+                    }
+                    a = read64(p + i - 16);
+                    b = read64(p + i - 8);
+                }
+                a ^= wy_secret[1];
+                b ^= seed;
+                wy_mum(a, b);
+                return wy_mix(a ^ wy_secret[0] ^ len, b ^ wy_secret[1]);
+            }
+        }
+
+        // 对任意字节串求哈希
+        inline size_t hash_bytes(const void *key, size_t len, uint64_t seed = 0)
+        {
+            return size_t(detail::hash_bytes_impl<true>(key, len, seed));
+        }
+        // 整数混合：两轮 128 位乘法折叠，输入的每一位都会影响输出的低位，适合 2 的幂个桶
+        // 只做一轮时，连续整数或低位全零的整数在低位上仍有明显规律
+        inline size_t mix_integer(uint64_t x)
+        {
+            return size_t(detail::wy_mix(detail::wy_mix(x ^ detail::wy_secret[0], detail::wy_secret[1]) ^ detail::wy_secret[2], x ^ detail::wy_secret[3]));
+        }
+        // 把一个新的哈希值并入已有的种子，用于组合 pair / tuple 等复合键，结果与元素顺序有关
+        inline size_t hash_combine(size_t seed, size_t h)
+        {
+            return size_t(detail::wy_mix(seed ^ detail::wy_secret[2], h ^ detail::wy_secret[3]));
+        }
+
+        /**
+         * @brief 快速的非密码学哈希函数族，可以直接作为 HashTable 等哈希表的 Hash 模板参数。
+         *
+         * - 整数、枚举、指针：mix_integer；
+         * - 浮点数：先把 -0.0 规范为 0.0，再对位模式做整数混合；long double 只取存放数值的字节，不含填充；
+         * - 字符串：hash_bytes，并声明 is_transparent，std::string / std::string_view / const char* 的哈希值一致；
+         * - std::pair / std::tuple：逐个元素求哈希后用 hash_combine 组合；
+         * - 其余类型：先用 std::hash 求值，再做一次整数混合，弥补 std::hash 低位质量差的问题。
+         */
+        template <typename T>
+        struct FastHash
+        {
+            size_t operator()(const T &v) const
+            {
+                if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+                {
+                    return mix_integer(uint64_t(v));
+                }
+                else if constexpr (std::is_pointer_v<T>)
+                {
+                    return mix_integer(uint64_t(reinterpret_cast<uintptr_t>(v)));
+                }
+                else if constexpr (std::is_floating_point_v<T>)
+                {
+                    // 0.0 == -0.0，必须得到相同的哈希值
+                    T x = (v == T(0)) ? T(0) : v;
+                    if constexpr (sizeof(T) <= sizeof(uint64_t))
+                    {
+                        uint64_t bits = 0;
+                        std::memcpy(&bits, &x, sizeof(T));
+                        return mix_integer(bits);
+                    }
+                    else
+                    {
+                        // x86 的 80 位扩展精度 long double 占 16 字节，只有前 10 字节是数值，其余是内容不确定的填充
+                        constexpr size_t value_bytes = std::numeric_limits<T>::digits == 64 ? 10 : sizeof(T);
+                        return hash_bytes(&x, value_bytes);
+                    }
+                }
+                else
+                {
+                    return mix_integer(uint64_t(std::hash<T>{}(v)));
+                }
+            }
+        };
+        template <typename CharT, typename Traits, typename Alloc>
+        struct FastHash<std::basic_string<CharT, Traits, Alloc>>
+        {
+            using is_transparent = void;
+            size_t operator()(std::basic_string_view<CharT, Traits> s) const { return hash_bytes(s.data(), s.size() * sizeof(CharT)); }
+        };
+        template <typename CharT, typename Traits>
+        struct FastHash<std::basic_string_view<CharT, Traits>>
+        {
+            using is_transparent = void;
+            size_t operator()(std::basic_string_view<CharT, Traits> s) const { return hash_bytes(s.data(), s.size() * sizeof(CharT)); }
+        };
+        template <typename T1, typename T2>
+        struct FastHash<std::pair<T1, T2>>
+        {
+            size_t operator()(const std::pair<T1, T2> &v) const
+            {
+                return hash_combine(FastHash<std::remove_cv_t<T1>>{}(v.first), FastHash<std::remove_cv_t<T2>>{}(v.second));
+            }
+        };
+        template <typename... Ts>
+        struct FastHash<std::tuple<Ts...>>
+        {
+            size_t operator()(const std::tuple<Ts...> &v) const
+            {
+                return std::apply([](const Ts &...elems)
+                                  {
+                                      size_t seed = sizeof...(Ts);
+                                      ((seed = hash_combine(seed, FastHash<std::remove_cv_t<Ts>>{}(elems))), ...);
+                                      return seed; },
+                                  v);
+            }
+        };
+    }
+}
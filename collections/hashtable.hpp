@@ -7,6 +7,7 @@
 #include <vector>
 #include <algorithm>
 #include <type_traits>
+#include <bit>
 #include "hashtable_aux.hpp"
 #include "../utils.hpp"
 namespace DSA
@@ -73,12 +74,54 @@ namespace DSA
             float factor = 0.75;
         };
 
+        struct Pow2ReHash
+        {
+            /**
+             * @brief 桶数量总是取 2 的幂的重哈希策略。
+             *
+             * 通过 always_pow2 标志，哈希表可以用位与代替取模来计算桶下标；
+             * 代价是只用到了哈希码的低位，对哈希函数的质量更敏感。
+             */
+            static constexpr bool always_pow2 = true;
+
+            size_t next_bucket_count(size_t element_count, size_t least_bucket_count)
+            {
+                least_bucket_count = std::max(least_bucket_count, size_t(std::ceil(element_count / factor)));
+                return std::bit_ceil(std::max<size_t>(least_bucket_count, 1));
+            }
+            bool need_rehash(size_t element_count, size_t cur_bucket_count)
+            {
+                return (element_count / double(cur_bucket_count)) > factor;
+            }
+            float max_load_factor() const { return factor; }
+            void max_load_factor(float new_factor) { factor = new_factor; }
+
+        private:
+            float factor = 0.75;
+        };
+
         namespace detail
         {
             // 前向声明，因为 HashTableIterator 和 HashTableBase 相互引用
             template <typename T, bool HashCached>
             struct HashTableBase;
 
+            // 将完整的哈希码约束到桶索引。
+            // 如果 ReHashPolicy 提供了 always_pow2 标志，并且为 true，则使用位运算代替取模，效率更高
+            template <typename ReHashPolicy>
+            constexpr size_t constrain_hash(size_t hashcode_to_constrain, size_t constrain_bucket_count)
+            {
+                if constexpr (requires { ReHashPolicy::always_pow2; })
+                {
+                    if constexpr (ReHashPolicy::always_pow2)
+                    {
+                        return hashcode_to_constrain & (constrain_bucket_count - 1);
+                    }
+                }
+                // 默认使用取模运算
+                return hashcode_to_constrain % constrain_bucket_count;
+            }
+
             /**
              * @brief 节点特性萃取 (Node Traits)。
              *
@@ -278,7 +321,7 @@ namespace DSA
          * @tparam ReHashPolicy 重哈希策略类型。
          * @tparam HashCached 是否缓存哈希值。
          */
-        template <typename T, typename KeyT = T, typename Hash = std::hash<KeyT>, typename EqualT = std::equal_to<T>, typename KeyOfValue = IdentityKeyOfValue<T>, typename ReHashPolicy = PrimeReHash, bool HashCached = true>
+        template <typename T, typename KeyT = T, typename Hash = std::hash<KeyT>, typename EqualT = std::equal_to<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>, typename ReHashPolicy = PrimeReHash, bool HashCached = true>
         struct HashTable : detail::HashTableBase<T, HashCached>
         {
             using Base = detail::HashTableBase<T, HashCached>;
@@ -444,9 +487,11 @@ namespace DSA
              * @brief 重哈希操作。
              * @param new_bucket_count 期望的新桶数量。如果为0，则由策略自动计算。
              *
-             * 不重新创建节点，而是遍历一次现有的 `overall_list`，
-             * 并使用 `forward_list::splice_after` 将节点移动到它们在新桶布局中的正确位置。
+             * 不重新创建节点，而是把现有节点整体摘到一个临时链表上，再逐个
+             * 使用 `forward_list::splice_after` 将节点移动到它们在新桶布局中的正确位置。
              * 这避免了内存分配和拷贝，开销很小。
+             * 新桶为空时节点被挂到整条链表的最前面，此时原来排在最前面的桶的前驱就变成了这个节点；
+             * 否则节点挂在所属桶的最前面。相邻的相等元素会被连续处理，所以 multi 的“相等元素相邻”性质得以保持。
              */
             void rehash(size_type new_bucket_count)
             {
@@ -454,24 +499,24 @@ namespace DSA
                 new_bucket_count = std::max(new_bucket_count, rehash_policy.next_bucket_count(size(), new_bucket_count));
                 // 创建一个新的桶向量，所有条目都指向链表头的前一个位置 (before_begin)
                 std::vector<node_iterator> tmp(new_bucket_count, overall_list.before_begin());
-                node_iterator it = overall_list.begin();
-                if (it != overall_list.end())
+                list_type pending;
+                pending.splice_after(pending.before_begin(), overall_list);
+                // 当前排在整条链表最前面的桶，它的前驱同样是 before_begin，需要和空桶区分开
+                size_type front_bucket = new_bucket_count;
+                while (!pending.empty())
                 {
-                    // 计算第一个元素在新布局下的桶索引
-                    size_t last_bucket = hash_bucket(node_hashcode(*it), new_bucket_count);
-                    for (++it; it != overall_list.end(); ++it)
+                    size_type cur_bucket = hash_bucket(node_hashcode(pending.front()), new_bucket_count);
+                    if (cur_bucket != front_bucket && tmp[cur_bucket] == overall_list.before_begin())
                     {
-                        size_t cur_bucket = hash_bucket(node_hashcode(*it), new_bucket_count);
-                        if (cur_bucket != last_bucket)
-                        {
-                            // 当遇到一个属于不同桶的元素时，把之前属于 last_bucket 的整个链表段
-                            // 移到 (splice) 新桶表 tmp[last_bucket] 的后面。
-                            overall_list.splice_after(tmp[last_bucket], overall_list, overall_list.before_begin(), it);
-                            last_bucket = cur_bucket;
-                        }
+                        overall_list.splice_after(overall_list.before_begin(), pending, pending.before_begin());
+                        if (front_bucket != new_bucket_count)
+                            tmp[front_bucket] = overall_list.begin();
+                        front_bucket = cur_bucket;
+                    }
+                    else
+                    {
+                        overall_list.splice_after(tmp[cur_bucket], pending, pending.before_begin());
                     }
-                    // 把最后一段链表也移动到正确的位置
-                    overall_list.splice_after(tmp[last_bucket], overall_list, overall_list.before_begin(), overall_list.end());
                 }
                 // 用新的桶向量替换旧的
                 bucket_before_first.swap(tmp);
@@ -493,19 +538,29 @@ namespace DSA
                 rehash_policy.max_load_factor(1.0);
                 bucket_before_first.assign(rehash_policy.next_bucket_count(0, 0), overall_list.before_begin());
             }
+            // 区间构造，按唯一键插入（与 std::unordered_set 一致）；需要重复键时先默认构造再调用 insert_range_multi
+            template <typename InputIt>
+                requires std::input_iterator<InputIt>
+            HashTable(InputIt first, InputIt last, size_type init_buckets_count = 0, const hasher &h = hasher{}, const key_equal &keq = key_equal{})
+                : HashTable(init_buckets_count, h, keq)
+            {
+                insert_range_unique(first, last);
+            }
             void clear()
             {
                 overall_list.clear();
-                bucket_before_first.clear();
+                // 桶数组保留原有大小，只是全部重置为空桶，这样 clear 之后仍然可以继续插入
+                std::fill(bucket_before_first.begin(), bucket_before_first.end(), overall_list.before_begin());
+                size_r = 0;
             }
 
-            iterator begin() { return overall_list.begin(); }
-            const_iterator begin() const { return overall_list.begin(); }
-            const_iterator cbegin() const { return overall_list.cbegin(); }
+            iterator begin() { return iterator{overall_list.begin()}; }
+            const_iterator begin() const { return const_iterator{overall_list.begin()}; }
+            const_iterator cbegin() const { return const_iterator{overall_list.cbegin()}; }
 
-            iterator end() { return overall_list.end(); }
-            const_iterator end() const { return overall_list.end(); }
-            const_iterator cend() const { return overall_list.end(); }
+            iterator end() { return iterator{overall_list.end()}; }
+            const_iterator end() const { return const_iterator{overall_list.end()}; }
+            const_iterator cend() const { return const_iterator{overall_list.end()}; }
 
             // --- 局部(桶)迭代器 ---
             local_iterator begin(size_type n)
@@ -620,8 +675,66 @@ namespace DSA
                 ++size_r;
                 return iterator{pre_it};
             }
-            iterator find(const key_type &k) { return iterator{find_node(*this, k)}; }
-            const_iterator find(const key_type &k) const { return const_iterator{find_node(*this, k)}; }
+            /**
+             * @brief 批量插入唯一键值，等价于对 [first, last) 中每个元素调用 insert_unique，但开销小得多。
+             *
+             * 逐个插入时每次都要检查负载因子，表在增长过程中会反复 rehash，而且节点按输入顺序
+             * 零散地挂到各个桶上。批量插入改为：
+             * 1. 先把输入整体取出来，同时在一趟循环里算好所有哈希码；
+             * 2. 按最终元素个数一次性把桶数组调整到位（至多一次 rehash）；
+             * 3. 按桶号做一次计数排序，得到每个桶要新增的元素；
+             * 4. 对每个桶，先在一条临时链表上把新节点串好，再整段 splice 到该桶的位置。
+             * 这样每个桶只做一次链接操作，桶数组的维护也只发生在桶的边界上。
+             */
+            template <typename InputIt>
+            void insert_range_unique(InputIt first, InputIt last)
+            {
+                insert_range_impl<true>(first, last);
+            }
+            /**
+             * @brief 批量插入可重复的键值。相等的元素插入后仍然在链表中相邻，保证 equal_range_multi 的正确性。
+             */
+            template <typename InputIt>
+            void insert_range_multi(InputIt first, InputIt last)
+            {
+                insert_range_impl<false>(first, last);
+            }
+            /**
+             * @brief 异构查找开关。
+             *
+             * 与标准库的无序容器一致：只有当哈希函数与键比较函数都声明了 `is_transparent` 时，
+             * 才开放以任意类型 K 为参数的查找重载（例如直接用 std::string_view 查 std::string 的表），
+             * 从而避免仅仅为了查找而构造一个临时的 key_type。
+             */
+            static constexpr bool is_transparent_lookup = requires {
+                typename Hash::is_transparent;
+                typename EqualT::is_transparent;
+            };
+
+            // 计算键的哈希码。结果可以保存下来传给下面带 hashcode 参数的重载，
+            // 这样同一个键在多张表里查找、删除时只需要哈希一次
+            size_t hash_code(const key_type &k) const { return hashf(k); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_t hash_code(const K &k) const { return hashf(k); }
+
+            // 以下所有带 hashcode 参数的重载都要求 hashcode == hash_function()(k)，表内不做校验
+            iterator find(const key_type &k) { return iterator{find_node(*this, k, hashf(k))}; }
+            const_iterator find(const key_type &k) const { return const_iterator{find_node(*this, k, hashf(k))}; }
+            iterator find(const key_type &k, size_t hashcode) { return iterator{find_node(*this, k, hashcode)}; }
+            const_iterator find(const key_type &k, size_t hashcode) const { return const_iterator{find_node(*this, k, hashcode)}; }
+            template <typename K>
+                requires is_transparent_lookup
+            iterator find(const K &k) { return iterator{find_node(*this, k, hashf(k))}; }
+            template <typename K>
+                requires is_transparent_lookup
+            const_iterator find(const K &k) const { return const_iterator{find_node(*this, k, hashf(k))}; }
+            template <typename K>
+                requires is_transparent_lookup
+            iterator find(const K &k, size_t hashcode) { return iterator{find_node(*this, k, hashcode)}; }
+            template <typename K>
+                requires is_transparent_lookup
+            const_iterator find(const K &k, size_t hashcode) const { return const_iterator{find_node(*this, k, hashcode)}; }
 
             /**
              * @brief 删除指定迭代器位置的元素。
@@ -630,8 +743,7 @@ namespace DSA
             iterator erase(const_iterator pos)
             {
                 const_node_iterator posn = getNode(pos); // 获取底层迭代器
-                size_t phash = node_hashcode(*posn);
-                size_type pbucket = hash_bucket(phash);
+                size_type pbucket = hash_bucket(node_hashcode(*posn));
                 node_iterator it = bucket_before_first[pbucket], pre_it;
 
                 // 找到 posn 的前一个节点 pre_it
@@ -639,181 +751,100 @@ namespace DSA
                 {
                     if (it == posn)
                     {
-                        it = overall_list.erase_after(pre_it);
                         --size_r;
-                        break;
-                    }
-                }
-
-                // 维护 bucket_before_first 数组
-                if (it != overall_list.end())
-                {
-                    size_type nbucket = hash_bucket(node_hashcode(*it));
-                    if (nbucket != pbucket)
-                    {
-                        // 如果删除后，pre_it 后面紧邻的节点属于一个新的桶 nbucket,
-                        // 那么 pre_it 就成了 nbucket 的前驱节点
-                        bucket_before_first[nbucket] = pre_it;
-                        // 如果被删除的元素是 pbucket 的第一个元素
-                        if (pre_it == bucket_before_first[pbucket])
-                        {
-                            // pbucket 现在变空了
-                            bucket_before_first[pbucket] = overall_list.before_begin();
-                        }
-                    }
-                }
-                else // 如果删除的是链表最后一个元素
-                {
-                    if (pre_it == bucket_before_first[pbucket])
-                    {
-                        bucket_before_first[pbucket] = overall_list.before_begin();
+                        return iterator{erase_after_in_bucket(pre_it, std::next(it), pbucket)};
                     }
                 }
                 return iterator{it};
             }
 
             // 根据键删除唯一元素
-            size_type erase_unique(const key_type &k)
-            {
-                // ... 实现与 erase(pos) 类似，但先要查找 ...
-                // 找到后调用 erase(iterator) 即可，但这里为了效率直接实现了
-                size_type res = 0;
-                size_t khash = hashf(k);
-                size_type kbucket = hash_bucket(khash);
-                node_iterator it = bucket_before_first[kbucket], pre_it;
-                for (pre_it = it, ++it; it != overall_list.end(); pre_it = it, ++it)
-                {
-                    size_t cur_hash = node_hashcode(*it);
-                    if (hash_bucket(cur_hash) != kbucket)
-                        break;
-                    if (cur_hash == khash && kequal(KeyOfValue{}(value_traits::value(*it)), k))
-                    {
-                        it = overall_list.erase_after(pre_it);
-                        ++res;
-                        size_r -= res;
-                        break;
-                    }
-                }
-                if (res)
-                {
-                    // 维护 bucket_before_first，逻辑同 erase(pos)
-                    if (it != overall_list.end())
-                    {
-                        size_type nbucket = hash_bucket(node_hashcode(*it));
-                        if (nbucket != kbucket)
-                        {
-                            bucket_before_first[nbucket] = pre_it;
-                            if (pre_it == bucket_before_first[kbucket])
-                            {
-                                bucket_before_first[kbucket] = overall_list.before_begin();
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (pre_it == bucket_before_first[kbucket])
-                        {
-                            bucket_before_first[kbucket] = overall_list.before_begin();
-                        }
-                    }
-                }
-                return res;
-            }
+            size_type erase_unique(const key_type &k) { return erase_unique_node(k, hashf(k)); }
+            size_type erase_unique(const key_type &k, size_t hashcode) { return erase_unique_node(k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_unique(const K &k) { return erase_unique_node(k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_unique(const K &k, size_t hashcode) { return erase_unique_node(k, hashcode); }
+
             // 根据键删除所有匹配的元素 (multi)
-            size_type erase_multi(const key_type &k)
-            {
-                // ... 找到第一个匹配元素后，继续向后查找所有匹配元素，然后一次性删除 ...
-                size_type res = 0;
-                size_t khash = hashf(k);
-                size_type kbucket = hash_bucket(khash);
-                node_iterator it = bucket_before_first[kbucket], pre_it;
-                for (pre_it = it, ++it; it != overall_list.end(); pre_it = it, ++it)
-                {
-                    size_t cur_hash = node_hashcode(*it);
-                    if (hash_bucket(cur_hash) != kbucket)
-                        break;
-                    if (cur_hash == khash && kequal(KeyOfValue{}(value_traits::value(*it)), k))
-                    {
-                        // 找到第一个匹配项，继续寻找这个匹配范围的末尾
-                        for (++res, ++it; it != overall_list.end(); ++res, ++it)
-                        {
-                            cur_hash = node_hashcode(*it);
-                            if (cur_hash != khash)
-                                break;
-                            if (!kequal(KeyOfValue{}(value_traits::value(*it)), k))
-                                break;
-                        }
-                        it = overall_list.erase_after(pre_it, it);
-                        size_r -= res;
-                        break;
-                    }
-                }
-                if (res)
-                {
+            size_type erase_multi(const key_type &k) { return erase_multi_node(k, hashf(k)); }
+            size_type erase_multi(const key_type &k, size_t hashcode) { return erase_multi_node(k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_multi(const K &k) { return erase_multi_node(k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_multi(const K &k, size_t hashcode) { return erase_multi_node(k, hashcode); }
 
-                    // 维护 bucket_before_first，逻辑同 erase(pos)
-                    if (it != overall_list.end())
-                    {
-                        size_type nbucket = hash_bucket(node_hashcode(*it));
-                        if (nbucket != kbucket)
-                        {
-                            bucket_before_first[nbucket] = pre_it;
-                            if (pre_it == bucket_before_first[kbucket])
-                            {
-                                bucket_before_first[kbucket] = overall_list.before_begin();
-                            }
-                        }
-                    }
-                    else
-                    {
-                        if (pre_it == bucket_before_first[kbucket])
-                        {
-                            bucket_before_first[kbucket] = overall_list.before_begin();
-                        }
-                    }
-                }
-                return res;
-            }
             // 统计键的个数
-            size_type count_unique(const key_type &k) const
+            size_type count_unique(const key_type &k) const { return count_unique(k, hashf(k)); }
+            size_type count_unique(const key_type &k, size_t hashcode) const
             {
-                return size_type(find(k) != end());
+                return size_type(find_node(*this, k, hashcode) != overall_list.end());
             }
-            size_type count_multi(const key_type &k) const
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_unique(const K &k) const { return count_unique(k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_unique(const K &k, size_t hashcode) const
             {
-                auto rg = equal_range_multi(k);
-                return std::distance(rg.first, rg.second);
+                return size_type(find_node(*this, k, hashcode) != overall_list.end());
             }
-            // 返回键匹配的范围 (unique)
-            std::pair<iterator, iterator> equal_range_unique(const key_type &k)
+            size_type count_multi(const key_type &k) const { return count_multi(k, hashf(k)); }
+            size_type count_multi(const key_type &k, size_t hashcode) const
             {
-                node_iterator node_it = find_node(*this, k);
-                if (node_it == overall_list.end())
-                    return {iterator{node_it}, iterator{node_it}};
-                else
-                    return {iterator{node_it}, iterator{std::next(node_it)}};
+                auto rg = equal_range_multi_node(*this, k, hashcode);
+                return std::distance(rg.first, rg.second);
             }
-            std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k) const
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_multi(const K &k) const { return count_multi(k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_multi(const K &k, size_t hashcode) const
             {
-                const_node_iterator node_it = find_node(*this, k);
-                if (node_it == overall_list.end())
-                    return {const_iterator{node_it}, const_iterator{node_it}};
-                else
-                    return {const_iterator{node_it}, const_iterator{std::next(node_it)}};
+                auto rg = equal_range_multi_node(*this, k, hashcode);
+                return std::distance(rg.first, rg.second);
             }
 
-            // 返回键匹配的范围 (multi)
-            std::pair<iterator, iterator> equal_range_multi(const key_type &k)
-            {
-                std::pair<node_iterator, node_iterator> res = equal_range_multi_node(*this, k);
-                return {iterator{res.first}, iterator{res.second}};
-            }
-            std::pair<const_iterator, const_iterator> equal_range_multi(const key_type &k) const
-            {
-                std::pair<const_node_iterator, const_node_iterator> res = equal_range_multi_node(*this, k);
-                return {const_iterator{res.first}, const_iterator{res.second}};
-            }
+            // 返回键匹配的范围 (unique)
+            std::pair<iterator, iterator> equal_range_unique(const key_type &k) { return equal_range_unique_impl(*this, k, hashf(k)); }
+            std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k) const { return equal_range_unique_impl(*this, k, hashf(k)); }
+            std::pair<iterator, iterator> equal_range_unique(const key_type &k, size_t hashcode) { return equal_range_unique_impl(*this, k, hashcode); }
+            std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k, size_t hashcode) const { return equal_range_unique_impl(*this, k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<iterator, iterator> equal_range_unique(const K &k) { return equal_range_unique_impl(*this, k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<const_iterator, const_iterator> equal_range_unique(const K &k) const { return equal_range_unique_impl(*this, k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<iterator, iterator> equal_range_unique(const K &k, size_t hashcode) { return equal_range_unique_impl(*this, k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<const_iterator, const_iterator> equal_range_unique(const K &k, size_t hashcode) const { return equal_range_unique_impl(*this, k, hashcode); }
 
+            // 返回键匹配的范围 (multi)
+            std::pair<iterator, iterator> equal_range_multi(const key_type &k) { return equal_range_multi_impl(*this, k, hashf(k)); }
+            std::pair<const_iterator, const_iterator> equal_range_multi(const key_type &k) const { return equal_range_multi_impl(*this, k, hashf(k)); }
+            std::pair<iterator, iterator> equal_range_multi(const key_type &k, size_t hashcode) { return equal_range_multi_impl(*this, k, hashcode); }
+            std::pair<const_iterator, const_iterator> equal_range_multi(const key_type &k, size_t hashcode) const { return equal_range_multi_impl(*this, k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<iterator, iterator> equal_range_multi(const K &k) { return equal_range_multi_impl(*this, k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<const_iterator, const_iterator> equal_range_multi(const K &k) const { return equal_range_multi_impl(*this, k, hashf(k)); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<iterator, iterator> equal_range_multi(const K &k, size_t hashcode) { return equal_range_multi_impl(*this, k, hashcode); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<const_iterator, const_iterator> equal_range_multi(const K &k, size_t hashcode) const { return equal_range_multi_impl(*this, k, hashcode); }
         protected:
             // 继承 using 声明，让派生类可以使用基类的 protected 成员
             using Base::getNode;
@@ -858,17 +889,7 @@ namespace DSA
             // 静态辅助函数，将完整的哈希码约束到桶索引
             static size_type hash_bucket(size_t hashcode_to_constrain, size_type constrain_bucket_count)
             {
-
-                // 如果 ReHashPolicy 提供了 always_pow2 标志，并且为 true，则使用位运算代替取模，效率更高
-                if constexpr (requires { ReHashPolicy::always_pow2; })
-                {
-                    if constexpr (ReHashPolicy::always_pow2)
-                    {
-                        return hashcode_to_constrain & (constrain_bucket_count - 1);
-                    }
-                }
-                // 默认使用取模运算
-                return hashcode_to_constrain % constrain_bucket_count;
+                return detail::constrain_hash<ReHashPolicy>(hashcode_to_constrain, constrain_bucket_count);
             }
             // 实例方法版本，使用当前哈希表的桶数量
             size_type hash_bucket(size_t hashcode_to_constrain) const
@@ -879,14 +900,17 @@ namespace DSA
             /**
              * @brief 查找节点的静态辅助函数模板。
              * @tparam Self 可以是 HashTable 或 const HashTable，通过模板推导实现代码复用。
+             * @tparam K 查找用的键类型，异构查找时不必是 key_type。
+             * @param khash 键的哈希码，由调用者计算（或预先计算好）传入。
              * @return 返回找到的底层节点迭代器，或 end()。
              */
-            template <typename Self>
-            static auto find_node(Self &self, const key_type &k)
+            template <typename Self, typename K>
+            static auto find_node(Self &self, const K &k, size_t khash)
             {
-                size_t khash = self.hashf(k);
+                // const 的表只能拿到 const_node_iterator，这里统一成 overall_list.end() 的类型，避免 auto 推导冲突
+                using self_node_iterator = decltype(self.overall_list.end());
                 size_type kbucket = self.hash_bucket(khash);
-                auto it = self.bucket_before_first[kbucket];
+                self_node_iterator it = self.bucket_before_first[kbucket];
                 for (++it; it != self.overall_list.end(); ++it)
                 {
                     size_t cur_hash = self.node_hashcode(*it);
@@ -903,13 +927,12 @@ namespace DSA
             /**
              * @brief 查找多个匹配节点的范围的静态辅助函数模板。
              */
-            template <typename Self>
-            static auto equal_range_multi_node(Self &self, const key_type &k)
+            template <typename Self, typename K>
+            static auto equal_range_multi_node(Self &self, const K &k, size_t khash)
             {
-
-                size_t khash = self.hashf(k);
+                using self_node_iterator = decltype(self.overall_list.end());
                 size_type kbucket = self.hash_bucket(khash);
-                auto it = self.bucket_before_first[kbucket];
+                self_node_iterator it = self.bucket_before_first[kbucket];
 
                 // 查找第一个匹配的节点
                 for (++it; it != self.overall_list.end(); ++it)
@@ -919,7 +942,7 @@ namespace DSA
                         break;
                     if (cur_hash == khash && self.kequal(KeyOfValue{}(value_traits::value(*it)), k))
                     {
-                        auto next_it = std::next(it);
+                        self_node_iterator next_it = std::next(it);
                         for (; next_it != self.overall_list.end(); ++next_it)
                         {
 
@@ -930,11 +953,237 @@ namespace DSA
                             if (!self.kequal(KeyOfValue{}(value_traits::value(*next_it)), k))
                                 break;
                         }
-                        return std::make_pair(it, next_it);// 返回 [first, last) 范围
+                        return std::make_pair(it, next_it); // 返回 [first, last) 范围
                     }
                 }
                 // 没找到，返回一个空范围
-                return std::make_pair(self.overall_list.end(), self.overall_list.end());
+                return std::make_pair(self_node_iterator{self.overall_list.end()}, self_node_iterator{self.overall_list.end()});
+            }
+
+            // 把节点范围包装成对外的迭代器范围，Self 的常量性决定返回 iterator 还是 const_iterator
+            template <typename Self, typename K>
+            static auto equal_range_unique_impl(Self &self, const K &k, size_t khash)
+            {
+                using self_iterator = std::conditional_t<std::is_const_v<Self>, const_iterator, iterator>;
+                auto node_it = find_node(self, k, khash);
+                if (node_it == self.overall_list.end())
+                    return std::make_pair(self_iterator{node_it}, self_iterator{node_it});
+                else
+                    return std::make_pair(self_iterator{node_it}, self_iterator{std::next(node_it)});
+            }
+            template <typename Self, typename K>
+            static auto equal_range_multi_impl(Self &self, const K &k, size_t khash)
+            {
+                using self_iterator = std::conditional_t<std::is_const_v<Self>, const_iterator, iterator>;
+                auto res = equal_range_multi_node(self, k, khash);
+                return std::make_pair(self_iterator{res.first}, self_iterator{res.second});
+            }
+
+            /**
+             * @brief 删除 (pre_it, last) 之间的节点，这些节点都属于 pbucket 号桶。
+             *
+             * 删除之后维护 bucket_before_first：
+             * 如果紧随其后的节点属于另一个桶，pre_it 就成了那个桶的前驱；
+             * 如果 pre_it 恰好是 pbucket 的前驱，说明 pbucket 被删空了。
+             * @return 指向被删除范围之后元素的节点迭代器。
+             */
+            node_iterator erase_after_in_bucket(node_iterator pre_it, node_iterator last, size_type pbucket)
+            {
+                node_iterator it = overall_list.erase_after(pre_it, last);
+                if (it != overall_list.end())
+                {
+                    size_type nbucket = hash_bucket(node_hashcode(*it));
+                    if (nbucket != pbucket)
+                    {
+                        bucket_before_first[nbucket] = pre_it;
+                        if (pre_it == bucket_before_first[pbucket])
+                        {
+                            bucket_before_first[pbucket] = overall_list.before_begin();
+                        }
+                    }
+                }
+                else // 如果删除的是链表最后一段
+                {
+                    if (pre_it == bucket_before_first[pbucket])
+                    {
+                        bucket_before_first[pbucket] = overall_list.before_begin();
+                    }
+                }
+                return it;
+            }
+            // 判断第 n 个桶是否为空。空桶与排在整条链表最前面的桶的前驱都是 before_begin，需要看首节点区分
+            bool bucket_empty(size_type n) const
+            {
+                if (bucket_before_first[n] != overall_list.before_begin())
+                    return false;
+                return overall_list.empty() || hash_bucket(node_hashcode(overall_list.front())) != n;
+            }
+            // 在 pos 之后插入一个属于 pbucket 号桶的节点，pos 必须位于该桶内部，若新节点成为下一个桶的前驱则更新之
+            node_iterator insert_after_in_bucket(node_iterator pos, node_value_type &&vnode, size_type pbucket)
+            {
+                node_iterator it = overall_list.insert_after(pos, std::move(vnode));
+                node_iterator nxt_it = std::next(it);
+                if (nxt_it != overall_list.end())
+                {
+                    size_type nxt_bucket = hash_bucket(node_hashcode(*nxt_it));
+                    if (nxt_bucket != pbucket)
+                        bucket_before_first[nxt_bucket] = it;
+                }
+                return it;
+            }
+            // 把一条已经串好的、全部属于 pbucket 号桶的临时链表整段接到该桶的最前面，chain_last 是其最后一个节点
+            void link_bucket_chain(size_type pbucket, list_type &chain, node_iterator chain_last)
+            {
+                bool was_empty = bucket_empty(pbucket);
+                overall_list.splice_after(bucket_before_first[pbucket], chain);
+                // 空桶的链段被接到了整条链表的最前面，原来的首节点所在的桶的前驱变成了 chain_last
+                if (was_empty)
+                {
+                    node_iterator nxt_it = std::next(chain_last);
+                    if (nxt_it != overall_list.end())
+                        bucket_before_first[hash_bucket(node_hashcode(*nxt_it))] = chain_last;
+                }
+            }
+            template <bool Unique, typename InputIt>
+            void insert_range_impl(InputIt first, InputIt last)
+            {
+                // 第一步：取出输入并计算哈希（缓存哈希时 node_value 已经顺带算好）
+                std::vector<node_value_type> staged;
+                if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+                {
+                    staged.reserve(std::distance(first, last));
+                }
+                for (; first != last; ++first)
+                    staged.push_back(node_value(*first));
+                size_type n = staged.size();
+                if (!n)
+                    return;
+                std::vector<size_t> hashes(n);
+                for (size_type i = 0; i < n; ++i)
+                    hashes[i] = node_hashcode(staged[i]);
+
+                // 第二步：按插入后的元素个数一次性确定桶数量
+                if (rehash_policy.need_rehash(size() + n, bucket_count()))
+                    rehash(rehash_policy.next_bucket_count(size() + n, bucket_count()));
+
+                // 第三步：按桶号计数排序，bucket_start[b] 到 bucket_start[b+1] 是第 b 个桶的新元素
+                size_type nbucket = bucket_count();
+                std::vector<size_type> in_bucket(n), bucket_start(nbucket + 1, 0), order(n);
+                for (size_type i = 0; i < n; ++i)
+                {
+                    in_bucket[i] = hash_bucket(hashes[i]);
+                    ++bucket_start[in_bucket[i] + 1];
+                }
+                for (size_type b = 0; b < nbucket; ++b)
+                    bucket_start[b + 1] += bucket_start[b];
+                {
+                    std::vector<size_type> fill_pos(bucket_start.begin(), bucket_start.end() - 1);
+                    for (size_type i = 0; i < n; ++i)
+                        order[fill_pos[in_bucket[i]]++] = i;
+                }
+
+                // 第四步：逐桶串好临时链表，再整段接入
+                // heads 记录临时链表中每组相等元素的第一个，查重只比较组首，重复键很多时也不会逐个扫描整条临时链表
+                std::vector<node_iterator> heads;
+                for (size_type b = 0; b < nbucket; ++b)
+                {
+                    if (bucket_start[b] == bucket_start[b + 1])
+                        continue;
+                    list_type chain;
+                    node_iterator chain_last = chain.before_begin();
+                    heads.clear();
+                    for (size_type j = bucket_start[b]; j < bucket_start[b + 1]; ++j)
+                    {
+                        size_type i = order[j];
+                        const key_type &k = KeyOfValue{}(value_traits::value(staged[i]));
+                        // 在临时链表里找相等的元素，它们与表中已有的元素同样需要去重或相邻
+                        node_iterator chain_equal = chain.end();
+                        for (node_iterator it : heads)
+                        {
+                            if (node_hashcode(*it) == hashes[i] && kequal(KeyOfValue{}(value_traits::value(*it)), k))
+                            {
+                                chain_equal = it;
+                                break;
+                            }
+                        }
+                        if constexpr (Unique)
+                        {
+                            if (chain_equal != chain.end() || find_node(*this, k, hashes[i]) != overall_list.end())
+                                continue;
+                            heads.push_back(chain_last = chain.insert_after(chain_last, std::move(staged[i])));
+                        }
+                        else
+                        {
+                            if (chain_equal != chain.end())
+                            {
+                                node_iterator it = chain.insert_after(chain_equal, std::move(staged[i]));
+                                if (chain_equal == chain_last)
+                                    chain_last = it;
+                            }
+                            else if (node_iterator table_equal = find_node(*this, k, hashes[i]); table_equal != overall_list.end())
+                            {
+                                // 表中已有相等元素，直接挂在它后面，保持相等元素相邻
+                                insert_after_in_bucket(table_equal, std::move(staged[i]), b);
+                            }
+                            else
+                            {
+                                heads.push_back(chain_last = chain.insert_after(chain_last, std::move(staged[i])));
+                            }
+                        }
+                        ++size_r;
+                    }
+                    if (!chain.empty())
+                        link_bucket_chain(b, chain, chain_last);
+                }
+            }
+            template <typename K>
+            size_type erase_unique_node(const K &k, size_t khash)
+            {
+                size_type kbucket = hash_bucket(khash);
+                node_iterator it = bucket_before_first[kbucket], pre_it;
+                for (pre_it = it, ++it; it != overall_list.end(); pre_it = it, ++it)
+                {
+                    size_t cur_hash = node_hashcode(*it);
+                    if (hash_bucket(cur_hash) != kbucket)
+                        break;
+                    if (cur_hash == khash && kequal(KeyOfValue{}(value_traits::value(*it)), k))
+                    {
+                        erase_after_in_bucket(pre_it, std::next(it), kbucket);
+                        --size_r;
+                        return 1;
+                    }
+                }
+                return 0;
+            }
+            template <typename K>
+            size_type erase_multi_node(const K &k, size_t khash)
+            {
+                // 找到第一个匹配元素后，继续向后查找所有匹配元素，然后一次性删除
+                size_type res = 0;
+                size_type kbucket = hash_bucket(khash);
+                node_iterator it = bucket_before_first[kbucket], pre_it;
+                for (pre_it = it, ++it; it != overall_list.end(); pre_it = it, ++it)
+                {
+                    size_t cur_hash = node_hashcode(*it);
+                    if (hash_bucket(cur_hash) != kbucket)
+                        break;
+                    if (cur_hash == khash && kequal(KeyOfValue{}(value_traits::value(*it)), k))
+                    {
+                        // 找到第一个匹配项，继续寻找这个匹配范围的末尾
+                        for (++res, ++it; it != overall_list.end(); ++res, ++it)
+                        {
+                            cur_hash = node_hashcode(*it);
+                            if (cur_hash != khash)
+                                break;
+                            if (!kequal(KeyOfValue{}(value_traits::value(*it)), k))
+                                break;
+                        }
+                        erase_after_in_bucket(pre_it, it, kbucket);
+                        size_r -= res;
+                        break;
+                    }
+                }
+                return res;
             }
         };
 
@@ -0,0 +1,577 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "hashtable.hpp"
+namespace DSA
+{
+    namespace Hashing
+    {
+        /**
+         * @brief 支持并发读写的分桶布谷鸟哈希表（只支持唯一键）。
+         *
+         * - 每个桶有 slot_per_bucket(4) 个槽，每个键有两个候选桶：b1 = h & mask，b2 = b1 ^ (tag(h) | 1)。
+         *   第二个桶只依赖第一个桶和哈希码（partial-key cuckoo），所以从任意一个候选桶都能算出另一个，搬迁元素时不必重新哈希键。
+         * - 桶按下标映射到固定数量的锁条带（lock striping），写操作只锁住两个候选桶所在的条带；
+         *   每个条带的锁同时是一个版本号：偶数表示空闲，写者把它加一变成奇数后独占，解锁时再加一。
+         * - 两个候选桶都满时，用 BFS 在“候选桶图”上找一条长度有限的布谷鸟路径，从路径末端的空槽开始逐步往回搬，
+         *   每一步只锁涉及的两个条带；找不到路径才整体扩容。这样在占用率接近 95% 时插入依然很快。
+         * - 当 value_type 可平凡拷贝时，读操作是乐观无锁的：先记下两个条带的版本号，读取槽内容，再确认版本号没有变化，
+         *   否则重试（seqlock）；不满足时读操作退化为加锁读。
+         * - 扩容时持有全部条带锁。旧的桶数组不立即释放，而是按纪元（epoch）回收：每个操作进入时登记当前纪元，
+         *   旧数组记下退役时的纪元，等所有可能还拿着它的操作都结束后，才在之后的扩容或操作退出时释放。
+         *
+         * 读接口以拷贝的方式返回元素，因为持有指向表内元素的引用在并发修改下是不安全的。
+         */
+        template <typename T, typename KeyT = T, typename Hash = std::hash<KeyT>, typename EqualT = std::equal_to<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+        struct ConcurrentCuckooHashTable
+        {
+            using key_type = KeyT;
+            using value_type = T;
+            using size_type = size_t;
+            using hasher = Hash;
+            using key_equal = EqualT;
+
+            static constexpr size_type slot_per_bucket = 4;
+            static constexpr size_type stripe_count = 512;
+            static constexpr size_type min_bucket_count = 16;
+            // BFS 搜索布谷鸟路径的最大深度，即一次插入最多连续搬迁的元素个数
+            static constexpr int max_bfs_depth = 5;
+            // 读操作是否可以乐观无锁
+            static constexpr bool optimistic_read = std::is_trivially_copyable_v<T>;
+
+            explicit ConcurrentCuckooHashTable(size_type init_capacity = 0, const hasher &h = hasher{}, const key_equal &keq = key_equal{})
+                : hashf(h), kequal(keq)
+            {
+                size_type nbucket = std::bit_ceil(std::max(min_bucket_count, (init_capacity + slot_per_bucket - 1) / slot_per_bucket));
+                table_owner = std::make_unique<TableState>(nbucket);
+                current.store(table_owner.get(), std::memory_order_release);
+            }
+            ConcurrentCuckooHashTable(const ConcurrentCuckooHashTable &) = delete;
+            ConcurrentCuckooHashTable &operator=(const ConcurrentCuckooHashTable &) = delete;
+            ~ConcurrentCuckooHashTable()
+            {
+                current.load(std::memory_order_relaxed)->destroy_all();
+            }
+
+            // 并发修改期间只是一个近似值
+            size_type size() const { return size_r.load(std::memory_order_relaxed); }
+            bool empty() const { return !size(); }
+            size_type bucket_count() const
+            {
+                EpochGuard eg(*this);
+                return current.load(std::memory_order_acquire)->bucket_count();
+            }
+            size_type capacity() const { return bucket_count() * slot_per_bucket; }
+            float load_factor() const { return float(size()) / capacity(); }
+            hasher hash_function() const { return hashf; }
+            key_equal key_eq() const { return kequal; }
+
+            /**
+             * @brief 插入唯一键值。
+             * @return 成功插入返回 true，键已存在返回 false。
+             */
+            bool insert(const T &v)
+            {
+                const key_type &k = KeyOfValue{}(v);
+                size_t h = hashf(k);
+                EpochGuard eg(*this);
+                for (;;)
+                {
+                    TableState *t = current.load(std::memory_order_acquire);
+                    size_type b1 = t->primary_bucket(h), b2 = t->alt_bucket(b1, h);
+                    {
+                        StripeGuard guard(*this, b1, b2);
+                        if (t == current.load(std::memory_order_acquire))
+                        {
+                            if (t->find_slot(b1, k, h, kequal) >= 0 || t->find_slot(b2, k, h, kequal) >= 0)
+                                return false;
+                            if (place_in(t, b1, v, h) || place_in(t, b2, v, h))
+                                return true;
+                        }
+                        else
+                        {
+                            continue;
+                        }
+                    }
+                    // 两个候选桶都满了：串行化地寻找布谷鸟路径，失败则扩容，然后重试
+                    std::lock_guard<std::mutex> lk(resize_mutex);
+                    if (t != current.load(std::memory_order_acquire))
+                        continue;
+                    if (make_room(t, b1, b2) == PathResult::NotFound)
+                        grow(t);
+                }
+            }
+
+            /**
+             * @brief 查找键，找到时把元素拷贝到 out。
+             */
+            bool find(const key_type &k, T &out) const
+            {
+                size_t h = hashf(k);
+                EpochGuard eg(*this);
+                return read_slot(k, h, [&](const T &v)
+                                 { out = v; });
+            }
+            bool contains(const key_type &k) const
+            {
+                size_t h = hashf(k);
+                EpochGuard eg(*this);
+                return read_slot(k, h, [](const T &) {});
+            }
+
+            /**
+             * @brief 删除键。
+             * @return 删除的元素个数（0 或 1）。
+             */
+            size_type erase(const key_type &k)
+            {
+                size_t h = hashf(k);
+                EpochGuard eg(*this);
+                for (;;)
+                {
+                    TableState *t = current.load(std::memory_order_acquire);
+                    size_type b1 = t->primary_bucket(h), b2 = t->alt_bucket(b1, h);
+                    StripeGuard guard(*this, b1, b2);
+                    if (t != current.load(std::memory_order_acquire))
+                        continue;
+                    for (size_type b : {b1, b2})
+                    {
+                        int s = t->find_slot(b, k, h, kequal);
+                        if (s >= 0)
+                        {
+                            t->buckets[b].destroy(s);
+                            size_r.fetch_sub(1, std::memory_order_relaxed);
+                            return 1;
+                        }
+                    }
+                    return 0;
+                }
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lk(resize_mutex);
+                lock_all();
+                current.load(std::memory_order_relaxed)->destroy_all();
+                size_r.store(0, std::memory_order_relaxed);
+                unlock_all();
+            }
+            // 已退役但还没有释放的桶数组个数
+            size_type retired_tables() const { return retired_count.load(std::memory_order_relaxed); }
+
+        protected:
+            // 一个桶：occupied 与 hashes 是原子变量，乐观读者可以无数据竞争地读取；元素本身存放在未初始化的存储中
+            struct Bucket
+            {
+                std::atomic<bool> occupied[slot_per_bucket];
+                std::atomic<size_t> hashes[slot_per_bucket];
+                alignas(T) unsigned char storage[slot_per_bucket][sizeof(T)];
+
+                Bucket()
+                {
+                    for (size_type s = 0; s < slot_per_bucket; ++s)
+                    {
+                        occupied[s].store(false, std::memory_order_relaxed);
+                        hashes[s].store(0, std::memory_order_relaxed);
+                    }
+                }
+                T *slot(size_type s) { return std::launder(reinterpret_cast<T *>(storage[s])); }
+                const T *slot(size_type s) const { return std::launder(reinterpret_cast<const T *>(storage[s])); }
+                bool is_occupied(size_type s) const { return occupied[s].load(std::memory_order_relaxed); }
+                size_t hash_at(size_type s) const { return hashes[s].load(std::memory_order_relaxed); }
+                template <typename V>
+                void construct(size_type s, V &&v, size_t h)
+                {
+                    ::new (static_cast<void *>(storage[s])) T(std::forward<V>(v));
+                    hashes[s].store(h, std::memory_order_relaxed);
+                    occupied[s].store(true, std::memory_order_relaxed);
+                }
+                void destroy(size_type s)
+                {
+                    occupied[s].store(false, std::memory_order_relaxed);
+                    std::destroy_at(slot(s));
+                }
+            };
+            // 一份桶数组及其掩码，扩容时整体替换
+            struct TableState
+            {
+                size_type mask;
+                std::unique_ptr<Bucket[]> buckets;
+
+                explicit TableState(size_type nbucket) : mask(nbucket - 1), buckets(new Bucket[nbucket]) {}
+                size_type bucket_count() const { return mask + 1; }
+                size_type primary_bucket(size_t h) const { return h & mask; }
+                // 第二个哈希函数：用哈希码的高位混合出一个奇数偏移与桶号异或，alt_bucket(alt_bucket(b)) == b
+                size_type alt_bucket(size_type b, size_t h) const
+                {
+                    size_t tag = ((h >> 32) ^ h) * 0x9E3779B97F4A7C15ull;
+                    return (b ^ ((tag >> 17) | 1)) & mask;
+                }
+                template <typename K>
+                int find_slot(size_type b, const K &k, size_t h, const key_equal &keq) const
+                {
+                    const Bucket &bk = buckets[b];
+                    for (size_type s = 0; s < slot_per_bucket; ++s)
+                    {
+                        if (bk.is_occupied(s) && bk.hash_at(s) == h && keq(KeyOfValue{}(*bk.slot(s)), k))
+                            return int(s);
+                    }
+                    return -1;
+                }
+                int empty_slot(size_type b) const
+                {
+                    for (size_type s = 0; s < slot_per_bucket; ++s)
+                        if (!buckets[b].is_occupied(s))
+                            return int(s);
+                    return -1;
+                }
+                void destroy_all()
+                {
+                    for (size_type b = 0; b <= mask; ++b)
+                        for (size_type s = 0; s < slot_per_bucket; ++s)
+                            if (buckets[b].is_occupied(s))
+                                buckets[b].destroy(s);
+                }
+            };
+            // 锁条带。version 为偶数时空闲，奇数时被某个写者持有
+            struct alignas(64) Stripe
+            {
+                std::atomic<size_t> version{0};
+            };
+            // 同时锁住两个桶所在的条带，按条带下标从小到大加锁以避免死锁
+            struct StripeGuard
+            {
+                StripeGuard(const ConcurrentCuckooHashTable &table, size_type b1, size_type b2)
+                    : self(table), s1(stripe_of(b1)), s2(stripe_of(b2))
+                {
+                    if (s1 > s2)
+                        std::swap(s1, s2);
+                    self.lock_stripe(s1);
+                    if (s2 != s1)
+                        self.lock_stripe(s2);
+                }
+                ~StripeGuard()
+                {
+                    if (s2 != s1)
+                        self.unlock_stripe(s2);
+                    self.unlock_stripe(s1);
+                }
+                const ConcurrentCuckooHashTable &self;
+                size_type s1, s2;
+            };
+            enum class PathResult
+            {
+                Done,     // 已经在候选桶中腾出一个空槽
+                Retry,    // 路径被并发修改打断，重新尝试插入即可
+                NotFound, // 限定深度内没有路径，需要扩容
+            };
+            // BFS 的一个结点：到达的桶，父结点，以及从父结点的哪个槽搬过来
+            struct PathNode
+            {
+                size_type bucket;
+                int parent;
+                int slot_in_parent;
+                int depth;
+            };
+
+            // 已退役的桶数组，以及退役时的纪元
+            struct Retired
+            {
+                std::unique_ptr<TableState> table;
+                size_t epoch;
+            };
+            /**
+             * @brief 操作期间登记所在的纪元，析构时注销。
+             *
+             * 纪元只在持有 resize_mutex 时推进，且只有上一个纪元的操作全部结束（active[(e - 1) & 1] 为 0）时才能从 e 推进到 e + 1，
+             * 所以任一时刻进行中的操作只分布在相邻的两个纪元，两个计数器就够了。
+             * 登记时先加计数再确认纪元没有变化，否则撤销重来，保证不会登记到一个已经被判定为清空的纪元上。
+             */
+            struct EpochGuard
+            {
+                explicit EpochGuard(const ConcurrentCuckooHashTable &table) : self(table)
+                {
+                    for (;;)
+                    {
+                        e = self.epoch.load(std::memory_order_seq_cst);
+                        self.active[e & 1].fetch_add(1, std::memory_order_seq_cst);
+                        if (self.epoch.load(std::memory_order_seq_cst) == e)
+                            return;
+                        self.active[e & 1].fetch_sub(1, std::memory_order_release);
+                    }
+                }
+                ~EpochGuard()
+                {
+                    self.active[e & 1].fetch_sub(1, std::memory_order_release);
+                    // 有待回收的桶数组时顺手推进纪元，拿不到锁就留给别的操作
+                    if (self.retired_count.load(std::memory_order_relaxed) && self.resize_mutex.try_lock())
+                    {
+                        self.reclaim();
+                        self.resize_mutex.unlock();
+                    }
+                }
+                const ConcurrentCuckooHashTable &self;
+                size_t e;
+            };
+
+            std::atomic<TableState *> current;
+            std::unique_ptr<TableState> table_owner; // 当前桶数组，受 resize_mutex 保护
+            mutable std::vector<Retired> retired; // 受 resize_mutex 保护
+            mutable std::atomic<size_type> retired_count{0};
+            mutable std::atomic<size_t> epoch{0};
+            mutable std::atomic<size_t> active[2] = {0, 0};
+            mutable Stripe stripes[stripe_count];
+            mutable std::mutex resize_mutex; // 串行化布谷鸟路径的搬迁、扩容与旧桶数组的回收
+            std::atomic<size_type> size_r{0};
+            hasher hashf;
+            key_equal kequal;
+
+            static size_type stripe_of(size_type b) { return b & (stripe_count - 1); }
+            void lock_stripe(size_type i) const
+            {
+                std::atomic<size_t> &ver = stripes[i].version;
+                for (int spin = 0;; ++spin)
+                {
+                    size_t v = ver.load(std::memory_order_relaxed);
+                    if (!(v & 1) && ver.compare_exchange_weak(v, v + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                        return;
+                    if (spin > 64)
+                        std::this_thread::yield();
+                }
+            }
+            void unlock_stripe(size_type i) const
+            {
+                stripes[i].version.fetch_add(1, std::memory_order_release);
+            }
+            void lock_all() const
+            {
+                for (size_type i = 0; i < stripe_count; ++i)
+                    lock_stripe(i);
+            }
+            void unlock_all() const
+            {
+                for (size_type i = stripe_count; i-- > 0;)
+                    unlock_stripe(i);
+            }
+
+            // 调用者已持有 b 所在条带的锁
+            bool place_in(TableState *t, size_type b, const T &v, size_t h)
+            {
+                int s = t->empty_slot(b);
+                if (s < 0)
+                    return false;
+                t->buckets[b].construct(s, v, h);
+                size_r.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /**
+             * @brief 读取键对应的元素并交给 visit。
+             *
+             * 乐观模式下先把槽拷贝到本地缓冲区再比较键，读完后确认两个条带的版本号都没有变化、桶数组也没有被替换，
+             * 否则说明读到的可能是被并发修改的中间状态，重试。
+             */
+            template <typename Visit>
+            bool read_slot(const key_type &k, size_t h, Visit &&visit) const
+            {
+                for (;;)
+                {
+                    TableState *t = current.load(std::memory_order_acquire);
+                    size_type b1 = t->primary_bucket(h), b2 = t->alt_bucket(b1, h);
+                    if constexpr (optimistic_read)
+                    {
+                        size_type s1 = stripe_of(b1), s2 = stripe_of(b2);
+                        size_t v1 = stripes[s1].version.load(std::memory_order_acquire);
+                        size_t v2 = stripes[s2].version.load(std::memory_order_acquire);
+                        if ((v1 | v2) & 1)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        alignas(T) unsigned char buf[sizeof(T)];
+                        bool found = false;
+                        for (size_type b : {b1, b2})
+                        {
+                            const Bucket &bk = t->buckets[b];
+                            for (size_type s = 0; s < slot_per_bucket && !found; ++s)
+                            {
+                                if (bk.is_occupied(s) && bk.hash_at(s) == h)
+                                {
+                                    std::memcpy(buf, bk.storage[s], sizeof(T));
+                                    std::atomic_thread_fence(std::memory_order_acquire);
+                                    // 键比较之前先确认拷贝出来的内容是一致的
+                                    if (stripes[s1].version.load(std::memory_order_relaxed) != v1 ||
+                                        stripes[s2].version.load(std::memory_order_relaxed) != v2)
+                                        break;
+                                    found = kequal(KeyOfValue{}(*std::launder(reinterpret_cast<const T *>(buf))), k);
+                                }
+                            }
+                            if (found)
+                                break;
+                        }
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        if (stripes[s1].version.load(std::memory_order_relaxed) != v1 ||
+                            stripes[s2].version.load(std::memory_order_relaxed) != v2 ||
+                            t != current.load(std::memory_order_acquire))
+                            continue;
+                        if (found)
+                            visit(*std::launder(reinterpret_cast<const T *>(buf)));
+                        return found;
+                    }
+                    else
+                    {
+                        StripeGuard guard(*this, b1, b2);
+                        if (t != current.load(std::memory_order_acquire))
+                            continue;
+                        for (size_type b : {b1, b2})
+                        {
+                            int s = t->find_slot(b, k, h, kequal);
+                            if (s >= 0)
+                            {
+                                visit(*t->buckets[b].slot(s));
+                                return true;
+                            }
+                        }
+                        return false;
+                    }
+                }
+            }
+
+            /**
+             * @brief 在候选桶图上广度优先搜索一条到空槽的布谷鸟路径。
+             *
+             * 结点是桶，从桶 b 的第 s 个槽出发的边指向该槽元素的另一个候选桶。
+             * 找到空槽后沿父指针回溯，得到 (桶, 槽) 序列：path[0] 位于 b1 或 b2，path.back() 是空槽。
+             * 搜索过程不加锁，读到的可能是过时的信息，搬迁时会逐步校验。
+             */
+            static bool search_path(const TableState *t, size_type b1, size_type b2, std::vector<std::pair<size_type, int>> &path)
+            {
+                std::vector<PathNode> nodes;
+                nodes.push_back({b1, -1, -1, 0});
+                nodes.push_back({b2, -1, -1, 0});
+                for (size_type head = 0; head < nodes.size(); ++head)
+                {
+                    PathNode cur = nodes[head];
+                    const Bucket &bk = t->buckets[cur.bucket];
+                    for (size_type s = 0; s < slot_per_bucket; ++s)
+                    {
+                        if (!bk.is_occupied(s))
+                        {
+                            path.clear();
+                            path.emplace_back(cur.bucket, int(s));
+                            for (int i = int(head); nodes[i].parent >= 0; i = nodes[i].parent)
+                                path.emplace_back(nodes[nodes[i].parent].bucket, nodes[i].slot_in_parent);
+                            std::reverse(path.begin(), path.end());
+                            return true;
+                        }
+                    }
+                    if (cur.depth >= max_bfs_depth)
+                        continue;
+                    for (size_type s = 0; s < slot_per_bucket; ++s)
+                        nodes.push_back({t->alt_bucket(cur.bucket, bk.hash_at(s)), int(head), int(s), cur.depth + 1});
+                }
+                return false;
+            }
+            // 搬迁一个元素前的校验：目标槽为空，源槽有元素，且目标桶确实是源元素的另一个候选桶
+            static bool can_move(const TableState *t, std::pair<size_type, int> from, std::pair<size_type, int> to)
+            {
+                const Bucket &src = t->buckets[from.first];
+                return !t->buckets[to.first].is_occupied(to.second) && src.is_occupied(from.second) &&
+                       t->alt_bucket(from.first, src.hash_at(from.second)) == to.first;
+            }
+            static void move_slot(TableState *t, std::pair<size_type, int> from, std::pair<size_type, int> to)
+            {
+                Bucket &src = t->buckets[from.first];
+                t->buckets[to.first].construct(to.second, std::move(*src.slot(from.second)), src.hash_at(from.second));
+                src.destroy(from.second);
+            }
+            // 调用者持有 resize_mutex。沿 BFS 路径从空槽一端开始逐步往回搬，每一步锁住两端的条带并校验
+            PathResult make_room(TableState *t, size_type b1, size_type b2)
+            {
+                std::vector<std::pair<size_type, int>> path;
+                if (!search_path(t, b1, b2, path))
+                    return PathResult::NotFound;
+                for (size_type i = path.size() - 1; i > 0; --i)
+                {
+                    StripeGuard guard(*this, path[i - 1].first, path[i].first);
+                    if (!can_move(t, path[i - 1], path[i]))
+                        return PathResult::Retry;
+                    move_slot(t, path[i - 1], path[i]);
+                }
+                return PathResult::Done;
+            }
+            // 扩容时的单线程插入（全部条带已被锁住），同样先试两个候选桶再找布谷鸟路径
+            static bool insert_exclusive(TableState *t, const T &v, size_t h)
+            {
+                size_type b1 = t->primary_bucket(h), b2 = t->alt_bucket(b1, h);
+                for (size_type b : {b1, b2})
+                {
+                    int s = t->empty_slot(b);
+                    if (s >= 0)
+                    {
+                        t->buckets[b].construct(s, v, h);
+                        return true;
+                    }
+                }
+                std::vector<std::pair<size_type, int>> path;
+                if (!search_path(t, b1, b2, path))
+                    return false;
+                for (size_type i = path.size() - 1; i > 0; --i)
+                    move_slot(t, path[i - 1], path[i]);
+                t->buckets[path[0].first].construct(path[0].second, v, h);
+                return true;
+            }
+            // 调用者持有 resize_mutex。锁住全部条带，把元素拷贝进两倍大小的新桶数组；偶尔新数组也放不下时再翻倍
+            void grow(TableState *t)
+            {
+                lock_all();
+                size_type nbucket = t->bucket_count() * 2;
+                for (;; nbucket *= 2)
+                {
+                    auto nt = std::make_unique<TableState>(nbucket);
+                    bool ok = true;
+                    for (size_type b = 0; b <= t->mask && ok; ++b)
+                    {
+                        Bucket &bk = t->buckets[b];
+                        for (size_type s = 0; s < slot_per_bucket && ok; ++s)
+                            if (bk.is_occupied(s))
+                                ok = insert_exclusive(nt.get(), *bk.slot(s), bk.hash_at(s));
+                    }
+                    if (!ok)
+                    {
+                        nt->destroy_all();
+                        continue;
+                    }
+                    t->destroy_all();
+                    current.store(nt.get(), std::memory_order_release);
+                    // 纪元只在持有 resize_mutex 时推进，此刻读到的纪元不小于任何还可能拿着 t 的操作所登记的纪元
+                    retired.push_back({std::move(table_owner), epoch.load(std::memory_order_seq_cst)});
+                    retired_count.store(retired.size(), std::memory_order_relaxed);
+                    table_owner = std::move(nt);
+                    break;
+                }
+                unlock_all();
+                reclaim();
+            }
+            /**
+             * @brief 调用者持有 resize_mutex。上一个纪元的操作都结束时把纪元从 e 推进到 e + 1，
+             * 此时纪元不超过 e - 1 的操作都已结束，退役纪元不超过 e - 1 的桶数组不会再被访问，可以释放。
+             */
+            void reclaim() const
+            {
+                size_t e = epoch.load(std::memory_order_seq_cst);
+                if (active[(e + 1) & 1].load(std::memory_order_seq_cst) == 0)
+                    epoch.store(++e, std::memory_order_seq_cst);
+                std::erase_if(retired, [e](const Retired &r)
+                              { return r.epoch + 2 <= e; });
+                retired_count.store(retired.size(), std::memory_order_relaxed);
+            }
+        };
+    }
+}
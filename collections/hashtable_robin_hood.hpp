@@ -0,0 +1,583 @@
+#pragma once
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "hashtable.hpp"
+#include "hash_function.hpp"
+namespace DSA
+{
+    namespace Hashing
+    {
+        template <typename T, typename KeyT, typename Hash, typename EqualT, typename KeyOfValue, typename ReHashPolicy, bool HashCached>
+        struct RobinHoodHashTable;
+
+        namespace detail
+        {
+            /**
+             * @brief 开放定址哈希表的前向迭代器。
+             *
+             * 同时持有探测距离数组与槽数组中的位置，++ 时跳过空槽。
+             * 探测距离数组的末尾放了一个非零的哨兵，所以跳过空槽时不需要检查越界。
+             */
+            template <typename T, bool HashCached, bool IsConst>
+            struct RobinHoodIterator
+            {
+                using value_traits = hash_node_traits<T, HashCached>;
+                using node_value_type = value_traits::node_value_type;
+                using value_type = std::conditional_t<IsConst, const T, T>;
+                using iterator_category = std::forward_iterator_tag;
+                using reference = value_type &;
+                using pointer = value_type *;
+                using difference_type = std::ptrdiff_t;
+
+                RobinHoodIterator() = default;
+                RobinHoodIterator(const unsigned char *d, node_value_type *s) : dist(d), slot(s) {}
+                // 允许从可变迭代器构造常量迭代器
+                template <bool FromConst = IsConst>
+                    requires FromConst
+                RobinHoodIterator(const RobinHoodIterator<T, HashCached, false> &other)
+                    : dist(other.dist), slot(other.slot)
+                {
+                }
+
+                reference operator*() const { return value_traits::value(*slot); }
+                pointer operator->() const { return &value_traits::value(*slot); }
+
+                RobinHoodIterator &operator++()
+                {
+                    do
+                    {
+                        ++dist;
+                        ++slot;
+                    } while (!*dist);
+                    return *(this);
+                }
+                RobinHoodIterator operator++(int)
+                {
+                    auto tmp = *this;
+                    ++(*this);
+                    return tmp;
+                }
+                bool operator==(const RobinHoodIterator &other) const { return dist == other.dist; }
+                bool operator!=(const RobinHoodIterator &other) const { return dist != other.dist; }
+
+            protected:
+                const unsigned char *dist = nullptr;
+                node_value_type *slot = nullptr;
+                friend RobinHoodIterator<T, HashCached, true>;
+                template <typename, typename, typename, typename, typename, typename, bool>
+                friend struct DSA::Hashing::RobinHoodHashTable;
+            };
+        }
+
+        /**
+         * @brief 开放定址 + Robin Hood 探测的哈希表，只支持唯一键。
+         *
+         * 与 HashTable 使用相同的模板参数和同名接口（insert_unique / find / erase_unique / count_unique ...），
+         * 只存唯一键的场合可以直接替换。相比分离链接法：
+         * - 没有链表节点，元素直接存放在连续的槽数组中，默认最大加载因子可以提高到 0.9；
+         * - 插入时“劫富济贫”：新元素一旦比当前槽里的元素离家更远，就占据该槽，原元素继续向后找位置，
+         *   因此所有元素的探测距离都比较平均，并且按“家”桶的顺序排列；
+         * - 查找时只要遇到探测距离比自己当前距离还小的槽，就可以提前判定不存在；
+         * - 删除使用后移回填（backward shift）：把后面离家的元素逐个前移一格，不需要墓碑。
+         *
+         * 探测距离有上界 max_displacement，槽数组在桶数量之后额外多出这么多个溢出槽，所以探测永远不会绕回数组开头，
+         * 一旦某次插入会让任何元素的探测距离超过上界就扩容。桶数量取 2 的幂时，哈希码先经过 mix_integer 混合再取低位，
+         * 所以 std::hash 这类恒等映射的整数哈希也不会让步长为 2 的幂的键挤在一起。
+         * 只有超过 max_displacement 个键的哈希码完全相同时，插入才会抛出 length_error，此时表保持不变。
+         * 元素的移动构造应当是不抛异常的。
+         */
+        template <typename T, typename KeyT = T, typename Hash = std::hash<KeyT>, typename EqualT = std::equal_to<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>, typename ReHashPolicy = Pow2ReHash, bool HashCached = true>
+        struct RobinHoodHashTable
+        {
+            using key_type = KeyT;
+            using value_type = T;
+            using reference = T &;
+            using const_reference = const T &;
+            using pointer = T *;
+            using const_pointer = const T *;
+            using iterator = detail::RobinHoodIterator<T, HashCached, false>;
+            using const_iterator = detail::RobinHoodIterator<T, HashCached, true>;
+            using size_type = size_t;
+            using difference_type = std::ptrdiff_t;
+            using value_traits = detail::hash_node_traits<T, HashCached>;
+            using node_value_type = value_traits::node_value_type;
+            using hasher = Hash;
+            using key_equal = EqualT;
+
+            // 探测距离的上界，同时也是桶数组之后溢出槽的个数
+            static constexpr size_type max_displacement = 128;
+
+            // 与 HashTable 一致：只有哈希函数与比较函数都声明 is_transparent 时才开放异构查找
+            static constexpr bool is_transparent_lookup = requires {
+                typename Hash::is_transparent;
+                typename EqualT::is_transparent;
+            };
+
+            RobinHoodHashTable() : RobinHoodHashTable(0) {}
+            explicit RobinHoodHashTable(size_type init_buckets_count, const hasher &h = hasher{}, const key_equal &keq = key_equal{}) : hashf(h), kequal(keq)
+            {
+                rehash_policy.max_load_factor(0.9);
+                allocate_slots(rehash_policy.next_bucket_count(0, init_buckets_count));
+            }
+            template <typename InputIt>
+                requires std::input_iterator<InputIt>
+            RobinHoodHashTable(InputIt first, InputIt last, size_type init_buckets_count = 0, const hasher &h = hasher{}, const key_equal &keq = key_equal{})
+                : RobinHoodHashTable(init_buckets_count, h, keq)
+            {
+                insert_range_unique(first, last);
+            }
+            RobinHoodHashTable(const RobinHoodHashTable &other) : hashf(other.hashf), rehash_policy(other.rehash_policy), kequal(other.kequal)
+            {
+                // 桶数量相同，逐槽拷贝即可，不需要重新探测
+                allocate_slots(other.bucket_count());
+                try
+                {
+                    for (size_type i = 0; i < slot_count(); ++i)
+                    {
+                        if (other.probe_dist[i])
+                        {
+                            std::allocator_traits<slot_allocator>::construct(slot_alloc, slots + i, other.slots[i]);
+                            probe_dist[i] = other.probe_dist[i];
+                            ++size_r;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    release_slots();
+                    throw;
+                }
+            }
+            RobinHoodHashTable(RobinHoodHashTable &&other) : RobinHoodHashTable()
+            {
+                swap(other);
+            }
+            RobinHoodHashTable &operator=(RobinHoodHashTable other)
+            {
+                swap(other);
+                return *this;
+            }
+            ~RobinHoodHashTable() { release_slots(); }
+
+            void swap(RobinHoodHashTable &other)
+            {
+                std::swap(probe_dist, other.probe_dist);
+                std::swap(slots, other.slots);
+                std::swap(bucket_count_r, other.bucket_count_r);
+                std::swap(size_r, other.size_r);
+                std::swap(hashf, other.hashf);
+                std::swap(rehash_policy, other.rehash_policy);
+                std::swap(kequal, other.kequal);
+            }
+
+            size_type size() const { return size_r; }
+            bool empty() const { return !size_r; }
+            size_type bucket_count() const { return bucket_count_r; }
+            float load_factor() const { return float(size_r) / bucket_count_r; }
+            hasher hash_function() const { return hashf; }
+            key_equal key_eq() const { return kequal; }
+            float max_load_factor() const { return rehash_policy.max_load_factor(); }
+            void max_load_factor(float new_factor)
+            {
+                rehash_policy.max_load_factor(new_factor);
+                if (rehash_policy.need_rehash(size(), bucket_count()))
+                    rehash(0);
+            }
+            // 当前所有元素中最大的探测距离（0 表示在自己的家桶里），用于观察探测长度是否可控
+            size_type max_probe_length() const
+            {
+                unsigned char res = 0;
+                for (size_type i = 0; i < slot_count(); ++i)
+                    res = std::max(res, probe_dist[i]);
+                return res ? res - 1 : 0;
+            }
+
+            iterator begin() { return first_from(0); }
+            const_iterator begin() const { return first_from(0); }
+            const_iterator cbegin() const { return first_from(0); }
+            iterator end() { return iterator_at(slot_count()); }
+            const_iterator end() const { return iterator_at(slot_count()); }
+            const_iterator cend() const { return iterator_at(slot_count()); }
+
+            void clear()
+            {
+                destroy_all();
+                size_r = 0;
+            }
+
+            /**
+             * @brief 重哈希。先只用下标在新的探测距离数组上模拟放置，全部放得下之后才把元素移动进新的槽数组；
+             * 放不下就把桶数量加倍重来。移动元素之前的任何失败（分配内存、哈希函数退化）都不会改动原表。
+             * @param new_bucket_count 期望的新桶数量。如果为0，则由策略自动计算。
+             */
+            void rehash(size_type new_bucket_count)
+            {
+                new_bucket_count = std::max(new_bucket_count, rehash_policy.next_bucket_count(size(), new_bucket_count));
+                std::vector<unsigned char> new_dist;
+                std::vector<size_type> from; // from[j]：新槽 j 中的元素在旧槽数组中的下标
+                while (!plan_layout(new_bucket_count, new_dist, from))
+                {
+                    if (size_r * 8 < new_bucket_count)
+                        throw std::length_error("RobinHoodHashTable: more than max_displacement keys share the same hash code");
+                    new_bucket_count *= 2;
+                }
+                size_type n = new_dist.size() - 1;
+                node_value_type *new_slots = slot_alloc.allocate(n);
+                for (size_type j = 0; j < n; ++j)
+                {
+                    if (new_dist[j])
+                    {
+                        std::allocator_traits<slot_allocator>::construct(slot_alloc, new_slots + j, std::move(slots[from[j]]));
+                        std::allocator_traits<slot_allocator>::destroy(slot_alloc, slots + from[j]);
+                    }
+                }
+                slot_alloc.deallocate(slots, slot_count());
+                slots = new_slots;
+                probe_dist.swap(new_dist);
+                bucket_count_r = new_bucket_count;
+            }
+            // 预留至少能容纳 n 个元素而不触发重哈希的空间
+            void reserve(size_type n)
+            {
+                rehash(size_type(std::ceil(n / max_load_factor())));
+            }
+
+            /**
+             * @brief 插入唯一键值。
+             * @return pair<iterator, bool>，其中 iterator 指向插入的元素或已存在的元素，
+             *         bool 表示是否成功插入 (true) 或已存在 (false)。
+             */
+            std::pair<iterator, bool> insert_unique(const T &v) { return insert_unique_impl(v); }
+            std::pair<iterator, bool> insert_unique(T &&v) { return insert_unique_impl(std::move(v)); }
+            template <typename InputIt>
+            void insert_range_unique(InputIt first, InputIt last)
+            {
+                if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+                {
+                    size_type n = size() + std::distance(first, last);
+                    if (rehash_policy.need_rehash(n, bucket_count()))
+                        rehash(rehash_policy.next_bucket_count(n, bucket_count()));
+                }
+                for (; first != last; ++first)
+                    insert_unique_impl(*first);
+            }
+
+            // 计算键的哈希码，可以传给下面带 hashcode 参数的重载，要求 hashcode == hash_function()(k)
+            size_t hash_code(const key_type &k) const { return hashf(k); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_t hash_code(const K &k) const { return hashf(k); }
+
+            iterator find(const key_type &k) { return find_at(locate(k, hashf(k))); }
+            const_iterator find(const key_type &k) const { return find_at(locate(k, hashf(k))); }
+            iterator find(const key_type &k, size_t hashcode) { return find_at(locate(k, hashcode)); }
+            const_iterator find(const key_type &k, size_t hashcode) const { return find_at(locate(k, hashcode)); }
+            template <typename K>
+                requires is_transparent_lookup
+            iterator find(const K &k) { return find_at(locate(k, hashf(k))); }
+            template <typename K>
+                requires is_transparent_lookup
+            const_iterator find(const K &k) const { return find_at(locate(k, hashf(k))); }
+            template <typename K>
+                requires is_transparent_lookup
+            iterator find(const K &k, size_t hashcode) { return find_at(locate(k, hashcode)); }
+            template <typename K>
+                requires is_transparent_lookup
+            const_iterator find(const K &k, size_t hashcode) const { return find_at(locate(k, hashcode)); }
+
+            size_type count_unique(const key_type &k) const { return locate(k, hashf(k)) != npos; }
+            size_type count_unique(const key_type &k, size_t hashcode) const { return locate(k, hashcode) != npos; }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_unique(const K &k) const { return locate(k, hashf(k)) != npos; }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type count_unique(const K &k, size_t hashcode) const { return locate(k, hashcode) != npos; }
+
+            std::pair<iterator, iterator> equal_range_unique(const key_type &k) { return equal_range_at<iterator>(*this, locate(k, hashf(k))); }
+            std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k) const { return equal_range_at<const_iterator>(*this, locate(k, hashf(k))); }
+            std::pair<iterator, iterator> equal_range_unique(const key_type &k, size_t hashcode) { return equal_range_at<iterator>(*this, locate(k, hashcode)); }
+            std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k, size_t hashcode) const { return equal_range_at<const_iterator>(*this, locate(k, hashcode)); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<iterator, iterator> equal_range_unique(const K &k) { return equal_range_at<iterator>(*this, locate(k, hashf(k))); }
+            template <typename K>
+                requires is_transparent_lookup
+            std::pair<const_iterator, const_iterator> equal_range_unique(const K &k) const { return equal_range_at<const_iterator>(*this, locate(k, hashf(k))); }
+
+            /**
+             * @brief 删除指定迭代器位置的元素。
+             * @return iterator 指向被删除元素之后元素的迭代器。
+             * 后移回填只会把后面的元素搬到被删位置及其之后，所以返回的迭代器继续遍历不会漏掉或重复元素。
+             */
+            iterator erase(const_iterator pos)
+            {
+                size_type i = pos.dist - probe_dist.data();
+                erase_at(i);
+                return first_from(i);
+            }
+            size_type erase_unique(const key_type &k) { return erase_located(locate(k, hashf(k))); }
+            size_type erase_unique(const key_type &k, size_t hashcode) { return erase_located(locate(k, hashcode)); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_unique(const K &k) { return erase_located(locate(k, hashf(k))); }
+            template <typename K>
+                requires is_transparent_lookup
+            size_type erase_unique(const K &k, size_t hashcode) { return erase_located(locate(k, hashcode)); }
+
+        protected:
+            using slot_allocator = std::allocator<node_value_type>;
+            static constexpr size_type npos = size_type(-1);
+
+            // probe_dist[i] == 0 表示槽 i 为空，否则等于该槽元素的探测距离 + 1；
+            // 末尾多出一个恒为 1 的哨兵，供迭代器和后移回填判断终点
+            std::vector<unsigned char> probe_dist;
+            node_value_type *slots = nullptr; // 未初始化的槽数组，只有 probe_dist 非零的位置上才构造了元素
+            size_type bucket_count_r = 0;
+            size_type size_r = 0;
+            hasher hashf;
+            ReHashPolicy rehash_policy;
+            key_equal kequal;
+            [[no_unique_address]] slot_allocator slot_alloc;
+
+            size_type slot_count() const { return probe_dist.size() - 1; }
+            static size_type displacement_bound(size_type bucket_count)
+            {
+                return std::min(max_displacement, bucket_count);
+            }
+            void allocate_slots(size_type new_bucket_count)
+            {
+                bucket_count_r = new_bucket_count;
+                size_type n = new_bucket_count + displacement_bound(new_bucket_count);
+                probe_dist.assign(n + 1, 0);
+                probe_dist[n] = 1;
+                slots = slot_alloc.allocate(n);
+            }
+            void destroy_all()
+            {
+                for (size_type i = 0; i < slot_count(); ++i)
+                {
+                    if (probe_dist[i])
+                    {
+                        std::allocator_traits<slot_allocator>::destroy(slot_alloc, slots + i);
+                        probe_dist[i] = 0;
+                    }
+                }
+            }
+            void release_slots()
+            {
+                if (!slots)
+                    return;
+                destroy_all();
+                slot_alloc.deallocate(slots, slot_count());
+                slots = nullptr;
+            }
+
+            iterator iterator_at(size_type i) { return iterator{probe_dist.data() + i, slots + i}; }
+            const_iterator iterator_at(size_type i) const { return const_iterator{probe_dist.data() + i, slots + i}; }
+            // 从槽 i 开始的第一个元素（哨兵保证一定停在 end）
+            iterator first_from(size_type i)
+            {
+                while (!probe_dist[i])
+                    ++i;
+                return iterator_at(i);
+            }
+            const_iterator first_from(size_type i) const
+            {
+                while (!probe_dist[i])
+                    ++i;
+                return iterator_at(i);
+            }
+            iterator find_at(size_type i) { return i == npos ? end() : iterator_at(i); }
+            const_iterator find_at(size_type i) const { return i == npos ? end() : iterator_at(i); }
+            template <typename It, typename Self>
+            static std::pair<It, It> equal_range_at(Self &self, size_type i)
+            {
+                It it = self.find_at(i);
+                if (i == npos)
+                    return {it, it};
+                return {it, std::next(it)};
+            }
+
+            size_t node_hashcode(const node_value_type &nv) const
+            {
+                if constexpr (HashCached)
+                    return value_traits::hashcode(nv);
+                else
+                    return hashf(KeyOfValue{}(nv));
+            }
+            // 用已经算好的哈希码创建槽里存放的值，避免重复哈希
+            template <typename V>
+            static node_value_type node_value(V &&v, size_t hashcode)
+            {
+                if constexpr (HashCached)
+                    return node_value_type{hashcode, std::forward<V>(v)};
+                else
+                    return node_value_type(std::forward<V>(v));
+            }
+            static constexpr bool pow2_buckets = requires { requires ReHashPolicy::always_pow2; };
+            // 桶数量是 2 的幂时只会用到哈希码的低位，而 std::hash 对整数是恒等映射，步长为 2 的幂的键会落进同一个桶；
+            // 先把哈希码整体混合一遍，让每一位都影响低位
+            static size_type bucket_of(size_t hashcode, size_type bucket_count)
+            {
+                if constexpr (pow2_buckets)
+                    return detail::constrain_hash<ReHashPolicy>(mix_integer(hashcode), bucket_count);
+                else
+                    return detail::constrain_hash<ReHashPolicy>(hashcode, bucket_count);
+            }
+            size_type hash_bucket(size_t hashcode) const { return bucket_of(hashcode, bucket_count_r); }
+
+            /**
+             * @brief 查找键所在的槽。
+             *
+             * 从家桶开始顺序探测，d 是“若键在这里，它的探测距离 + 1”。
+             * 由于表中元素按家桶顺序排列，一旦某个槽的探测距离小于 d（包括空槽），键就不可能出现在更后面。
+             * @return 槽下标，或 npos。
+             */
+            template <typename K>
+            size_type locate(const K &k, size_t khash) const
+            {
+                size_type i = hash_bucket(khash);
+                for (unsigned char d = 1; probe_dist[i] >= d; ++i, ++d)
+                {
+                    if (probe_dist[i] != d)
+                        continue;
+                    if constexpr (HashCached)
+                    {
+                        if (value_traits::hashcode(slots[i]) != khash)
+                            continue;
+                    }
+                    if (kequal(KeyOfValue{}(value_traits::value(slots[i])), k))
+                        return i;
+                }
+                return npos;
+            }
+
+            /**
+             * @brief 计算新元素在探测距离数组 dist（桶数量为 bucket_count）中的放置方式。
+             *
+             * Robin Hood 插入等价于：找到第一个“比新元素离家更近”的槽 p，把从 p 开始直到第一个空槽 e 之前的元素整体后移一格
+             * （它们的探测距离各加 1），再把新元素放进 p。因此可以在动手之前就判断是否会有元素超过探测距离上界或越过溢出区，
+             * 超过时返回 false 且不修改任何东西。d 为新元素的探测距离 + 1。
+             */
+            struct ProbeSpan
+            {
+                size_type p, e;
+                unsigned char d;
+            };
+            static bool probe_span(const std::vector<unsigned char> &dist, size_type bucket_count, size_t vhash, ProbeSpan &span)
+            {
+                size_type bound = displacement_bound(bucket_count);
+                size_type n = dist.size() - 1;
+                size_type p = bucket_of(vhash, bucket_count);
+                unsigned char d = 1;
+                while (dist[p] >= d)
+                {
+                    ++p;
+                    ++d;
+                }
+                if (d > bound)
+                    return false;
+                size_type e = p;
+                for (; e < n && dist[e]; ++e)
+                {
+                    if (dist[e] >= bound)
+                        return false;
+                }
+                if (e >= n)
+                    return false;
+                span = {p, e, d};
+                return true;
+            }
+            // 不做查重地放入一个元素，放不下时返回 npos 且不修改任何东西，由调用者扩容后重试
+            size_type place(node_value_type &&vnode, size_t vhash)
+            {
+                ProbeSpan span;
+                if (!probe_span(probe_dist, bucket_count_r, vhash, span))
+                    return npos;
+                for (size_type j = span.e; j > span.p; --j)
+                {
+                    std::allocator_traits<slot_allocator>::construct(slot_alloc, slots + j, std::move(slots[j - 1]));
+                    std::allocator_traits<slot_allocator>::destroy(slot_alloc, slots + j - 1);
+                    probe_dist[j] = probe_dist[j - 1] + 1;
+                }
+                std::allocator_traits<slot_allocator>::construct(slot_alloc, slots + span.p, std::move(vnode));
+                probe_dist[span.p] = span.d;
+                return span.p;
+            }
+            // 用下标模拟把当前所有元素放进桶数量为 bucket_count 的新布局，不移动任何元素
+            bool plan_layout(size_type bucket_count, std::vector<unsigned char> &dist, std::vector<size_type> &from) const
+            {
+                size_type n = bucket_count + displacement_bound(bucket_count);
+                dist.assign(n + 1, 0);
+                dist[n] = 1;
+                from.assign(n, npos);
+                for (size_type i = 0; i < slot_count(); ++i)
+                {
+                    if (!probe_dist[i])
+                        continue;
+                    ProbeSpan span;
+                    if (!probe_span(dist, bucket_count, node_hashcode(slots[i]), span))
+                        return false;
+                    for (size_type j = span.e; j > span.p; --j)
+                    {
+                        from[j] = from[j - 1];
+                        dist[j] = dist[j - 1] + 1;
+                    }
+                    from[span.p] = i;
+                    dist[span.p] = span.d;
+                }
+                return true;
+            }
+            // 放入元素，探测距离超界时扩容重试；扩容无济于事时 rehash 抛出 length_error，表保持不变
+            size_type place_or_grow(node_value_type &&vnode, size_t vhash)
+            {
+                for (;;)
+                {
+                    size_type i = place(std::move(vnode), vhash);
+                    if (i != npos)
+                    {
+                        ++size_r;
+                        return i;
+                    }
+                    rehash(bucket_count_r * 2);
+                }
+            }
+            template <typename V>
+            std::pair<iterator, bool> insert_unique_impl(V &&v)
+            {
+                size_t vhash = hashf(KeyOfValue{}(v));
+                if (size_type i = locate(KeyOfValue{}(v), vhash); i != npos)
+                    return {iterator_at(i), false};
+                if (rehash_policy.need_rehash(size() + 1, bucket_count()))
+                    rehash(bucket_count() * 2);
+                node_value_type vnode = node_value(std::forward<V>(v), vhash);
+                return {iterator_at(place_or_grow(std::move(vnode), vhash)), true};
+            }
+
+            // 后移回填：把删除位置之后所有不在家桶的元素逐个前移一格，直到遇到空槽或已在家桶的元素
+            void erase_at(size_type i)
+            {
+                std::allocator_traits<slot_allocator>::destroy(slot_alloc, slots + i);
+                size_type j = i + 1;
+                for (; probe_dist[j] > 1; ++j)
+                {
+                    std::allocator_traits<slot_allocator>::construct(slot_alloc, slots + j - 1, std::move(slots[j]));
+                    std::allocator_traits<slot_allocator>::destroy(slot_alloc, slots + j);
+                    probe_dist[j - 1] = probe_dist[j] - 1;
+                }
+                probe_dist[j - 1] = 0;
+                --size_r;
+            }
+            size_type erase_located(size_type i)
+            {
+                if (i == npos)
+                    return 0;
+                erase_at(i);
+                return 1;
+            }
+        };
+    }
+}
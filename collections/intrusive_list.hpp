@@ -0,0 +1,332 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "list_link.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            /**
+             * @brief 侵入式链表的挂钩：嵌入在用户对象中（作为基类），链表直接把对象串起来，不分配节点也不拷贝对象。
+             *
+             * 同一个对象要同时挂在多条链表上时，为每条链表使用不同的 Tag 继承多个挂钩。
+             * 拷贝对象不会拷贝挂接状态，新对象总是未挂接的。
+             */
+            template <typename Tag = void>
+            struct ListHook
+            {
+                ListHook *n_next = nullptr;
+                ListHook *n_prev = nullptr;
+
+                ListHook() = default;
+                ListHook(const ListHook &) {}
+                ListHook &operator=(const ListHook &) { return *this; }
+
+                bool is_linked() const { return n_next != nullptr; }
+
+                // 将当前挂钩（this）链接到挂钩p的前面
+                void link(ListHook *p) { detail::link_before(this, p); }
+                // 将当前挂钩（this）链接到挂钩p的后面
+                void link_back(ListHook *p) { detail::link_after(this, p); }
+                // 将当前挂钩从链表中解开，并恢复为未挂接状态
+                void unlink()
+                {
+                    detail::unlink(this);
+                    this->n_next = this->n_prev = nullptr;
+                }
+            };
+
+            template <typename T, typename Tag>
+            struct IntrusiveList;
+
+            namespace detail
+            {
+                template <typename T, typename Tag, bool IsConst>
+                class IntrusiveListIterator
+                {
+                public:
+                    using value_type = T;
+                    using reference = std::conditional_t<IsConst, const T &, T &>;
+                    using pointer = std::conditional_t<IsConst, const T *, T *>;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using Hook = ListHook<Tag>;
+
+                    IntrusiveListIterator() = default;
+                    explicit IntrusiveListIterator(const Hook *h) : hook_ptr_(const_cast<Hook *>(h)) {}
+                    // 允许从可变迭代器构造常量迭代器
+                    template <bool FromConst = IsConst>
+                        requires FromConst
+                    IntrusiveListIterator(const IntrusiveListIterator<T, Tag, false> &other) : hook_ptr_(other.hook_ptr_)
+                    {
+                    }
+
+                    reference operator*() const { return *static_cast<T *>(hook_ptr_); }
+                    pointer operator->() const { return static_cast<T *>(hook_ptr_); }
+
+                    IntrusiveListIterator &operator++()
+                    {
+                        hook_ptr_ = hook_ptr_->n_next;
+                        return *this;
+                    }
+                    IntrusiveListIterator operator++(int)
+                    {
+                        auto tmp = *this;
+                        ++(*this);
+                        return tmp;
+                    }
+                    IntrusiveListIterator &operator--()
+                    {
+                        hook_ptr_ = hook_ptr_->n_prev;
+                        return *this;
+                    }
+                    IntrusiveListIterator operator--(int)
+                    {
+                        auto tmp = *this;
+                        --(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const IntrusiveListIterator &other) const { return hook_ptr_ == other.hook_ptr_; }
+                    bool operator!=(const IntrusiveListIterator &other) const { return !(*this == other); }
+
+                protected:
+                    Hook *hook_ptr_ = nullptr;
+                    friend IntrusiveListIterator<T, Tag, true>;
+                    template <typename, typename>
+                    friend struct ListOrForwardlist::IntrusiveList;
+                };
+            }
+
+            /**
+             * @brief 侵入式双向链表：T 必须继承 ListHook<Tag>，链表只负责链接，不拥有、不分配也不析构元素。
+             *
+             * - 插入/删除都是 O(1) 的指针操作，没有内存分配，元素的地址在整个生命周期内不变；
+             * - 通过对象本身即可 O(1) 定位：iterator_to(obj) 得到迭代器，erase(obj) 直接摘下；
+             * - 元素在析构前必须先从链表中移除；链表析构或 clear() 时会把所有元素恢复为未挂接状态；
+             * - 一个挂钩同一时刻只能挂在一条链表上。
+             *
+             * 典型用法是 LRU：命中时 splice(begin(), *this, iterator_to(obj)) 把对象移到表头，淘汰时 pop_back()。
+             */
+            template <typename T, typename Tag = void>
+            struct IntrusiveList
+            {
+                using Hook = ListHook<Tag>;
+                static_assert(std::is_base_of_v<Hook, T>, "T must inherit ListHook<Tag>");
+
+                using value_type = T;
+                using reference = T &;
+                using const_reference = const T &;
+                using pointer = T *;
+                using const_pointer = const T *;
+                using iterator = detail::IntrusiveListIterator<T, Tag, false>;
+                using const_iterator = detail::IntrusiveListIterator<T, Tag, true>;
+                using reverse_iterator = std::reverse_iterator<iterator>;
+                using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+                using size_type = size_t;
+                using difference_type = std::ptrdiff_t;
+
+                IntrusiveList() { reset_header(); }
+                IntrusiveList(const IntrusiveList &) = delete;
+                IntrusiveList &operator=(const IntrusiveList &) = delete;
+                IntrusiveList(IntrusiveList &&other) noexcept : IntrusiveList() { swap(other); }
+                IntrusiveList &operator=(IntrusiveList &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        clear();
+                        swap(other);
+                    }
+                    return *this;
+                }
+                ~IntrusiveList() { clear(); }
+
+                iterator begin() { return iterator(header.n_next); }
+                const_iterator begin() const { return const_iterator(header.n_next); }
+                const_iterator cbegin() const { return begin(); }
+                iterator end() { return iterator(&header); }
+                const_iterator end() const { return const_iterator(&header); }
+                const_iterator cend() const { return end(); }
+                reverse_iterator rbegin() { return reverse_iterator(end()); }
+                const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+                reverse_iterator rend() { return reverse_iterator(begin()); }
+                const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+                size_type size() const { return size_r; }
+                bool empty() const { return size_r == 0; }
+
+                reference front() { return *begin(); }
+                const_reference front() const { return *begin(); }
+                reference back() { return *iterator(header.n_prev); }
+                const_reference back() const { return *const_iterator(header.n_prev); }
+
+                // 由对象本身得到指向它的迭代器，O(1)；对象必须挂在本链表上
+                static iterator iterator_to(reference obj) { return iterator(static_cast<Hook *>(&obj)); }
+                static const_iterator iterator_to(const_reference obj) { return const_iterator(static_cast<const Hook *>(&obj)); }
+
+                void push_front(reference obj) { insert(begin(), obj); }
+                void push_back(reference obj) { insert(end(), obj); }
+                void pop_front() { erase(begin()); }
+                void pop_back() { erase(iterator(header.n_prev)); }
+
+                // 把 obj 插入到 pos 之前，obj 必须未挂接
+                iterator insert(const_iterator pos, reference obj)
+                {
+                    Hook *h = static_cast<Hook *>(&obj);
+                    h->link(pos.hook_ptr_);
+                    ++size_r;
+                    return iterator(h);
+                }
+                iterator erase(const_iterator pos)
+                {
+                    Hook *h = pos.hook_ptr_, *next = h->n_next;
+                    h->unlink();
+                    --size_r;
+                    return iterator(next);
+                }
+                iterator erase(const_iterator first, const_iterator last)
+                {
+                    while (first != last)
+                        first = erase(first);
+                    return iterator(last.hook_ptr_);
+                }
+                // 通过对象本身 O(1) 摘下，返回原来的下一个位置
+                iterator erase(reference obj) { return erase(iterator_to(obj)); }
+                // 摘下后再对对象调用 disposer（例如 delete），用于链表实际上管理着元素生命周期的场合
+                template <typename Disposer>
+                iterator erase_and_dispose(const_iterator pos, Disposer disposer)
+                {
+                    T *obj = static_cast<T *>(pos.hook_ptr_);
+                    iterator res = erase(pos);
+                    disposer(obj);
+                    return res;
+                }
+                void clear()
+                {
+                    clear_and_dispose([](T *) {});
+                }
+                template <typename Disposer>
+                void clear_and_dispose(Disposer disposer)
+                {
+                    Hook *p = header.n_next;
+                    while (p != &header)
+                    {
+                        Hook *next = p->n_next;
+                        p->n_next = p->n_prev = nullptr;
+                        disposer(static_cast<T *>(p));
+                        p = next;
+                    }
+                    reset_header();
+                }
+
+                void swap(IntrusiveList &other)
+                {
+                    // 头节点嵌在容器里，交换时需要把首尾元素重新指向新的头节点
+                    Hook tmp;
+                    tmp.n_next = &tmp;
+                    tmp.n_prev = &tmp;
+                    move_chain(other.header, tmp);
+                    move_chain(header, other.header);
+                    move_chain(tmp, header);
+                    std::swap(size_r, other.size_r);
+                }
+                friend void swap(IntrusiveList &x, IntrusiveList &y) { x.swap(y); }
+
+                // 把 other 的全部元素移到 pos 之前
+                void splice(const_iterator pos, IntrusiveList &other)
+                {
+                    if (other.empty() || &other == this)
+                        return;
+                    transfer(pos.hook_ptr_, other.header.n_next, &other.header);
+                    size_r += other.size_r;
+                    other.size_r = 0;
+                }
+                void splice(const_iterator pos, IntrusiveList &&other) { splice(pos, other); }
+                // 把 other 中 it 指向的单个元素移到 pos 之前
+                void splice(const_iterator pos, IntrusiveList &other, const_iterator it)
+                {
+                    Hook *h = it.hook_ptr_;
+                    if (h == pos.hook_ptr_ || h->n_next == pos.hook_ptr_)
+                        return;
+                    transfer(pos.hook_ptr_, h, h->n_next);
+                    ++size_r;
+                    --other.size_r;
+                }
+                void splice(const_iterator pos, IntrusiveList &&other, const_iterator it) { splice(pos, other, it); }
+                // 把 other 中 [first, last) 移到 pos 之前；跨链表时需要 O(len) 计数
+                void splice(const_iterator pos, IntrusiveList &other, const_iterator first, const_iterator last)
+                {
+                    if (first == last)
+                        return;
+                    if (&other != this)
+                    {
+                        size_type len = size_type(std::distance(first, last));
+                        size_r += len;
+                        other.size_r -= len;
+                    }
+                    transfer(pos.hook_ptr_, first.hook_ptr_, last.hook_ptr_);
+                }
+                void splice(const_iterator pos, IntrusiveList &&other, const_iterator first, const_iterator last) { splice(pos, other, first, last); }
+
+                // 摘下所有满足 pred 的元素，返回摘下的个数
+                template <typename Pred>
+                size_type remove_if(Pred pred)
+                {
+                    size_type res = 0;
+                    for (auto it = begin(); it != end();)
+                    {
+                        if (pred(*it))
+                            it = erase(it), ++res;
+                        else
+                            ++it;
+                    }
+                    return res;
+                }
+                void reverse()
+                {
+                    Hook *p = &header;
+                    do
+                    {
+                        std::swap(p->n_next, p->n_prev);
+                        p = p->n_prev;
+                    } while (p != &header);
+                }
+
+            protected:
+                Hook header;
+                size_type size_r = 0;
+
+                void reset_header()
+                {
+                    header.n_next = header.n_prev = &header;
+                    size_r = 0;
+                }
+                // 把 [first, last) 这一段从原链表解开，接到 pos 之前
+                static void transfer(Hook *pos, Hook *first, Hook *last)
+                {
+                    Hook *prelast = last->n_prev;
+                    detail::unlink_range(first, prelast);
+                    detail::link_range(pos, first, prelast);
+                }
+                // 把以 from 为头的整条链挂到空的头节点 to 上，from 变为空
+                static void move_chain(Hook &from, Hook &to)
+                {
+                    if (from.n_next == &from)
+                    {
+                        to.n_next = to.n_prev = &to;
+                        return;
+                    }
+                    to.n_next = from.n_next;
+                    to.n_prev = from.n_prev;
+                    to.n_next->n_prev = &to;
+                    to.n_prev->n_next = &to;
+                    from.n_next = from.n_prev = &from;
+                }
+            };
+        }
+    }
+}
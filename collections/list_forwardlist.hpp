@@ -9,6 +9,12 @@
 #include <iostream>
 #include <exception>
 #include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../sorting/sorting.hpp"
+#include "../sorting/parallel_sorting.hpp"
+#include "list_link.hpp"
 namespace DSA
 {
     namespace Collections
@@ -17,7 +23,7 @@ namespace DSA
         {
             namespace detail
             {
-                template <typename T>
+                template <typename T, typename Alloc = std::allocator<T>>
                 struct ListBase;
 
                 template <typename T>
@@ -27,28 +33,15 @@ namespace DSA
                     ListNode *n_next = nullptr;
                     ListNode *n_prev = nullptr;
                     ListNode(const T &v = T{}) : value{v} {}
+                    // 用任意实参原地构造 value
+                    template <typename... Args>
+                    explicit ListNode(std::in_place_t, Args &&...args) : value(std::forward<Args>(args)...) {}
                     // 将当前节点（this）链接到节点p的前面
-                    void link(ListNode *p)
-                    {
-                        this->n_next = p;
-                        this->n_prev = p->n_prev;
-                        p->n_prev->n_next = this;
-                        p->n_prev = this;
-                    }
+                    void link(ListNode *p) { detail::link_before(this, p); }
                     // 将当前节点（this）链接到节点p的后面
-                    void link_back(ListNode *p)
-                    {
-                        this->n_prev = p;
-                        this->n_next = p->n_next;
-                        p->n_next->n_prev = this;
-                        p->n_next = this;
-                    }
+                    void link_back(ListNode *p) { detail::link_after(this, p); }
                     // 将当前节点从链表中解开
-                    void unlink()
-                    {
-                        this->n_prev->n_next = this->n_next;
-                        this->n_next->n_prev = this->n_prev;
-                    }
+                    void unlink() { detail::unlink(this); }
                 };
 
                 template <typename T>
@@ -105,7 +98,8 @@ namespace DSA
                 protected:
                     Node *node_ptr_;
 
-                    friend struct ListBase<T>;
+                    template <typename, typename>
+                    friend struct ListBase;
                 };
 
                 template <typename T>
@@ -154,10 +148,12 @@ namespace DSA
 
                 protected:
                     const Node *node_ptr_;
-                    friend struct ListBase<T>;
+                    template <typename, typename>
+                    friend struct ListBase;
                 };
                 // ListBase 封装了底层的节点管理和指针操作，与上层的 List 类实现关注点分离。
-                template <typename T>
+                // 节点通过 Alloc rebind 到 ListNode<T> 之后的分配器申请和释放。
+                template <typename T, typename Alloc>
                 struct ListBase
                 {
 
@@ -171,7 +167,11 @@ namespace DSA
                     using size_type = size_t;
                     using difference_type = std::ptrdiff_t;
                     using Node = ListNode<T>;
-                    ListBase()
+                    using allocator_type = Alloc;
+                    using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+                    using node_traits = std::allocator_traits<node_allocator_type>;
+                    ListBase() : ListBase(Alloc{}) {}
+                    explicit ListBase(const Alloc &a) : node_alloc(a)
                     {
                         // 使用一个哨兵节点（header）这个节点不存储实际数据，它的存在简化了边界条件的处理。
                         // 例如，插入和删除操作无需区分是在链表头部、尾部还是中部。
@@ -183,30 +183,58 @@ namespace DSA
                     {
                         if (begin_ptr() != end_ptr())
                         {
-                            destroyNodeInternal(begin_ptr(), end_ptr());
+                            if (release_pool())
+                            {
+                                // 整个池已作废，header 也在其中，需要重新申请一个
+                                header = createNodeInternal();
+                            }
+                            else
+                                destroyNodeInternal(begin_ptr(), end_ptr());
                             // 清空后，重置 header 节点的指针，恢复到空链表状态。
                             header->n_prev = header->n_next = header;
+                            size_r = 0;
                         }
                     }
                     // RAII：析构时自动清理所有节点内存。
                     ~ListBase()
                     {
-                        clear();
+                        if (release_pool())
+                            return;
+                        destroyNodeInternal(begin_ptr(), end_ptr());
                         destroyNodeInternal(end_ptr()); // 最后销毁 header 节点自身。
                     }
+                    allocator_type get_allocator() const { return allocator_type(node_alloc); }
 
                 protected:
                     Node *header;
+                    size_type size_r = 0;
+                    [[no_unique_address]] node_allocator_type node_alloc;
                     // begin_ptr() 指向第一个实际数据节点。
                     Node *&begin_ptr() { return header->n_next; }
                     Node *begin_ptr() const { return header->n_next; }
                     // end_ptr() 始终指向 header 节点。
                     Node *end_ptr() const { return header; }
-                    Node *createNodeInternal(const T &v = T{})
+                    // 在新节点中用实参原地构造值；没有实参时值初始化（header 使用）
+                    template <typename... Args>
+                    Node *createNodeInternal(Args &&...args)
+                    {
+                        Node *p = node_traits::allocate(node_alloc, 1);
+                        try
+                        {
+                            node_traits::construct(node_alloc, p, std::in_place, std::forward<Args>(args)...);
+                        }
+                        catch (...)
+                        {
+                            node_traits::deallocate(node_alloc, p, 1);
+                            throw;
+                        }
+                        return p;
+                    }
+                    void destroyNodeInternal(Node *p)
                     {
-                        return new Node{v};
+                        node_traits::destroy(node_alloc, p);
+                        node_traits::deallocate(node_alloc, p, 1);
                     }
-                    void destroyNodeInternal(Node *p) { delete p; }
                     void destroyNodeInternal(Node *first, Node *last)
                     {
                         for (Node *p = first; first != last; p = first)
@@ -218,28 +246,31 @@ namespace DSA
                     // 将 [first, prelast] 所代表的节点范围，链接到 pos 节点之前。
                     // 这是一个核心的 O(1) 操作，是 splice 的基础。
                     // note prelast=prev(last),last=next(prelast) ,that is ,[first,prelast]=[first,last)
-                    static void link_range(Node *pos, Node *first, Node *prelast)
-                    {
-                        first->n_prev = pos->n_prev;
-                        prelast->n_next = pos;
-                        pos->n_prev->n_next = first;
-                        pos->n_prev = prelast;
-                    }
-                    // 将 [first, prelast] 所代表的节点范围，链接到 pos 节点之后。
-                    static void link_range_back(Node *pos, Node *first, Node *prelast)
-                    {
-                        first->n_prev = pos;
-                        prelast->n_next = pos->n_next;
-                        pos->n_next->n_prev = prelast;
-                        pos->n_next = first;
-                    }
-                    // 将 [first, prelast] 所代表的节点范围从链表中解开。
-                    // 这同样是 O(1) 操作。
-                    static void unlink_range(Node *first, Node *prelast)
-                    {
-                        first->n_prev->n_next = prelast->n_next;
-                        prelast->n_next->n_prev = first->n_prev;
+                    /**
+                     * @brief 分配器提供 live_nodes() / release() 钩子（如 NodePoolAllocator）且池中只有本链表的节点时，
+                     * 先析构元素（平凡可析构时跳过），再把所有 slab 整块作废，不再逐个归还节点。
+                     * 成功时 header 也随之失效，返回 true。
+                     */
+                    bool release_pool()
+                    {
+                        if constexpr (requires(node_allocator_type &a) { a.live_nodes(); a.release(); })
+                        {
+                            if (node_alloc.live_nodes() != size_r + 1)
+                                return false;
+                            if constexpr (!std::is_trivially_destructible_v<T>)
+                                for (Node *p = begin_ptr(); p != end_ptr(); p = p->n_next)
+                                    node_traits::destroy(node_alloc, p);
+                            node_traits::destroy(node_alloc, header);
+                            node_alloc.release();
+                            return true;
+                        }
+                        else
+                            return false;
                     }
+                    // 链表拓扑操作与 ListHook 共用 list_link.hpp 中的实现
+                    static void link_range(Node *pos, Node *first, Node *prelast) { detail::link_range(pos, first, prelast); }
+                    static void link_range_back(Node *pos, Node *first, Node *prelast) { detail::link_range_back(pos, first, prelast); }
+                    static void unlink_range(Node *first, Node *prelast) { detail::unlink_range(first, prelast); }
                     // 辅助函数，用于从 const_iterator 中安全地获取底层的非 const 节点指针。
                     // 这是必需的，因为像 insert, erase 等修改操作通常以 const_iterator 作为参数。
                     static Node *getNode(const_iterator iter)
@@ -249,11 +280,12 @@ namespace DSA
                 };
             }
             // List 类继承自 ListBase，负责提供用户接口、管理大小和实现复杂算法。
-            template <typename T>
+            // Alloc 可以是 NodePoolAllocator，节点从连续的 slab 中切出；两个链表之间 splice / merge 要求分配器相等。
+            template <typename T, typename Alloc = std::allocator<T>>
             struct List final
-                : detail::ListBase<T>
+                : detail::ListBase<T, Alloc>
             { // types:
-                using Base = detail::ListBase<T>;
+                using Base = detail::ListBase<T, Alloc>;
                 using value_type = Base::value_type;
                 using reference = Base::reference;
                 using const_reference = Base::const_reference;
@@ -266,16 +298,20 @@ namespace DSA
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
                 using Node = Base::Node;
+                using allocator_type = Base::allocator_type;
+                using Base::get_allocator;
                 List() = default;
                 ~List() = default;
+                explicit List(const allocator_type &a)
+                    : detail::ListBase<T, Alloc>(a) {}
                 explicit List(const List &other)
-                    : detail::ListBase<T>()
+                    : detail::ListBase<T, Alloc>(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.get_allocator()))
                 {
                     for (const T &it : other)
                         push_back(it);
                 }
                 explicit List(List &&other)
-                    : detail::ListBase<T>()
+                    : detail::ListBase<T, Alloc>(other.get_allocator())
                 {
                     this->swap(other);
                 }
@@ -291,28 +327,28 @@ namespace DSA
                     this->swap(other);
                     return *this;
                 }
-                explicit List(size_type n, const T &v = T{})
-                    : detail::ListBase<T>()
+                explicit List(size_type n, const T &v = T{}, const allocator_type &a = allocator_type())
+                    : detail::ListBase<T, Alloc>(a)
                 {
                     for (; n > 0; --n)
                         push_back(v);
                 }
                 template <typename InputIt>
-                explicit List(InputIt first, InputIt last)
-                    : detail::ListBase<T>()
+                explicit List(InputIt first, InputIt last, const allocator_type &a = allocator_type())
+                    : detail::ListBase<T, Alloc>(a)
                 {
                     for (; first != last; ++first)
                         push_back(*first);
                 }
                 void assign(size_type n, const T &v)
                 {
-                    List tmp(n, v);
+                    List tmp(n, v, get_allocator());
                     this->swap(tmp);
                 }
                 template <typename InputIt>
                 void assign(InputIt first, InputIt last)
                 {
-                    List tmp(first, last);
+                    List tmp(first, last, get_allocator());
                     this->swap(tmp);
                 }
 
@@ -330,11 +366,7 @@ namespace DSA
                 const_reverse_iterator crend() const { return rend(); };
 
                 bool empty() const { return begin_ptr() == end_ptr(); }
-                void clear()
-                {
-                    size_r = 0;
-                    Base::clear();
-                }
+                void clear() { Base::clear(); }
                 size_type size() const { return size_r; }
                 reference front() { return begin_ptr()->value; }
                 const_reference front() const { return begin_ptr()->value; }
@@ -345,12 +377,22 @@ namespace DSA
                 {
                     return iterator{insert_pointer(getNode(pos), v)};
                 }
+                iterator insert(const_iterator pos, T &&v)
+                {
+                    return iterator{insert_pointer(getNode(pos), std::move(v))};
+                }
+                // 在 pos 之前用实参原地构造一个元素
+                template <typename... Args>
+                iterator emplace(const_iterator pos, Args &&...args)
+                {
+                    return iterator{insert_pointer(getNode(pos), std::forward<Args>(args)...)};
+                }
                 // 同样是“拷贝并交换”（Copy-and-Swap）模式，强异常安全
                 iterator insert(const_iterator pos, size_type n, const T &v)
                 {
                     if (n)
                     {
-                        List tmp(n, v);
+                        List tmp(n, v, get_allocator());
                         iterator res = tmp.begin();
                         this->splice(pos, tmp);
                         return res;
@@ -362,7 +404,7 @@ namespace DSA
                 {
                     if (first != last)
                     {
-                        List tmp(first, last);
+                        List tmp(first, last, get_allocator());
                         iterator res = tmp.begin();
                         this->splice(pos, tmp);
                         return res;
@@ -377,8 +419,14 @@ namespace DSA
                     return iterator{getNode(last)};
                 }
                 void push_back(const T &v) { insert_pointer(end_ptr(), v); }
+                void push_back(T &&v) { insert_pointer(end_ptr(), std::move(v)); }
+                template <typename... Args>
+                reference emplace_back(Args &&...args) { return insert_pointer(end_ptr(), std::forward<Args>(args)...)->value; }
                 void pop_back() { erase_pointer(end_ptr()->n_prev); }
                 void push_front(const T &v) { insert_pointer(begin_ptr(), v); }
+                void push_front(T &&v) { insert_pointer(begin_ptr(), std::move(v)); }
+                template <typename... Args>
+                reference emplace_front(Args &&...args) { return insert_pointer(begin_ptr(), std::forward<Args>(args)...)->value; }
                 void pop_front() { erase_pointer(end_ptr()->n_next); }
                 void splice(const_iterator pos, List &other)
                 {
@@ -409,12 +457,14 @@ namespace DSA
                     if (new_size > size_r)
                         insert(end(), new_size - size_r, T{});
                 }
-                // swap 实现为 O(1) 操作，仅交换 header 指针和 size 成员。
+                // swap 实现为 O(1) 操作，仅交换 header 指针和 size 成员（以及按 propagate_on_container_swap 交换分配器）。
                 void swap(List &other)
                 {
                     using std::swap;
                     swap(this->header, other.header);
                     swap(this->size_r, other.size_r);
+                    if constexpr (Base::node_traits::propagate_on_container_swap::value)
+                        swap(this->node_alloc, other.node_alloc);
                 }
                 template <typename Compare>
                 void merge(List &other, Compare comp)
@@ -424,7 +474,7 @@ namespace DSA
                         if (this->empty())
                             this->swap(other);
                         else
-                            merge_range(this->begin(), std::prev(this->end()), other.begin(), std::prev(other.end()), this->size_r, other.size_r);
+                            merge_range(this->begin(), std::prev(this->end()), other.begin(), std::prev(other.end()), this->size_r, other.size_r, comp);
                     }
                 }
                 template <typename Compare>
@@ -438,7 +488,7 @@ namespace DSA
                 // 最后 to_remove 析构时，所有被移除的节点被一次性销毁。
                 size_type remove(const T &v)
                 {
-                    List to_remove{};
+                    List to_remove(get_allocator());
                     for (iterator i = begin(), ed = end(); i != ed;)
                     {
                         if (*i == v)
@@ -459,7 +509,7 @@ namespace DSA
                 size_type remove_if(UnaryPredicate pred)
                 {
 
-                    List to_remove{};
+                    List to_remove(get_allocator());
                     // 外层循环负责遍历。增量操作在循环体内手动控制。
                     for (iterator i = begin(), ed = end(); i != ed;)
                     {
@@ -504,7 +554,7 @@ namespace DSA
                 size_type unique(BinaryPredicate pred)
                 {
 
-                    List to_remove{};
+                    List to_remove(get_allocator());
                     for (iterator i = begin(), ed = end(); i != ed;)
                     {
                         iterator j = std::next(i);
@@ -522,9 +572,43 @@ namespace DSA
                 {
                     return unique(std::equal_to<T>{});
                 }
-                // 采用非递归的自底向上归并排序。是链表排序的最高效算法之一。
+                // 值能与节点指针一起收集到数组里（平凡可拷贝且不超过 16 字节）时，比较不需要访问节点
+                static constexpr bool gather_inline_keys = std::is_trivially_copyable_v<T> && sizeof(T) <= 16;
+                // 节点数不少于该值时，sort 改用“收集-排序-重新链接”（gather_sort）。
+                // 只收集指针时每次比较仍要解引用节点，收益要到很长的链表才超过收集的开销
+                static constexpr size_type gather_sort_threshold = gather_inline_keys ? 64 : size_type(1) << 17;
+                /**
+                 * @brief 稳定排序，不移动元素，只重新链接节点，迭代器保持有效。
+                 * 短链表用原地的自底向上归并排序；长链表把节点指针收集到连续数组中排好再一次性重新链接，
+                 * 比较时不再沿着指针在堆中跳来跳去。
+                 */
                 template <typename Compare>
                 void sort(Compare comp)
+                {
+                    if (size_r >= gather_sort_threshold)
+                        gather_sort(comp, nullptr);
+                    else
+                        merge_sort(comp);
+                }
+                void sort()
+                {
+                    sort(std::less<T>{});
+                }
+                // 与 sort 相同，但数组排序由调度器 s 上的 Sorting::ParallelMergeSort 完成
+                template <typename Compare>
+                void parallel_sort(Compare comp, Parallel::Scheduler &s = Parallel::default_scheduler())
+                {
+                    if (size_r >= gather_sort_threshold)
+                        gather_sort(comp, &s);
+                    else
+                        merge_sort(comp);
+                }
+                void parallel_sort() { parallel_sort(std::less<T>{}); }
+
+            protected:
+                // 采用非递归的自底向上归并排序。是链表排序的最高效算法之一。
+                template <typename Compare>
+                void merge_sort(Compare comp)
                 {
                     // 1. 准备一个大小为机器字长位数的数组，用于存放已排序的子链表。
                     //    sorted_ranges[i] 理论上存放长度为 2^i 的子链表。
@@ -545,7 +629,7 @@ namespace DSA
                             }
                             // 3b. 如果槽位不为空，将槽内的子链表与 carry 合并。
                             iterator first_anchor = std::prev(sorted_ranges[i].first);
-                            merge_range(sorted_ranges[i].first, sorted_ranges[i].second, carry.first, carry.second);
+                            merge_range(sorted_ranges[i].first, sorted_ranges[i].second, carry.first, carry.second, comp);
                             // 合并后的结果成为新的 carry，继续向上层槽位尝试。
                             carry.first = std::next(first_anchor);
                             carry.second = std::prev(it);
@@ -563,20 +647,80 @@ namespace DSA
                             }
 
                             iterator first_anchor = std::prev(sorted_ranges[i].first);
-                            merge_range(sorted_ranges[i].first, sorted_ranges[i].second, carry.first, carry.second);
+                            merge_range(sorted_ranges[i].first, sorted_ranges[i].second, carry.first, carry.second, comp);
                             carry.first = std::next(first_anchor);
                             carry.second = std::prev(this->end());
                             sorted_ranges[i] = empty_range;
                         }
                     return;
                 }
-                void sort()
+                /**
+                 * @brief 收集-排序-重新链接：
+                 * - 值是不超过 16 字节的平凡可拷贝类型时，把 (值, 节点指针) 对收集到数组里，比较不必访问节点；
+                 *   其中整数按 std::less 排序时直接用 RadixSortLSD；
+                 * - 否则只收集节点指针，比较时解引用；
+                 * 数组用库里的稳定排序（MergeSort，或 s 非空时 ParallelMergeSort）排好，最后一遍重新链接所有节点。
+                 * 比较器抛出异常时链表保持原样。
+                 */
+                template <typename Compare>
+                void gather_sort(Compare comp, Parallel::Scheduler *s)
+                {
+                    constexpr bool radix = std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                           (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>);
+                    if constexpr (gather_inline_keys)
+                    {
+                        using Entry = std::pair<T, Node *>;
+                        std::vector<Entry> a;
+                        a.reserve(size_r);
+                        for (Node *p = begin_ptr(); p != end_ptr(); p = p->n_next)
+                            a.emplace_back(p->value, p);
+                        auto cmp = [&comp](const Entry &x, const Entry &y)
+                        { return comp(x.first, y.first); };
+                        if (s)
+                            Sorting::ParallelMergeSort(a.begin(), a.end(), cmp, *s);
+                        else if constexpr (radix)
+                        {
+                            Sorting::PairKeyRadixAdapter<T> adapter{};
+                            Sorting::RadixSortLSD(a.begin(), a.end(), adapter);
+                        }
+                        else
+                            Sorting::MergeSort(a.begin(), a.end(), cmp);
+                        relink(a.begin(), a.end(), [](const Entry &e)
+                               { return e.second; });
+                    }
+                    else
+                    {
+                        std::vector<Node *> a;
+                        a.reserve(size_r);
+                        for (Node *p = begin_ptr(); p != end_ptr(); p = p->n_next)
+                            a.push_back(p);
+                        auto cmp = [&comp](const Node *x, const Node *y)
+                        { return comp(x->value, y->value); };
+                        if (s)
+                            Sorting::ParallelMergeSort(a.begin(), a.end(), cmp, *s);
+                        else
+                            Sorting::MergeSort(a.begin(), a.end(), cmp);
+                        relink(a.begin(), a.end(), [](Node *p)
+                               { return p; });
+                    }
+                }
+                // 按 [first, last) 的顺序把所有节点重新串成链表
+                template <typename It, typename GetNode>
+                void relink(It first, It last, GetNode get)
                 {
-                    sort(std::less<T>{});
+                    Node *prev = end_ptr();
+                    for (; first != last; ++first)
+                    {
+                        Node *p = get(*first);
+                        prev->n_next = p;
+                        p->n_prev = prev;
+                        prev = p;
+                    }
+                    prev->n_next = end_ptr();
+                    end_ptr()->n_prev = prev;
                 }
 
-            protected:
-                size_type size_r = 0;
+                using Base::size_r;
                 using Base::begin_ptr;
                 using Base::createNodeInternal;
                 using Base::destroyNodeInternal;
@@ -586,9 +730,10 @@ namespace DSA
                 using Base::link_range_back;
                 using Base::unlink_range;
 
-                Node *insert_pointer(Node *pos, const T &v)
+                template <typename... Args>
+                Node *insert_pointer(Node *pos, Args &&...args)
                 {
-                    Node *node = createNodeInternal(v);
+                    Node *node = createNodeInternal(std::forward<Args>(args)...);
                     node->link(pos);
                     ++size_r;
                     return node;
@@ -611,6 +756,7 @@ namespace DSA
                         destroyNodeInternal(p);
                         --size_r;
                     }
+                    return res;
                 }
                 void splice_pointer(Node *pos, List &other)
                 {
@@ -0,0 +1,66 @@
+#pragma once
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            namespace detail
+            {
+                // 双向循环链表的拓扑操作，只依赖 n_prev / n_next 成员，
+                // List 的节点（ListNode）和侵入式链表的挂钩（ListHook）共用同一份实现。
+
+                // 将 node 链接到 p 的前面
+                template <typename NodeType>
+                void link_before(NodeType *node, NodeType *p)
+                {
+                    node->n_next = p;
+                    node->n_prev = p->n_prev;
+                    p->n_prev->n_next = node;
+                    p->n_prev = node;
+                }
+                // 将 node 链接到 p 的后面
+                template <typename NodeType>
+                void link_after(NodeType *node, NodeType *p)
+                {
+                    node->n_prev = p;
+                    node->n_next = p->n_next;
+                    p->n_next->n_prev = node;
+                    p->n_next = node;
+                }
+                // 将 node 从链表中解开，node 自身的指针保持不变
+                template <typename NodeType>
+                void unlink(NodeType *node)
+                {
+                    node->n_prev->n_next = node->n_next;
+                    node->n_next->n_prev = node->n_prev;
+                }
+                // 将 [first, prelast] 所代表的节点范围，链接到 pos 节点之前。
+                template <typename NodeType>
+                void link_range(NodeType *pos, NodeType *first, NodeType *prelast)
+                {
+                    first->n_prev = pos->n_prev;
+                    prelast->n_next = pos;
+                    pos->n_prev->n_next = first;
+                    pos->n_prev = prelast;
+                }
+                // 将 [first, prelast] 所代表的节点范围，链接到 pos 节点之后。
+                template <typename NodeType>
+                void link_range_back(NodeType *pos, NodeType *first, NodeType *prelast)
+                {
+                    first->n_prev = pos;
+                    prelast->n_next = pos->n_next;
+                    pos->n_next->n_prev = prelast;
+                    pos->n_next = first;
+                }
+                // 将 [first, prelast] 所代表的节点范围从链表中解开，O(1)。
+                template <typename NodeType>
+                void unlink_range(NodeType *first, NodeType *prelast)
+                {
+                    first->n_prev->n_next = prelast->n_next;
+                    prelast->n_next->n_prev = first->n_prev;
+                }
+            }
+        }
+    }
+}
@@ -9,9 +9,13 @@
 #include <iostream>
 #include <memory>
 #include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include "../tree/binary_tree/binary_tree_basic.hpp"
 #include "../tree/binary_tree/binary_search_tree/AVL_balanced_tree.hpp"
 #include "../tree/binary_tree/binary_search_tree/RB_balanced_tree.hpp"
+#include "../tree/b_tree/bplus_tree.hpp"
 #include "../utils.hpp"
 namespace DSA
 {
@@ -22,7 +26,17 @@ namespace DSA
             using DSA::Tree::BinaryTree::BinarySearchTree::BinarySearchTreeLinked;
             using DSA::Tree::BinaryTree::BinarySearchTree::AVLTree::AVLTreeLinked;
             using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::RBTreeLinked;
+            using DSA::Tree::BinaryTree::BinarySearchTree::AVLTree::OrderStatisticAVLTreeLinked;
+            using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::OrderStatisticRBTreeLinked;
+            using DSA::Tree::BinaryTree::BinarySearchTree::AVLTree::AggregateAVLTree;
+            using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::AggregateRBTree;
+            using DSA::Tree::BTree::BPlusTree;
+            using DSA::Tree::BinaryTree::BinarySearchTree::MaxMonoid;
+            using DSA::Tree::BinaryTree::BinarySearchTree::MinMonoid;
+            using DSA::Tree::BinaryTree::BinarySearchTree::SumMonoid;
             using DSA::Utils::Select1stKeyOfValue;
+            template <typename Key, typename T, typename Compare, template <typename, typename, typename, typename> class Implement>
+            struct MultiMap;
             template <typename Key, typename T, typename Compare = std::less<Key>, template <typename, typename, typename, typename> class Implement = RBTreeLinked>
             struct Map final
             {
@@ -40,6 +54,14 @@ namespace DSA
                 using const_iterator = Base::const_iterator;
                 using iterator = Base::iterator;
                 using difference_type = Base::difference_type;
+                // 节点句柄：extract 摘下的节点，可以不分配、不拷贝地插回同类型的容器
+                using node_type = Base::node_type;
+                struct insert_return_type
+                {
+                    iterator position;
+                    bool inserted;
+                    node_type node;
+                };
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
                 struct value_compare
@@ -60,8 +82,11 @@ namespace DSA
                 Map() = default;
                 explicit Map(const key_compare &comp) : impl{comp} {};
                 Map(const Map &m): impl(m.impl) {}
+                // 区间构造：输入已按键有序时O(N)自底向上批量建成平衡树，否则先稳定排序；等价键保留先出现的元素
+                template <std::input_iterator InputIt>
+                Map(InputIt first, InputIt last, const key_compare &comp = key_compare{}) : impl{comp} { impl.assign_unique(first, last); }
                 ~Map() = default;
-                Map &operator=(const Map &m) { impl = m.impl; }
+                Map &operator=(const Map &m) { impl = m.impl; return *this; }
 
                 // iterators:
                 iterator begin() { return impl.begin(); }
@@ -84,11 +109,66 @@ namespace DSA
                 size_type size() const { return impl.size(); }
 
                 std::pair<iterator, bool> insert(const value_type &v) { return impl.insert_unique(v); }
+                std::pair<iterator, bool> insert(value_type &&v) { return impl.insert_unique(std::move(v)); }
+                template <typename... Args>
+                std::pair<iterator, bool> emplace(Args &&...args) { return impl.emplace_unique(std::forward<Args>(args)...); }
+                // 键不存在时才用 args 原地构造 mapped 值；键已存在时 args 不会被移动
+                template <typename... Args>
+                std::pair<iterator, bool> try_emplace(const key_type &k, Args &&...args)
+                {
+                    return impl.try_emplace_unique(k, std::piecewise_construct, std::forward_as_tuple(k), std::forward_as_tuple(std::forward<Args>(args)...));
+                }
+                template <typename... Args>
+                std::pair<iterator, bool> try_emplace(key_type &&k, Args &&...args)
+                {
+                    // 查找只用到 k 的引用，之后才把 k 移动进新节点
+                    return impl.try_emplace_unique(k, std::piecewise_construct, std::forward_as_tuple(std::move(k)), std::forward_as_tuple(std::forward<Args>(args)...));
+                }
+                template <typename M>
+                std::pair<iterator, bool> insert_or_assign(const key_type &k, M &&obj)
+                {
+                    auto res = try_emplace(k, std::forward<M>(obj));
+                    if (!res.second)
+                    {
+                        res.first->second = std::forward<M>(obj);
+                        impl.refresh(res.first);
+                    }
+                    return res;
+                }
+                template <typename M>
+                std::pair<iterator, bool> insert_or_assign(key_type &&k, M &&obj)
+                {
+                    auto res = try_emplace(std::move(k), std::forward<M>(obj));
+                    if (!res.second)
+                    {
+                        res.first->second = std::forward<M>(obj);
+                        impl.refresh(res.first);
+                    }
+                    return res;
+                }
 
-                iterator erase(const_iterator position) { return impl.erase_unique(position); }
+                iterator erase(const_iterator position) { return impl.erase(position); }
+                node_type extract(const_iterator position) { return impl.extract(position); }
+                node_type extract(const key_type &k) { return impl.extract_unique(k); }
+                insert_return_type insert(node_type &&nh)
+                {
+                    auto res = impl.insert_unique(std::move(nh));
+                    return {res.position, res.inserted, std::move(res.node)};
+                }
+                // 把other中键在本容器中不存在的节点转移过来，不分配、不拷贝；重复键的元素留在other中
+                void merge(Map &other) { impl.merge_unique(other.impl); }
+                void merge(Map &&other) { merge(other); }
+                void merge(MultiMap<Key, T, Compare, Implement> &other) { impl.merge_unique(other.impl); }
+                void merge(MultiMap<Key, T, Compare, Implement> &&other) { merge(other); }
                 size_type erase(const key_type &k) { return impl.erase_unique(k); }
                 // iterator erase(const_iterator first, const_iterator last);
                 void clear() { impl.clear(); }
+                // 用区间[first, last)替换全部内容，规则与区间构造相同
+                template <std::input_iterator InputIt>
+                void assign(InputIt first, InputIt last) { impl.assign_unique(first, last); }
+                // 同上，但由调用者保证区间已按键有序，O(N)
+                template <std::input_iterator InputIt>
+                void assign_sorted(InputIt first, InputIt last) { impl.assign_sorted_unique(first, last); }
 
                 void swap(Map &m)
                 {
@@ -105,10 +185,47 @@ namespace DSA
                 const_iterator find(const key_type &k) const { return impl.find(k); };
                 size_type count(const key_type &k) const { return impl.count_unique(k); };
 
-                T &operator[](const key_type &k)
+                // 维护子树聚合的Implement上，mapped值一变聚合就要重算，所以operator[]返回代理：
+                // 读取得到const引用，赋值（以及+=、-=）写入后自动refresh；其余Implement直接返回T&
+                static constexpr bool aggregate_augmented = requires(const Base &b, const key_type &k) { b.aggregate(k, k); };
+                class mapped_reference
                 {
-                    return impl.insert_unique(value_type{k, T{}}).first->second;
-                }
+                public:
+                    operator const T &() const { return it->second; }
+                    const T &get() const { return it->second; }
+                    template <typename M>
+                    mapped_reference &operator=(M &&obj)
+                    {
+                        it->second = std::forward<M>(obj);
+                        m->impl.refresh(it);
+                        return *this;
+                    }
+                    // m[a] = m[b] 赋的是值，不是让代理改指向
+                    mapped_reference &operator=(const mapped_reference &other) { return *this = other.get(); }
+                    template <typename M>
+                    mapped_reference &operator+=(M &&obj)
+                    {
+                        it->second += std::forward<M>(obj);
+                        m->impl.refresh(it);
+                        return *this;
+                    }
+                    template <typename M>
+                    mapped_reference &operator-=(M &&obj)
+                    {
+                        it->second -= std::forward<M>(obj);
+                        m->impl.refresh(it);
+                        return *this;
+                    }
+
+                private:
+                    friend struct Map;
+                    mapped_reference(Map *map, iterator pos) : m(map), it(pos) {}
+                    Map *m;
+                    iterator it;
+                };
+                using subscript_reference = std::conditional_t<aggregate_augmented, mapped_reference, T &>;
+                subscript_reference operator[](const key_type &k) { return subscript(try_emplace(k).first); }
+                subscript_reference operator[](key_type &&k) { return subscript(try_emplace(std::move(k)).first); }
                 T &at(const key_type &k)
                 {
                     iterator res = impl.find(k);
@@ -123,9 +240,6 @@ namespace DSA
                         throw std::out_of_range("Map::at");
                     return (*res).second;
                 }
-                // template<typename VT>
-                // std::pair<iterator,bool> insert_or_assign(const key_type&k,VT&& v);
-
                 // bool contains(const key_type &x) const; // C++20
                 // template <class K>
                 // bool contains(const K &x) const; // C++20
@@ -138,10 +252,34 @@ namespace DSA
                 std::pair<iterator, iterator> equal_range(const key_type &k) { return impl.equal_range_unique(k); }
                 std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const { return impl.equal_range_unique(k); }
 
+                // 顺序统计：要求Implement维护子树大小（如OrderStatisticRBTreeLinked），均为O(logN)
+                // 键小于k的元素个数
+                size_type rank(const key_type &k) const { return impl.rank(k); }
+                // 第i个（从0开始）元素，越界时返回end()
+                iterator select(size_type i) { return impl.select(i); }
+                const_iterator select(size_type i) const { return impl.select(i); }
+                size_type index_of(const_iterator pos) const { return impl.index_of(pos); }
+                difference_type distance(const_iterator first, const_iterator last) const { return impl.distance(first, last); }
+
+                // 区间聚合：要求Implement维护子树聚合（如AggregateRBTree<SumMonoid<T>>::Linked），
+                // 返回键在[lo, hi)中的mapped值按键序合并的结果，O(logN)
+                auto aggregate(const key_type &lo, const key_type &hi) const { return impl.aggregate(lo, hi); }
+                // 通过迭代器直接修改mapped值后，调用refresh让聚合重新生效（insert_or_assign和operator[]赋值会自动处理）
+                void refresh(const_iterator pos) { impl.refresh(pos); }
+
                 bool checker() { return impl.checker_unique(); }
 
             protected:
+                friend struct MultiMap<Key, T, Compare, Implement>;
                 Base impl;
+
+                subscript_reference subscript(iterator pos)
+                {
+                    if constexpr (aggregate_augmented)
+                        return mapped_reference(this, pos);
+                    else
+                        return pos->second;
+                }
             };
             template <typename Key, typename T, typename Compare = std::less<Key>, template <typename, typename, typename, typename> class Implement = RBTreeLinked>
             struct MultiMap final
@@ -160,6 +298,7 @@ namespace DSA
                 using const_iterator = Base::const_iterator;
                 using iterator = Base::iterator;
                 using difference_type = Base::difference_type;
+                using node_type = Base::node_type;
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
                 struct value_compare
@@ -179,10 +318,13 @@ namespace DSA
                 };
                 MultiMap() = default;
                 explicit MultiMap(const key_compare &comp) : impl{comp} {};
-                MultiMap(const MultiMap &m) :impl(m.impe) {}
+                MultiMap(const MultiMap &m) : impl(m.impl) {}
+                // 区间构造：输入已按键有序时O(N)自底向上批量建成平衡树，否则先稳定排序；等价键保持输入中的先后次序
+                template <std::input_iterator InputIt>
+                MultiMap(InputIt first, InputIt last, const key_compare &comp = key_compare{}) : impl{comp} { impl.assign_multi(first, last); }
                 ~MultiMap() = default;
 
-                MultiMap &operator=(const MultiMap &m){impl=m.impl;}
+                MultiMap &operator=(const MultiMap &m) { impl = m.impl; return *this; }
 
                 // iterators:
                 iterator begin() { return impl.begin(); }
@@ -205,11 +347,29 @@ namespace DSA
                 size_type size() const { return impl.size(); }
 
                 iterator insert(const value_type &v) { return impl.insert_multi(v); }
-
-                iterator erase(const_iterator position) { return impl.erase_multi(position); }
+                iterator insert(value_type &&v) { return impl.insert_multi(std::move(v)); }
+                template <typename... Args>
+                iterator emplace(Args &&...args) { return impl.emplace_multi(std::forward<Args>(args)...); }
+
+                iterator erase(const_iterator position) { return impl.erase(position); }
+                node_type extract(const_iterator position) { return impl.extract(position); }
+                // 摘下第一个键等价于k的元素
+                node_type extract(const key_type &k) { return impl.extract_multi(k); }
+                iterator insert(node_type &&nh) { return impl.insert_multi(std::move(nh)); }
+                // 把other的全部节点转移过来，不分配、不拷贝
+                void merge(MultiMap &other) { impl.merge_multi(other.impl); }
+                void merge(MultiMap &&other) { merge(other); }
+                void merge(Map<Key, T, Compare, Implement> &other) { impl.merge_multi(other.impl); }
+                void merge(Map<Key, T, Compare, Implement> &&other) { merge(other); }
                 size_type erase(const key_type &k) { return impl.erase_multi(k); }
                 // iterator erase(const_iterator first, const_iterator last);
                 void clear() { impl.clear(); }
+                // 用区间[first, last)替换全部内容，规则与区间构造相同
+                template <std::input_iterator InputIt>
+                void assign(InputIt first, InputIt last) { impl.assign_multi(first, last); }
+                // 同上，但由调用者保证区间已按键有序，O(N)
+                template <std::input_iterator InputIt>
+                void assign_sorted(InputIt first, InputIt last) { impl.assign_sorted_multi(first, last); }
 
                 void swap(MultiMap &m)
                 {
@@ -238,9 +398,25 @@ namespace DSA
                 std::pair<iterator, iterator> equal_range(const key_type &k) { return impl.equal_range_multi(k); }
                 std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const { return impl.equal_range_multi(k); }
 
+                // 顺序统计：要求Implement维护子树大小（如OrderStatisticRBTreeLinked），均为O(logN)
+                // 键小于k的元素个数
+                size_type rank(const key_type &k) const { return impl.rank(k); }
+                // 第i个（从0开始）元素，越界时返回end()
+                iterator select(size_type i) { return impl.select(i); }
+                const_iterator select(size_type i) const { return impl.select(i); }
+                size_type index_of(const_iterator pos) const { return impl.index_of(pos); }
+                difference_type distance(const_iterator first, const_iterator last) const { return impl.distance(first, last); }
+
+                // 区间聚合：要求Implement维护子树聚合（如AggregateRBTree<SumMonoid<T>>::Linked），
+                // 返回键在[lo, hi)中的mapped值按键序合并的结果，O(logN)
+                auto aggregate(const key_type &lo, const key_type &hi) const { return impl.aggregate(lo, hi); }
+                // 通过迭代器直接修改mapped值后，调用refresh让聚合重新生效
+                void refresh(const_iterator pos) { impl.refresh(pos); }
+
                 bool checker() { return impl.checker_multi(); }
 
             protected:
+                friend struct Map<Key, T, Compare, Implement>;
                 Base impl;
             };
 
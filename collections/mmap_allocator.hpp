@@ -0,0 +1,203 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            // mmap 分配的可选行为
+            struct MmapOptions
+            {
+                bool huge_pages = false; // madvise(MADV_HUGEPAGE)，让内核尽量用透明大页，减少 TLB miss
+                bool populate = false;   // MAP_POPULATE，映射时就把所有页调入，省去之后逐页缺页
+            };
+            namespace detail
+            {
+                inline size_t page_size()
+                {
+                    static const size_t size = size_t(::sysconf(_SC_PAGESIZE));
+                    return size;
+                }
+                inline size_t round_to_page(size_t bytes)
+                {
+                    size_t page = page_size();
+                    return (bytes + page - 1) / page * page;
+                }
+                // 持有一个已打开的文件，所有共享同一文件的分配器拷贝都指向同一个 MmapFile
+                struct MmapFile
+                {
+                    int fd = -1;
+                    explicit MmapFile(const std::string &path)
+                    {
+                        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+                        if (fd < 0)
+                            throw std::system_error(errno, std::generic_category(), "MmapAllocator: cannot open " + path);
+                    }
+                    ~MmapFile()
+                    {
+                        if (fd >= 0)
+                            ::close(fd);
+                    }
+                    MmapFile(const MmapFile &) = delete;
+                    MmapFile &operator=(const MmapFile &) = delete;
+                    size_t file_size() const
+                    {
+                        struct stat st;
+                        if (::fstat(fd, &st) != 0)
+                            throw std::system_error(errno, std::generic_category(), "MmapAllocator: fstat");
+                        return size_t(st.st_size);
+                    }
+                    void resize(size_t bytes)
+                    {
+                        if (::ftruncate(fd, off_t(bytes)) != 0)
+                            throw std::system_error(errno, std::generic_category(), "MmapAllocator: ftruncate");
+                    }
+                    // 只在文件不够长时加长，已有内容不会被截断
+                    void reserve(size_t bytes)
+                    {
+                        if (file_size() < bytes)
+                            resize(bytes);
+                    }
+                };
+            }
+
+            /**
+             * @brief 用 mmap 直接向内核申请内存的分配器，面向 GB 级的超大数组。
+             *
+             * - 匿名模式（默认构造）：MAP_PRIVATE | MAP_ANONYMOUS，可选透明大页与预先调页；
+             * - 文件模式（以路径构造）：MAP_SHARED 映射到文件，数组内容直接写在文件里，
+             *   之后可以用 Vector(adopt_storage, alloc) 把文件重新映射回来，不拷贝任何元素。
+             *
+             * 它额外提供 reallocate(p, old_n, new_n)，Vector 检测到这个钩子后，扩容与 shrink_to_fit 不再“分配新内存、搬移、释放旧内存”，
+             * 而是直接 mremap：内核只改页表，不拷贝数据，与数组大小无关。
+             * 因为内存可能被整体挪到新地址，只支持平凡可拷贝的元素类型。
+             *
+             * 文件模式下同一时刻只应有一块缓冲区映射到该文件。分配只会加长文件，不会截断已有内容；
+             * Vector 析构时通过 persist(p, n) 钩子把文件截断为恰好 n 个有效元素，所以重新加载后的 size() 就是析构前的 size()。
+             */
+            template <typename T>
+            struct MmapAllocator
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "MmapAllocator only supports trivially copyable types");
+                using value_type = T;
+                using size_type = size_t;
+
+                std::shared_ptr<detail::MmapFile> file; // 为空表示匿名映射
+                MmapOptions options;
+
+                MmapAllocator() = default;
+                explicit MmapAllocator(MmapOptions opt) : options(opt) {}
+                explicit MmapAllocator(const std::string &path, MmapOptions opt = {})
+                    : file(std::make_shared<detail::MmapFile>(path)), options(opt) {}
+                template <typename U>
+                MmapAllocator(const MmapAllocator<U> &other) : file(other.file), options(other.options) {}
+
+                // 拷贝容器时得到匿名映射，避免两个容器写同一个文件
+                MmapAllocator select_on_container_copy_construction() const { return MmapAllocator(options); }
+
+                T *allocate(size_type n)
+                {
+                    size_t bytes = n * sizeof(T);
+                    if (file)
+                        file->reserve(bytes);
+                    return static_cast<T *>(map(bytes));
+                }
+                void deallocate(T *p, size_type n)
+                {
+                    // 文件模式只解除映射，内容保留在文件中
+                    ::munmap(p, mapped_bytes(n * sizeof(T)));
+                }
+                /**
+                 * @brief 把 p 处 old_n 个元素的映射调整为 new_n 个元素，内容保持不变，返回新地址。
+                 * Linux 上用 mremap(MREMAP_MAYMOVE) 完成，只修改页表；其他平台退化为映射新区域再拷贝。
+                 */
+                T *reallocate(T *p, size_type old_n, size_type new_n)
+                {
+                    size_t old_bytes = old_n * sizeof(T), new_bytes = new_n * sizeof(T);
+                    // 文件先变长再扩大映射；缩小时先缩映射再截断文件，避免访问文件末尾之外的页
+                    if (file && new_bytes > old_bytes)
+                        file->reserve(new_bytes);
+#if defined(__linux__)
+                    void *q = ::mremap(p, mapped_bytes(old_bytes), mapped_bytes(new_bytes), MREMAP_MAYMOVE);
+                    if (q == MAP_FAILED)
+                        throw std::bad_alloc();
+                    advise(q, mapped_bytes(new_bytes));
+#else
+                    void *q = p;
+                    if (mapped_bytes(new_bytes) != mapped_bytes(old_bytes))
+                    {
+                        q = map(new_bytes);
+                        if (!file)
+                            std::memcpy(q, p, std::min(old_bytes, new_bytes));
+                        ::munmap(p, mapped_bytes(old_bytes));
+                    }
+#endif
+                    if (file && new_bytes < old_bytes)
+                        file->resize(new_bytes);
+                    return static_cast<T *>(q);
+                }
+                /**
+                 * @brief 记录 p 处只有前 n 个元素有效：文件模式下把文件截断为 n 个元素，映射本身由之后的 deallocate 解除。
+                 * 在析构路径上调用，所以失败时不抛异常，文件保持原长度。
+                 */
+                void persist(T *, size_type n) noexcept
+                {
+                    if (file)
+                        (void)::ftruncate(file->fd, off_t(n * sizeof(T)));
+                }
+                /**
+                 * @brief 文件模式下映射文件的全部内容，返回起始地址和元素个数，供 Vector 的零拷贝重新加载使用。
+                 */
+                std::pair<T *, size_type> map_existing()
+                {
+                    if (!file)
+                        return {nullptr, 0};
+                    size_type n = file->file_size() / sizeof(T);
+                    if (!n)
+                        return {nullptr, 0};
+                    return {static_cast<T *>(map(n * sizeof(T))), n};
+                }
+
+                template <typename U>
+                bool operator==(const MmapAllocator<U> &other) const { return file == other.file; }
+
+            private:
+                static size_t mapped_bytes(size_t bytes) { return detail::round_to_page(std::max<size_t>(bytes, 1)); }
+                void advise(void *p, size_t len) const
+                {
+#if defined(MADV_HUGEPAGE)
+                    if (options.huge_pages)
+                        ::madvise(p, len, MADV_HUGEPAGE);
+#endif
+                }
+                void *map(size_t bytes) const
+                {
+                    int flags = file ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS);
+#if defined(MAP_POPULATE)
+                    if (options.populate)
+                        flags |= MAP_POPULATE;
+#endif
+                    void *p = ::mmap(nullptr, mapped_bytes(bytes), PROT_READ | PROT_WRITE, flags, file ? file->fd : -1, 0);
+                    if (p == MAP_FAILED)
+                        throw std::bad_alloc();
+                    advise(p, mapped_bytes(bytes));
+                    return p;
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+namespace DSA
+{
+    namespace Collections
+    {
+        /**
+         * @brief 定长节点内存池：从连续的大块（slab）中按顺序切出节点，释放的节点挂到空闲链表上供下次复用。
+         *
+         * - 节点大小在第一次分配时确定，之后大小或对齐不同的请求直接转给 operator new；
+         * - slab 的容量从 first_slab_nodes 个节点开始按两倍增长，单个 slab 不超过 max_slab_bytes；
+         * - 逐个申请的节点在内存中基本连续，遍历链表时缓存与预取都更有效，也省掉了每个节点一次 malloc；
+         * - release() 一次性作废所有节点，只保留最大的一个 slab 供之后继续切分，不再逐个归还。
+         *
+         * 不是线程安全的，同一个池只应在一个线程中使用。
+         */
+        class NodePool
+        {
+        public:
+            explicit NodePool(size_t first_slab_nodes = 64, size_t max_slab_bytes = size_t(1) << 20)
+                : next_slab_nodes(std::max<size_t>(first_slab_nodes, 1)), max_slab_bytes(max_slab_bytes) {}
+            ~NodePool()
+            {
+                for (auto &s : slabs)
+                    free_slab(s);
+            }
+            NodePool(const NodePool &) = delete;
+            NodePool &operator=(const NodePool &) = delete;
+
+            void *allocate(size_t size, size_t align)
+            {
+                if (!block_size)
+                {
+                    block_align = std::max(align, alignof(FreeNode));
+                    block_size = (std::max(size, sizeof(FreeNode)) + block_align - 1) / block_align * block_align;
+                }
+                if (!fits(size, align))
+                    return ::operator new(size, std::align_val_t(align));
+                ++live;
+                if (free_list)
+                    return std::exchange(free_list, free_list->next);
+                if (cursor == slab_end)
+                    add_slab();
+                void *p = cursor;
+                cursor += block_size;
+                return p;
+            }
+            void deallocate(void *p, size_t size, size_t align)
+            {
+                if (!fits(size, align))
+                {
+                    ::operator delete(p, std::align_val_t(align));
+                    return;
+                }
+                --live;
+                free_list = ::new (p) FreeNode{free_list};
+            }
+            /**
+             * @brief 作废池中所有节点（不调用任何析构函数），保留最大的 slab 从头重新切分，其余 slab 归还系统。
+             * 调用者必须保证之后不再访问任何已分配的节点。
+             */
+            void release()
+            {
+                if (slabs.empty())
+                    return;
+                Slab keep = slabs.back();
+                slabs.pop_back();
+                for (auto &s : slabs)
+                    free_slab(s);
+                slabs.assign(1, keep);
+                cursor = keep.data;
+                slab_end = keep.data + keep.nodes * block_size;
+                free_list = nullptr;
+                live = 0;
+            }
+            // 当前尚未归还的节点数
+            size_t live_nodes() const { return live; }
+            size_t slab_count() const { return slabs.size(); }
+            size_t node_size() const { return block_size; }
+
+        private:
+            struct FreeNode
+            {
+                FreeNode *next;
+            };
+            struct Slab
+            {
+                std::byte *data;
+                size_t nodes;
+            };
+            std::vector<Slab> slabs;
+            std::byte *cursor = nullptr, *slab_end = nullptr;
+            FreeNode *free_list = nullptr;
+            size_t block_size = 0, block_align = 0;
+            size_t live = 0;
+            size_t next_slab_nodes;
+            size_t max_slab_bytes;
+
+            bool fits(size_t size, size_t align) const
+            {
+                return size <= block_size && align <= block_align;
+            }
+            void add_slab()
+            {
+                size_t nodes = next_slab_nodes;
+                std::byte *data = static_cast<std::byte *>(::operator new(nodes * block_size, std::align_val_t(block_align)));
+                slabs.push_back({data, nodes});
+                cursor = data;
+                slab_end = data + nodes * block_size;
+                next_slab_nodes = std::max<size_t>(1, std::min(nodes * 2, max_slab_bytes / block_size));
+            }
+            void free_slab(const Slab &s) const
+            {
+                ::operator delete(s.data, std::align_val_t(block_align));
+            }
+        };
+
+        /**
+         * @brief 以 NodePool 为后端的分配器，供链表、树等基于节点的容器使用。
+         *
+         * 只有单个对象的分配走内存池，数组分配直接使用 operator new。
+         * 拷贝与 rebind 得到的分配器共享同一个池；拷贝构造容器时得到一个新池，
+         * 这样每个容器独占自己的池，clear() 才能通过 release() 整块释放。
+         * 两个容器之间 splice / merge 节点要求它们的分配器相等（共享同一个池）。
+         */
+        template <typename T>
+        struct NodePoolAllocator
+        {
+            using value_type = T;
+            using size_type = size_t;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            std::shared_ptr<NodePool> pool;
+
+            NodePoolAllocator() : pool(std::make_shared<NodePool>()) {}
+            explicit NodePoolAllocator(std::shared_ptr<NodePool> p) : pool(std::move(p)) {}
+            template <typename U>
+            NodePoolAllocator(const NodePoolAllocator<U> &other) : pool(other.pool) {}
+
+            NodePoolAllocator select_on_container_copy_construction() const { return NodePoolAllocator(); }
+
+            T *allocate(size_type n)
+            {
+                if (n == 1)
+                    return static_cast<T *>(pool->allocate(sizeof(T), alignof(T)));
+                return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+            }
+            void deallocate(T *p, size_type n)
+            {
+                if (n == 1)
+                    pool->deallocate(p, sizeof(T), alignof(T));
+                else
+                    ::operator delete(p, std::align_val_t(alignof(T)));
+            }
+            // 容器的整块释放钩子：池中存活的节点数恰好等于容器持有的节点数时，容器独占该池，可以直接 release()
+            size_type live_nodes() const { return pool->live_nodes(); }
+            void release() { pool->release(); }
+
+            template <typename U>
+            bool operator==(const NodePoolAllocator<U> &other) const { return pool == other.pool; }
+        };
+    }
+}
@@ -1,11 +1,14 @@
 #pragma once
-#include <queue>
 #include <vector>
+#include <utility>
+#include "deque.hpp"
+#include "ring_buffer.hpp"
 namespace DSA
 {
     namespace Collections
     {
-        template <class T, class Container = std::deque<T>>
+        // 默认以分段的 ArrayLike::Deque 作为底层容器：一端进一端出时块在两端之间循环复用，稳态下不再分配内存
+        template <class T, class Container = ArrayLike::Deque<T>>
         class Queue
         {
         public:
@@ -37,10 +40,22 @@ namespace DSA
             const_reference back() const { return c.back(); }
 
             void push(const value_type &v) { c.push_back(v); }
+            void push(value_type &&v) { c.push_back(std::move(v)); }
+            template <typename... Args>
+            decltype(auto) emplace(Args &&...args) { return c.emplace_back(std::forward<Args>(args)...); }
             void pop() { c.pop_front(); }
+            // 底层容器支持 reserve 时（如 RingBuffer）可以按已知的元素个数上界预先分配
+            void reserve(size_type n)
+                requires requires(container_type &c) { c.reserve(n); }
+            {
+                c.reserve(n);
+            }
 
-            void swap(queue &q) { std::swap(c, q.c); }
+            void swap(Queue &q) { std::swap(c, q.c); }
         };
+        // 以环形缓冲区为底层容器的队列：连续内存、按位与取模，适合 BFS 队列这类元素个数有上界的场合
+        template <class T>
+        using RingQueue = Queue<T, ArrayLike::RingBuffer<T>>;
 
         template <class T, class Container = std::vector<T>>
         class Stack
@@ -61,7 +76,7 @@ namespace DSA
 
             Stack(const Stack &q) = default;
 
-            stack &operator=(const Stack &q) = default;
+            Stack &operator=(const Stack &q) = default;
 
             explicit Stack(const container_type &_c) : c(_c) {}
 
@@ -0,0 +1,450 @@
+#pragma once
+#include <memory>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <bit>
+#include <string>
+#include <sstream>
+#include "vector.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            template <typename T, typename Alloc = std::allocator<T>>
+            struct RingBuffer;
+
+            namespace detail
+            {
+                /**
+                 * @brief RingBuffer 的随机访问迭代器，持有缓冲区起点、掩码和（未取模的）逻辑位置。
+                 */
+                template <typename T, bool IsConst>
+                struct RingIterator
+                {
+                    using value_type = T;
+                    using reference = std::conditional_t<IsConst, const T &, T &>;
+                    using pointer = std::conditional_t<IsConst, const T *, T *>;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::random_access_iterator_tag;
+
+                    RingIterator() = default;
+                    RingIterator(T *b, size_t m, size_t p) : buf(b), mask(m), pos(p) {}
+                    // 允许从可变迭代器构造常量迭代器
+                    template <bool FromConst = IsConst>
+                        requires FromConst
+                    RingIterator(const RingIterator<T, false> &other) : buf(other.buf), mask(other.mask), pos(other.pos)
+                    {
+                    }
+
+                    reference operator*() const { return buf[pos & mask]; }
+                    pointer operator->() const { return &buf[pos & mask]; }
+                    reference operator[](difference_type n) const { return buf[(pos + n) & mask]; }
+
+                    RingIterator &operator++()
+                    {
+                        ++pos;
+                        return *this;
+                    }
+                    RingIterator operator++(int)
+                    {
+                        auto tmp = *this;
+                        ++pos;
+                        return tmp;
+                    }
+                    RingIterator &operator--()
+                    {
+                        --pos;
+                        return *this;
+                    }
+                    RingIterator operator--(int)
+                    {
+                        auto tmp = *this;
+                        --pos;
+                        return tmp;
+                    }
+                    RingIterator &operator+=(difference_type n)
+                    {
+                        pos += n;
+                        return *this;
+                    }
+                    RingIterator &operator-=(difference_type n)
+                    {
+                        pos -= n;
+                        return *this;
+                    }
+                    friend RingIterator operator+(RingIterator it, difference_type n) { return it += n; }
+                    friend RingIterator operator+(difference_type n, RingIterator it) { return it += n; }
+                    friend RingIterator operator-(RingIterator it, difference_type n) { return it -= n; }
+                    friend difference_type operator-(const RingIterator &lhs, const RingIterator &rhs)
+                    {
+                        return difference_type(lhs.pos - rhs.pos);
+                    }
+                    bool operator==(const RingIterator &other) const { return pos == other.pos; }
+                    bool operator!=(const RingIterator &other) const { return pos != other.pos; }
+                    bool operator<(const RingIterator &other) const { return difference_type(pos - other.pos) < 0; }
+                    bool operator<=(const RingIterator &other) const { return difference_type(pos - other.pos) <= 0; }
+                    bool operator>(const RingIterator &other) const { return difference_type(pos - other.pos) > 0; }
+                    bool operator>=(const RingIterator &other) const { return difference_type(pos - other.pos) >= 0; }
+
+                protected:
+                    T *buf = nullptr;
+                    size_t mask = 0;
+                    size_t pos = 0;
+                    friend RingIterator<T, true>;
+                };
+            }
+
+            /**
+             * @brief 容量为 2 的幂、可增长的环形缓冲区，作为 Queue 的高吞吐底层容器。
+             *
+             * 元素存放在一整块连续内存中，第 i 个元素位于 (head + i) & mask，取模只是一次按位与。
+             * 与 Deque 相比没有中控数组的二级寻址，FIFO 循环时既不分配也不释放内存；
+             * 容量不够时翻倍，元素按两段连续区间重定位到新缓冲区的开头（可平凡重定位的类型直接 memcpy）。
+             *
+             * push_n / pop_n 按至多两段连续区间批量拷入/移出；reserve 可以提前按已知上界（如 BFS 的节点数）分配好。
+             * 与 Deque 不同，扩容会移动元素，扩容后指向元素的引用失效。
+             */
+            template <typename T, typename Alloc>
+            struct RingBuffer
+            {
+                using value_type = T;
+                using reference = T &;
+                using const_reference = const T &;
+                using pointer = T *;
+                using const_pointer = const T *;
+                using size_type = size_t;
+                using difference_type = std::ptrdiff_t;
+                using allocator_type = Alloc;
+                using traits = std::allocator_traits<allocator_type>;
+                using iterator = detail::RingIterator<T, false>;
+                using const_iterator = detail::RingIterator<T, true>;
+                // 元素可平凡重定位且移动不抛异常时，扩容用 memcpy 搬移
+                static constexpr bool relocatable = is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>;
+                static constexpr size_type min_capacity = 8;
+
+                RingBuffer() = default;
+                explicit RingBuffer(const allocator_type &a) : alloc(a) {}
+                // 预留至少 n 个元素的容量
+                explicit RingBuffer(size_type n, const allocator_type &a = allocator_type()) : alloc(a) { reserve(n); }
+                template <class InputIt>
+                    requires std::input_iterator<InputIt>
+                RingBuffer(InputIt first, InputIt last, const allocator_type &a = allocator_type()) : alloc(a)
+                {
+                    if constexpr (std::forward_iterator<InputIt>)
+                        reserve(size_type(std::distance(first, last)));
+                    for (; first != last; ++first)
+                        emplace_back(*first);
+                }
+                RingBuffer(std::initializer_list<T> il, const allocator_type &a = allocator_type()) : RingBuffer(il.begin(), il.end(), a) {}
+                RingBuffer(const RingBuffer &other)
+                    : RingBuffer(other, traits::select_on_container_copy_construction(other.alloc)) {}
+                RingBuffer(const RingBuffer &other, const allocator_type &a) : RingBuffer(other.begin(), other.end(), a) {}
+                RingBuffer(RingBuffer &&other) noexcept : alloc(std::move(other.alloc)) { steal(other); }
+                ~RingBuffer() { release(); }
+
+                RingBuffer &operator=(const RingBuffer &other)
+                {
+                    if (this == std::addressof(other))
+                        return *this;
+                    clear();
+                    if constexpr (traits::propagate_on_container_copy_assignment::value)
+                    {
+                        // 旧分配器分配的内存必须由旧分配器释放
+                        if (alloc != other.alloc)
+                            release();
+                        alloc = other.alloc;
+                    }
+                    reserve(other.size());
+                    for (const T &v : other)
+                        emplace_back(v);
+                    return *this;
+                }
+                RingBuffer &operator=(RingBuffer &&other) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value)
+                {
+                    if (this == std::addressof(other))
+                        return *this;
+                    if (traits::propagate_on_container_move_assignment::value || alloc == other.alloc)
+                    {
+                        release();
+                        if constexpr (traits::propagate_on_container_move_assignment::value)
+                            alloc = std::move(other.alloc);
+                        steal(other);
+                    }
+                    else
+                    {
+                        // 分配器不同且不传播，只能逐个移动元素
+                        clear();
+                        reserve(other.size());
+                        for (T &v : other)
+                            emplace_back(std::move(v));
+                    }
+                    return *this;
+                }
+
+                allocator_type get_allocator() const { return alloc; }
+                size_type size() const { return count; }
+                bool empty() const { return !count; }
+                size_type capacity() const { return cap; }
+
+                reference at(size_type index)
+                {
+                    check_index(index);
+                    return (*this)[index];
+                }
+                const_reference at(size_type index) const
+                {
+                    check_index(index);
+                    return (*this)[index];
+                }
+                reference operator[](size_type index) { return buf[(head + index) & mask()]; }
+                const_reference operator[](size_type index) const { return buf[(head + index) & mask()]; }
+                reference front() { return buf[head]; }
+                const_reference front() const { return buf[head]; }
+                reference back() { return (*this)[count - 1]; }
+                const_reference back() const { return (*this)[count - 1]; }
+
+                iterator begin() { return iterator{buf, mask(), head}; }
+                const_iterator begin() const { return const_iterator{buf, mask(), head}; }
+                iterator end() { return iterator{buf, mask(), head + count}; }
+                const_iterator end() const { return const_iterator{buf, mask(), head + count}; }
+                const_iterator cbegin() const { return begin(); }
+                const_iterator cend() const { return end(); }
+
+                // 容量取整到 2 的幂；只会扩大，不会缩小
+                void reserve(size_type least_cap)
+                {
+                    if (least_cap > cap)
+                        reallocate(std::bit_ceil(std::max(least_cap, min_capacity)));
+                }
+
+                template <typename... Args>
+                reference emplace_back(Args &&...args)
+                {
+                    if (count == cap)
+                        grow_for_one(std::forward<Args>(args)...);
+                    else
+                        traits::construct(alloc, buf + ((head + count) & mask()), std::forward<Args>(args)...);
+                    ++count;
+                    return back();
+                }
+                template <typename... Args>
+                reference emplace_front(Args &&...args)
+                {
+                    if (count == cap)
+                    {
+                        // 参数可能引用缓冲区中的元素，扩容前先构造出新值
+                        T tmp(std::forward<Args>(args)...);
+                        reserve(cap + 1);
+                        traits::construct(alloc, buf + ((head - 1) & mask()), std::move(tmp));
+                    }
+                    else
+                        traits::construct(alloc, buf + ((head - 1) & mask()), std::forward<Args>(args)...);
+                    size_type pos = (head - 1) & mask();
+                    head = pos;
+                    ++count;
+                    return front();
+                }
+                void push_back(const T &v) { emplace_back(v); }
+                void push_back(T &&v) { emplace_back(std::move(v)); }
+                void push_front(const T &v) { emplace_front(v); }
+                void push_front(T &&v) { emplace_front(std::move(v)); }
+                void pop_front()
+                {
+                    traits::destroy(alloc, buf + head);
+                    head = (head + 1) & mask();
+                    --count;
+                }
+                void pop_back()
+                {
+                    --count;
+                    traits::destroy(alloc, buf + ((head + count) & mask()));
+                }
+
+                /**
+                 * @brief 把 [src, src + n) 依次追加到队尾。
+                 * 写入位置最多分成两段连续区间（缓冲区末尾一段、开头一段），每段用一次 uninitialized_copy 完成。
+                 */
+                void push_n(const T *src, size_type n)
+                {
+                    reserve(count + n);
+                    size_type tail = (head + count) & mask();
+                    size_type first = std::min(n, cap - tail);
+                    std::uninitialized_copy_n(src, first, buf + tail);
+                    try
+                    {
+                        std::uninitialized_copy_n(src + first, n - first, buf);
+                    }
+                    catch (...)
+                    {
+                        std::destroy_n(buf + tail, first);
+                        throw;
+                    }
+                    count += n;
+                }
+                /**
+                 * @brief 从队首取出至多 n 个元素，移动赋值到 [dst, dst + k)，返回实际取出的个数 k。
+                 * 读取同样最多分两段连续区间。
+                 */
+                size_type pop_n(T *dst, size_type n)
+                {
+                    n = std::min(n, count);
+                    size_type first = std::min(n, cap - head);
+                    std::move(buf + head, buf + head + first, dst);
+                    std::move(buf, buf + (n - first), dst + first);
+                    std::destroy_n(buf + head, first);
+                    std::destroy_n(buf, n - first);
+                    head = (head + n) & mask();
+                    count -= n;
+                    return n;
+                }
+
+                void clear()
+                {
+                    size_type first = std::min(count, cap - head);
+                    std::destroy_n(buf + head, first);
+                    std::destroy_n(buf, count - first);
+                    head = count = 0;
+                }
+                // 分配器不随 swap 传播时，要求两个容器的分配器相等（与标准库相同）
+                void swap(RingBuffer &other) noexcept
+                {
+                    std::swap(buf, other.buf);
+                    std::swap(cap, other.cap);
+                    std::swap(head, other.head);
+                    std::swap(count, other.count);
+                    if constexpr (traits::propagate_on_container_swap::value)
+                        std::swap(alloc, other.alloc);
+                }
+                friend void swap(RingBuffer &lhs, RingBuffer &rhs) noexcept { lhs.swap(rhs); }
+                friend bool operator==(const RingBuffer &lhs, const RingBuffer &rhs)
+                {
+                    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+                }
+
+            protected:
+                T *buf = nullptr;
+                size_type cap = 0;   // 0 或 2 的幂
+                size_type head = 0;  // 队首所在的槽，总在 [0, cap) 内
+                size_type count = 0; // 元素个数
+                [[no_unique_address]] allocator_type alloc;
+
+                size_type mask() const { return cap - 1; }
+
+                // 缓冲区已满时先在新缓冲区里构造新元素（参数可能引用旧缓冲区中的元素），再搬移旧元素
+                template <typename... Args>
+                void grow_for_one(Args &&...args)
+                {
+                    size_type new_cap = cap ? cap * 2 : min_capacity;
+                    T *new_buf = traits::allocate(alloc, new_cap);
+                    try
+                    {
+                        traits::construct(alloc, new_buf + count, std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        traits::deallocate(alloc, new_buf, new_cap);
+                        throw;
+                    }
+                    try
+                    {
+                        relocate_to(new_buf, new_cap);
+                    }
+                    catch (...)
+                    {
+                        traits::destroy(alloc, new_buf + count);
+                        traits::deallocate(alloc, new_buf, new_cap);
+                        throw;
+                    }
+                }
+                void reallocate(size_type new_cap)
+                {
+                    T *new_buf = traits::allocate(alloc, new_cap);
+                    try
+                    {
+                        relocate_to(new_buf, new_cap);
+                    }
+                    catch (...)
+                    {
+                        traits::deallocate(alloc, new_buf, new_cap);
+                        throw;
+                    }
+                }
+                /**
+                 * @brief 把元素按两段连续区间搬到 new_buf 的开头并接管 new_buf。
+                 * 移动可能抛异常时改为拷贝；拷贝失败则销毁 new_buf 中已构造的元素并重新抛出，原缓冲区保持不变，new_buf 由调用者释放。
+                 */
+                void relocate_to(T *new_buf, size_type new_cap)
+                {
+                    size_type first = std::min(count, cap - head);
+                    if constexpr (relocatable)
+                    {
+                        if (first)
+                            std::memcpy(static_cast<void *>(new_buf), buf + head, first * sizeof(T));
+                        if (count - first)
+                            std::memcpy(static_cast<void *>(new_buf + first), buf, (count - first) * sizeof(T));
+                    }
+                    else
+                    {
+                        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                        {
+                            std::uninitialized_move_n(buf + head, first, new_buf);
+                            std::uninitialized_move_n(buf, count - first, new_buf + first);
+                        }
+                        else
+                        {
+                            std::uninitialized_copy_n(buf + head, first, new_buf);
+                            try
+                            {
+                                std::uninitialized_copy_n(buf, count - first, new_buf + first);
+                            }
+                            catch (...)
+                            {
+                                std::destroy_n(new_buf, first);
+                                throw;
+                            }
+                        }
+                        std::destroy_n(buf + head, first);
+                        std::destroy_n(buf, count - first);
+                    }
+                    if (buf)
+                        traits::deallocate(alloc, buf, cap);
+                    buf = new_buf;
+                    cap = new_cap;
+                    head = 0;
+                }
+                void release()
+                {
+                    clear();
+                    if (buf)
+                        traits::deallocate(alloc, buf, cap);
+                    buf = nullptr;
+                    cap = 0;
+                }
+                void steal(RingBuffer &other) noexcept
+                {
+                    buf = std::exchange(other.buf, nullptr);
+                    cap = std::exchange(other.cap, 0);
+                    head = std::exchange(other.head, 0);
+                    count = std::exchange(other.count, 0);
+                }
+                void check_index(size_type index) const
+                {
+                    if (index >= size())
+                    {
+                        std::ostringstream ss;
+                        ss << "RingBuffer::at(index): index (" << index << ") >= this->size() (" << size() << ") ";
+                        throw std::out_of_range(ss.str());
+                    }
+                }
+            };
+        }
+    }
+}
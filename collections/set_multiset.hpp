@@ -5,12 +5,14 @@
 #include <string>
 #include <sstream>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <random>
 #include <iostream>
 #include "../tree/binary_tree/binary_tree_basic.hpp"
 #include "../tree/binary_tree/binary_search_tree/AVL_balanced_tree.hpp"
 #include "../tree/binary_tree/binary_search_tree/RB_balanced_tree.hpp"
+#include "../tree/b_tree/bplus_tree.hpp"
 namespace DSA
 {
     namespace Collections
@@ -20,6 +22,11 @@ namespace DSA
             using DSA::Tree::BinaryTree::BinarySearchTree::BinarySearchTreeLinked;
             using DSA::Tree::BinaryTree::BinarySearchTree::AVLTree::AVLTreeLinked;
             using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::RBTreeLinked;
+            using DSA::Tree::BinaryTree::BinarySearchTree::AVLTree::OrderStatisticAVLTreeLinked;
+            using DSA::Tree::BinaryTree::BinarySearchTree::RBTree::OrderStatisticRBTreeLinked;
+            using DSA::Tree::BTree::BPlusTree;
+            template <typename Key, typename Compare, template <typename, typename, typename> class Implement>
+            struct MultiSet;
             template <typename Key, typename Compare = std::less<Key>, template <typename, typename, typename> class Implement = RBTreeLinked>
             struct Set final
             {
@@ -37,13 +44,24 @@ namespace DSA
                 using const_iterator = Base::const_iterator;
                 using iterator = const_iterator;
                 using difference_type = Base::difference_type;
+                // 节点句柄：extract 摘下的节点，可以不分配、不拷贝地插回同类型的容器
+                using node_type = Base::node_type;
+                struct insert_return_type
+                {
+                    iterator position;
+                    bool inserted;
+                    node_type node;
+                };
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
                 Set() = default;
                 explicit Set(const value_compare &comp) : impl{comp} {};
                 explicit Set(const Set &s) : impl(s.impl) {}
+                // 区间构造：输入已按键有序时O(N)自底向上批量建成平衡树，否则先稳定排序；等价键保留先出现的元素
+                template <std::input_iterator InputIt>
+                Set(InputIt first, InputIt last, const value_compare &comp = value_compare{}) : impl{comp} { impl.assign_unique(first, last); }
                 ~Set() = default;
-                Set &operator=(const Set &s) { impl = s.impl; }
+                Set &operator=(const Set &s) { impl = s.impl; return *this; }
 
                 // iterators:
                 iterator begin() { return impl.begin(); }
@@ -66,11 +84,32 @@ namespace DSA
                 size_type size() const { return impl.size(); }
 
                 std::pair<iterator, bool> insert(const value_type &v) { return impl.insert_unique(v); }
+                std::pair<iterator, bool> insert(value_type &&v) { return impl.insert_unique(std::move(v)); }
+                template <typename... Args>
+                std::pair<iterator, bool> emplace(Args &&...args) { return impl.emplace_unique(std::forward<Args>(args)...); }
 
-                iterator erase(const_iterator position) { return impl.erase_unique(position); }
+                iterator erase(const_iterator position) { return impl.erase(position); }
+                node_type extract(const_iterator position) { return impl.extract(position); }
+                node_type extract(const key_type &k) { return impl.extract_unique(k); }
+                insert_return_type insert(node_type &&nh)
+                {
+                    auto res = impl.insert_unique(std::move(nh));
+                    return {res.position, res.inserted, std::move(res.node)};
+                }
+                // 把other中键在本容器中不存在的节点转移过来，不分配、不拷贝；重复键的元素留在other中
+                void merge(Set &other) { impl.merge_unique(other.impl); }
+                void merge(Set &&other) { merge(other); }
+                void merge(MultiSet<Key, Compare, Implement> &other) { impl.merge_unique(other.impl); }
+                void merge(MultiSet<Key, Compare, Implement> &&other) { merge(other); }
                 size_type erase(const key_type &k) { return impl.erase_unique(k); }
                 // iterator erase(const_iterator first, const_iterator last);
                 void clear() { impl.clear(); }
+                // 用区间[first, last)替换全部内容，规则与区间构造相同
+                template <std::input_iterator InputIt>
+                void assign(InputIt first, InputIt last) { impl.assign_unique(first, last); }
+                // 同上，但由调用者保证区间已按键有序，O(N)
+                template <std::input_iterator InputIt>
+                void assign_sorted(InputIt first, InputIt last) { impl.assign_sorted_unique(first, last); }
 
                 void swap(Set &s)
                 {
@@ -95,9 +134,19 @@ namespace DSA
                 std::pair<iterator, iterator> equal_range(const key_type &k) { return impl.equal_range_unique(k); }
                 std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const { return impl.equal_range_unique(k); }
 
+                // 顺序统计：要求Implement维护子树大小（如OrderStatisticRBTreeLinked），均为O(logN)
+                // 键小于k的元素个数
+                size_type rank(const key_type &k) const { return impl.rank(k); }
+                // 第i个（从0开始）元素，越界时返回end()
+                iterator select(size_type i) { return impl.select(i); }
+                const_iterator select(size_type i) const { return impl.select(i); }
+                size_type index_of(const_iterator pos) const { return impl.index_of(pos); }
+                difference_type distance(const_iterator first, const_iterator last) const { return impl.distance(first, last); }
+
                 bool checker() { return impl.checker_unique(); }
 
             protected:
+                friend struct MultiSet<Key, Compare, Implement>;
                 Base impl;
             };
             template <typename Key, typename Compare = std::less<Key>, template <typename, typename, typename> class Implement = RBTreeLinked>
@@ -117,14 +166,18 @@ namespace DSA
                 using const_iterator = Base::const_iterator;
                 using iterator = const_iterator;
                 using difference_type = Base::difference_type;
+                using node_type = Base::node_type;
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
                 MultiSet() = default;
                 explicit MultiSet(const value_compare &comp) : impl{comp} {};
                 MultiSet(const MultiSet &s) : impl(s.impl) {}
+                // 区间构造：输入已按键有序时O(N)自底向上批量建成平衡树，否则先稳定排序；等价键保持输入中的先后次序
+                template <std::input_iterator InputIt>
+                MultiSet(InputIt first, InputIt last, const value_compare &comp = value_compare{}) : impl{comp} { impl.assign_multi(first, last); }
                 ~MultiSet() = default;
 
-                MultiSet &operator=(const MultiSet &s) { impl = s.impl; }
+                MultiSet &operator=(const MultiSet &s) { impl = s.impl; return *this; }
 
                 // iterators:
                 iterator begin() { return impl.begin(); }
@@ -147,11 +200,29 @@ namespace DSA
                 size_type size() const { return impl.size(); }
 
                 iterator insert(const value_type &v) { return impl.insert_multi(v); }
+                iterator insert(value_type &&v) { return impl.insert_multi(std::move(v)); }
+                template <typename... Args>
+                iterator emplace(Args &&...args) { return impl.emplace_multi(std::forward<Args>(args)...); }
 
-                iterator erase(const_iterator position) { return impl.erase_multi(position); }
+                iterator erase(const_iterator position) { return impl.erase(position); }
+                node_type extract(const_iterator position) { return impl.extract(position); }
+                // 摘下第一个键等价于k的元素
+                node_type extract(const key_type &k) { return impl.extract_multi(k); }
+                iterator insert(node_type &&nh) { return impl.insert_multi(std::move(nh)); }
+                // 把other的全部节点转移过来，不分配、不拷贝
+                void merge(MultiSet &other) { impl.merge_multi(other.impl); }
+                void merge(MultiSet &&other) { merge(other); }
+                void merge(Set<Key, Compare, Implement> &other) { impl.merge_multi(other.impl); }
+                void merge(Set<Key, Compare, Implement> &&other) { merge(other); }
                 size_type erase(const key_type &k) { return impl.erase_multi(k); }
                 // iterator erase(const_iterator first, const_iterator last);
                 void clear() { impl.clear(); }
+                // 用区间[first, last)替换全部内容，规则与区间构造相同
+                template <std::input_iterator InputIt>
+                void assign(InputIt first, InputIt last) { impl.assign_multi(first, last); }
+                // 同上，但由调用者保证区间已按键有序，O(N)
+                template <std::input_iterator InputIt>
+                void assign_sorted(InputIt first, InputIt last) { impl.assign_sorted_multi(first, last); }
 
                 void swap(MultiSet &s)
                 {
@@ -180,9 +251,19 @@ namespace DSA
                 std::pair<iterator, iterator> equal_range(const key_type &k) { return impl.equal_range_multi(k); }
                 std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const { return impl.equal_range_multi(k); }
 
+                // 顺序统计：要求Implement维护子树大小（如OrderStatisticRBTreeLinked），均为O(logN)
+                // 键小于k的元素个数
+                size_type rank(const key_type &k) const { return impl.rank(k); }
+                // 第i个（从0开始）元素，越界时返回end()
+                iterator select(size_type i) { return impl.select(i); }
+                const_iterator select(size_type i) const { return impl.select(i); }
+                size_type index_of(const_iterator pos) const { return impl.index_of(pos); }
+                difference_type distance(const_iterator first, const_iterator last) const { return impl.distance(first, last); }
+
                 bool checker() { return impl.checker_multi(); }
 
             protected:
+                friend struct Set<Key, Compare, Implement>;
                 Base impl;
             };
 
@@ -0,0 +1,486 @@
+#pragma once
+#include "vector.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            namespace detail
+            {
+                /**
+                 * @brief SmallVector 的内存管理基类。
+                 *
+                 * 在 VectorMemoryBase 的基础上增加 N 个元素的内联缓冲区：容量不超过 N 时 p_start 指向内联缓冲区，
+                 * 超过 N 后才在堆上分配，堆内存的分配与释放仍沿用 VectorMemoryBase 的实现。
+                 * 内联缓冲区随对象本身移动，所以这个类既不可拷贝也不可移动，移动语义由 SmallVector 逐元素实现。
+                 */
+                template <typename T, size_t N>
+                struct SmallVectorMemoryBase : VectorMemoryBase<T>
+                {
+                    static_assert(N > 0, "SmallVector needs at least one inline slot");
+                    using Base = VectorMemoryBase<T>;
+                    using size_type = typename Base::size_type;
+
+                    SmallVectorMemoryBase() { reset_to_inline(); }
+                    explicit SmallVectorMemoryBase(size_type n)
+                    {
+                        if (n <= N)
+                        {
+                            reset_to_inline();
+                        }
+                        else
+                        {
+                            this->p_start = this->allocate_storage(n);
+                            this->p_end_of_storage = this->p_start + n;
+                        }
+                    }
+                    ~SmallVectorMemoryBase()
+                    {
+                        // 内联缓冲区不能交给 VectorMemoryBase 的析构函数释放
+                        if (is_inline())
+                            this->p_start = this->p_end_of_storage = nullptr;
+                    }
+                    SmallVectorMemoryBase(const SmallVectorMemoryBase &) = delete;
+                    SmallVectorMemoryBase &operator=(const SmallVectorMemoryBase &) = delete;
+                    SmallVectorMemoryBase(SmallVectorMemoryBase &&) = delete;
+
+                    bool is_inline() const { return this->p_start == inline_data(); }
+
+                protected:
+                    T *inline_data() { return reinterpret_cast<T *>(inline_buf); }
+                    const T *inline_data() const { return reinterpret_cast<const T *>(inline_buf); }
+                    void reset_to_inline()
+                    {
+                        this->p_start = inline_data();
+                        this->p_end_of_storage = this->p_start + N;
+                    }
+                    // 释放堆内存并切回内联缓冲区；调用前所有元素必须已经析构或搬走
+                    void release_storage()
+                    {
+                        if (!is_inline())
+                            this->deallocate_storage(this->p_start, this->p_end_of_storage - this->p_start);
+                        reset_to_inline();
+                    }
+
+                    alignas(T) unsigned char inline_buf[N * sizeof(T)];
+                };
+            }
+            /**
+             * @brief 带小缓冲区优化的 Vector。
+             *
+             * 最多 N 个元素直接存放在对象内部，不做任何堆分配；超过 N 后整体搬到堆上，之后的行为与 Vector 相同。
+             * 适合绝大多数情况下只有少量元素的场景，比如低度数顶点的邻接表。
+             * 与 Vector 共用 VectorBase / VectorGuard / 迭代器与增长策略（GrowthPolicy），异常安全保证相同：
+             * 批量构造失败时由 VectorGuard 回滚，扩容时先在新内存中构造好全部元素再释放旧内存。
+             *
+             * 注意：元素在内联缓冲区中时，移动构造与 swap 需要逐个移动元素，复杂度为 O(N) 而不是 O(1)。
+             */
+            template <typename T, size_t N, typename GrowthPolicy>
+            struct SmallVector final
+                : detail::VectorBase<T, detail::SmallVectorMemoryBase<T, N>>
+            {
+                static constexpr size_t inline_capacity = N;
+                static constexpr bool relocatable = is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>;
+                using MemoryBase = detail::SmallVectorMemoryBase<T, N>;
+                using Base = detail::VectorBase<T, MemoryBase>;
+                using HeapBase = detail::VectorBase<T>;
+                using allocator_type = Base::allocator_type;
+                using value_type = Base::value_type;
+                using reference = Base::reference;
+                using const_reference = Base::const_reference;
+                using pointer = Base::pointer;
+                using const_pointer = Base::const_pointer;
+                using iterator = detail::ArrayLikeIterator<T>;
+                using const_iterator = detail::ConstArrayLikeIterator<T>;
+                using size_type = Base::size_type;
+                using difference_type = Base::difference_type;
+                using reverse_iterator = std::reverse_iterator<iterator>;
+                using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+                using Guard = detail::VectorGuard<T, MemoryBase>;
+                using traits = typename Base::traits;
+
+                SmallVector() = default;
+                explicit SmallVector(size_type n)
+                    : Base(n)
+                {
+                    this->default_construct_at_end_multi(n);
+                }
+                explicit SmallVector(size_type n, const T &v)
+                    : Base(n)
+                {
+                    this->construct_at_end_multi(n, v);
+                }
+                template <class InputIt>
+                    requires std::input_iterator<InputIt>
+                explicit SmallVector(InputIt first, InputIt last)
+                {
+                    insert(end(), first, last);
+                }
+                SmallVector(std::initializer_list<T> il) : SmallVector(il.begin(), il.end()) {}
+                SmallVector(const SmallVector &other)
+                    : Base(other.size())
+                {
+                    Guard guard_tmp(this);
+                    for (const T &v : other)
+                        this->construct_at_end(v);
+                    guard_tmp.commit();
+                }
+                // other 在堆上时直接接管缓冲区；在内联缓冲区时逐个移动元素
+                SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                {
+                    steal_from(other);
+                }
+                SmallVector &operator=(const SmallVector &other)
+                {
+                    if (this != std::addressof(other))
+                    {
+                        SmallVector tmp(other);
+                        *this = std::move(tmp);
+                    }
+                    return *this;
+                }
+                SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                {
+                    if (this != std::addressof(other))
+                    {
+                        clear();
+                        this->release_storage();
+                        steal_from(other);
+                    }
+                    return *this;
+                }
+                ~SmallVector() = default;
+
+                void clear() { Base::clear(); }
+                size_type size() const { return this->p_finish - this->p_start; }
+                bool empty() const { return this->p_finish == this->p_start; }
+                size_type capacity() const { return this->p_end_of_storage - this->p_start; }
+                // 元素当前是否存放在内联缓冲区中
+                bool is_inline() const { return MemoryBase::is_inline(); }
+                pointer data() { return this->p_start; }
+                const_pointer data() const { return this->p_start; }
+                reference at(size_type index)
+                {
+                    if (index >= size())
+                    {
+                        std::ostringstream ss;
+                        ss << "SmallVector::at(index): index (" << index << ") >= this->size() (" << size() << ") ";
+                        throw std::out_of_range(ss.str());
+                    }
+                    return this->p_start[index];
+                }
+                const_reference at(size_type index) const
+                {
+                    if (index >= size())
+                    {
+                        std::ostringstream ss;
+                        ss << "SmallVector::at(index): index (" << index << ") >= this->size() (" << size() << ") ";
+                        throw std::out_of_range(ss.str());
+                    }
+                    return this->p_start[index];
+                }
+                reference operator[](size_type index) { return this->p_start[index]; }
+                const_reference operator[](size_type index) const { return this->p_start[index]; }
+                reference front() { return *(this->p_start); }
+                const_reference front() const { return *(this->p_start); }
+                reference back() { return *(this->p_finish - 1); }
+                const_reference back() const { return *(this->p_finish - 1); }
+
+                iterator begin() { return iterator{this->p_start}; }
+                const_iterator begin() const { return const_iterator{this->p_start}; }
+                iterator end() { return iterator{this->p_finish}; }
+                const_iterator end() const { return const_iterator{this->p_finish}; }
+                reverse_iterator rbegin() { return reverse_iterator{end()}; }
+                const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+                reverse_iterator rend() { return reverse_iterator{begin()}; }
+                const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+                const_iterator cbegin() const { return begin(); }
+                const_iterator cend() const { return end(); }
+                const_reverse_iterator crbegin() const { return rbegin(); }
+                const_reverse_iterator crend() const { return rend(); }
+
+                void reserve(size_type least_cap)
+                {
+                    if (least_cap > capacity())
+                        reallocate(least_cap);
+                }
+                // 元素个数不超过 N 时搬回内联缓冲区（要求移动不抛异常），否则把堆内存收缩到恰好容纳所有元素
+                void shrink_to_fit()
+                {
+                    if (is_inline() || size() == capacity())
+                        return;
+                    if (size() > N)
+                    {
+                        reallocate(size());
+                        return;
+                    }
+                    if constexpr (std::is_nothrow_move_constructible_v<T>)
+                    {
+                        pointer old_start = this->p_start, old_finish = this->p_finish, old_end = this->p_end_of_storage;
+                        this->reset_to_inline();
+                        this->p_finish = this->p_start;
+                        for (pointer p = old_start; p != old_finish; ++p)
+                        {
+                            this->construct_at_end(std::move(*p));
+                            traits::destroy(this->alloc, p);
+                        }
+                        this->deallocate_storage(old_start, old_end - old_start);
+                    }
+                }
+                void resize(size_type n)
+                {
+                    if (capacity() < n)
+                        reallocate(calc_new_capacity(n));
+                    if (size() < n)
+                    {
+                        Guard guard_tmp(this);
+                        this->default_construct_at_end_multi(n - size());
+                        guard_tmp.commit();
+                    }
+                    while (size() > n)
+                        this->destroy_at_end();
+                }
+                void resize(size_type n, const T &v)
+                {
+                    if (capacity() < n)
+                    {
+                        T copy(v); // v 可能引用容器内的元素
+                        reallocate(calc_new_capacity(n));
+                        resize(n, copy);
+                        return;
+                    }
+                    if (size() < n)
+                    {
+                        Guard guard_tmp(this);
+                        this->construct_at_end_multi(n - size(), v);
+                        guard_tmp.commit();
+                    }
+                    while (size() > n)
+                        this->destroy_at_end();
+                }
+                void push_back(const T &v) { emplace_back(v); }
+                void push_back(T &&v) { emplace_back(std::move(v)); }
+                template <typename... Args>
+                reference emplace_back(Args &&...args)
+                {
+                    if (size() == capacity())
+                    {
+                        // 参数可能引用本容器内的元素，扩容会把它们移走，所以先构造出新值
+                        T v(std::forward<Args>(args)...);
+                        reallocate(calc_new_capacity(size() + 1));
+                        this->construct_at_end(std::move(v));
+                    }
+                    else
+                    {
+                        this->emplace_at_end(std::forward<Args>(args)...);
+                    }
+                    return back();
+                }
+                void pop_back() { this->destroy_at_end(); }
+                template <typename... Args>
+                iterator emplace(const_iterator pos, Args &&...args)
+                {
+                    size_type pos_index = pos - cbegin();
+                    if (pos_index == size())
+                    {
+                        emplace_back(std::forward<Args>(args)...);
+                        return begin() + pos_index;
+                    }
+                    T v(std::forward<Args>(args)...);
+                    if (size() == capacity())
+                        reallocate(calc_new_capacity(size() + 1));
+                    if constexpr (relocatable)
+                    {
+                        this->relocate_insert(pos_index, 1, [&](pointer p)
+                                              { traits::construct(this->alloc, p, std::move(v)); });
+                    }
+                    else
+                    {
+                        // 最后一个元素移动构造到末尾，其余元素依次后移一格，再把新值移入空位
+                        this->construct_at_end(std::move(*(this->p_finish - 1)));
+                        std::move_backward(begin() + pos_index, end() - 2, end() - 1);
+                        *(begin() + pos_index) = std::move(v);
+                    }
+                    return begin() + pos_index;
+                }
+                iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+                iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
+                iterator insert(const_iterator pos, size_type n, const T &v)
+                {
+                    size_type pos_index = pos - cbegin();
+                    if (!n)
+                        return begin() + pos_index;
+                    T copy(v); // v 可能引用容器内的元素
+                    if (capacity() - size() < n)
+                        reallocate(calc_new_capacity(size() + n));
+                    if constexpr (relocatable)
+                    {
+                        this->relocate_insert(pos_index, n, [&](pointer p)
+                                              { traits::construct(this->alloc, p, copy); });
+                    }
+                    else
+                    {
+                        Guard guard_tmp(this);
+                        this->construct_at_end_multi(n, copy);
+                        guard_tmp.commit();
+                        std::rotate(begin() + pos_index, end() - n, end());
+                    }
+                    return begin() + pos_index;
+                }
+                // 传入 std::move_iterator 时元素会被移动而不是拷贝
+                template <typename InputIt>
+                    requires std::input_iterator<InputIt>
+                iterator insert(const_iterator pos, InputIt first, InputIt last)
+                {
+                    size_type pos_index = pos - cbegin();
+                    // 与 Vector 一样按 iterator_category 分派：C++20 的 std::move_iterator 只声明为 input_iterator 概念，但仍可多次遍历
+                    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+                    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+                    {
+                        size_type n = std::distance(first, last);
+                        if (!n)
+                            return begin() + pos_index;
+                        if (capacity() - size() < n)
+                            reallocate(calc_new_capacity(size() + n));
+                        if constexpr (relocatable)
+                        {
+                            this->relocate_insert(pos_index, n, [&](pointer p)
+                                                  { traits::construct(this->alloc, p, *first); ++first; });
+                        }
+                        else
+                        {
+                            Guard guard_tmp(this);
+                            for (; first != last; ++first)
+                                this->emplace_at_end(*first);
+                            guard_tmp.commit();
+                            std::rotate(begin() + pos_index, end() - n, end());
+                        }
+                    }
+                    else
+                    {
+                        // 输入迭代器只能遍历一次，先收集到临时容器中
+                        SmallVector tmp;
+                        for (; first != last; ++first)
+                            tmp.emplace_back(*first);
+                        insert(begin() + pos_index, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+                    }
+                    return begin() + pos_index;
+                }
+                iterator insert(const_iterator pos, std::initializer_list<T> il) { return insert(pos, il.begin(), il.end()); }
+                iterator erase(const_iterator pos)
+                {
+                    iterator nonconst_pos = begin() + (pos - cbegin());
+                    if constexpr (relocatable)
+                    {
+                        pointer p = this->p_start + (pos - cbegin());
+                        this->relocate_erase(p, p + 1);
+                        return nonconst_pos;
+                    }
+                    std::move(nonconst_pos + 1, end(), nonconst_pos);
+                    pop_back();
+                    return nonconst_pos;
+                }
+                iterator erase(const_iterator first, const_iterator last)
+                {
+                    iterator nonconst_first = begin() + (first - cbegin());
+                    iterator nonconst_last = begin() + (last - cbegin());
+                    if (first == last)
+                        return nonconst_last;
+                    if constexpr (relocatable)
+                    {
+                        this->relocate_erase(this->p_start + (first - cbegin()), this->p_start + (last - cbegin()));
+                        return nonconst_first;
+                    }
+                    iterator new_end = std::move(nonconst_last, end(), nonconst_first);
+                    while (end() != new_end)
+                        pop_back();
+                    return nonconst_first;
+                }
+                void swap(SmallVector &other)
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    // 两边都在堆上时只交换指针
+                    if (!is_inline() && !other.is_inline())
+                    {
+                        this->Base::swap(other);
+                        return;
+                    }
+                    SmallVector tmp(std::move(other));
+                    other = std::move(*this);
+                    *this = std::move(tmp);
+                }
+
+            protected:
+                // 从 other 取走全部元素，调用前 this 为空且处于内联状态
+                void steal_from(SmallVector &other)
+                {
+                    if (!other.is_inline())
+                    {
+                        this->p_start = other.p_start;
+                        this->p_finish = other.p_finish;
+                        this->p_end_of_storage = other.p_end_of_storage;
+                        other.reset_to_inline();
+                        other.p_finish = other.p_start;
+                        return;
+                    }
+                    if constexpr (relocatable)
+                    {
+                        std::memcpy(static_cast<void *>(this->p_start), other.p_start, other.size() * sizeof(T));
+                        this->p_finish = this->p_start + other.size();
+                        other.p_finish = other.p_start;
+                    }
+                    else
+                    {
+                        Guard guard_tmp(this);
+                        for (T &v : other)
+                            this->construct_at_end(std::move(v));
+                        guard_tmp.commit();
+                        other.clear();
+                    }
+                }
+                // 把全部元素搬到容量为 new_cap 的堆内存中，假设 new_cap >= size()
+                void reallocate(size_type new_cap)
+                {
+                    size_type n = size();
+                    if constexpr (relocatable)
+                    {
+                        if constexpr (MemoryBase::use_realloc)
+                        {
+                            if (!is_inline())
+                            {
+                                this->p_finish = this->reallocate_storage(new_cap) + n;
+                                return;
+                            }
+                        }
+                        pointer new_start = this->allocate_storage(new_cap);
+                        if (n)
+                            std::memcpy(static_cast<void *>(new_start), this->p_start, n * sizeof(T));
+                        // 元素已经按字节搬走，只释放旧内存，不析构
+                        this->p_finish = this->p_start;
+                        this->release_storage();
+                        this->p_start = new_start;
+                        this->p_finish = new_start + n;
+                        this->p_end_of_storage = new_start + new_cap;
+                        return;
+                    }
+                    // 先在新内存中构造好全部元素，失败时由 tmp 的析构函数回滚，原容器不受影响
+                    HeapBase tmp(new_cap);
+                    tmp.construct_at_end_range(this->p_start, this->p_finish);
+                    clear();
+                    this->release_storage();
+                    this->p_start = tmp.p_start;
+                    this->p_finish = tmp.p_finish;
+                    this->p_end_of_storage = tmp.p_end_of_storage;
+                    tmp.p_start = tmp.p_finish = tmp.p_end_of_storage = nullptr;
+                }
+                // 与 Vector 相同，由增长策略决定新容量
+                size_type calc_new_capacity(size_type new_size)
+                {
+                    return GrowthPolicy::next_capacity(capacity(), new_size, sizeof(T));
+                }
+            };
+        }
+    }
+}
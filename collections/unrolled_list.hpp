@@ -0,0 +1,761 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            // 默认每个节点存放约 256 字节的元素，至少 8 个
+            template <typename T>
+            inline constexpr size_t unrolled_node_capacity = std::max<size_t>(8, 256 / sizeof(T));
+
+            template <typename T, size_t K, typename Alloc>
+            struct UnrolledList;
+
+            namespace detail
+            {
+                // 不带元素的部分：双向链接与本节点的元素个数。链表的 header 就是一个 UnrolledNodeBase，count 恒为 0。
+                struct UnrolledNodeBase
+                {
+                    UnrolledNodeBase *n_next = nullptr;
+                    UnrolledNodeBase *n_prev = nullptr;
+                    size_t count = 0;
+                };
+                // 元素连续存放在 [0, count) 中，除 header 外的节点都非空
+                template <typename T, size_t K>
+                struct UnrolledNode : UnrolledNodeBase
+                {
+                    alignas(T) std::byte storage[K * sizeof(T)];
+                    T *data() { return std::launder(reinterpret_cast<T *>(storage)); }
+                    const T *data() const { return std::launder(reinterpret_cast<const T *>(storage)); }
+                };
+
+                /**
+                 * @brief UnrolledList 的双向迭代器：节点指针加节点内下标。
+                 * 与 ListIterator 的接口一致；end() 为 (header, 0)。
+                 */
+                template <typename T, size_t K, bool IsConst>
+                class UnrolledListIterator
+                {
+                public:
+                    using value_type = T;
+                    using reference = std::conditional_t<IsConst, const T &, T &>;
+                    using pointer = std::conditional_t<IsConst, const T *, T *>;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+                    using Node = UnrolledNode<T, K>;
+
+                    UnrolledListIterator() = default;
+                    UnrolledListIterator(const UnrolledNodeBase *n, size_t i) : node_ptr_(const_cast<UnrolledNodeBase *>(n)), index_(i) {}
+                    // 允许从可变迭代器构造常量迭代器
+                    template <bool FromConst = IsConst>
+                        requires FromConst
+                    UnrolledListIterator(const UnrolledListIterator<T, K, false> &other)
+                        : node_ptr_(other.node_ptr_), index_(other.index_)
+                    {
+                    }
+
+                    reference operator*() const { return static_cast<Node *>(node_ptr_)->data()[index_]; }
+                    pointer operator->() const { return &**this; }
+
+                    UnrolledListIterator &operator++()
+                    {
+                        if (++index_ == node_ptr_->count)
+                        {
+                            node_ptr_ = node_ptr_->n_next;
+                            index_ = 0;
+                        }
+                        return *this;
+                    }
+                    UnrolledListIterator operator++(int)
+                    {
+                        auto tmp = *this;
+                        ++(*this);
+                        return tmp;
+                    }
+                    UnrolledListIterator &operator--()
+                    {
+                        if (index_ == 0)
+                        {
+                            node_ptr_ = node_ptr_->n_prev;
+                            index_ = node_ptr_->count;
+                        }
+                        --index_;
+                        return *this;
+                    }
+                    UnrolledListIterator operator--(int)
+                    {
+                        auto tmp = *this;
+                        --(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const UnrolledListIterator &other) const { return node_ptr_ == other.node_ptr_ && index_ == other.index_; }
+                    bool operator!=(const UnrolledListIterator &other) const { return !(*this == other); }
+
+                protected:
+                    UnrolledNodeBase *node_ptr_ = nullptr;
+                    size_t index_ = 0;
+                    friend UnrolledListIterator<T, K, true>;
+                    template <typename, size_t, typename>
+                    friend struct ListOrForwardlist::UnrolledList;
+                };
+            }
+
+            /**
+             * @brief 展开链表：每个节点连续存放至多 K 个元素，节点之间双向链接。
+             *
+             * - 遍历时每 K 个元素才跳一次指针，节点内是连续数组，速度接近 Vector；
+             * - 在迭代器处插入 / 删除只移动所在节点内的至多 K 个元素，满了对半分裂，过空时与相邻节点合并，均摊 O(1)；
+             * - splice 以节点为粒度：在切分点把节点一分为二，然后整段重新链接，不移动其余元素；
+             * - merge / sort 稳定，语义与 List 相同，且都不分配新节点；remove_if / unique 逐节点原地压缩，谓词对每个元素按顺序只调用一次。
+             *
+             * 与 List 不同，节点内的插入、删除会移动元素：修改操作使指向同一节点（分裂、合并时还包括相邻节点）的迭代器失效，
+             * splice 之后被移动元素的迭代器也会失效。两个链表之间 splice / merge 要求分配器相等。
+             */
+            template <typename T, size_t K = unrolled_node_capacity<T>, typename Alloc = std::allocator<T>>
+            struct UnrolledList
+            {
+                static_assert(K >= 2, "UnrolledList needs room for at least two elements per node");
+                using value_type = T;
+                using reference = T &;
+                using const_reference = const T &;
+                using pointer = T *;
+                using const_pointer = const T *;
+                using iterator = detail::UnrolledListIterator<T, K, false>;
+                using const_iterator = detail::UnrolledListIterator<T, K, true>;
+                using reverse_iterator = std::reverse_iterator<iterator>;
+                using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+                using size_type = size_t;
+                using difference_type = std::ptrdiff_t;
+                using allocator_type = Alloc;
+                using NodeBase = detail::UnrolledNodeBase;
+                using Node = detail::UnrolledNode<T, K>;
+                using node_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+                using node_traits = std::allocator_traits<node_allocator_type>;
+                static constexpr size_type node_capacity = K;
+
+                UnrolledList() : UnrolledList(Alloc{}) {}
+                explicit UnrolledList(const allocator_type &a) : node_alloc(a) { reset_header(); }
+                UnrolledList(const UnrolledList &other)
+                    : UnrolledList(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.get_allocator()))
+                {
+                    for (const T &v : other)
+                        push_back(v);
+                }
+                UnrolledList(UnrolledList &&other) : UnrolledList(other.get_allocator()) { this->swap(other); }
+                explicit UnrolledList(size_type n, const T &v = T{}, const allocator_type &a = allocator_type())
+                    : UnrolledList(a)
+                {
+                    for (; n > 0; --n)
+                        push_back(v);
+                }
+                template <typename InputIt>
+                UnrolledList(InputIt first, InputIt last, const allocator_type &a = allocator_type())
+                    : UnrolledList(a)
+                {
+                    for (; first != last; ++first)
+                        emplace_back(*first);
+                }
+                UnrolledList(std::initializer_list<T> il, const allocator_type &a = allocator_type()) : UnrolledList(il.begin(), il.end(), a) {}
+                ~UnrolledList() { clear(); }
+                // 拷贝并交换（Copy-and-Swap），强异常安全
+                UnrolledList &operator=(const UnrolledList &other)
+                {
+                    if (this != std::addressof(other))
+                    {
+                        UnrolledList tmp(other);
+                        this->swap(tmp);
+                    }
+                    return *this;
+                }
+                UnrolledList &operator=(UnrolledList &&other)
+                {
+                    this->swap(other);
+                    return *this;
+                }
+                void assign(size_type n, const T &v)
+                {
+                    UnrolledList tmp(n, v, get_allocator());
+                    this->swap(tmp);
+                }
+                template <typename InputIt>
+                void assign(InputIt first, InputIt last)
+                {
+                    UnrolledList tmp(first, last, get_allocator());
+                    this->swap(tmp);
+                }
+                allocator_type get_allocator() const { return allocator_type(node_alloc); }
+
+                iterator begin() { return iterator{header.n_next, 0}; }
+                const_iterator begin() const { return const_iterator{header.n_next, 0}; }
+                iterator end() { return iterator{&header, 0}; }
+                const_iterator end() const { return const_iterator{&header, 0}; }
+                reverse_iterator rbegin() { return reverse_iterator{end()}; }
+                const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+                reverse_iterator rend() { return reverse_iterator{begin()}; }
+                const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+                const_iterator cbegin() const { return begin(); }
+                const_iterator cend() const { return end(); }
+                const_reverse_iterator crbegin() const { return rbegin(); }
+                const_reverse_iterator crend() const { return rend(); }
+
+                bool empty() const { return size_r == 0; }
+                size_type size() const { return size_r; }
+                // 当前的节点个数，O(size() / K)
+                size_type node_count() const
+                {
+                    size_type res = 0;
+                    for (const NodeBase *p = header.n_next; p != &header; p = p->n_next)
+                        ++res;
+                    return res;
+                }
+                reference front() { return as_node(header.n_next)->data()[0]; }
+                const_reference front() const { return as_node(header.n_next)->data()[0]; }
+                reference back() { return as_node(header.n_prev)->data()[header.n_prev->count - 1]; }
+                const_reference back() const { return as_node(header.n_prev)->data()[header.n_prev->count - 1]; }
+
+                void clear()
+                {
+                    for (NodeBase *p = header.n_next; p != &header;)
+                    {
+                        NodeBase *next = p->n_next;
+                        destroy_node(as_node(p));
+                        p = next;
+                    }
+                    reset_header();
+                    size_r = 0;
+                }
+
+                template <typename... Args>
+                reference emplace_back(Args &&...args)
+                {
+                    NodeBase *last = header.n_prev;
+                    Node *n = (last == &header || last->count == K) ? create_node(&header) : as_node(last);
+                    try
+                    {
+                        std::construct_at(n->data() + n->count, std::forward<Args>(args)...);
+                    }
+                    catch (...)
+                    {
+                        if (!n->count)
+                            free_node(n);
+                        throw;
+                    }
+                    ++size_r;
+                    return n->data()[n->count++];
+                }
+                template <typename... Args>
+                reference emplace_front(Args &&...args)
+                {
+                    return *emplace(begin(), std::forward<Args>(args)...);
+                }
+                void push_back(const T &v) { emplace_back(v); }
+                void push_back(T &&v) { emplace_back(std::move(v)); }
+                void push_front(const T &v) { emplace_front(v); }
+                void push_front(T &&v) { emplace_front(std::move(v)); }
+                void pop_back()
+                {
+                    Node *n = as_node(header.n_prev);
+                    std::destroy_at(n->data() + --n->count);
+                    --size_r;
+                    if (!n->count)
+                        free_node(n);
+                }
+                void pop_front() { erase(begin()); }
+
+                /**
+                 * @brief 在 pos 之前构造新元素。所在节点已满时先对半分裂；
+                 * pos 是节点首元素且前一个节点还有空位时，直接追加到前一个节点末尾。
+                 */
+                template <typename... Args>
+                iterator emplace(const_iterator pos, Args &&...args)
+                {
+                    NodeBase *nb = pos.node_ptr_;
+                    size_type idx = pos.index_;
+                    if (nb == &header)
+                    {
+                        emplace_back(std::forward<Args>(args)...);
+                        return iterator{header.n_prev, header.n_prev->count - 1};
+                    }
+                    if (idx == 0 && nb->n_prev != &header && nb->n_prev->count < K)
+                    {
+                        nb = nb->n_prev;
+                        idx = nb->count;
+                    }
+                    Node *n = as_node(nb);
+                    if (n->count == K)
+                    {
+                        Node *m = split_node(n, K / 2);
+                        if (idx > K / 2)
+                            n = m, idx -= K / 2;
+                    }
+                    insert_in_node(n, idx, std::forward<Args>(args)...);
+                    return iterator{n, idx};
+                }
+                iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+                iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
+                // 与 List 相同，先构造到临时链表再整段 splice，强异常安全
+                iterator insert(const_iterator pos, size_type n, const T &v)
+                {
+                    if (!n)
+                        return iterator{pos.node_ptr_, pos.index_};
+                    UnrolledList tmp(n, v, get_allocator());
+                    return splice_nodes(pos, tmp, tmp.begin(), tmp.end());
+                }
+                template <typename InputIt>
+                iterator insert(const_iterator pos, InputIt first, InputIt last)
+                {
+                    if (first == last)
+                        return iterator{pos.node_ptr_, pos.index_};
+                    UnrolledList tmp(first, last, get_allocator());
+                    return splice_nodes(pos, tmp, tmp.begin(), tmp.end());
+                }
+
+                iterator erase(const_iterator pos)
+                {
+                    Node *n = as_node(pos.node_ptr_);
+                    size_type idx = pos.index_;
+                    T *d = n->data();
+                    std::move(d + idx + 1, d + n->count, d + idx);
+                    std::destroy_at(d + --n->count);
+                    --size_r;
+                    NodeBase *rn = n;
+                    size_type ri = idx;
+                    if (!n->count)
+                    {
+                        rn = n->n_next;
+                        free_node(n);
+                        return iterator{rn, 0};
+                    }
+                    if (ri == n->count)
+                        rn = n->n_next, ri = 0;
+                    rebalance(n, rn, ri);
+                    return iterator{rn, ri};
+                }
+                iterator erase(const_iterator first, const_iterator last)
+                {
+                    NodeBase *nb = first.node_ptr_;
+                    size_type i = first.index_;
+                    Node *touched = nullptr; // 只删去一部分元素的第一个节点，最后检查是否需要合并
+                    while (nb != last.node_ptr_ || i != last.index_)
+                    {
+                        Node *n = as_node(nb);
+                        bool at_last = nb == last.node_ptr_;
+                        size_type end = at_last ? last.index_ : n->count;
+                        size_type k = end - i;
+                        T *d = n->data();
+                        std::move(d + end, d + n->count, d + i);
+                        std::destroy(d + n->count - k, d + n->count);
+                        n->count -= k;
+                        size_r -= k;
+                        if (at_last)
+                        {
+                            // last 之后还有元素，节点不会被删空
+                            NodeBase *rn = n;
+                            size_type ri = i;
+                            rebalance(touched ? touched : n, rn, ri);
+                            return iterator{rn, ri};
+                        }
+                        NodeBase *next = n->n_next;
+                        if (!n->count)
+                            free_node(n);
+                        else if (!touched)
+                            touched = n;
+                        nb = next;
+                        i = 0;
+                    }
+                    NodeBase *rn = nb;
+                    size_type ri = i;
+                    if (touched)
+                        rebalance(touched, rn, ri);
+                    return iterator{rn, ri};
+                }
+
+                void resize(size_type new_size)
+                {
+                    while (new_size < size_r)
+                        pop_back();
+                    while (new_size > size_r)
+                        emplace_back();
+                }
+                void resize(size_type new_size, const T &v)
+                {
+                    while (new_size < size_r)
+                        pop_back();
+                    while (new_size > size_r)
+                        emplace_back(v);
+                }
+                // O(1)：交换节点链、大小，并按 propagate_on_container_swap 交换分配器
+                void swap(UnrolledList &other)
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    NodeBase *f1 = empty() ? nullptr : header.n_next, *l1 = header.n_prev;
+                    NodeBase *f2 = other.empty() ? nullptr : other.header.n_next, *l2 = other.header.n_prev;
+                    adopt_chain(f2, l2);
+                    other.adopt_chain(f1, l1);
+                    std::swap(size_r, other.size_r);
+                    if constexpr (node_traits::propagate_on_container_swap::value)
+                    {
+                        using std::swap;
+                        swap(node_alloc, other.node_alloc);
+                    }
+                }
+
+                // 以节点为粒度拼接：在 pos 处切分本链表，把 other 的全部节点整段链接进来
+                void splice(const_iterator pos, UnrolledList &other)
+                {
+                    if (this != std::addressof(other) && !other.empty())
+                        splice_nodes(pos, other, other.begin(), other.end());
+                }
+                void splice(const_iterator pos, UnrolledList &&other) { splice(pos, other); }
+                // 单个元素直接移动构造到 pos 处，不为它单独切出节点
+                void splice(const_iterator pos, UnrolledList &other, const_iterator it)
+                {
+                    if (pos == it || pos == std::next(it))
+                        return;
+                    if (this == std::addressof(other))
+                    {
+                        splice_nodes(pos, other, it, std::next(it));
+                        return;
+                    }
+                    emplace(pos, std::move(*iterator{it.node_ptr_, it.index_}));
+                    other.erase(it);
+                }
+                void splice(const_iterator pos, UnrolledList &&other, const_iterator it) { splice(pos, other, it); }
+                // pos 不能在 [first, last) 范围内。违反此前提将导致未定义行为。
+                void splice(const_iterator pos, UnrolledList &other, const_iterator first, const_iterator last)
+                {
+                    if (first != last)
+                        splice_nodes(pos, other, first, last);
+                }
+                void splice(const_iterator pos, UnrolledList &&other, const_iterator first, const_iterator last) { splice(pos, other, first, last); }
+
+                /**
+                 * @brief 稳定归并两个有序链表，other 清空，不分配新节点。
+                 *
+                 * other 整体排在本链表之前或之后时只重新链接节点，元素不移动，引用保持有效（与 List 相同）；
+                 * 两者交错时先把 other 的节点链整段接到末尾，再用 std::inplace_merge 在节点内原地移动元素，
+                 * 它至多申请一块临时缓冲区，申请失败时退化为不需要额外内存的 O(N log N) 归并。
+                 * 比较或移动抛出异常时所有元素都留在本链表中，结构合法（基本异常保证）。
+                 */
+                template <typename Compare>
+                void merge(UnrolledList &other, Compare comp)
+                {
+                    if (this == std::addressof(other) || other.empty())
+                        return;
+                    if (empty() || !comp(other.front(), back()))
+                    {
+                        splice(end(), other);
+                        return;
+                    }
+                    if (comp(other.back(), front()))
+                    {
+                        splice(begin(), other);
+                        return;
+                    }
+                    iterator mid{other.header.n_next, 0};
+                    splice(end(), other);
+                    std::inplace_merge(begin(), mid, end(), comp);
+                }
+                template <typename Compare>
+                void merge(UnrolledList &&other, Compare comp) { merge(other, comp); }
+                void merge(UnrolledList &other) { merge(other, std::less<T>{}); }
+                void merge(UnrolledList &&other) { merge(other); }
+
+                size_type remove(const T &v)
+                {
+                    // v 可能就是链表中的元素，压缩时会被覆盖，先拷贝一份
+                    const T value = v;
+                    return remove_if([&](const T &x)
+                                     { return x == value; });
+                }
+                // 逐节点原地压缩，pred 对每个元素按顺序只调用一次
+                template <typename UnaryPredicate>
+                size_type remove_if(UnaryPredicate pred)
+                {
+                    size_type removed = 0;
+                    for (NodeBase *p = header.n_next; p != &header;)
+                    {
+                        NodeBase *next = p->n_next;
+                        Node *n = as_node(p);
+                        T *d = n->data();
+                        size_type w = 0;
+                        for (size_type r = 0; r < n->count; ++r)
+                            if (!pred(d[r]))
+                            {
+                                if (w != r)
+                                    d[w] = std::move(d[r]);
+                                ++w;
+                            }
+                        removed += shrink_node(n, w);
+                        p = next;
+                    }
+                    size_r -= removed;
+                    if (removed)
+                        compact();
+                    return removed;
+                }
+                template <typename BinaryPredicate>
+                size_type unique(BinaryPredicate pred)
+                {
+                    size_type removed = 0;
+                    T *kept = nullptr; // 最近保留的元素，即当前连续等价段的第一个
+                    for (NodeBase *p = header.n_next; p != &header;)
+                    {
+                        NodeBase *next = p->n_next;
+                        Node *n = as_node(p);
+                        T *d = n->data();
+                        size_type w = 0;
+                        for (size_type r = 0; r < n->count; ++r)
+                            if (!kept || !pred(*kept, d[r]))
+                            {
+                                if (w != r)
+                                    d[w] = std::move(d[r]);
+                                kept = d + w++;
+                            }
+                        removed += shrink_node(n, w);
+                        p = next;
+                    }
+                    size_r -= removed;
+                    if (removed)
+                        compact();
+                    return removed;
+                }
+                size_type unique() { return unique(std::equal_to<T>{}); }
+                // 反转节点顺序，再反转每个节点内部
+                void reverse()
+                {
+                    NodeBase *p = &header;
+                    do
+                    {
+                        std::swap(p->n_next, p->n_prev);
+                        if (p != &header)
+                            std::reverse(as_node(p)->data(), as_node(p)->data() + p->count);
+                        p = p->n_prev;
+                    } while (p != &header);
+                }
+                /**
+                 * @brief 稳定排序。元素先移动到一块连续缓冲区中用 std::stable_sort 排好，再按原来的节点布局移回，
+                 * 节点结构不变，所有比较都在连续内存上进行。
+                 */
+                template <typename Compare>
+                void sort(Compare comp)
+                {
+                    if (size_r < 2)
+                        return;
+                    std::vector<T> buf;
+                    buf.reserve(size_r);
+                    for (T &v : *this)
+                        buf.push_back(std::move(v));
+                    std::stable_sort(buf.begin(), buf.end(), comp);
+                    auto src = buf.begin();
+                    for (T &v : *this)
+                        v = std::move(*src++);
+                }
+                void sort() { sort(std::less<T>{}); }
+
+                friend bool operator==(const UnrolledList &a, const UnrolledList &b)
+                {
+                    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+                }
+                friend bool operator!=(const UnrolledList &a, const UnrolledList &b) { return !(a == b); }
+
+            protected:
+                NodeBase header;
+                size_type size_r = 0;
+                [[no_unique_address]] node_allocator_type node_alloc;
+
+                static Node *as_node(NodeBase *p) { return static_cast<Node *>(p); }
+                static const Node *as_node(const NodeBase *p) { return static_cast<const Node *>(p); }
+                void reset_header() { header.n_next = header.n_prev = &header; }
+                // 把 [first, last] 这条节点链挂到 header 上；first 为空表示空链
+                void adopt_chain(NodeBase *first, NodeBase *last)
+                {
+                    if (!first)
+                    {
+                        reset_header();
+                        return;
+                    }
+                    header.n_next = first;
+                    header.n_prev = last;
+                    first->n_prev = &header;
+                    last->n_next = &header;
+                }
+                // 分配一个空节点并链接到 pos 之前
+                Node *create_node(NodeBase *pos)
+                {
+                    Node *n = node_traits::allocate(node_alloc, 1);
+                    ::new (static_cast<void *>(n)) Node;
+                    n->n_next = pos;
+                    n->n_prev = pos->n_prev;
+                    pos->n_prev->n_next = n;
+                    pos->n_prev = n;
+                    return n;
+                }
+                // 解开并释放节点（元素必须已经析构）
+                void free_node(Node *n)
+                {
+                    n->n_prev->n_next = n->n_next;
+                    n->n_next->n_prev = n->n_prev;
+                    n->~Node();
+                    node_traits::deallocate(node_alloc, n, 1);
+                }
+                void destroy_node(Node *n)
+                {
+                    std::destroy(n->data(), n->data() + n->count);
+                    n->~Node();
+                    node_traits::deallocate(node_alloc, n, 1);
+                }
+                // 把 [from, n->count) 的元素搬到紧跟在 n 之后的新节点中
+                Node *split_node(Node *n, size_type from)
+                {
+                    Node *m = create_node(n->n_next);
+                    T *d = n->data();
+                    try
+                    {
+                        std::uninitialized_move(d + from, d + n->count, m->data());
+                    }
+                    catch (...)
+                    {
+                        free_node(m);
+                        throw;
+                    }
+                    std::destroy(d + from, d + n->count);
+                    m->count = n->count - from;
+                    n->count = from;
+                    return m;
+                }
+                // b 必须紧跟在 a 之后且 a->count + b->count <= K；b 的元素搬到 a 末尾后释放 b
+                void merge_nodes(Node *a, Node *b)
+                {
+                    T *db = b->data();
+                    std::uninitialized_move(db, db + b->count, a->data() + a->count);
+                    std::destroy(db, db + b->count);
+                    a->count += b->count;
+                    b->count = 0;
+                    free_node(b);
+                }
+                template <typename... Args>
+                void insert_in_node(Node *n, size_type idx, Args &&...args)
+                {
+                    T *d = n->data();
+                    if (idx == n->count)
+                        std::construct_at(d + idx, std::forward<Args>(args)...);
+                    else
+                    {
+                        T tmp(std::forward<Args>(args)...);
+                        std::construct_at(d + n->count, std::move(d[n->count - 1]));
+                        std::move_backward(d + idx, d + n->count - 1, d + n->count);
+                        d[idx] = std::move(tmp);
+                    }
+                    ++n->count;
+                    ++size_r;
+                }
+                // 压缩后只保留前 w 个元素，析构其余部分；删空的节点直接释放。返回删去的个数
+                size_type shrink_node(Node *n, size_type w)
+                {
+                    size_type k = n->count - w;
+                    std::destroy(n->data() + w, n->data() + n->count);
+                    n->count = w;
+                    if (!w)
+                        free_node(n);
+                    return k;
+                }
+                /**
+                 * @brief 节点元素少于 K / 4 时与相邻节点合并（合并后不超过 3K / 4，留出插入的余地，避免反复分裂合并）。
+                 * (rn, ri) 是调用者要返回的迭代器位置，合并时同步修正。
+                 */
+                void rebalance(Node *n, NodeBase *&rn, size_type &ri)
+                {
+                    if (n->count >= K / 4)
+                        return;
+                    if (n->n_next != &header && n->count + n->n_next->count <= K * 3 / 4)
+                    {
+                        Node *b = as_node(n->n_next);
+                        if (rn == b)
+                            rn = n, ri += n->count;
+                        merge_nodes(n, b);
+                    }
+                    else if (n->n_prev != &header && n->n_prev->count + n->count <= K * 3 / 4)
+                    {
+                        Node *a = as_node(n->n_prev);
+                        if (rn == n)
+                            rn = a, ri += a->count;
+                        merge_nodes(a, n);
+                    }
+                }
+                // 批量删除之后，把相邻且合起来放得下的节点合并
+                void compact()
+                {
+                    for (NodeBase *p = header.n_next; p != &header && p->n_next != &header;)
+                    {
+                        if (p->count + p->n_next->count <= K)
+                            merge_nodes(as_node(p), as_node(p->n_next));
+                        else
+                            p = p->n_next;
+                    }
+                }
+                // 让 it 成为某个节点的第一个元素，返回该节点；it 为 end() 时返回 header
+                NodeBase *split_at(NodeBase *nb, size_type idx)
+                {
+                    if (idx == 0)
+                        return nb;
+                    if (idx >= nb->count)
+                        return nb->n_next;
+                    return split_node(as_node(nb), idx);
+                }
+                /**
+                 * @brief splice 的核心：在 pos、first、last 三处切分出节点边界，然后把 [first, last) 对应的节点链整段移动到 pos 之前。
+                 * 同一节点里下标大的位置先切，这样之前取得的、下标更小的位置不受影响。返回指向第一个被移动元素的迭代器。
+                 */
+                iterator splice_nodes(const_iterator pos, UnrolledList &other, const_iterator first, const_iterator last)
+                {
+                    struct Cut
+                    {
+                        NodeBase *node;
+                        size_type index;
+                        NodeBase **out;
+                    };
+                    NodeBase *P, *F, *L;
+                    Cut cuts[3] = {{pos.node_ptr_, pos.index_, &P}, {first.node_ptr_, first.index_, &F}, {last.node_ptr_, last.index_, &L}};
+                    std::sort(std::begin(cuts), std::end(cuts), [](const Cut &a, const Cut &b)
+                              { return a.index > b.index; });
+                    for (auto &c : cuts)
+                        *c.out = split_at(c.node, c.index);
+                    if (this != std::addressof(other))
+                    {
+                        size_type moved = 0;
+                        for (NodeBase *p = F; p != L; p = p->n_next)
+                            moved += p->count;
+                        size_r += moved;
+                        other.size_r -= moved;
+                    }
+                    if (P != L)
+                    {
+                        NodeBase *prelast = L->n_prev;
+                        // 从原位置解开 [F, prelast]
+                        F->n_prev->n_next = L;
+                        L->n_prev = F->n_prev;
+                        // 链接到 P 之前
+                        F->n_prev = P->n_prev;
+                        prelast->n_next = P;
+                        P->n_prev->n_next = F;
+                        P->n_prev = prelast;
+                    }
+                    return iterator{F, 0};
+                }
+            };
+        }
+    }
+}
@@ -1,6 +1,18 @@
 #pragma once
 #include <memory>
 #include <exception>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <concepts>
+#include <bit>
+#include <memory_resource>
+#include <thread>
+#include <vector>
 #include <string>
 #include <sstream>
 namespace DSA
@@ -9,10 +21,140 @@ namespace DSA
     {
         namespace ArrayLike
         {
+            // --- Vector 的增长策略 ---
+            // next_capacity(当前容量, 至少需要的元素个数, 元素字节数) 返回扩容后的新容量，结果不小于 required
+
+            // 按固定倍数 Num / Den 增长
+            template <size_t Num, size_t Den = 1>
+            struct GrowthFactor
+            {
+                static_assert(Num > Den, "growth factor must be greater than 1");
+                static size_t next_capacity(size_t cap, size_t required, size_t)
+                {
+                    return std::max(cap * Num / Den, required);
+                }
+            };
+            using DoubleGrowth = GrowthFactor<2>;
+            using OneAndHalfGrowth = GrowthFactor<3, 2>;
+
+            /**
+             * @brief 按页取整的增长策略：先按 BaseGrowth 计算容量，缓冲区超过一页时把字节数向上取整到整页，
+             * 原本会浪费在最后半页里的空间也计入容量。适合很大的数组。
+             */
+            template <typename BaseGrowth = DoubleGrowth, size_t PageSize = 4096>
+            struct PageRoundedGrowth
+            {
+                static size_t next_capacity(size_t cap, size_t required, size_t elem_size)
+                {
+                    size_t new_cap = BaseGrowth::next_capacity(cap, required, elem_size);
+                    size_t bytes = new_cap * elem_size;
+                    if (bytes < PageSize)
+                        return new_cap;
+                    bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+                    return bytes / elem_size;
+                }
+            };
+
+            /**
+             * @brief 按 jemalloc 尺寸类取整的增长策略。
+             *
+             * jemalloc 实际分配的块大小是 8、16、32、48、……、128，之后每个 (2^k, 2^(k+1)] 区间再等分为 4 档，
+             * 申请的字节数会被向上取整到所在的尺寸类。把容量直接取整到尺寸类，就能用满分配器本来就会给出的空间。
+             */
+            template <typename BaseGrowth = DoubleGrowth>
+            struct SizeClassGrowth
+            {
+                static size_t size_class(size_t bytes)
+                {
+                    if (bytes <= 8)
+                        return 8;
+                    if (bytes <= 128)
+                        return (bytes + 15) / 16 * 16;
+                    size_t k = std::bit_width(bytes - 1) - 1; // 2^k < bytes <= 2^(k+1)
+                    size_t step = size_t(1) << (k - 2);
+                    return (bytes + step - 1) / step * step;
+                }
+                static size_t next_capacity(size_t cap, size_t required, size_t elem_size)
+                {
+                    size_t new_cap = BaseGrowth::next_capacity(cap, required, elem_size);
+                    return size_class(new_cap * elem_size) / elem_size;
+                }
+            };
+
+            template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = DoubleGrowth>
+            struct Vector;
+
+            // 构造标签：直接接管分配器中已经存在的数据（如文件映射中持久化的数组）
+            struct adopt_storage_t
+            {
+                explicit adopt_storage_t() = default;
+            };
+            inline constexpr adopt_storage_t adopt_storage{};
+            // 构造标签：元素只做默认初始化（平凡类型即不初始化），用于随后整体被覆盖写入的缓冲区
+            struct default_init_t
+            {
+                explicit default_init_t() = default;
+            };
+            inline constexpr default_init_t default_init{};
+            template <typename T, size_t N = 8, typename GrowthPolicy = DoubleGrowth>
+            struct SmallVector;
+
+            /**
+             * @brief 类型 T 是否可以“平凡重定位”：把对象按字节搬到新地址后，旧地址直接作废且不调用析构，结果等价于移动构造再析构。
+             *
+             * 平凡可拷贝的类型默认满足；std::unique_ptr 这类只持有指针、不引用自身地址的类型也满足，需要显式特化为 true。
+             * 注意 libstdc++ 的 std::string 在短字符串优化时持有指向自身的指针，不满足该性质。
+             */
+            template <typename T>
+            struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+            {
+            };
+            template <typename T>
+            struct is_trivially_relocatable<std::unique_ptr<T, std::default_delete<T>>> : std::true_type
+            {
+            };
+            template <typename T>
+            inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
             namespace detail
             {
+                // 超过这个字节数的新缓冲区才默认做多线程 first-touch
+                inline constexpr size_t first_touch_threshold = size_t(64) << 20;
+
+                /**
+                 * @brief 多线程 first-touch：把 [p, p + bytes) 按线程数切成连续的几段，每个线程向自己那段的每一页写一个字节。
+                 *
+                 * Linux 按“第一次写入该页的线程所在的 NUMA 节点”放置物理页，之后用同样的静态分块并行写入数据的线程
+                 * 就都在访问本地内存；顺带把缺页中断分摊到多个核上。写入的字节本来就是未初始化的内容，不影响语义。
+                 * threads 为 0 时，不足 first_touch_threshold 的缓冲区不做处理，否则使用 hardware_concurrency 个线程。
+                 */
+                inline void parallel_first_touch(void *p, size_t bytes, unsigned threads = 0)
+                {
+                    if (!threads)
+                        threads = bytes >= first_touch_threshold ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+                    if (threads < 2 || !bytes)
+                        return;
+                    const size_t page = 4096;
+                    unsigned char *base = static_cast<unsigned char *>(p);
+                    size_t chunk = (bytes / threads + page - 1) / page * page;
+                    std::vector<std::thread> workers;
+                    workers.reserve(threads);
+                    for (size_t begin = 0; begin < bytes; begin += chunk)
+                    {
+                        size_t end = std::min(bytes, begin + chunk);
+                        workers.emplace_back([base, begin, end, page]
+                                             {
+                                                 for (size_t off = begin; off < end; off += page)
+                                                     static_cast<volatile unsigned char *>(base)[off] = 0; });
+                    }
+                    for (auto &w : workers)
+                        w.join();
+                }
+
                 // 前向声明，因为 VectorBase 和 迭代器 相互引用
-                template <typename T>
+                template <typename T, typename Alloc = std::allocator<T>>
+                struct VectorMemoryBase;
+                template <typename T, typename MemoryBase = VectorMemoryBase<T>>
                 struct VectorBase;
 
                 template <typename T>
@@ -188,7 +330,7 @@ namespace DSA
                  * 它不关心内存中对象的构造和析构。这种关注点分离的设计使得代码更清晰。
                  * 它是不可拷贝的，但可移动，符合资源管理的“单一所有权”原则。
                  */
-                template <typename T>
+                template <typename T, typename Alloc>
                 struct VectorMemoryBase
                 {
 
@@ -199,14 +341,25 @@ namespace DSA
                     using const_pointer = const T *;
                     using size_type = size_t;
                     using difference_type = std::ptrdiff_t;
-                    using allocator_type = std::allocator<T>;
+                    using allocator_type = Alloc;
+                    using alloc_traits = std::allocator_traits<allocator_type>;
+                    // 可平凡重定位的元素使用 malloc/realloc 管理内存，扩容时可以原地延长，省去整块拷贝
+                    // 只在使用默认的 std::allocator 时启用，自定义分配器的内存总是交给分配器本身管理
+                    static constexpr bool use_realloc = is_trivially_relocatable_v<T> && std::is_same_v<allocator_type, std::allocator<T>> &&
+                                                        alignof(T) <= alignof(std::max_align_t);
+                    // 分配器自带 reallocate(p, old_n, new_n) 钩子（如 MmapAllocator 的 mremap）时，同样可以原地调整存储
+                    static constexpr bool has_reallocate_hook = is_trivially_relocatable_v<T> && requires(allocator_type &a, T *p, size_type n) {
+                        { a.reallocate(p, n, n) } -> std::same_as<T *>;
+                    };
+                    static constexpr bool can_reallocate_storage = use_realloc || has_reallocate_hook;
 
                     VectorMemoryBase() = default;
-                    explicit VectorMemoryBase(size_type n)
+                    explicit VectorMemoryBase(const allocator_type &a) : alloc(a) {}
+                    explicit VectorMemoryBase(size_type n, const allocator_type &a = allocator_type()) : alloc(a)
                     {
                         if (n)
                         {
-                            p_start = alloc.allocate(n); // 分配n个T大小的未初始化内存
+                            p_start = allocate_storage(n); // 分配n个T大小的未初始化内存
                             p_end_of_storage = p_start + n;
                         }
                     }
@@ -214,7 +367,7 @@ namespace DSA
                     {
                         if (p_start)
                         {
-                            alloc.deallocate(p_start, p_end_of_storage - p_start); // 释放内存
+                            deallocate_storage(p_start, p_end_of_storage - p_start); // 释放内存
                         }
                     }
                     // 删除拷贝构造和拷贝赋值，防止内存被重复释放
@@ -231,21 +384,71 @@ namespace DSA
                 protected:
                     T *p_start = nullptr;          // 指向已分配内存的起始位置
                     T *p_end_of_storage = nullptr; // 指向已分配内存的末尾之后的位置
-                    allocator_type alloc;
+                    [[no_unique_address]] allocator_type alloc;
+
+                    T *allocate_storage(size_type n)
+                    {
+                        if constexpr (use_realloc)
+                        {
+                            void *p = std::malloc(n * sizeof(T));
+                            if (!p)
+                                throw std::bad_alloc();
+                            return static_cast<T *>(p);
+                        }
+                        else
+                        {
+                            return alloc_traits::allocate(alloc, n);
+                        }
+                    }
+                    void deallocate_storage(T *p, size_type n)
+                    {
+                        if constexpr (use_realloc)
+                            std::free(p);
+                        else
+                            alloc_traits::deallocate(alloc, p, n);
+                    }
+                    // 用 realloc（或分配器的 reallocate 钩子）把存储调整为 n 个元素，已有元素按字节搬移（或原地保留）；
+                    // 调用者保证 n 不小于已构造元素数。返回新内存中的起始位置，调用者据此修正其余指针
+                    T *reallocate_storage(size_type n)
+                        requires can_reallocate_storage
+                    {
+                        if (!n)
+                        {
+                            if (p_start)
+                                deallocate_storage(p_start, p_end_of_storage - p_start);
+                            p_start = p_end_of_storage = nullptr;
+                            return nullptr;
+                        }
+                        if constexpr (use_realloc)
+                        {
+                            void *p = std::realloc(static_cast<void *>(p_start), n * sizeof(T));
+                            if (!p)
+                                throw std::bad_alloc();
+                            p_start = static_cast<T *>(p);
+                        }
+                        else
+                        {
+                            p_start = p_start ? alloc.reallocate(p_start, p_end_of_storage - p_start, n) : alloc_traits::allocate(alloc, n);
+                        }
+                        p_end_of_storage = p_start + n;
+                        return p_start;
+                    }
                 };
-                template <typename T>
+                template <typename T, typename MemoryBase = VectorMemoryBase<T>>
                 struct VectorGuard;
                 /**
                  * @brief Vector 的对象生命周期管理基类。
                  *
-                 * 继承自 VectorMemoryBase，这个类负责在已分配的原始内存上构造和析构对象。
+                 * 继承自 MemoryBase（默认为 VectorMemoryBase），这个类负责在已分配的原始内存上构造和析构对象。
                  * 它引入了 p_finish 指针来追踪已构造对象的末尾。
+                 * MemoryBase 只需提供 p_start、p_end_of_storage、alloc 以及与 VectorMemoryBase 相同的类型别名，
+                 * SmallVector 借此换上带内联缓冲区的内存基类。
                  */
-                template <typename T>
-                struct VectorBase : VectorMemoryBase<T>
+                template <typename T, typename MemoryBase>
+                struct VectorBase : MemoryBase
                 {
 
-                    using Base = VectorMemoryBase<T>;
+                    using Base = MemoryBase;
                     using value_type = Base::value_type;
                     using reference = Base::reference;
                     using const_reference = Base::const_reference;
@@ -255,13 +458,31 @@ namespace DSA
                     using difference_type = Base::difference_type;
                     using allocator_type = Base::allocator_type;
                     using traits = std::allocator_traits<allocator_type>; // 使用 traits 来与分配器交互，这是现代C++的推荐做法
-                    friend struct VectorGuard<T>;
+                    friend struct VectorGuard<T, MemoryBase>;
+                    // Vector 和 SmallVector 在扩容时需要操作临时的 VectorBase 对象
+                    template <typename U, typename A, typename G>
+                    friend struct ArrayLike::Vector;
+                    template <typename U, size_t N, typename G>
+                    friend struct ArrayLike::SmallVector;
 
                     VectorBase() { this->p_finish = this->p_start; }
-                    explicit VectorBase(size_type n) : VectorMemoryBase<T>(n)
+                    explicit VectorBase(size_type n) : MemoryBase(n)
                     {
                         this->p_finish = this->p_start;
                     }
+                    explicit VectorBase(const allocator_type &a) : MemoryBase(a)
+                    {
+                        this->p_finish = this->p_start;
+                    }
+                    VectorBase(size_type n, const allocator_type &a) : MemoryBase(n, a)
+                    {
+                        this->p_finish = this->p_start;
+                    }
+                    // 移动构造只转移三个指针，O(1)
+                    VectorBase(VectorBase &&other) noexcept : MemoryBase(std::move(other)), p_finish(other.p_finish)
+                    {
+                        other.p_finish = nullptr;
+                    }
                     // 清空容器，调用所有元素的析构函数，但不释放内存
                     void clear()
                     {
@@ -289,6 +510,9 @@ namespace DSA
                     // --- 在 p_finish 位置构造或销毁元素的底层接口 ---
                     void construct_at_end(const T &v) { construct_at_end_impl(v); }
                     void construct_at_end(T &&v) { construct_at_end_impl(std::move(v)); }
+                    // 用任意参数就地构造，供 emplace 系列接口使用
+                    template <typename... Args>
+                    void emplace_at_end(Args &&...args) { construct_at_end_impl(std::forward<Args>(args)...); }
                     void destroy_at_end()
                     {
                         --this->p_finish;
@@ -314,6 +538,42 @@ namespace DSA
                             construct_at_end_impl();
                     }
 
+                    // --- 可平凡重定位元素的插入与删除，用 memmove 整体搬移尾部 ---
+
+                    // 把 [pos, p_finish) 整体后移 n 格，再由 fill 在空出的位置上依次构造新元素
+                    // 调用前保证容量足够；构造失败时销毁已构造的新元素，并把尾部搬回原位
+                    template <typename Fill>
+                    void relocate_insert(size_type pos_index, size_type n, Fill fill)
+                    {
+                        pointer gap = this->p_start + pos_index;
+                        size_type tail = this->p_finish - gap;
+                        if (tail)
+                            std::memmove(static_cast<void *>(gap + n), gap, tail * sizeof(T));
+                        size_type built = 0;
+                        try
+                        {
+                            for (; built < n; ++built)
+                                fill(gap + built);
+                        }
+                        catch (...)
+                        {
+                            while (built)
+                                traits::destroy(this->alloc, gap + --built);
+                            if (tail)
+                                std::memmove(static_cast<void *>(gap), gap + n, tail * sizeof(T));
+                            throw;
+                        }
+                        this->p_finish += n;
+                    }
+                    // 析构 [first, last) 并把其后的元素前移补上空缺
+                    void relocate_erase(pointer first, pointer last)
+                    {
+                        for (pointer p = first; p != last; ++p)
+                            traits::destroy(this->alloc, p);
+                        std::memmove(static_cast<void *>(first), last, (this->p_finish - last) * sizeof(T));
+                        this->p_finish -= last - first;
+                    }
+
                 private:
                     // 使用可变参数模板和完美转发，将参数原封不动地传递给元素的构造函数
                     template <typename... Args>
@@ -331,14 +591,14 @@ namespace DSA
                  * 这个守护类的析构函数会自动被调用，它会销毁所有在这个失败操作中已经成功构造的元素，
                  * 从而使 Vector 恢复到操作开始前的状态，避免了内存泄漏和状态不一致。
                  */
-                template <typename T>
+                template <typename T, typename MemoryBase>
                 struct VectorGuard
                 {
-                    using pointer = VectorBase<T>::pointer;
-                    VectorBase<T> *guarded_instance; // 指向被守护的 VectorBase 实例
-                    pointer guarded_pos = nullptr;   // 记录操作开始时的 p_finish 位置
-                    bool commited = false;           // 标记操作是否成功提交
-                    explicit VectorGuard(VectorBase<T> *base_instance)
+                    using pointer = VectorBase<T, MemoryBase>::pointer;
+                    VectorBase<T, MemoryBase> *guarded_instance; // 指向被守护的 VectorBase 实例
+                    pointer guarded_pos = nullptr;               // 记录操作开始时的 p_finish 位置
+                    bool commited = false;                       // 标记操作是否成功提交
+                    explicit VectorGuard(VectorBase<T, MemoryBase> *base_instance)
                     {
                         guarded_instance = base_instance;
                         guarded_pos = base_instance->p_finish;
@@ -361,13 +621,18 @@ namespace DSA
              *
              * 继承自 VectorBase，实现了完整的 std::vector 接口，包括容量管理、
              * 元素访问、修改器（push_back, insert, erase等）。
+             * @tparam Alloc 分配器，遵循 propagate_on_container_* 传播规则，支持 std::pmr::polymorphic_allocator。
+             * @tparam GrowthPolicy 扩容时的容量增长策略，见 GrowthFactor / PageRoundedGrowth / SizeClassGrowth。
              */
-            template <typename T>
+            template <typename T, typename Alloc, typename GrowthPolicy>
             struct Vector final
-                : detail::VectorBase<T>
+                : detail::VectorBase<T, detail::VectorMemoryBase<T, Alloc>>
             {
-                static constexpr double grow_factor = 2.0; // 容量增长因子
-                using Base = detail::VectorBase<T>;
+                using growth_policy = GrowthPolicy;
+                // 元素可平凡重定位且移动不抛异常时，搬移元素一律用 memcpy / memmove
+                static constexpr bool relocatable = is_trivially_relocatable_v<T> && std::is_nothrow_move_constructible_v<T>;
+                using MemoryBase = detail::VectorMemoryBase<T, Alloc>;
+                using Base = detail::VectorBase<T, MemoryBase>;
                 using allocator_type = Base::allocator_type;
                 using value_type = Base::value_type;
                 using reference = Base::reference;
@@ -380,26 +645,122 @@ namespace DSA
                 using difference_type = Base::difference_type;
                 using reverse_iterator = std::reverse_iterator<iterator>;
                 using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-                using Guard = detail::VectorGuard<T>;
+                using Guard = detail::VectorGuard<T, MemoryBase>;
+                using traits = typename Base::traits;
                 Vector() = default;
-                explicit Vector(size_type n)
-                    : detail::VectorBase<T>(n)
+                explicit Vector(const allocator_type &a) : Base(a) {}
+                explicit Vector(size_type n, const allocator_type &a = allocator_type())
+                    : Base(n, a)
                 {
                     this->default_construct_at_end_multi(n);
                 }
-                explicit Vector(size_type n, const T &v)
-                    : detail::VectorBase<T>(n)
+                explicit Vector(size_type n, const T &v, const allocator_type &a = allocator_type())
+                    : Base(n, a)
                 {
                     this->construct_at_end_multi(n, v);
                 }
                 template <class InputIt>
-                explicit Vector(InputIt first, InputIt last)
+                    requires std::input_iterator<InputIt>
+                explicit Vector(InputIt first, InputIt last, const allocator_type &a = allocator_type())
+                    : Base(a)
                 {
                     // 委托给 insert 实现
                     insert(end(), first, last);
                 }
+                Vector(std::initializer_list<T> il, const allocator_type &a = allocator_type()) : Vector(il.begin(), il.end(), a) {}
+                // n 个默认初始化的元素：平凡类型不清零，内容不确定，必须先写后读
+                Vector(size_type n, default_init_t, const allocator_type &a = allocator_type())
+                    requires std::is_trivially_default_constructible_v<T>
+                    : Base(n, a)
+                {
+                    resize_for_overwrite(n);
+                }
+                // 拷贝构造时由分配器决定新容器使用哪个分配器（std::pmr 的分配器会退回默认内存资源）
+                Vector(const Vector &other)
+                    : Vector(other, traits::select_on_container_copy_construction(other.alloc)) {}
+                Vector(const Vector &other, const allocator_type &a)
+                    : Base(other.size(), a)
+                {
+                    Guard guard_tmp(this);
+                    for (const T &v : other)
+                        this->construct_at_end(v);
+                    guard_tmp.commit();
+                }
+                // 移动构造直接接管 other 的缓冲区，other 变为空
+                Vector(Vector &&other) noexcept : Base(std::move(other)) {}
+                // 指定分配器的移动构造：分配器相等时接管缓冲区，否则只能逐个移动元素到新分配的内存中
+                Vector(Vector &&other, const allocator_type &a)
+                    : Base(a)
+                {
+                    if (this->alloc == other.alloc)
+                    {
+                        take_storage(other);
+                        return;
+                    }
+                    reserve(other.size());
+                    Guard guard_tmp(this);
+                    for (T &v : other)
+                        this->construct_at_end(std::move(v));
+                    guard_tmp.commit();
+                }
+                Vector &operator=(const Vector &other)
+                {
+                    if (this != std::addressof(other))
+                    {
+                        // 先用最终要使用的分配器完整拷贝一份，再接管它，保证强异常安全
+                        constexpr bool propagate = traits::propagate_on_container_copy_assignment::value;
+                        Vector tmp(other, propagate ? other.alloc : this->alloc);
+                        take_storage(tmp);
+                        if constexpr (propagate)
+                            this->alloc = other.alloc;
+                    }
+                    return *this;
+                }
+                Vector &operator=(Vector &&other) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value)
+                {
+                    if (this == std::addressof(other))
+                        return *this;
+                    if constexpr (traits::propagate_on_container_move_assignment::value)
+                    {
+                        take_storage(other);
+                        this->alloc = std::move(other.alloc);
+                    }
+                    else if (traits::is_always_equal::value || this->alloc == other.alloc)
+                    {
+                        take_storage(other);
+                    }
+                    else
+                    {
+                        // 分配器不相等又不能传播：other 的内存不能由本容器释放，只能逐个移动元素
+                        Vector tmp(std::move(other), this->alloc);
+                        take_storage(tmp);
+                    }
+                    return *this;
+                }
+                /**
+                 * @brief 零拷贝地重新加载分配器中已有的数组，例如 MmapAllocator 文件模式下持久化的数据。
+                 * 分配器需提供 map_existing()，返回 {起始地址, 元素个数}；加载后 size() == capacity()。
+                 */
+                Vector(adopt_storage_t, const allocator_type &a)
+                    requires requires(allocator_type &al) { al.map_existing(); }
+                    : Base(a)
+                {
+                    auto [p, n] = this->alloc.map_existing();
+                    this->p_start = p;
+                    this->p_finish = p + n;
+                    this->p_end_of_storage = p + n;
+                }
+                allocator_type get_allocator() const { return this->alloc; }
                 void clear() { Base::clear(); }
-                ~Vector() = default;
+                ~Vector()
+                {
+                    // 分配器需要知道有效元素个数时（如 MmapAllocator 文件模式要把文件截断到有效长度），释放存储前告知它
+                    if constexpr (requires(allocator_type &al, T *p, size_type n) { al.persist(p, n); })
+                    {
+                        if (this->p_start)
+                            this->alloc.persist(this->p_start, size());
+                    }
+                }
                 size_type size() const { return this->p_finish - this->p_start; }
                 bool empty() const { return this->p_finish == this->p_start; }
                 size_type capacity() const { return this->p_end_of_storage - this->p_start; }
@@ -434,13 +795,14 @@ namespace DSA
                 void assign(size_type n, const T &v)
                 {
                     // 使用 "拷贝再交换" (copy-and-swap) 惯用法，提供强异常保证
-                    Vector tmp(n, v);
+                    Vector tmp(n, v, this->alloc);
                     this->swap(tmp);
                 }
                 template <class InputIt>
+                    requires std::input_iterator<InputIt>
                 void assign(InputIt first, InputIt last)
                 {
-                    Vector tmp(first, last);
+                    Vector tmp(first, last, this->alloc);
                     this->swap(tmp);
                 }
 
@@ -480,6 +842,25 @@ namespace DSA
                     while (size() > n)
                         this->destroy_at_end();
                 }
+                /**
+                 * @brief 调整大小，但新增的元素不做值初始化（不清零），只适用于平凡可默认构造的类型。
+                 * 适合随后会被 I/O 或计算整体覆盖的缓冲区，省去一次完整的清零写入。
+                 * @param threads first-touch 的线程数，见 detail::parallel_first_touch；传 1 表示不做 first-touch。
+                 */
+                void resize_for_overwrite(size_type n, unsigned threads = 0)
+                    requires std::is_trivially_default_constructible_v<T>
+                {
+                    if (capacity() < n)
+                        reallocate(calc_new_capacity(n));
+                    if (size() < n)
+                    {
+                        detail::parallel_first_touch(this->p_finish, (n - size()) * sizeof(T), threads);
+                        // 平凡默认构造没有任何效果，直接移动 p_finish 即可
+                        this->p_finish = this->p_start + n;
+                    }
+                    while (size() > n)
+                        this->destroy_at_end();
+                }
                 void resize(size_type n, const T &v)
                 {
                     if (capacity() < n)
@@ -493,40 +874,83 @@ namespace DSA
                     while (size() > n)
                         this->destroy_at_end();
                 }
-                void push_back(const T &v)
+                void push_back(const T &v) { emplace_back(v); }
+                void push_back(T &&v) { emplace_back(std::move(v)); }
+                template <typename... Args>
+                reference emplace_back(Args &&...args)
                 {
                     if (size() == capacity())
                     {
-                        size_type new_cap = calc_new_capacity(size() + 1);
-                        reallocate(new_cap);
+                        // 参数可能引用本容器内的元素，扩容会把它们移走，所以先构造出新值
+                        T v(std::forward<Args>(args)...);
+                        reallocate(calc_new_capacity(size() + 1));
+                        this->construct_at_end(std::move(v));
                     }
-                    this->construct_at_end(v);
+                    else
+                    {
+                        this->emplace_at_end(std::forward<Args>(args)...);
+                    }
+                    return back();
                 }
                 void pop_back() { this->destroy_at_end(); }
-                iterator insert(const_iterator pos, const T &v)
+                template <typename... Args>
+                iterator emplace(const_iterator pos, Args &&...args)
                 {
                     size_type pos_index = pos - cbegin();
-                    if (size() == capacity())
+                    if (pos_index == size())
+                    {
+                        emplace_back(std::forward<Args>(args)...);
+                        return begin() + pos_index;
+                    }
+                    T v(std::forward<Args>(args)...);
+                    if constexpr (relocatable)
+                    {
+                        if (size() == capacity())
+                            reallocate(calc_new_capacity(size() + 1));
+                        this->relocate_insert(pos_index, 1, [&](pointer p)
+                                        { traits::construct(this->alloc, p, std::move(v)); });
+                    }
+                    else if (size() == capacity())
+                    {
+                        // 扩容时直接在新内存中按 前缀、新元素、后缀 的顺序构造，不再需要二次搬移
+                        Base tmp(calc_new_capacity(size() + 1), this->alloc);
+                        tmp.construct_at_end_range(this->p_start, this->p_start + pos_index);
+                        tmp.construct_at_end(std::move(v));
+                        tmp.construct_at_end_range(this->p_start + pos_index, this->p_finish);
+                        this->Base::swap(tmp);
+                    }
+                    else
                     {
-                        size_type new_cap = calc_new_capacity(size() + 1);
-                        reallocate(new_cap);
+                        // 最后一个元素移动构造到末尾，其余元素依次后移一格，再把新值移入空位
+                        this->construct_at_end(std::move(*(this->p_finish - 1)));
+                        std::move_backward(begin() + pos_index, end() - 2, end() - 1);
+                        *(begin() + pos_index) = std::move(v);
                     }
-                    this->construct_at_end(v); // 在末尾构造一个临时元素
-                    // 使用 std::rotate 将末尾的元素旋转到正确的位置，这是一种高效的移动方式
-                    std::rotate(begin() + pos_index, end() - 1, end());
                     return begin() + pos_index;
                 }
+                iterator insert(const_iterator pos, const T &v) { return emplace(pos, v); }
+                iterator insert(const_iterator pos, T &&v) { return emplace(pos, std::move(v)); }
                 iterator insert(const_iterator pos, size_type n, const T &v)
                 {
                     size_type pos_index = pos - cbegin();
                     if (!n)
                         return begin() + pos_index;
+                    if constexpr (relocatable)
+                    {
+                        // v 可能引用容器内的元素，搬移前先复制一份
+                        T copy(v);
+                        if (capacity() - size() < n)
+                            reallocate(calc_new_capacity(size() + n));
+                        this->relocate_insert(pos_index, n, [&](pointer p)
+                                        { traits::construct(this->alloc, p, copy); });
+                        return begin() + pos_index;
+                    }
                     // 检查剩余容量是否足够
                     if (capacity() - size() < n)
                     {
                         size_type new_cap = calc_new_capacity(size() + n);
                         // 创建一个临时的 Base 对象来执行重新分配和插入，以保证异常安全
-                        Base tmp(new_cap);
+                        Base tmp(new_cap, this->alloc);
                         tmp.construct_at_end_range(this->p_start, this->p_start + pos_index);
                         tmp.construct_at_end_multi(n, v);
                         tmp.construct_at_end_range(this->p_start + pos_index, this->p_finish);
@@ -541,7 +965,9 @@ namespace DSA
                     }
                     return begin() + pos_index;
                 }
+                // 传入 std::move_iterator 时元素会被移动而不是拷贝
                 template <typename InputIt>
+                    requires std::input_iterator<InputIt>
                 iterator insert(const_iterator pos, InputIt first, InputIt last)
                 {
                     // 使用迭代器萃取 (iterator_traits) 来获取迭代器的类型
@@ -553,9 +979,16 @@ namespace DSA
                     insert_dispatch(pos_index, first, last, Category());
                     return begin() + pos_index;
                 }
+                iterator insert(const_iterator pos, std::initializer_list<T> il) { return insert(pos, il.begin(), il.end()); }
                 iterator erase(const_iterator pos)
                 {
                     iterator nonconst_pos = begin() + (pos - cbegin());
+                    if constexpr (relocatable)
+                    {
+                        pointer p = this->p_start + (pos - cbegin());
+                        this->relocate_erase(p, p + 1);
+                        return nonconst_pos;
+                    }
                     // 使用 std::move 将删除点之后的元素向前移动，覆盖被删除的元素
                     std::move(nonconst_pos + 1, end(), nonconst_pos);
                     pop_back(); // 销毁最后一个（现在是多余的）元素
@@ -567,7 +1000,11 @@ namespace DSA
                     iterator nonconst_last = begin() + (last - cbegin());
                     if (first == last)
                         return nonconst_last;
-                    size_type pos_index = first - cbegin();
+                    if constexpr (relocatable)
+                    {
+                        this->relocate_erase(this->p_start + (first - cbegin()), this->p_start + (last - cbegin()));
+                        return nonconst_first;
+                    }
                     // 将范围之后的元素向前移动
                     iterator new_end = std::move(nonconst_last, end(), nonconst_first);
                     // 销毁所有移动后末尾多余的元素
@@ -576,6 +1013,7 @@ namespace DSA
                     return nonconst_first;
                 }
 
+                // 分配器不随 swap 传播时，要求两个容器的分配器相等（与标准库相同）
                 void swap(Vector &other)
                 {
                     if (this != std::addressof(other))
@@ -583,13 +1021,45 @@ namespace DSA
                 }
 
             protected:
+                // 销毁自身元素、用自身的分配器释放缓冲区，然后接管 other 的缓冲区
+                // 调用者保证接管之后 this->alloc 能够释放 other 的内存
+                void take_storage(Vector &other) noexcept
+                {
+                    clear();
+                    if (this->p_start)
+                        this->deallocate_storage(this->p_start, capacity());
+                    this->p_start = other.p_start;
+                    this->p_finish = other.p_finish;
+                    this->p_end_of_storage = other.p_end_of_storage;
+                    other.p_start = other.p_finish = other.p_end_of_storage = nullptr;
+                }
                 // 内存重新分配函数
                 // 假设 new_cap >= size()
                 // assuming new_cap>=size()
                 void reallocate(size_type new_cap)
                 {
+                    if constexpr (relocatable)
+                    {
+                        size_type n = size();
+                        if constexpr (Base::can_reallocate_storage)
+                        {
+                            // realloc / mremap 能原地延长时完全不搬移元素，否则由它按字节拷贝到新内存
+                            this->p_finish = this->reallocate_storage(new_cap) + n;
+                        }
+                        else
+                        {
+                            Base vec_base(new_cap, this->alloc);
+                            if (n)
+                                std::memcpy(static_cast<void *>(vec_base.p_start), this->p_start, n * sizeof(T));
+                            vec_base.p_finish = vec_base.p_start + n;
+                            // 元素已经按字节搬走，旧内存里的对象不再析构
+                            this->p_finish = this->p_start;
+                            this->Base::swap(vec_base);
+                        }
+                        return;
+                    }
                     // 1. 创建一个新的内存基座
-                    Base vec_base(new_cap);
+                    Base vec_base(new_cap, this->alloc);
                     // 2. 将现有元素移动（或拷贝）到新内存中
                     //    construct_at_end_range 内部使用 std::move_if_noexcept 实现了优化
                     vec_base.construct_at_end_range(this->p_start, this->p_finish);
@@ -605,16 +1075,24 @@ namespace DSA
                 void insert_dispatch(size_type pos_index, ForwardIt first, ForwardIt last,
                                      std::forward_iterator_tag)
                 {
-                    auto n = std::distance(first, last);// 可以安全地计算距离
+                    size_type n = std::distance(first, last); // 可以安全地计算距离
                     if (!n)
                         return;
+                    if constexpr (relocatable)
+                    {
+                        if (capacity() - size() < n)
+                            reallocate(calc_new_capacity(size() + n));
+                        this->relocate_insert(pos_index, n, [&](pointer p)
+                                        { traits::construct(this->alloc, p, *first); ++first; });
+                        return;
+                    }
 
                     if (capacity() - size() >= n)
                     {
                         Guard guard_tmp(this);
                         for (auto it = first; it != last; ++it)
                         {
-                            this->construct_at_end(*it);
+                            this->emplace_at_end(*it);
                         }
                         guard_tmp.commit();
                         std::rotate(begin() + pos_index, end() - n, end());
@@ -622,10 +1100,10 @@ namespace DSA
                     else
                     {
                         size_type new_cap = calc_new_capacity(size() + n);
-                        Base tmp(new_cap);
+                        Base tmp(new_cap, this->alloc);
                         tmp.construct_at_end_range(this->p_start, this->p_start + pos_index);
                         for (auto it = first; it != last; ++it)
-                            tmp.construct_at_end(*it);
+                            tmp.emplace_at_end(*it);
                         tmp.construct_at_end_range(this->p_start + pos_index, this->p_finish);
                         this->Base::swap(tmp);
                     }
@@ -640,11 +1118,11 @@ namespace DSA
                                      std::input_iterator_tag)
                 {
                     // 创建一个临时 vector 来存储所有最终元素
-                    Vector tmp;
+                    Vector tmp(this->alloc);
                     tmp.reserve(size());// 预先分配一些容量以减少重分配
                     tmp.construct_at_end_range(this->p_start, this->p_start + pos_index);
                     for (; first != last; ++first)
-                        tmp.push_back(*first);
+                        tmp.emplace_back(*first);
                     for (auto it = begin() + pos_index; it != end(); ++it)
                     {
                         tmp.push_back(std::move_if_noexcept(*it));
@@ -655,13 +1133,17 @@ namespace DSA
                 // 计算新容量的策略
                 size_type calc_new_capacity(size_type new_size)
                 {
-                    
-                    // 常见的指数增长策略，确保 push_back 的摊还时间复杂度为 O(1)
-                    size_type new_cap = capacity() * grow_factor;
-                    return std::max(new_cap, new_size);
+                    // 由增长策略决定，默认的指数增长保证 push_back 的摊还时间复杂度为 O(1)
+                    return GrowthPolicy::next_capacity(capacity(), new_size, sizeof(T));
                 }
             };
 
+            namespace pmr
+            {
+                // 从 std::pmr::memory_resource 分配内存的 Vector，可以配合 monotonic_buffer_resource 等内存池使用
+                template <typename T, typename GrowthPolicy = DoubleGrowth>
+                using Vector = ArrayLike::Vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+            }
         }
     }
 
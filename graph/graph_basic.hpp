@@ -2,8 +2,8 @@
 #include <iostream>
 #include <vector>
 #include <stack>
-#include <queue>
 #include <tuple>
+#include "../collections/queue_stack.hpp"
 
 namespace DSA
 {
@@ -87,7 +87,7 @@ namespace DSA
 				Graph g;
 				int visited;
 				std::vector<int> vis;
-				std::queue<int> vis_queue;
+				Collections::RingQueue<int> vis_queue;
 				void BFS(int u)
 				{
 					vis_queue.push(u);
@@ -99,14 +99,17 @@ namespace DSA
 						vis_queue.pop();
 						for (auto v : g.adj[u])
 							if (!vis[v])
+							{
+								vis[v] = ++visited;
 								vis_queue.push(v);
+							}
 					}
 				}
 				static void Demo(int n, const std::vector<std::pair<int, int>> &edges, bool directed = false)
 				{
 					auto instance = BasicDemoBFS();
 					instance.g = Graph(n, edges, directed);
-					instance.vis_queue = std::queue<int>();
+					instance.vis_queue = Collections::RingQueue<int>();
 					instance.vis = std::vector<int>(n + 1, 0);
 					instance.visited = 0;
 					instance.BFS(1);
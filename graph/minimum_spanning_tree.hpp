@@ -37,8 +37,8 @@ namespace DSA
                  * 4. 重复步骤 3，直到选择了 n-1 条边（n是节点数）。
                  * 该算法使用并查集 (DSU) 来高效地检测环。
                  */
-                template <typename T = int>
-                bool Kruskal(const WGraph<T> &g, T &sum, std::vector<T> &chosen)
+                template <typename T = int, typename AdjList>
+                bool Kruskal(const WGraph<T, AdjList> &g, T &sum, std::vector<T> &chosen)
                 {
                     chosen.clear();            // 清空结果向量，以防之前有数据。
                     DSU dsu(g.number_of_node); // 初始化并查集，每个节点自成一个T集合。
@@ -89,8 +89,8 @@ namespace DSA
                  * 4. 重复步骤 2 和 3，直到所有节点都加入树中。
                  * 这个实现使用了优先队列来高效地找到符合条件的最小权重边。
                  */
-                template <typename T = int>
-                bool Prim(const WGraph<T> &g, T &sum, std::vector<int> &chosen)
+                template <typename T = int, typename AdjList>
+                bool Prim(const WGraph<T, AdjList> &g, T &sum, std::vector<int> &chosen)
                 {
                     chosen.clear();
                     // dis[v] 存储将节点 v 连接到当前生成树所需的最小边权重。inf 表示 v 还未被触及。
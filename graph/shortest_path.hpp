@@ -31,8 +31,8 @@ namespace DSA
                  * 它可以处理带负权的边，并且可以检测出负权环的存在。
                  * 算法核心思想：对于每一对顶点 i 和 j，检查是否存在一个顶点 k，使得从 i到k再到j的路径比已知的 i到j 的路径更短。
                  */
-                template <typename T = int>
-                bool Floyd(const WGraph<T> &g, std::vector<std::vector<T>> &dis)
+                template <typename T = int, typename AdjList>
+                bool Floyd(const WGraph<T, AdjList> &g, std::vector<std::vector<T>> &dis)
                 {
                     int n = g.number_of_node; // 获取图中的节点数量。
 
@@ -78,8 +78,8 @@ namespace DSA
                  * 算法思想：对图中的所有边进行 n-1 轮松弛操作。因为一条不含环的最短路径最多有 n-1 条边。
                  * 如果在 n-1 轮后仍能进行松弛，则说明图中存在负权环。
                  */
-                template <typename T = int>
-                bool BellmanFord(const WGraph<T> &g, int s, std::vector<T> &dis)
+                template <typename T = int, typename AdjList>
+                bool BellmanFord(const WGraph<T, AdjList> &g, int s, std::vector<T> &dis)
                 {
                     int n = g.number_of_node; // 获取节点数。
 
@@ -130,8 +130,8 @@ namespace DSA
                  * 它不盲目地对所有边进行松弛，而是维护一个队列，只将被成功松弛的节点的邻居加入队列中。
                  * 在随机数据上平均时间复杂度优于 Bellman-Ford，约为 O(m)，但最坏情况下仍为 O(n*m)。
                  */
-                template <typename T = int>
-                bool BellmanFord_Queue(const WGraph<T> &g, int s, std::vector<T> &dis)
+                template <typename T = int, typename AdjList>
+                bool BellmanFord_Queue(const WGraph<T, AdjList> &g, int s, std::vector<T> &dis)
                 {
                     int n = g.number_of_node;
                     dis = std::vector<T>(n + 1, Infinity<T>());
@@ -141,7 +141,8 @@ namespace DSA
                     // cnt[i] 记录从源点 s 到节点 i 的最短路径所包含的边数。
                     std::vector<int> cnt(n + 1);
                     // q 是一个先进先出的队列，存放待处理的节点。
-                    std::queue<int> q;
+                    // 环形缓冲区只随队列的峰值长度增长，循环使用同一段常驻缓存的内存
+                    Collections::RingQueue<int> q;
                     // inq[i] 标记节点 i 当前是否在队列中，以避免重复添加。
                     std::vector<int> inq(n + 1); // avoid using std::vector<bool> which never store bool
                     // 算法从源点 s 开始。
@@ -200,8 +201,8 @@ namespace DSA
                  * 核心思想：维护一个已找到最短路径的节点集合，每次从未处理的节点中选择距离源点最近的一个加入集合，并更新其邻居的距离。
                  * 这个实现使用了优先队列（最小堆）和“懒惰删除”技巧。
                  */
-                template <typename T = int>
-                bool Dijkstra(const WGraph<T> &g, int s, std::vector<T> &dis)
+                template <typename T = int, typename AdjList>
+                bool Dijkstra(const WGraph<T, AdjList> &g, int s, std::vector<T> &dis)
                 {
                     int n = g.number_of_node;
                     dis = std::vector<T>(n + 1, Infinity<T>());
@@ -46,7 +46,7 @@ namespace DSA
                     for (auto e : g.E)
                         ++ind[e.v];
                     // q 是一个队列，用于存放当前入度为 0 的节点。
-                    std::queue<int> q;
+                    Collections::RingQueue<int> q;
                     // 找到所有初始入度为 0 的节点并入队。
                     for (int i = 1; i <= n; i++)
                         if (!ind[i])
@@ -129,8 +129,8 @@ namespace DSA
                  * 3. 有且仅有一个汇点（出度为0的节点）。
                  * 4. 所有边的权重（代表活动持续时间）必须为非负数。
                  */
-                template <typename T = int>
-                bool validateAOE(const WGraph<T> &g, std::vector<int> &topo_order)
+                template <typename T = int, typename AdjList>
+                bool validateAOE(const WGraph<T, AdjList> &g, std::vector<int> &topo_order)
                 {
                     int n = g.number_of_node, begin_v = 0, end_v = 0;
 
@@ -183,8 +183,8 @@ namespace DSA
                  * @param latest 输出参数，每个事件的最迟发生时间。
                  * @return bool 如果分析成功，返回 true；如果图不是有效的 AOE 网络，返回 false。
                  */
-                template <typename T = int>
-                bool resolve(const WGraph<T> &g, T &critical_path, std::vector<int> &critical_event, std::vector<int> &earliest, std::vector<int> &latest)
+                template <typename T = int, typename AdjList>
+                bool resolve(const WGraph<T, AdjList> &g, T &critical_path, std::vector<int> &critical_event, std::vector<int> &earliest, std::vector<int> &latest)
                 {
                     std::vector<int> order; // 用于存储拓扑排序结果。
                     int n = g.number_of_node;
@@ -6,6 +6,7 @@
 #include <queue>
 #include <tuple>
 #include "graph_basic.hpp"
+#include "../collections/small_vector.hpp"
 namespace DSA
 {
     namespace Graph
@@ -33,20 +34,29 @@ namespace DSA
                 int edge_index = 0;
             };
 
-            template <typename T=int>
+            // 小缓冲区邻接表：度数不超过 N 的顶点不做堆分配
+            template <typename T = int, size_t N = 4>
+            using SmallAdjList = Collections::ArrayLike::SmallVector<WeightedAdjoint<T>, N>;
+
+            /**
+             * @brief 带权图。
+             * @tparam AdjList 每个顶点的邻接表容器，需支持 push_back 与范围 for 遍历；
+             *         大多数顶点度数很低时可以用 SmallAdjList<T> 减少堆分配。
+             */
+            template <typename T = int, typename AdjList = vector<WeightedAdjoint<T>>>
             struct WGraph
             {
                 int number_of_node;
                 bool is_directed;
                 vector<WeightedEdge<T>> E;
 
-                vector<vector<WeightedAdjoint<T>>> adj;
+                vector<AdjList> adj;
                 WGraph(int n = 0, const vector<tuple<int, int, T>> &edges = {}, bool directed = false)
                 {
                     n = std::max(n, 0);
                     number_of_node = n;
                     is_directed = directed;
-                    adj = vector<vector<WeightedAdjoint<T>>>(n + 1);
+                    adj = vector<AdjList>(n + 1);
                     int i = 0;
                     for (auto e : edges)
                     {
@@ -0,0 +1,386 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "work_stealing_deque.hpp"
+#include "../collections/deque.hpp"
+namespace DSA
+{
+    namespace Parallel
+    {
+        class Scheduler;
+        class TaskGroup;
+
+        namespace detail
+        {
+            struct Task
+            {
+                TaskGroup *group;
+                explicit Task(TaskGroup *g) : group(g) {}
+                virtual void run() = 0;
+                virtual ~Task() = default;
+            };
+            template <typename F>
+            struct TaskImpl final : Task
+            {
+                F f;
+                TaskImpl(TaskGroup *g, F &&fn) : Task(g), f(std::move(fn)) {}
+                void run() override { f(); }
+            };
+            // 当前线程是哪个调度器的第几个工作线程；非工作线程的 scheduler 为空
+            struct WorkerSlot
+            {
+                Scheduler *scheduler = nullptr;
+                unsigned index = 0;
+                uint32_t rng = 0x9e3779b9u; // 选择窃取对象用的 xorshift 状态
+            };
+            inline WorkerSlot &current_worker()
+            {
+                thread_local WorkerSlot slot;
+                return slot;
+            }
+        }
+
+        /**
+         * @brief fork/join 线程池：每个工作线程一个 Chase-Lev 工作窃取队列。
+         *
+         * - 工作线程产生的任务放进自己的队列底端，自己也从底端取（后进先出，数据在缓存里）；
+         * - 空闲的工作线程从随机挑选的其他队列顶端窃取（先进先出，拿到的是最大的那块工作）；
+         * - 非工作线程提交的任务进入一个加锁的注入队列；
+         * - 等待子任务的线程（TaskGroup::sync）不睡眠，而是帮忙执行可运行的任务，嵌套的 fork/join 不会死锁；
+         * - 找不到工作时先自旋，再在 epoch 计数器上 atomic::wait 睡眠，提交任务时只在确有睡眠者时才 notify；
+         * - Linux 上工作线程 i 绑定到进程亲和性掩码中的第 i 个可用 CPU（pin_threads），避免线程在核之间迁移、丢失缓存；
+         *   进程被 taskset / cgroup 限制在部分 CPU 上时也只会绑定到允许的 CPU。
+         *
+         * 排序、图算法等的并行版本应当共用 default_scheduler()，而不是每次调用都创建线程。
+         */
+        class Scheduler
+        {
+        public:
+            static constexpr int spin_rounds = 64;
+
+            // threads 为 0 时使用 hardware_concurrency 个工作线程
+            explicit Scheduler(unsigned threads = 0, bool pin_threads = true)
+            {
+                if (!threads)
+                    threads = std::max(1u, std::thread::hardware_concurrency());
+                for (unsigned i = 0; i < threads; ++i)
+                    workers.push_back(std::make_unique<Worker>());
+                std::vector<int> cpus = pin_threads ? allowed_cpus() : std::vector<int>{};
+                for (unsigned i = 0; i < threads; ++i)
+                {
+                    workers[i]->thread = std::thread([this, i]
+                                                     { worker_loop(i); });
+                    if (!cpus.empty())
+                        pin(workers[i]->thread, cpus[i % cpus.size()]);
+                }
+            }
+            ~Scheduler()
+            {
+                stop.store(true, std::memory_order_seq_cst);
+                epoch.fetch_add(1, std::memory_order_seq_cst);
+                epoch.notify_all();
+                for (auto &w : workers)
+                    w->thread.join();
+            }
+            Scheduler(const Scheduler &) = delete;
+            Scheduler &operator=(const Scheduler &) = delete;
+
+            unsigned num_workers() const { return unsigned(workers.size()); }
+            // 当前线程是否为本调度器的工作线程
+            bool on_worker_thread() const { return detail::current_worker().scheduler == this; }
+
+            // 工作线程放进自己的队列，其他线程放进注入队列，然后唤醒睡眠中的工作线程
+            void submit(detail::Task *task)
+            {
+                auto &slot = detail::current_worker();
+                if (slot.scheduler == this)
+                    workers[slot.index]->deque.push(task);
+                else
+                {
+                    std::lock_guard<std::mutex> lk(inject_mutex);
+                    injected.push_back(task);
+                    inject_count.fetch_add(1, std::memory_order_release);
+                }
+                epoch.fetch_add(1, std::memory_order_seq_cst);
+                if (sleepers.load(std::memory_order_seq_cst) > 0)
+                    epoch.notify_all();
+            }
+            /**
+             * @brief 找一个可运行的任务并执行：先取自己的队列，再取注入队列，最后从其他工作线程窃取。
+             * @return 是否执行了任务。
+             */
+            bool run_one()
+            {
+                detail::Task *task = find_task();
+                if (!task)
+                    return false;
+                execute(task);
+                return true;
+            }
+
+        private:
+            struct Worker
+            {
+                WorkStealingDeque<detail::Task *> deque;
+                std::thread thread;
+            };
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::mutex inject_mutex;
+            Collections::ArrayLike::Deque<detail::Task *> injected;
+            alignas(64) std::atomic<size_t> inject_count{0};
+            alignas(64) std::atomic<uint32_t> epoch{0};
+            std::atomic<int> sleepers{0};
+            std::atomic<bool> stop{false};
+
+            // 当前进程亲和性掩码中允许运行的 CPU 编号；取不到时返回空，不绑定
+            static std::vector<int> allowed_cpus()
+            {
+                std::vector<int> res;
+#if defined(__linux__)
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (::sched_getaffinity(0, sizeof(set), &set) == 0)
+                {
+                    for (int c = 0; c < CPU_SETSIZE; ++c)
+                        if (CPU_ISSET(c, &set))
+                            res.push_back(c);
+                }
+#endif
+                return res;
+            }
+            static void pin([[maybe_unused]] std::thread &th, [[maybe_unused]] int cpu)
+            {
+#if defined(__linux__)
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                ::pthread_setaffinity_np(th.native_handle(), sizeof(set), &set);
+#endif
+            }
+            detail::Task *find_task()
+            {
+                auto &slot = detail::current_worker();
+                bool is_worker = slot.scheduler == this;
+                if (is_worker)
+                    if (auto t = workers[slot.index]->deque.pop())
+                        return *t;
+                if (inject_count.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lk(inject_mutex);
+                    if (!injected.empty())
+                    {
+                        detail::Task *t = injected.front();
+                        injected.pop_front();
+                        inject_count.fetch_sub(1, std::memory_order_relaxed);
+                        return t;
+                    }
+                }
+                // 从随机位置开始把其他队列各试一遍
+                unsigned n = num_workers();
+                slot.rng ^= slot.rng << 13;
+                slot.rng ^= slot.rng >> 17;
+                slot.rng ^= slot.rng << 5;
+                unsigned start = slot.rng % n;
+                for (unsigned k = 0; k < n; ++k)
+                {
+                    unsigned victim = (start + k) % n;
+                    if (is_worker && victim == slot.index)
+                        continue;
+                    if (auto t = workers[victim]->deque.steal())
+                        return *t;
+                }
+                return nullptr;
+            }
+            inline void execute(detail::Task *task);
+            void worker_loop(unsigned index)
+            {
+                auto &slot = detail::current_worker();
+                slot.scheduler = this;
+                slot.index = index;
+                slot.rng += index * 0x6d2b79f5u;
+                while (!stop.load(std::memory_order_acquire))
+                {
+                    bool ran = false;
+                    for (int i = 0; i < spin_rounds && !ran; ++i)
+                    {
+                        ran = run_one();
+                        if (!ran)
+                            std::this_thread::yield();
+                    }
+                    if (ran)
+                        continue;
+                    // 先读 epoch 再最后检查一次：检查之后提交的任务一定会改变 epoch，wait 会立即返回
+                    uint32_t e = epoch.load(std::memory_order_seq_cst);
+                    if (run_one())
+                        continue;
+                    sleepers.fetch_add(1, std::memory_order_seq_cst);
+                    if (!stop.load(std::memory_order_acquire))
+                        epoch.wait(e, std::memory_order_seq_cst);
+                    sleepers.fetch_sub(1, std::memory_order_relaxed);
+                }
+                slot.scheduler = nullptr;
+            }
+        };
+
+        // 全局共享的调度器，第一次使用时创建
+        inline Scheduler &default_scheduler()
+        {
+            static Scheduler scheduler;
+            return scheduler;
+        }
+
+        /**
+         * @brief 一组 fork/join 任务：spawn 派生子任务，sync 等待全部完成。
+         *
+         * sync 期间当前线程会帮忙执行任何可运行的任务；子任务抛出的第一个异常在 sync 中重新抛出。
+         * 析构时会等待尚未完成的子任务（但不再抛出异常）。
+         */
+        class TaskGroup
+        {
+        public:
+            explicit TaskGroup(Scheduler &s = default_scheduler()) : sched(s) {}
+            ~TaskGroup() { wait(); }
+            TaskGroup(const TaskGroup &) = delete;
+            TaskGroup &operator=(const TaskGroup &) = delete;
+
+            template <typename F>
+            void spawn(F &&f)
+            {
+                auto task = std::make_unique<detail::TaskImpl<std::decay_t<F>>>(this, std::decay_t<F>(std::forward<F>(f)));
+                // 任务一旦入队就可能立刻被执行并递减计数，所以要在入队前递增；入队失败（分配内存）时撤销
+                pending.fetch_add(1, std::memory_order_relaxed);
+                try
+                {
+                    sched.submit(task.get());
+                }
+                catch (...)
+                {
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    throw;
+                }
+                task.release();
+            }
+            void sync()
+            {
+                wait();
+                if (error)
+                    std::rethrow_exception(std::exchange(error, nullptr));
+            }
+
+        private:
+            friend class Scheduler;
+            Scheduler &sched;
+            std::atomic<size_t> pending{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            void wait()
+            {
+                while (pending.load(std::memory_order_acquire))
+                    if (!sched.run_one())
+                        std::this_thread::yield();
+            }
+            void record_error(std::exception_ptr e)
+            {
+                std::lock_guard<std::mutex> lk(error_mutex);
+                if (!error)
+                    error = std::move(e);
+            }
+            // 必须是任务对 group 的最后一次访问：计数归零后 group 随时可能被销毁
+            void finish() { pending.fetch_sub(1, std::memory_order_release); }
+        };
+
+        inline void Scheduler::execute(detail::Task *task)
+        {
+            TaskGroup *group = task->group;
+            try
+            {
+                task->run();
+            }
+            catch (...)
+            {
+                group->record_error(std::current_exception());
+            }
+            delete task;
+            group->finish();
+        }
+
+        namespace detail
+        {
+            inline size_t auto_grain(const Scheduler &s, size_t n)
+            {
+                // 每个工作线程大约分到 8 块，窃取有余地做负载均衡
+                return std::max<size_t>(1, n / (size_t(s.num_workers()) * 8));
+            }
+            template <typename F>
+            void parallel_for_impl(Scheduler &s, size_t lo, size_t hi, size_t grain, const F &f)
+            {
+                if (hi - lo <= grain)
+                {
+                    for (size_t i = lo; i < hi; ++i)
+                        f(i);
+                    return;
+                }
+                size_t mid = lo + (hi - lo) / 2;
+                TaskGroup g(s);
+                g.spawn([&s, mid, hi, grain, &f]
+                        { parallel_for_impl(s, mid, hi, grain, f); });
+                parallel_for_impl(s, lo, mid, grain, f);
+                g.sync();
+            }
+            template <typename T, typename Body, typename Combine>
+            T parallel_reduce_impl(Scheduler &s, size_t lo, size_t hi, size_t grain, const T &identity, const Body &body, const Combine &combine)
+            {
+                if (hi - lo <= grain)
+                    return body(lo, hi);
+                size_t mid = lo + (hi - lo) / 2;
+                T right = identity;
+                TaskGroup g(s);
+                g.spawn([&]
+                        { right = parallel_reduce_impl(s, mid, hi, grain, identity, body, combine); });
+                T left = parallel_reduce_impl(s, lo, mid, grain, identity, body, combine);
+                g.sync();
+                return combine(std::move(left), std::move(right));
+            }
+        }
+
+        /**
+         * @brief 对 [first, last) 中的每个下标并行调用 f(i)。
+         * 区间二分递归，长度不超过 grain 的区间串行执行；grain 为 0 时自动选择。
+         */
+        template <typename F>
+        void parallel_for(size_t first, size_t last, size_t grain, const F &f, Scheduler &s = default_scheduler())
+        {
+            if (first >= last)
+                return;
+            if (!grain)
+                grain = detail::auto_grain(s, last - first);
+            detail::parallel_for_impl(s, first, last, grain, f);
+        }
+        /**
+         * @brief 并行归约：body(lo, hi) 计算子区间 [lo, hi) 的结果，combine 按区间从左到右的顺序合并两个相邻子区间的结果。
+         * combine 只需满足结合律，不要求交换律；空区间返回 identity。
+         */
+        template <typename T, typename Body, typename Combine>
+        T parallel_reduce(size_t first, size_t last, size_t grain, const T &identity, const Body &body, const Combine &combine, Scheduler &s = default_scheduler())
+        {
+            if (first >= last)
+                return identity;
+            if (!grain)
+                grain = detail::auto_grain(s, last - first);
+            return detail::parallel_reduce_impl(s, first, last, grain, identity, body, combine);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+namespace DSA
+{
+    namespace Parallel
+    {
+        /**
+         * @brief Chase-Lev 工作窃取双端队列（按 Lê 等人给出的 C11 内存序版本实现）。
+         *
+         * 所有者线程在底端 push / pop，像栈一样后进先出，刚产生的任务数据还在缓存里；
+         * 其他线程从顶端 steal，先进先出地拿走最早产生、通常也是最大的任务。
+         * 所有者的 push / pop 在没有竞争时只有普通的读写和一次栅栏；只有在争抢最后一个元素时，pop 才需要和 steal 做一次 CAS。
+         *
+         * 缓冲区是容量为 2 的幂的循环数组，满了由所有者换成两倍大的新数组；
+         * 窃取者可能还在读旧数组，所以旧数组保留到队列析构时才释放（总量不超过当前数组的大小）。
+         * 元素类型应当是平凡可拷贝的小对象，通常是任务指针。
+         */
+        template <typename T>
+        class WorkStealingDeque
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores trivially copyable values such as task pointers");
+
+            struct Array
+            {
+                int64_t cap, mask;
+                std::unique_ptr<std::atomic<T>[]> buf;
+                explicit Array(int64_t c) : cap(c), mask(c - 1), buf(new std::atomic<T>[c]) {}
+                T get(int64_t i) const { return buf[i & mask].load(std::memory_order_relaxed); }
+                void put(int64_t i, T x) { buf[i & mask].store(x, std::memory_order_relaxed); }
+            };
+
+        public:
+            explicit WorkStealingDeque(int64_t capacity = 256)
+            {
+                int64_t cap = 2;
+                while (cap < capacity)
+                    cap *= 2;
+                arrays.push_back(std::make_unique<Array>(cap));
+                array.store(arrays.back().get(), std::memory_order_relaxed);
+            }
+            WorkStealingDeque(const WorkStealingDeque &) = delete;
+            WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+            // 并发时只是一个近似值
+            size_t size_approx() const
+            {
+                int64_t b = bottom.load(std::memory_order_relaxed), t = top.load(std::memory_order_relaxed);
+                return b > t ? size_t(b - t) : 0;
+            }
+            bool empty_approx() const { return size_approx() == 0; }
+
+            // 只能由所有者线程调用
+            void push(T x)
+            {
+                int64_t b = bottom.load(std::memory_order_relaxed);
+                int64_t t = top.load(std::memory_order_acquire);
+                Array *a = array.load(std::memory_order_relaxed);
+                if (b - t > a->cap - 1)
+                    a = grow(a, t, b);
+                a->put(b, x);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            // 只能由所有者线程调用；从底端取出最近放入的元素
+            std::optional<T> pop()
+            {
+                int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+                Array *a = array.load(std::memory_order_relaxed);
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = top.load(std::memory_order_relaxed);
+                if (t > b)
+                {
+                    // 队列为空
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return std::nullopt;
+                }
+                T x = a->get(b);
+                if (t == b)
+                {
+                    // 只剩最后一个元素，与窃取者竞争
+                    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    if (!won)
+                        return std::nullopt;
+                }
+                return x;
+            }
+            // 任何线程都可以调用；从顶端取出最早放入的元素，队列为空或竞争失败时返回空
+            std::optional<T> steal()
+            {
+                int64_t t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t b = bottom.load(std::memory_order_acquire);
+                if (t >= b)
+                    return std::nullopt;
+                Array *a = array.load(std::memory_order_acquire);
+                T x = a->get(t);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return std::nullopt;
+                return x;
+            }
+
+        private:
+            alignas(64) std::atomic<int64_t> top{0};
+            alignas(64) std::atomic<int64_t> bottom{0};
+            alignas(64) std::atomic<Array *> array{nullptr};
+            std::vector<std::unique_ptr<Array>> arrays; // 当前数组与所有换下来的旧数组，只由所有者修改
+
+            Array *grow(Array *a, int64_t t, int64_t b)
+            {
+                auto bigger = std::make_unique<Array>(a->cap * 2);
+                for (int64_t i = t; i < b; ++i)
+                    bigger->put(i, a->get(i));
+                Array *p = bigger.get();
+                arrays.push_back(std::move(bigger));
+                array.store(p, std::memory_order_release);
+                return p;
+            }
+        };
+    }
+}
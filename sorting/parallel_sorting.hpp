@@ -0,0 +1,90 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include "sorting.hpp"
+#include "../parallel/scheduler.hpp"
+namespace DSA
+{
+    namespace Sorting
+    {
+        namespace detail
+        {
+            // 长度不超过该值的子区间串行处理
+            inline constexpr size_t parallel_sort_grain = size_t(1) << 13;
+
+            /**
+             * @brief 稳定的并行归并：把有序区间 [f1, l1) 与 [f2, l2) 合并写入 out。
+             * 在较长区间的中点 x 处切分，另一区间用二分找到对应位置，两半独立合并。
+             * 左区间的元素在相等时排在前面：以左区间元素为界时右区间取 lower_bound，以右区间元素为界时左区间取 upper_bound。
+             */
+            template <typename It, typename OutIt, typename Compare>
+            void ParallelMerge(It f1, It l1, It f2, It l2, OutIt out, Compare comp, Parallel::Scheduler &s)
+            {
+                size_t n1 = size_t(l1 - f1), n2 = size_t(l2 - f2);
+                if (n1 + n2 <= parallel_sort_grain)
+                {
+                    std::merge(std::make_move_iterator(f1), std::make_move_iterator(l1), std::make_move_iterator(f2), std::make_move_iterator(l2), out, comp);
+                    return;
+                }
+                It m1, m2;
+                if (n1 >= n2)
+                {
+                    m1 = f1 + n1 / 2;
+                    m2 = std::lower_bound(f2, l2, *m1, comp);
+                }
+                else
+                {
+                    m2 = f2 + n2 / 2;
+                    m1 = std::upper_bound(f1, l1, *m2, comp);
+                }
+                OutIt out_mid = out + ((m1 - f1) + (m2 - f2));
+                Parallel::TaskGroup g(s);
+                g.spawn([=, &s]
+                        { ParallelMerge(m1, l1, m2, l2, out_mid, comp, s); });
+                ParallelMerge(f1, m1, f2, m2, out, comp, s);
+                g.sync();
+            }
+            // 排序 [first, last)，buf 是等长的缓冲区；结果留在 [first, last) 中
+            template <typename RandIt, typename BufIt, typename Compare>
+            void ParallelMergeSort(RandIt first, RandIt last, BufIt buf, Compare comp, Parallel::Scheduler &s)
+            {
+                size_t n = size_t(last - first);
+                if (n <= parallel_sort_grain)
+                {
+                    MergeSort(first, last, buf, comp);
+                    return;
+                }
+                RandIt mid = first + n / 2;
+                Parallel::TaskGroup g(s);
+                g.spawn([=, &s]
+                        { ParallelMergeSort(mid, last, buf + (mid - first), comp, s); });
+                ParallelMergeSort(first, mid, buf, comp, s);
+                g.sync();
+                // 两半合并到缓冲区，再并行搬回原区间
+                ParallelMerge(first, mid, mid, last, buf, comp, s);
+                Parallel::parallel_for(0, n, parallel_sort_grain, [&](size_t i)
+                                       { first[i] = std::move(buf[i]); }, s);
+            }
+        }
+
+        /**
+         * @brief 并行稳定归并排序：两半递归地作为 fork/join 任务排序，再用按二分切分的并行归并合并。
+         * 短于 parallel_sort_grain 的子区间用 MergeSort 串行排序；缓冲区由区间拷贝得到，元素需要可拷贝。
+         */
+        template <typename RandIt, typename Compare>
+        void ParallelMergeSort(RandIt first, RandIt last, Compare comp, Parallel::Scheduler &s = Parallel::default_scheduler())
+        {
+            if (last - first <= 1)
+                return;
+            std::vector<iterator_value_type_t<RandIt>> buf(first, last);
+            detail::ParallelMergeSort(first, last, buf.begin(), comp, s);
+        }
+        template <typename RandIt>
+        void ParallelMergeSort(RandIt first, RandIt last)
+        {
+            ParallelMergeSort(first, last, std::less<>{});
+        }
+    }
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
 #include <random>
 #include <type_traits> // for std::decay
 #include <utility>     // for std::declval
@@ -322,11 +325,12 @@ namespace DSA
          * @param first 待排序区间的起始迭代器
          * @param last 待排序区间的结束迭代器（不包含）
          * @param bfirst 指向一个预先分配好的缓冲区的起始迭代器。该缓冲区的大小必须至少为 `std::distance(first, last)`。
+         * @param comp 比较器，comp(a, b) 为真表示 a 应排在 b 之前
          *
          * @note 这是归并排序的内部实现。它依赖于一个外部传入的缓冲区来避免在递归中反复分配内存，从而提高性能。
          */
-        template <typename RandIt>
-        void MergeSort(RandIt first, RandIt last, RandIt bfirst)
+        template <typename RandIt, typename BufIt, typename Compare>
+        void MergeSort(RandIt first, RandIt last, BufIt bfirst, Compare comp)
         {
             int n = std::distance(first, last);
             if (n <= 1)
@@ -335,9 +339,9 @@ namespace DSA
 
             // 注意：这里递归调用时，原数组被分裂，但缓冲区也相应地被分裂使用
             // 排序左半部分 [first, first + mid)，使用缓冲区的前半部分 [bfirst, bfirst + mid)
-            MergeSort(first, first + mid, bfirst);
+            MergeSort(first, first + mid, bfirst, comp);
             // 排序右半部分 [first + mid, last)，使用缓冲区的后半部分 [bfirst + mid, bfirst + n)
-            MergeSort(first + mid, last, bfirst + mid);
+            MergeSort(first + mid, last, bfirst + mid, comp);
             auto arr = first;
             // merging
             {
@@ -349,7 +353,7 @@ namespace DSA
                 // 比较左右两部分，将较小的元素依次放入缓冲区
                 while (l < mid && r < n)
                 {
-                    if (arr[r] < arr[l])
+                    if (comp(arr[r], arr[l]))
                     {
                         *(blast++) = arr[r++];
                     }
@@ -367,6 +371,11 @@ namespace DSA
                 std::copy(bfirst, bfirst + n, arr);
             }
         }
+        template <typename RandIt>
+        void MergeSort(RandIt first, RandIt last, RandIt bfirst)
+        {
+            MergeSort(first, last, bfirst, std::less<>{});
+        }
         /**
          * @brief 归并排序（对外接口）
          * @tparam RandIt 随机访问迭代器类型
@@ -382,14 +391,19 @@ namespace DSA
          * 空间复杂度：O(N) (一次性分配一个辅助数组以提高效率)
          * 稳定排序
          */
-        template <typename RandIt>
-        void MergeSort(RandIt first, RandIt last)
+        template <typename RandIt, typename Compare>
+        void MergeSort(RandIt first, RandIt last, Compare comp)
         {
             int n = std::distance(first, last);
             if (n <= 1)
                 return;
             std::vector<iterator_value_type_t<RandIt>> buf(n);
-            MergeSort(first, last, buf.begin());
+            MergeSort(first, last, buf.begin(), comp);
+        }
+        template <typename RandIt>
+        void MergeSort(RandIt first, RandIt last)
+        {
+            MergeSort(first, last, std::less<>{});
         }
 
         // --- 基数排序的辅助组件 ---
@@ -460,6 +474,32 @@ namespace DSA
             }
         };
 
+        /**
+         * @brief 按 pair 的 first（整数键）做基数排序的适配器，second 是随键一起移动的附带数据（例如链表节点指针）。
+         * 有符号键的映射方式与 SignedIntRadixAdaper 相同。
+         */
+        template <typename Key>
+        struct PairKeyRadixAdapter
+        {
+            static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>,
+                          "PairKeyRadixAdapter is designed for integer keys");
+            using unsigned_key = std::make_unsigned_t<Key>;
+            static constexpr size_t max_key_size = 256;
+            template <typename RandIt>
+            static size_t end_key_index(RandIt, RandIt)
+            {
+                return sizeof(Key);
+            }
+            template <typename Pair>
+            size_t operator()(const Pair &value, size_t index)
+            {
+                unsigned_key key = unsigned_key(value.first);
+                if constexpr (std::is_signed_v<Key>)
+                    key ^= unsigned_key(std::numeric_limits<Key>::min());
+                return (key >> (8 * index)) & 0xff;
+            }
+        };
+
         /**
          * @brief LSD（最低位优先）基数排序
          * @tparam RandIt 随机访问迭代器
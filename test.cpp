@@ -15,5 +15,14 @@ int main()
 	Collections::SetOrMultiset::DemoSet::TestCases();
 	Collections::MapOrMultimap::DemoMap::TestCases();
 	Collections::ListOrForwardlist::DemoList::TestCases();
+	Hashing::DemoHashTable::TestCases();
+	Collections::ArrayLike::DemoVector::TestCases();
+	Collections::ArrayLike::DemoDeque::TestCases();
+	Collections::ArrayLike::DemoRingBuffer::TestCases();
+	Collections::Concurrent::DemoConcurrentQueue::TestCases();
+	Parallel::DemoParallel::TestCases();
+	Collections::ListOrForwardlist::DemoUnrolledList::TestCases();
+	Collections::DemoIntrusive::TestCases();
+	Tree::BTree::DemoBPlusTree::TestCases();
     return 0;
 }
\ No newline at end of file
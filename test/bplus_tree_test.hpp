@@ -0,0 +1,270 @@
+#pragma once
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <random>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "../collections/set_multiset.hpp"
+#include "../collections/map_multimap.hpp"
+#include "../tree/b_tree/bplus_tree.hpp"
+namespace DSA
+{
+    namespace Tree
+    {
+        namespace BTree
+        {
+            struct DemoBPlusTree
+            {
+                static void Check(bool ok, const char *msg)
+                {
+                    if (!ok)
+                        throw std::runtime_error(std::string("BPlusTree test fail: ") + msg);
+                }
+                template <typename A, typename B>
+                static bool Same(const A &a, const B &b)
+                {
+                    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin()) &&
+                           std::equal(std::make_reverse_iterator(a.end()), std::make_reverse_iterator(a.begin()), b.rbegin());
+                }
+                // 作为 Set / MultiSet 的 Implement，与 std::set / std::multiset 逐步对照；Key 为 std::string 时节点很小，树更深
+                template <typename Key, typename Make>
+                static void SetDemo(Make make, int steps, int range)
+                {
+                    using Collections::SetOrMultiset::MultiSet;
+                    using Collections::SetOrMultiset::Set;
+                    Set<Key, std::less<Key>, BPlusTree> s;
+                    MultiSet<Key, std::less<Key>, BPlusTree> ms;
+                    std::set<Key> ss;
+                    std::multiset<Key> sms;
+                    std::mt19937 rng{49};
+                    for (int step = 1; step <= steps; ++step)
+                    {
+                        Key k = make(int(rng() % unsigned(range)));
+                        switch (rng() % 6)
+                        {
+                        case 0:
+                        case 1:
+                        {
+                            auto r = s.insert(k);
+                            auto sr = ss.insert(k);
+                            Check(r.second == sr.second && *r.first == k, "insert");
+                            Check(*ms.insert(k) == k, "multi insert");
+                            sms.insert(k);
+                            break;
+                        }
+                        case 2:
+                            Check(s.erase(k) == ss.erase(k), "erase by key");
+                            Check(ms.erase(k) == sms.erase(k), "multi erase by key");
+                            break;
+                        case 3:
+                        {
+                            // erase(iterator) 返回下一个元素
+                            auto it = ms.lower_bound(k);
+                            auto sit = sms.lower_bound(k);
+                            Check((it == ms.end()) == (sit == sms.end()), "lower_bound");
+                            if (it != ms.end())
+                            {
+                                auto nx = ms.erase(it);
+                                auto snx = sms.erase(sit);
+                                Check((nx == ms.end()) == (snx == sms.end()) && (nx == ms.end() || *nx == *snx), "erase returned next");
+                            }
+                            break;
+                        }
+                        case 4:
+                            Check((s.find(k) != s.end()) == ss.count(k) && ms.count(k) == sms.count(k), "find/count");
+                            Check((ms.upper_bound(k) == ms.end()) == (sms.upper_bound(k) == sms.end()), "upper_bound");
+                            {
+                                auto [lo, hi] = s.equal_range(k);
+                                auto [mlo, mhi] = ms.equal_range(k);
+                                Check(size_t(std::distance(lo, hi)) == ss.count(k) && size_t(std::distance(mlo, mhi)) == sms.count(k), "equal_range");
+                            }
+                            break;
+                        default:
+                        {
+                            // 摘下再插回
+                            auto nh = ms.extract(k);
+                            Check(nh.empty() == !sms.count(k), "extract");
+                            if (!nh.empty())
+                            {
+                                Check(nh.value() == k, "extract value");
+                                ms.insert(std::move(nh));
+                                Check(nh.empty(), "insert node");
+                            }
+                            break;
+                        }
+                        }
+                        if (step % 97 == 0 || step == steps)
+                        {
+                            Check(s.checker() && ms.checker(), "structure broken");
+                            Check(Same(s, ss) && Same(ms, sms), "content differs");
+                        }
+                    }
+                    // 拷贝、交换、合并、清空
+                    Set<Key, std::less<Key>, BPlusTree> t(s);
+                    Check(t.checker() && Same(t, ss), "copy");
+                    Set<Key, std::less<Key>, BPlusTree> u;
+                    u.insert(make(range + 1));
+                    u.swap(t);
+                    Check(Same(u, ss) && t.size() == 1 && t.checker(), "swap");
+                    t.merge(ms);
+                    std::set<Key> expect(sms.begin(), sms.end());
+                    expect.insert(make(range + 1));
+                    Check(t.checker() && ms.checker() && Same(t, expect), "merge unique");
+                    Check(ms.size() == sms.size() + 1 - expect.size(), "merge unique leftover");
+                    ms.clear();
+                    Check(ms.empty() && ms.begin() == ms.end() && ms.checker(), "clear");
+                }
+                static void MapDemo()
+                {
+                    using Collections::MapOrMultimap::Map;
+                    using Collections::MapOrMultimap::MultiMap;
+                    Map<int, std::string, std::less<int>, BPlusTree> m;
+                    MultiMap<int, std::string, std::less<int>, BPlusTree> mm;
+                    std::map<int, std::string> sm;
+                    std::multimap<int, std::string> smm;
+                    std::mt19937 rng{50};
+                    for (int step = 1; step <= 6000; ++step)
+                    {
+                        int k = int(rng() % 700);
+                        std::string v(1 + rng() % 30, char('a' + step % 26));
+                        switch (rng() % 5)
+                        {
+                        case 0:
+                            m[k] = v, sm[k] = v;
+                            break;
+                        case 1:
+                            Check(m.try_emplace(k, v).second == sm.try_emplace(k, v).second, "try_emplace");
+                            break;
+                        case 2:
+                            m.insert_or_assign(k, v), sm.insert_or_assign(k, v);
+                            mm.insert({k, v}), smm.insert({k, v});
+                            break;
+                        case 3:
+                            Check(m.erase(k) == sm.erase(k), "map erase");
+                            break;
+                        default:
+                            if (auto it = mm.find(k); it != mm.end())
+                            {
+                                mm.erase(mm.lower_bound(k));
+                                smm.erase(smm.lower_bound(k));
+                            }
+                            break;
+                        }
+                        if (step % 101 == 0)
+                            Check(m.checker() && mm.checker() && Same(m, sm) && Same(mm, smm), "map content");
+                    }
+                    // 通过节点句柄改键
+                    if (auto nh = m.extract(m.begin()); !nh.empty())
+                    {
+                        sm.erase(sm.begin());
+                        nh.key() = 100000;
+                        nh.mapped() = "moved";
+                        m.insert(std::move(nh));
+                        sm[100000] = "moved";
+                    }
+                    Check(m.checker() && Same(m, sm), "node handle key change");
+                    mm.merge(m);
+                    smm.insert(sm.begin(), sm.end());
+                    Check(m.empty() && mm.checker() && Same(mm, smm), "merge multi");
+                }
+                // 实参引用的正是目标叶子中的元素：插入前挪动或分裂叶子不能让实参失效
+                static void AliasDemo()
+                {
+                    using Collections::MapOrMultimap::Map;
+                    using Collections::SetOrMultiset::MultiSet;
+                    constexpr int n = int(bplus_leaf_capacity<std::pair<const int, std::string>>);
+                    for (int size : {4, n - 1, n, 4 * n})
+                    {
+                        Map<int, std::string, std::less<int>, BPlusTree> m;
+                        std::map<int, std::string> sm;
+                        for (int i = 1; i <= size; ++i)
+                        {
+                            std::string v = "value#" + std::to_string(i) + std::string(size_t(i % 7) * 5, '*');
+                            m[2 * i + 1] = v, sm[2 * i + 1] = v;
+                        }
+                        for (int i = 1; i < size; i += 3)
+                        {
+                            m.try_emplace(2 * i, m.at(2 * i + 1)), sm.try_emplace(2 * i, sm.at(2 * i + 1));
+                            m.insert_or_assign(2 * i + 2, m.at(2 * i + 3)), sm.insert_or_assign(2 * i + 2, sm.at(2 * i + 3));
+                            m.emplace(-i, m.at(3)), sm.emplace(-i, sm.at(3));
+                        }
+                        Check(m.checker() && Same(m, sm), "map argument aliases a leaf element");
+                        MultiSet<std::string, std::less<std::string>, BPlusTree> ms;
+                        std::multiset<std::string> sms;
+                        for (int i = 0; i < size; ++i)
+                            ms.insert(std::to_string(i)), sms.insert(std::to_string(i));
+                        for (int i = 0; i < size; ++i)
+                        {
+                            ms.insert(*ms.find(std::to_string(i))), sms.insert(*sms.find(std::to_string(i)));
+                            ms.emplace(*ms.begin()), sms.emplace(*sms.begin());
+                        }
+                        Check(ms.checker() && Same(ms, sms), "multiset argument aliases a leaf element");
+                    }
+                }
+                // 直接对 BPlusTree 批量建树：各种规模下结构合法，之后的插入删除仍然正确
+                static void BulkLoadDemo()
+                {
+                    using Tree = BPlusTree<int>;
+                    constexpr size_t cap = Tree::leaf_capacity;
+                    for (size_t n : {size_t(0), size_t(1), cap, cap + 1, cap * 2 + 1, cap * 23 + 5, size_t(50000)})
+                    {
+                        std::vector<int> v;
+                        for (size_t i = 0; i < n; ++i)
+                            v.push_back(int(i / 3));
+                        Tree t, u;
+                        t.assign_sorted_multi(v.begin(), v.end());
+                        u.assign_sorted_unique(v.begin(), v.end());
+                        Check(t.checker_multi() && t.size() == n && std::equal(t.begin(), t.end(), v.begin()), "bulk load multi");
+                        std::vector<int> uv;
+                        std::unique_copy(v.begin(), v.end(), std::back_inserter(uv));
+                        Check(u.checker_unique() && u.size() == uv.size() && std::equal(u.begin(), u.end(), uv.begin()), "bulk load unique");
+                        std::multiset<int> st(v.begin(), v.end());
+                        std::mt19937 rng{unsigned(n)};
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            int k = int(rng() % (n / 3 + 2));
+                            if (rng() % 2)
+                                t.insert_multi(k), st.insert(k);
+                            else if (t.erase_multi(k) != st.erase(k))
+                                Check(false, "erase after bulk load");
+                        }
+                        Check(t.checker_multi() && Same(t, st), "modify after bulk load");
+                    }
+                }
+                static void TestCases()
+                {
+                    int case_index = 0;
+                    try
+                    {
+                        ++case_index;
+                        SetDemo<int>([](int x)
+                                     { return x; },
+                                     40000, 6000);
+                        ++case_index;
+                        SetDemo<std::string>([](int x)
+                                             { return std::to_string(x * 7919) + std::string(size_t(x % 5) * 7, '#'); },
+                                             20000, 1500);
+                        ++case_index;
+                        MapDemo();
+                        ++case_index;
+                        AliasDemo();
+                        ++case_index;
+                        BulkLoadDemo();
+
+                        std::cout
+                            << "BPlusTree test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << "BPlusTree test case " << case_index << " fail\n"
+                                  << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <sstream>
+#include <iostream>
+#include <numeric>
+#include "../collections/concurrent_queue.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace Concurrent
+        {
+            struct DemoConcurrentQueue
+            {
+                std::string name;
+                void Fail(const std::string &msg) const
+                {
+                    throw std::runtime_error(name + " test fail: " + msg);
+                }
+                // 单线程下的语义：容量、FIFO 顺序、批量操作跨越缓冲区末尾
+                template <typename Q>
+                void SingleThreadDemo()
+                {
+                    Q q(6);
+                    if (q.capacity() != 8)
+                        Fail("capacity must be rounded up to a power of two");
+                    std::deque<std::string> st;
+                    std::string out;
+                    for (int round = 0; round < 50; ++round)
+                    {
+                        while (st.size() < 8)
+                        {
+                            st.push_back(std::to_string(round) + "-" + std::to_string(st.size()) + std::string(20, 'x'));
+                            if (!q.try_push(st.back()))
+                                Fail("try_push on a non-full queue");
+                        }
+                        if (q.try_push("overflow"))
+                            Fail("try_push on a full queue must fail");
+                        for (int k = 0; k < round % 7 + 1; ++k)
+                        {
+                            if (!q.try_pop(out) || out != st.front())
+                                Fail("FIFO order");
+                            st.pop_front();
+                        }
+                        // 批量写入被剩余容量截断，批量取出至多取到队列为空
+                        std::vector<std::string> src(10, std::to_string(round)), dst(10);
+                        size_t pushed = q.try_push_n(src.data(), src.size());
+                        if (pushed != 8 - st.size())
+                            Fail("try_push_n must stop at capacity");
+                        st.insert(st.end(), src.begin(), src.begin() + pushed);
+                        size_t popped = q.try_pop_n(dst.data(), round % 10 + 1);
+                        if (popped != std::min<size_t>(st.size(), round % 10 + 1) || !std::equal(dst.begin(), dst.begin() + popped, st.begin()))
+                            Fail("try_pop_n order");
+                        st.erase(st.begin(), st.begin() + popped);
+                    }
+                    while (!st.empty())
+                    {
+                        if (!q.try_pop(out) || out != st.front())
+                            Fail("draining");
+                        st.pop_front();
+                    }
+                    if (q.try_pop(out))
+                        Fail("try_pop on an empty queue must fail");
+                }
+                // 每个生产者按顺序写入 (id, seq)；消费者检查总数、总和以及每个生产者的序号单调递增
+                template <typename Q>
+                void StressDemo(int producers, int consumers, int per_producer, bool batched)
+                {
+                    BlockingQueue<Q> q(64);
+                    std::atomic<long long> sum{0};
+                    std::atomic<int> received{0}, order_errors{0};
+                    std::vector<std::thread> threads;
+                    for (int p = 0; p < producers; ++p)
+                        threads.emplace_back([&, p]
+                                             {
+                                                 std::vector<long long> batch;
+                                                 for (int i = 0; i < per_producer; ++i)
+                                                 {
+                                                     long long v = (long long)p << 32 | i;
+                                                     if (!batched)
+                                                         q.push(v);
+                                                     else
+                                                     {
+                                                         batch.push_back(v);
+                                                         if (batch.size() == 7 || i + 1 == per_producer)
+                                                         {
+                                                             q.push_n(batch.data(), batch.size());
+                                                             batch.clear();
+                                                         }
+                                                     }
+                                                 } });
+                    for (int c = 0; c < consumers; ++c)
+                        threads.emplace_back([&]
+                                             {
+                                                 std::vector<long long> last(producers, -1);
+                                                 long long buf[5];
+                                                 for (;;)
+                                                 {
+                                                     size_t k = batched ? q.pop_n(buf, 5) : size_t(q.pop(buf[0]));
+                                                     if (!k)
+                                                         break;
+                                                     for (size_t j = 0; j < k; ++j)
+                                                     {
+                                                         int p = int(buf[j] >> 32), i = int(buf[j] & 0xffffffff);
+                                                         if (i <= last[p])
+                                                             ++order_errors;
+                                                         last[p] = i;
+                                                         sum += buf[j];
+                                                     }
+                                                     received += int(k);
+                                                 } });
+                    for (int p = 0; p < producers; ++p)
+                        threads[p].join();
+                    q.close();
+                    for (size_t t = producers; t < threads.size(); ++t)
+                        threads[t].join();
+                    long long expected = 0;
+                    for (int p = 0; p < producers; ++p)
+                        expected += ((long long)p << 32) * per_producer + (long long)per_producer * (per_producer - 1) / 2;
+                    if (received != producers * per_producer || sum != expected)
+                        Fail("elements lost or duplicated");
+                    if (order_errors)
+                        Fail("elements of one producer were reordered");
+                }
+                static void Demo()
+                {
+                    DemoConcurrentQueue instance;
+                    instance.name = "SPSCQueue";
+                    instance.SingleThreadDemo<SPSCQueue<std::string>>();
+                    instance.StressDemo<SPSCQueue<long long>>(1, 1, 100000, false);
+                    instance.StressDemo<SPSCQueue<long long>>(1, 1, 100000, true);
+                    instance.name = "MPMCQueue";
+                    instance.SingleThreadDemo<MPMCQueue<std::string>>();
+                    instance.StressDemo<MPMCQueue<long long>>(4, 4, 20000, false);
+                    instance.StressDemo<MPMCQueue<long long>>(3, 2, 20000, true);
+                }
+                static void TestCases()
+                {
+                    try
+                    {
+                        Demo();
+                        std::cout
+                            << "ConcurrentQueue test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <random>
+#include <memory>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include "../collections/deque.hpp"
+#include "../collections/queue_stack.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            struct DemoDeque
+            {
+                struct operation
+                {
+                    int opt, key, value;
+                    friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                    {
+                        switch (op.opt)
+                        {
+                        case 0:
+                        {
+                            os << "(push_back:" << op.value << ")";
+                            break;
+                        }
+                        case 1:
+                        {
+                            os << "(push_front:" << op.value << ")";
+                            break;
+                        }
+                        case 2:
+                        {
+                            os << "(pop_back)";
+                            break;
+                        }
+                        case 3:
+                        {
+                            os << "(pop_front)";
+                            break;
+                        }
+                        case 4:
+                        {
+                            os << "(insert:" << op.key << "," << op.value << ")";
+                            break;
+                        }
+                        default:
+                        {
+                            os << "(erase:" << op.key << ")";
+                            break;
+                        }
+                        }
+                        return os;
+                    }
+                };
+                // 统计分配次数的分配器，用来检查空闲块缓存
+                template <typename U>
+                struct CountingAllocator
+                {
+                    using value_type = U;
+                    std::shared_ptr<size_t> allocations = std::make_shared<size_t>(0);
+                    CountingAllocator() = default;
+                    template <typename V>
+                    CountingAllocator(const CountingAllocator<V> &other) : allocations(other.allocations) {}
+                    U *allocate(size_t n)
+                    {
+                        ++*allocations;
+                        return std::allocator<U>{}.allocate(n);
+                    }
+                    void deallocate(U *p, size_t n) { std::allocator<U>{}.deallocate(p, n); }
+                    bool operator==(const CountingAllocator &other) const { return allocations == other.allocations; }
+                };
+                std::vector<operation> ops;
+                template <typename T>
+                static void Print(const std::vector<T> &v, std::ostream &os)
+                {
+                    os << "[ ";
+                    for (auto i : v)
+                        os << i << ", ";
+                    os << "]";
+                }
+                void Fail(int cnt, const std::string &msg) const
+                {
+                    std::ostringstream ss;
+                    ss << "Deque test fail on the " << cnt << " operation :\n";
+                    ss << msg;
+                    ss << "\ntotal operations:";
+                    auto tmp = ops;
+                    tmp.resize(cnt);
+                    Print(tmp, ss);
+                    throw std::runtime_error(ss.str());
+                }
+                // 与 std::deque 逐步对照；元素用 std::string，检查构造与析构是否配对
+                void DequeDemo()
+                {
+                    std::deque<std::string> st;
+                    Deque<std::string> dq;
+                    int cnt = 0;
+                    for (auto oo : ops)
+                    {
+                        ++cnt;
+                        std::string v = std::to_string(oo.value);
+                        switch (oo.opt)
+                        {
+                        case 0:
+                            st.push_back(v);
+                            dq.push_back(v);
+                            break;
+                        case 1:
+                            st.push_front(v);
+                            dq.push_front(v);
+                            break;
+                        case 2:
+                            if (!st.empty())
+                            {
+                                st.pop_back();
+                                dq.pop_back();
+                            }
+                            break;
+                        case 3:
+                            if (!st.empty())
+                            {
+                                st.pop_front();
+                                dq.pop_front();
+                            }
+                            break;
+                        case 4:
+                        {
+                            size_t pos = size_t(oo.key) % (st.size() + 1);
+                            st.insert(st.begin() + pos, v);
+                            dq.insert(dq.cbegin() + pos, v);
+                            break;
+                        }
+                        default:
+                            if (!st.empty())
+                            {
+                                size_t pos = size_t(oo.key) % st.size();
+                                st.erase(st.begin() + pos);
+                                dq.erase(dq.cbegin() + pos);
+                            }
+                            break;
+                        }
+                        if (dq.size() != st.size() || !std::equal(dq.begin(), dq.end(), st.begin(), st.end()))
+                            Fail(cnt, "content differs from std::deque");
+                        if (!st.empty() && (dq.front() != st.front() || dq.back() != st.back() || dq[st.size() / 2] != st[st.size() / 2]))
+                            Fail(cnt, "front/back/operator[] differs from std::deque");
+                    }
+                    if (!std::equal(dq.rbegin(), dq.rend(), st.rbegin(), st.rend()))
+                        Fail(cnt, "reverse iteration");
+                    Deque<std::string> copied(dq);
+                    Deque<std::string> moved(std::move(copied));
+                    if (!(moved == dq) || !copied.empty())
+                        Fail(cnt, "copy and move constructors");
+                    copied = moved;
+                    dq.clear();
+                    dq.shrink_to_fit();
+                    dq.swap(copied);
+                    if (!(dq == moved) || !copied.empty())
+                        Fail(cnt, "copy assignment and swap");
+                }
+                // 两端插入都不移动已有元素：引用保持有效
+                void StabilityDemo()
+                {
+                    Deque<int> dq;
+                    std::vector<int *> addr;
+                    for (size_t i = 0; i < ops.size() * 20; ++i)
+                    {
+                        if (i % 3 == 0)
+                            addr.insert(addr.begin(), &dq.emplace_front(int(i)));
+                        else
+                            addr.push_back(&dq.emplace_back(int(i)));
+                    }
+                    for (size_t i = 0; i < addr.size(); ++i)
+                        if (addr[i] != &dq[i])
+                            Fail(int(ops.size()), "elements were relocated on growth");
+                    if (std::is_sorted(dq.begin(), dq.end()) && dq.size() > 3)
+                        Fail(int(ops.size()), "push_front order");
+                    std::sort(dq.begin(), dq.end());
+                    if (!std::is_sorted(dq.cbegin(), dq.cend()))
+                        Fail(int(ops.size()), "random access iterators with std::sort");
+                }
+                // 队列式使用：预热之后块在两端之间循环，不再分配
+                void QueueDemo()
+                {
+                    CountingAllocator<int> alloc;
+                    Queue<int, Deque<int, CountingAllocator<int>>> q{Deque<int, CountingAllocator<int>>(alloc)};
+                    const size_t window = Deque<int>::block_size * 3 + 5;
+                    for (size_t i = 0; i < window; ++i)
+                        q.push(int(i));
+                    size_t warmed = *alloc.allocations;
+                    for (size_t i = window; i < window + ops.size() * 1000; ++i)
+                    {
+                        if (q.front() != int(i - window))
+                            Fail(int(ops.size()), "queue order");
+                        q.pop();
+                        q.push(int(i));
+                    }
+                    // 中控数组平移回中间不需要分配；扩容最多发生常数次
+                    if (*alloc.allocations > warmed + 2)
+                        Fail(int(ops.size()), "steady state queue keeps allocating blocks");
+                    Queue<std::string> sq;
+                    for (auto oo : ops)
+                        sq.emplace(std::to_string(oo.value));
+                    for (auto oo : ops)
+                    {
+                        if (sq.front() != std::to_string(oo.value))
+                            Fail(int(ops.size()), "Queue over the default Deque");
+                        sq.pop();
+                    }
+                }
+                static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+                {
+                    std::mt19937 rng{seed};
+                    std::vector<operation> res(n);
+                    auto odist = std::uniform_int_distribution<int>(0, 9);
+                    auto vdist = std::uniform_int_distribution<int>(0, w);
+                    for (int i = 0; i < n; i++)
+                    {
+                        int tmp = odist(rng);
+                        res[i].opt = (tmp < 3 ? 0 : (tmp < 5 ? 1 : (tmp < 6 ? 2 : (tmp < 7 ? 3 : (tmp < 9 ? 4 : 5)))));
+                        res[i].key = vdist(rng);
+                        res[i].value = vdist(rng);
+                    }
+                    return res;
+                }
+                static void Demo(const std::vector<operation> &ops)
+                {
+                    auto instance = DemoDeque();
+                    instance.ops = ops;
+                    instance.DequeDemo();
+                    instance.StabilityDemo();
+                    instance.QueueDemo();
+                }
+                static void TestCases()
+                {
+
+                    int case_index = 0;
+                    try
+                    {
+
+                        ++case_index;
+                        Demo(RandomGen(5, 2));
+                        ++case_index;
+                        Demo(RandomGen(25, 4));
+                        ++case_index;
+                        Demo(RandomGen(100, 10));
+                        ++case_index;
+                        Demo(RandomGen(500, 40));
+                        ++case_index;
+                        Demo(RandomGen(5000, 1000));
+
+                        std::cout
+                            << "Deque test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << "Deque test case " << case_index << " fail\n"
+                                  << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
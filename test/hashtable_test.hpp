@@ -0,0 +1,469 @@
+#pragma once
+#include <unordered_set>
+#include <string>
+#include <string_view>
+#include "../collections/hashtable.hpp"
+#include "../collections/hashtable_robin_hood.hpp"
+#include "../collections/hashtable_cuckoo.hpp"
+#include "../collections/hash_function.hpp"
+#include <thread>
+namespace DSA
+{
+    namespace Hashing
+    {
+
+        struct DemoHashTable
+        {
+            struct operation
+            {
+                int opt, value;
+                friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                {
+                    switch (op.opt)
+                    {
+                    case 0:
+                    {
+                        os << "(insert:" << op.value << ")";
+                        break;
+                    }
+                    case 1:
+                    {
+                        os << "(erase:" << op.value << ")";
+                        break;
+                    }
+                    case 2:
+                    {
+                        os << "(find:" << op.value << ")";
+                        break;
+                    }
+                    default:
+                    {
+                        os << "(output)";
+                        break;
+                    }
+                    }
+                    return os;
+                }
+            };
+            // 支持异构查找的字符串哈希，用 std::string_view 直接查 std::string 的表
+            struct StringHash
+            {
+                using is_transparent = void;
+                size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+            };
+            std::vector<operation> ops;
+            template <typename T>
+            static void Print(const std::vector<T> &v, std::ostream &os)
+            {
+                os << "[ ";
+                for (auto i : v)
+                    os << i << ", ";
+                os << "]";
+            }
+            void Fail(const std::string &name, int cnt, const std::string &msg) const
+            {
+                std::ostringstream ss;
+                ss << name << " test fail on the " << cnt << " operation :\n";
+                ss << msg;
+                ss << "\ntotal operations:";
+                auto tmp = ops;
+                tmp.resize(cnt);
+                Print(tmp, ss);
+                throw std::runtime_error(ss.str());
+            }
+            template <typename Table>
+            void HashTableUniqueDemo(const std::string &name)
+            {
+                Table ht;
+                std::unordered_set<int> st;
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    // 奇数次操作使用预先计算好的哈希码，检查两套重载的行为一致
+                    bool use_hash = cnt & 1;
+                    size_t h = ht.hash_code(oo.value);
+                    switch (oo.opt)
+                    {
+                    case 0:
+                    {
+                        int c = st.insert(oo.value).second;
+                        int d = ht.insert_unique(oo.value).second;
+                        if (c != d)
+                            Fail(name, cnt, "inserting " + std::to_string(oo.value) + " ; expected " + std::to_string(c) + " but got " + std::to_string(d));
+                        break;
+                    }
+                    case 1:
+                    {
+                        size_t c = st.erase(oo.value);
+                        size_t d = use_hash ? ht.erase_unique(oo.value, h) : ht.erase_unique(oo.value);
+                        if (c != d)
+                            Fail(name, cnt, "erasing " + std::to_string(oo.value) + " ; expected " + std::to_string(c) + " but got " + std::to_string(d));
+                        break;
+                    }
+                    case 2:
+                    {
+                        size_t c = st.count(oo.value);
+                        size_t d = use_hash ? ht.count_unique(oo.value, h) : ht.count_unique(oo.value);
+                        auto rg = ht.equal_range_unique(oo.value, h);
+                        if (c != d || size_t(std::distance(rg.first, rg.second)) != c || (ht.find(oo.value, h) != ht.end()) != bool(c))
+                            Fail(name, cnt, "finding " + std::to_string(oo.value) + " ; expected " + std::to_string(c) + " but got " + std::to_string(d));
+                        break;
+                    }
+                    default:
+                    {
+                        std::vector<int> c(st.begin(), st.end());
+                        std::vector<int> d(ht.begin(), ht.end());
+                        std::sort(c.begin(), c.end());
+                        std::sort(d.begin(), d.end());
+                        if (c != d)
+                            Fail(name, cnt, "outputing ; content mismatch");
+                        if (!d.empty())
+                        {
+                            // 按迭代器删除一个元素
+                            st.erase(*ht.begin());
+                            ht.erase(ht.begin());
+                        }
+                        break;
+                    }
+                    }
+                    if (st.size() != ht.size())
+                        Fail(name, cnt, "size ; expected " + std::to_string(st.size()) + ", but got " + std::to_string(ht.size()));
+                }
+            }
+            void HashTableMultiDemo()
+            {
+                HashTable<int> ht;
+                std::unordered_multiset<int> st;
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    bool use_hash = cnt & 1;
+                    size_t h = ht.hash_code(oo.value);
+                    switch (oo.opt)
+                    {
+                    case 0:
+                    {
+                        st.insert(oo.value);
+                        if (*ht.insert_multi(oo.value) != oo.value)
+                            Fail("HashTable-Multi", cnt, "inserting " + std::to_string(oo.value));
+                        break;
+                    }
+                    case 1:
+                    {
+                        size_t c = st.erase(oo.value);
+                        size_t d = use_hash ? ht.erase_multi(oo.value, h) : ht.erase_multi(oo.value);
+                        if (c != d)
+                            Fail("HashTable-Multi", cnt, "erasing " + std::to_string(oo.value) + " ; expected " + std::to_string(c) + " but got " + std::to_string(d));
+                        break;
+                    }
+                    case 2:
+                    {
+                        size_t c = st.count(oo.value);
+                        size_t d = use_hash ? ht.count_multi(oo.value, h) : ht.count_multi(oo.value);
+                        if (c != d)
+                            Fail("HashTable-Multi", cnt, "counting " + std::to_string(oo.value) + " ; expected " + std::to_string(c) + " but got " + std::to_string(d));
+                        break;
+                    }
+                    default:
+                    {
+                        std::vector<int> c(st.begin(), st.end());
+                        std::vector<int> d(ht.begin(), ht.end());
+                        std::sort(c.begin(), c.end());
+                        std::sort(d.begin(), d.end());
+                        if (c != d)
+                            Fail("HashTable-Multi", cnt, "outputing ; content mismatch");
+                        break;
+                    }
+                    }
+                    if (st.size() != ht.size())
+                        Fail("HashTable-Multi", cnt, "size ; expected " + std::to_string(st.size()) + ", but got " + std::to_string(ht.size()));
+                }
+            }
+            template <typename Table>
+            void HashTableTransparentDemo()
+            {
+                Table ht;
+                std::unordered_set<std::string> st;
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    std::string s = "key#" + std::to_string(oo.value);
+                    std::string_view sv = s;
+                    switch (oo.opt)
+                    {
+                    case 0:
+                    {
+                        st.insert(s);
+                        ht.insert_unique(s);
+                        break;
+                    }
+                    case 1:
+                    {
+                        if (st.erase(s) != ht.erase_unique(sv, ht.hash_code(sv)))
+                            Fail("HashTable-Transparent", cnt, "erasing " + s);
+                        break;
+                    }
+                    default:
+                    {
+                        if (st.count(s) != ht.count_unique(sv) || (ht.find(sv) != ht.end()) != bool(st.count(s)))
+                            Fail("HashTable-Transparent", cnt, "finding " + s);
+                        break;
+                    }
+                    }
+                }
+            }
+            void HashTableRangeDemo()
+            {
+                // 分两批批量插入，第二批与第一批及已有元素都有重复
+                std::vector<int> values;
+                for (auto oo : ops)
+                    values.push_back(oo.value);
+                auto mid = values.begin() + values.size() / 2;
+                HashTable<int> ht(values.begin(), mid);
+                ht.insert_range_unique(mid, values.end());
+                HashTable<int> mht;
+                mht.insert_range_multi(values.begin(), mid);
+                mht.insert_range_multi(mid, values.end());
+                std::unordered_set<int> st(values.begin(), values.end());
+                std::unordered_multiset<int> mst(values.begin(), values.end());
+                if (ht.size() != st.size() || mht.size() != mst.size())
+                    Fail("HashTable-Range", int(ops.size()), "size mismatch after insert_range");
+                for (int v : values)
+                {
+                    if (ht.count_unique(v) != st.count(v) || mht.count_multi(v) != mst.count(v))
+                        Fail("HashTable-Range", int(ops.size()), "counting " + std::to_string(v) + " after insert_range");
+                }
+                // 批量插入之后表仍然可以正常增删
+                for (int v : values)
+                {
+                    if (ht.erase_unique(v) != st.erase(v) || mht.erase_multi(v) != mst.erase(v))
+                        Fail("HashTable-Range", int(ops.size()), "erasing " + std::to_string(v) + " after insert_range");
+                }
+                if (!ht.empty() || !mht.empty())
+                    Fail("HashTable-Range", int(ops.size()), "table not empty after erasing everything");
+            }
+            [[gnu::noinline]] static void dirty_stack(unsigned char fill)
+            {
+                volatile unsigned char junk[512];
+                for (auto &c : junk)
+                    c = fill;
+            }
+            [[gnu::noinline]] static size_t hash_on_dirty_stack(long double v, unsigned char fill)
+            {
+                dirty_stack(fill);
+                return FastHash<long double>{}(v);
+            }
+            void FastHashDemo()
+            {
+                // SIMD 批量路径与标量参考实现逐位一致，覆盖短、中、长以及跨 block 的各种长度
+                std::mt19937_64 rng(ops.size());
+                std::string buf(3000, '\0');
+                for (auto &c : buf)
+                    c = char(rng());
+                for (size_t len : {size_t(0), size_t(1), size_t(3), size_t(4), size_t(8), size_t(16), size_t(17), size_t(48), size_t(49), size_t(255), size_t(256), size_t(257), size_t(1087), size_t(1088), size_t(1089), size_t(3000)})
+                {
+                    if (detail::hash_bytes_impl<true>(buf.data(), len, 7) != detail::hash_bytes_impl<false>(buf.data(), len, 7))
+                        Fail("FastHash", int(ops.size()), "simd and scalar disagree on length " + std::to_string(len));
+                }
+                std::string s = "key#" + std::to_string(ops.size());
+                if (FastHash<std::string>{}(s) != FastHash<std::string_view>{}(s) || FastHash<std::string>{}(s) != FastHash<std::string>{}(s.c_str()))
+                    Fail("FastHash", int(ops.size()), "string and string_view hash differently");
+                if (FastHash<double>{}(0.0) != FastHash<double>{}(-0.0))
+                    Fail("FastHash", int(ops.size()), "0.0 and -0.0 hash differently");
+                // 相等的 long double 由不同计算得到，并且求哈希前把栈上的残留内容分别写成 0x00 与 0xAB，
+                // 这样哈希函数内部副本的填充字节也不同，哈希值仍必须一致
+                volatile long double three = 3.0L; // volatile 阻止编译期折叠，两个值都在运行时算出
+                long double lhs = 1.0L / three, rhs = (2.0L / three) / 2.0L;
+                if (lhs != rhs || hash_on_dirty_stack(lhs, 0x00) != hash_on_dirty_stack(rhs, 0xAB))
+                    Fail("FastHash", int(ops.size()), "equal long doubles hash differently");
+                if (FastHash<std::pair<int, int>>{}({1, 2}) == FastHash<std::pair<int, int>>{}({2, 1}) || FastHash<std::tuple<int, int, int>>{}({1, 2, 3}) == FastHash<std::tuple<int, int, int>>{}({3, 2, 1}))
+                    Fail("FastHash", int(ops.size()), "combinator should be order sensitive");
+            }
+            void RobinHoodStrideDemo()
+            {
+                // std::hash 对整数是恒等映射，步长为 2 的幂的键只靠低位取桶时会全部挤进同一个桶
+                RobinHoodHashTable<long long> ht;
+                int n = int(ops.size()) % 2000 + 1000;
+                for (int i = 0; i < n; ++i)
+                {
+                    if (!ht.insert_unique(i * 4096LL).second)
+                        Fail("RobinHoodStride", i, "insert reported duplicate");
+                }
+                for (int i = 0; i < n; ++i)
+                {
+                    if (ht.find(i * 4096LL) == ht.end())
+                        Fail("RobinHoodStride", i, "key not found");
+                }
+                if (ht.size() != size_t(n) || ht.find(4095) != ht.end())
+                    Fail("RobinHoodStride", n, "size or lookup mismatch");
+            }
+            void ConcurrentCuckooDemo()
+            {
+                // 单线程下与 std::unordered_set 对比
+                ConcurrentCuckooHashTable<int> ht;
+                std::unordered_set<int> st;
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    int out = 0;
+                    bool ok = true;
+                    switch (oo.opt)
+                    {
+                    case 0:
+                        ok = ht.insert(oo.value) == st.insert(oo.value).second;
+                        break;
+                    case 1:
+                        ok = ht.erase(oo.value) == st.erase(oo.value);
+                        break;
+                    default:
+                        ok = ht.find(oo.value, out) == bool(st.count(oo.value)) && (!st.count(oo.value) || out == oo.value);
+                        break;
+                    }
+                    if (!ok || ht.size() != st.size())
+                        Fail("ConcurrentCuckooHashTable", cnt, "mismatch with std::unordered_set");
+                }
+                // 多个写者插入互不相交的键，同时有读者反复查询已经确认插入的键
+                const int writers = 4, per_writer = int(ops.size());
+                ConcurrentCuckooHashTable<long long> cht;
+                std::atomic<int> done{0}, missing{0};
+                std::vector<std::thread> threads;
+                for (int w = 0; w < writers; ++w)
+                {
+                    threads.emplace_back([&, w]
+                                         {
+                        for (int i = 0; i < per_writer; ++i)
+                        {
+                            long long key = (long long)i * writers + w;
+                            if (!cht.insert(key) || !cht.contains(key))
+                                ++missing;
+                        }
+                        ++done; });
+                }
+                threads.emplace_back([&]
+                                     {
+                    while (done.load() < writers)
+                    {
+                        long long v;
+                        if (cht.find(0, v) && v != 0)
+                            ++missing;
+                    } });
+                for (auto &th : threads)
+                    th.join();
+                if (missing.load() || cht.size() != size_t(writers) * per_writer)
+                    Fail("ConcurrentCuckooHashTable", cnt, "concurrent insertion lost or corrupted keys");
+                for (long long key = 0; key < (long long)writers * per_writer; ++key)
+                {
+                    if (!cht.contains(key))
+                        Fail("ConcurrentCuckooHashTable", cnt, "key " + std::to_string(key) + " missing after concurrent insertion");
+                }
+                // 插入、删除、查找并发进行，扩容不断让旧桶数组退役；预先插入的负键在整个过程中都必须能查到
+                ConcurrentCuckooHashTable<long long> mix;
+                const long long stable = 1000;
+                for (long long key = 1; key <= stable; ++key)
+                    mix.insert(-key);
+                threads.clear();
+                done = 0;
+                for (int w = 0; w < writers; ++w)
+                {
+                    threads.emplace_back([&, w]
+                                         {
+                        for (int i = 0; i < per_writer; ++i)
+                        {
+                            long long key = (long long)i * writers + w;
+                            if (!mix.insert(key) || !mix.contains(key))
+                                ++missing;
+                            if (i % 2 == 0 && (mix.erase(key) != 1 || mix.contains(key)))
+                                ++missing;
+                        }
+                        ++done; });
+                }
+                threads.emplace_back([&]
+                                     {
+                    for (long long i = 0; done.load() < writers; ++i)
+                    {
+                        long long v;
+                        if (!mix.find(-(i % stable + 1), v) || v != -(i % stable + 1))
+                            ++missing;
+                    } });
+                for (auto &th : threads)
+                    th.join();
+                if (missing.load() || mix.size() != size_t(stable) + size_t(writers) * (per_writer / 2))
+                    Fail("ConcurrentCuckooHashTable", cnt, "concurrent insert/erase/find lost or corrupted keys");
+                for (long long key = 0; key < (long long)writers * per_writer; ++key)
+                {
+                    if (mix.contains(key) != ((key / writers) % 2 == 1))
+                        Fail("ConcurrentCuckooHashTable", cnt, "key " + std::to_string(key) + " wrong after concurrent insert/erase");
+                }
+                // 没有进行中的操作后，几次操作退出时推进纪元，旧桶数组全部释放
+                if (mix.retired_tables() != 0)
+                    Fail("ConcurrentCuckooHashTable", cnt, "retired tables not reclaimed after readers quiesced");
+            }
+            static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+            {
+                std::mt19937 rng{seed};
+                std::vector<operation> res(n);
+                auto odist = std::uniform_int_distribution<int>(0, 8);
+                auto vdist = std::uniform_int_distribution<int>(-w, w);
+                for (int i = 0; i < n; i++)
+                {
+                    int tmp = odist(rng);
+                    res[i].opt = (tmp < 4 ? 0 : (tmp < 6 ? 1 : (tmp < 8 ? 2 : 3)));
+                    if (res[i].opt < 3)
+                    {
+                        res[i].value = vdist(rng);
+                    }
+                }
+                return res;
+            }
+            static void Demo(const std::vector<operation> &ops)
+            {
+                auto instance = DemoHashTable();
+                instance.ops = ops;
+                instance.HashTableUniqueDemo<HashTable<int>>("HashTable");
+                instance.HashTableUniqueDemo<RobinHoodHashTable<int>>("RobinHoodHashTable");
+                instance.HashTableUniqueDemo<HashTable<int, int, FastHash<int>, std::equal_to<int>, IdentityKeyOfValue<int>, Pow2ReHash>>("HashTable-FastHash");
+                instance.HashTableMultiDemo();
+                instance.HashTableTransparentDemo<HashTable<std::string, std::string, StringHash, std::equal_to<>>>();
+                instance.HashTableTransparentDemo<RobinHoodHashTable<std::string, std::string, StringHash, std::equal_to<>>>();
+                instance.HashTableTransparentDemo<HashTable<std::string, std::string, FastHash<std::string>, std::equal_to<>>>();
+                instance.HashTableRangeDemo();
+                instance.FastHashDemo();
+                instance.RobinHoodStrideDemo();
+                instance.ConcurrentCuckooDemo();
+            }
+            static void TestCases()
+            {
+
+                int case_index = 0;
+                try
+                {
+
+                    ++case_index;
+                    Demo(RandomGen(5, 2));
+                    ++case_index;
+                    Demo(RandomGen(25, 4));
+                    ++case_index;
+                    Demo(RandomGen(100, 10));
+                    ++case_index;
+                    Demo(RandomGen(500, 40));
+                    ++case_index;
+                    Demo(RandomGen(5000, 1000));
+                    ++case_index;
+                    Demo(RandomGen(20000, 30000));
+
+                    std::cout
+                        << "HashTable test passed" << std::endl;
+                }
+                catch (const std::exception &ex)
+                {
+                    std::cerr << "HashTable test case " << case_index << " fail\n"
+                              << ex.what() << std::endl;
+                }
+            }
+        };
+    }
+}
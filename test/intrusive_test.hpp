@@ -0,0 +1,401 @@
+#pragma once
+#include <list>
+#include <map>
+#include <vector>
+#include <random>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include "../collections/intrusive_list.hpp"
+#include "../tree/binary_tree/binary_search_tree/intrusive_RB_tree.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        struct DemoIntrusive
+        {
+            template <typename T, typename Tag = void>
+            using IntrusiveList = ListOrForwardlist::IntrusiveList<T, Tag>;
+            template <typename Tag = void>
+            using ListHook = ListOrForwardlist::ListHook<Tag>;
+            template <typename T, typename KeyT, typename Compare, typename KeyOfValue, typename Tag = void>
+            using IntrusiveRBTree = Tree::BinaryTree::BinarySearchTree::RBTree::IntrusiveRBTree<T, KeyT, Compare, KeyOfValue, Tag>;
+            template <typename Tag = void>
+            using RBTreeHook = Tree::BinaryTree::BinarySearchTree::RBTree::RBTreeHook<Tag>;
+
+            struct SecondTag;
+            struct UniqueTag;
+            // 同时挂在两条链表和两棵树上的对象
+            struct Item : ListHook<>, ListHook<SecondTag>, RBTreeHook<>, RBTreeHook<UniqueTag>
+            {
+                int key = 0, id = 0;
+            };
+            struct ItemKey
+            {
+                const int &operator()(const Item &x) const { return x.key; }
+            };
+            using ItemList = IntrusiveList<Item>;
+            using SecondList = IntrusiveList<Item, SecondTag>;
+            using MultiTree = IntrusiveRBTree<Item, int, std::less<int>, ItemKey>;
+            using UniqueTree = IntrusiveRBTree<Item, int, std::less<int>, ItemKey, UniqueTag>;
+
+            struct operation
+            {
+                int opt, key, value;
+                friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                {
+                    return os << "(" << op.opt << ":" << op.key << "," << op.value << ")";
+                }
+            };
+            std::vector<operation> ops;
+            void Fail(int cnt, const std::string &msg) const
+            {
+                std::ostringstream ss;
+                ss << "Intrusive test fail on the " << cnt << " operation :\n"
+                   << msg << "\ntotal operations: [ ";
+                for (int i = 0; i < cnt; ++i)
+                    ss << ops[i] << ", ";
+                ss << "]";
+                throw std::runtime_error(ss.str());
+            }
+            template <typename Ls>
+            static std::vector<int> Ids(const Ls &ls)
+            {
+                std::vector<int> res;
+                for (auto &x : ls)
+                    res.push_back(x.id);
+                return res;
+            }
+            // 链表部分与 std::list<int>（存 id）逐步对照
+            void ListDemo(size_t pool_size)
+            {
+                std::vector<Item> pool(pool_size);
+                for (size_t i = 0; i < pool_size; ++i)
+                    pool[i].id = int(i);
+                ItemList ls;
+                SecondList other;
+                std::list<int> st, so;
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    Item &obj = pool[size_t(oo.value) % pool_size];
+                    bool linked = obj.ListHook<>::is_linked();
+                    size_t n = st.size();
+                    switch (oo.opt % 8)
+                    {
+                    case 0:
+                    case 1:
+                        if (linked)
+                            break;
+                        if (oo.opt % 8)
+                            ls.push_front(obj), st.push_front(obj.id);
+                        else
+                            ls.push_back(obj), st.push_back(obj.id);
+                        break;
+                    case 2:
+                    {
+                        if (linked)
+                            break;
+                        size_t k = size_t(oo.key) % (n + 1);
+                        auto it = ls.insert(std::next(ls.begin(), k), obj);
+                        st.insert(std::next(st.begin(), k), obj.id);
+                        if (&*it != &obj)
+                            Fail(cnt, "insert returned wrong iterator");
+                        break;
+                    }
+                    case 3:
+                    {
+                        // 通过对象本身摘下
+                        if (!linked)
+                            break;
+                        auto next = ls.erase(obj);
+                        auto sn = st.erase(std::find(st.begin(), st.end(), obj.id));
+                        if ((next == ls.end()) != (sn == st.end()) || (sn != st.end() && next->id != *sn))
+                            Fail(cnt, "erase(obj) returned wrong iterator");
+                        if (obj.ListHook<>::is_linked())
+                            Fail(cnt, "erased object still linked");
+                        break;
+                    }
+                    case 4:
+                    {
+                        // LRU 式的“移到表头”
+                        if (!linked)
+                            break;
+                        ls.splice(ls.begin(), ls, ls.iterator_to(obj));
+                        st.splice(st.begin(), st, std::find(st.begin(), st.end(), obj.id));
+                        break;
+                    }
+                    case 5:
+                        if (n)
+                        {
+                            if (oo.key & 1)
+                                ls.pop_back(), st.pop_back();
+                            else
+                                ls.pop_front(), st.pop_front();
+                        }
+                        break;
+                    case 6:
+                    {
+                        // 同一批对象的另一个挂钩：挂到第二条链表上，再整段拼接回来
+                        if (!obj.ListHook<SecondTag>::is_linked())
+                            other.push_back(obj), so.push_back(obj.id);
+                        if (oo.key % 3 == 0)
+                        {
+                            ItemList tmp;
+                            for (auto &x : other)
+                                if (!x.ListHook<>::is_linked())
+                                    tmp.push_back(x);
+                            std::list<int> stmp;
+                            for (int id : so)
+                                if (std::find(st.begin(), st.end(), id) == st.end())
+                                    stmp.push_back(id);
+                            size_t k = size_t(oo.key) % (n + 1);
+                            ls.splice(std::next(ls.begin(), k), tmp);
+                            st.splice(std::next(st.begin(), k), stmp);
+                            if (!tmp.empty())
+                                Fail(cnt, "splice should empty the source list");
+                            other.clear();
+                            so.clear();
+                        }
+                        break;
+                    }
+                    default:
+                        if (oo.key & 1)
+                        {
+                            ls.reverse();
+                            st.reverse();
+                        }
+                        else
+                        {
+                            auto pred = [&](const Item &x)
+                            { return x.id % 7 == oo.key % 7; };
+                            auto spred = [&](int id)
+                            { return id % 7 == oo.key % 7; };
+                            if (ls.remove_if(pred) != st.remove_if(spred))
+                                Fail(cnt, "remove_if count");
+                        }
+                        break;
+                    }
+                    if (ls.size() != st.size() || Ids(ls) != std::vector<int>(st.begin(), st.end()))
+                        Fail(cnt, "list content differs from std::list");
+                    std::vector<int> rev;
+                    for (auto it = ls.rbegin(); it != ls.rend(); ++it)
+                        rev.push_back(it->id);
+                    if (rev != std::vector<int>(st.rbegin(), st.rend()))
+                        Fail(cnt, "reverse iteration differs from std::list");
+                    if (Ids(other) != std::vector<int>(so.begin(), so.end()))
+                        Fail(cnt, "second hook list differs");
+                }
+                ItemList moved(std::move(ls));
+                if (!ls.empty() || Ids(moved) != std::vector<int>(st.begin(), st.end()))
+                    Fail(cnt, "move constructor");
+                ls.swap(moved);
+                moved.clear();
+                if (Ids(ls) != std::vector<int>(st.begin(), st.end()))
+                    Fail(cnt, "swap");
+                ls.clear();
+                for (auto &x : pool)
+                    if (x.ListHook<>::is_linked())
+                        Fail(cnt, "clear should unlink every object");
+            }
+            // 树的部分与 std::multimap / std::map 逐步对照
+            void TreeDemo(size_t pool_size, int key_range)
+            {
+                std::vector<Item> pool(pool_size);
+                for (size_t i = 0; i < pool_size; ++i)
+                    pool[i].id = int(i);
+                MultiTree mt;
+                UniqueTree ut;
+                std::multimap<int, int> smt;
+                std::map<int, int> sut;
+                auto same_multi = [&]
+                {
+                    if (mt.size() != smt.size())
+                        return false;
+                    auto it = mt.begin();
+                    for (auto &[k, id] : smt)
+                        if (it->key != k || (it++)->id != id)
+                            return false;
+                    return true;
+                };
+                int cnt = 0;
+                for (auto oo : ops)
+                {
+                    ++cnt;
+                    Item &obj = pool[size_t(oo.value) % pool_size];
+                    int k = oo.key % key_range;
+                    switch (oo.opt % 5)
+                    {
+                    case 0:
+                    case 1:
+                        if (obj.RBTreeHook<>::is_linked() || obj.RBTreeHook<UniqueTag>::is_linked())
+                            break;
+                        obj.key = k;
+                        if (&*mt.insert_multi(obj) != &obj)
+                            Fail(cnt, "insert_multi returned wrong iterator");
+                        smt.emplace(k, obj.id);
+                        {
+                            auto [it, ok] = ut.insert_unique(obj);
+                            auto [sit, sok] = sut.emplace(k, obj.id);
+                            if (ok != sok || it->id != sit->second)
+                                Fail(cnt, "insert_unique result");
+                        }
+                        break;
+                    case 2:
+                    {
+                        // 通过对象本身摘下，不按键查找
+                        if (obj.RBTreeHook<>::is_linked())
+                        {
+                            auto next = mt.erase(obj);
+                            auto [lo, hi] = smt.equal_range(obj.key);
+                            auto sit = std::find_if(lo, hi, [&](auto &pr)
+                                                    { return pr.second == obj.id; });
+                            auto snext = smt.erase(sit);
+                            if ((next == mt.end()) != (snext == smt.end()) || (snext != smt.end() && next->id != snext->second))
+                                Fail(cnt, "erase(obj) returned wrong iterator");
+                        }
+                        if (obj.RBTreeHook<UniqueTag>::is_linked())
+                        {
+                            ut.erase(obj);
+                            sut.erase(obj.key);
+                        }
+                        break;
+                    }
+                    case 3:
+                        if (mt.erase_multi(k) != smt.erase(k) || ut.erase_unique(k) != sut.erase(k))
+                            Fail(cnt, "erase by key count");
+                        break;
+                    default:
+                    {
+                        auto lb = mt.lower_bound(k);
+                        auto slb = smt.lower_bound(k);
+                        if ((lb == mt.end()) != (slb == smt.end()) || (lb != mt.end() && lb->id != slb->second))
+                            Fail(cnt, "lower_bound");
+                        auto ub = ut.upper_bound(k);
+                        auto sub = sut.upper_bound(k);
+                        if ((ub == ut.end()) != (sub == sut.end()) || (ub != ut.end() && ub->id != sub->second))
+                            Fail(cnt, "upper_bound");
+                        auto f = ut.find(k);
+                        if ((f == ut.end()) != !sut.count(k))
+                            Fail(cnt, "find");
+                        if (mt.count(k) != smt.count(k))
+                            Fail(cnt, "count");
+                        break;
+                    }
+                    }
+                    if (!mt.checker_multi() || !ut.checker_unique())
+                        Fail(cnt, "red-black or order property broken");
+                    if (!same_multi())
+                        Fail(cnt, "multi tree differs from std::multimap");
+                    if (ut.size() != sut.size() || !std::equal(ut.begin(), ut.end(), sut.begin(), sut.end(), [](const Item &x, auto &pr)
+                                                               { return x.key == pr.first && x.id == pr.second; }))
+                        Fail(cnt, "unique tree differs from std::map");
+                    if (!mt.empty() && std::prev(mt.end())->id != std::prev(smt.end())->second)
+                        Fail(cnt, "decrement from end()");
+                }
+                MultiTree moved(std::move(mt));
+                if (!mt.empty() || !mt.checker_multi() || !moved.checker_multi())
+                    Fail(cnt, "move constructor");
+                mt.swap(moved);
+                if (!same_multi() || !moved.empty())
+                    Fail(cnt, "swap");
+                mt.clear();
+                ut.clear_and_dispose([](Item *x)
+                                     { x->key = -1; });
+                for (auto &x : pool)
+                    if (x.RBTreeHook<>::is_linked() || x.RBTreeHook<UniqueTag>::is_linked())
+                        Fail(cnt, "clear should unlink every object");
+            }
+            // LRU：链表维护使用顺序，树按键索引，淘汰和命中都不分配内存
+            static void LRUDemo()
+            {
+                constexpr size_t capacity = 16;
+                std::vector<Item> slots(capacity);
+                ItemList lru;
+                MultiTree index;
+                std::list<int> ref;
+                std::mt19937 rng{7};
+                for (size_t i = 0; i < capacity; ++i)
+                    lru.push_back(slots[i]);
+                for (int step = 0; step < 20000; ++step)
+                {
+                    int k = int(rng() % 40);
+                    auto rit = std::find(ref.begin(), ref.end(), k);
+                    auto it = index.find(k);
+                    if ((it == index.end()) != (rit == ref.end()))
+                        throw std::runtime_error("Intrusive test fail: LRU lookup differs");
+                    if (it != index.end())
+                    {
+                        lru.splice(lru.begin(), lru, lru.iterator_to(*it));
+                        ref.splice(ref.begin(), ref, rit);
+                        continue;
+                    }
+                    // 未命中：复用最久未使用的槽位
+                    Item &victim = lru.back();
+                    if (victim.RBTreeHook<>::is_linked())
+                        index.erase(victim);
+                    if (ref.size() == capacity)
+                        ref.pop_back();
+                    victim.key = k;
+                    index.insert_multi(victim);
+                    lru.splice(lru.begin(), lru, lru.iterator_to(victim));
+                    ref.push_front(k);
+                }
+                std::vector<int> keys;
+                for (auto it = lru.begin(); it != lru.end() && it->RBTreeHook<>::is_linked(); ++it)
+                    keys.push_back(it->key);
+                if (keys != std::vector<int>(ref.begin(), ref.end()) || index.size() != ref.size() || !index.checker_unique())
+                    throw std::runtime_error("Intrusive test fail: LRU order differs");
+            }
+            static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+            {
+                std::mt19937 rng{seed};
+                std::vector<operation> res(n);
+                auto odist = std::uniform_int_distribution<int>(0, 39);
+                auto vdist = std::uniform_int_distribution<int>(0, w);
+                for (int i = 0; i < n; i++)
+                {
+                    res[i].opt = odist(rng);
+                    res[i].key = vdist(rng);
+                    res[i].value = vdist(rng);
+                }
+                return res;
+            }
+            static void Demo(const std::vector<operation> &ops, size_t pool_size, int key_range)
+            {
+                auto instance = DemoIntrusive();
+                instance.ops = ops;
+                instance.ListDemo(pool_size);
+                instance.TreeDemo(pool_size, key_range);
+            }
+            static void TestCases()
+            {
+
+                int case_index = 0;
+                try
+                {
+
+                    ++case_index;
+                    Demo(RandomGen(10, 4), 4, 3);
+                    ++case_index;
+                    Demo(RandomGen(100, 20), 12, 8);
+                    ++case_index;
+                    Demo(RandomGen(1000, 200), 64, 40);
+                    ++case_index;
+                    Demo(RandomGen(5000, 1000), 300, 1000);
+                    ++case_index;
+                    LRUDemo();
+
+                    std::cout
+                        << "Intrusive test passed" << std::endl;
+                }
+                catch (const std::exception &ex)
+                {
+                    std::cerr << "Intrusive test case " << case_index << " fail\n"
+                              << ex.what() << std::endl;
+                }
+            }
+        };
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "../collections/list_forwardlist.hpp"
+#include "../collections/node_pool.hpp"
 namespace DSA
 {
     namespace Collections
@@ -51,9 +52,10 @@ namespace DSA
                         os << i << ", ";
                     os << "]";
                 }
+                template <typename ListType = List<int>>
                 void ListDemo()
                 {
-                    List<int> ls;
+                    ListType ls;
                     if (!requires {
                             ls.front();
                             ls.back();
@@ -210,6 +212,104 @@ namespace DSA
                     }
                     return;
                 }
+                // 节点池：clear 整块释放、释放的节点被复用、拷贝得到独立的池、共享池的链表之间 splice
+                static void PoolDemo()
+                {
+                    using PoolList = List<std::string, NodePoolAllocator<std::string>>;
+                    auto fail = [](const char *msg)
+                    { throw std::runtime_error(std::string("List pool test fail: ") + msg); };
+                    PoolList ls;
+                    for (int i = 0; i < 1000; ++i)
+                        ls.push_back(std::to_string(i) + std::string(20, 'x'));
+                    auto pool = ls.get_allocator().pool;
+                    if (pool->live_nodes() != ls.size() + 1 || pool->slab_count() < 2)
+                        fail("nodes are not carved from the pool");
+                    ls.erase(std::next(ls.begin(), 10), std::next(ls.begin(), 20));
+                    size_t slabs = pool->slab_count();
+                    for (int i = 0; i < 10; ++i)
+                        ls.push_front(std::to_string(-i));
+                    if (pool->slab_count() != slabs || pool->live_nodes() != ls.size() + 1)
+                        fail("freed nodes are not reused");
+                    PoolList copied(ls);
+                    if (copied.get_allocator() == ls.get_allocator() || !std::equal(copied.begin(), copied.end(), ls.begin(), ls.end()))
+                        fail("copy should own a separate pool");
+                    ls.clear();
+                    if (!ls.empty() || ls.size() || pool->slab_count() != 1 || pool->live_nodes() != 1)
+                        fail("clear should release whole slabs");
+                    ls.push_back("a");
+                    ls.push_back("b");
+                    PoolList other(ls.get_allocator());
+                    other.push_back("c");
+                    ls.splice(ls.end(), other);
+                    ls.sort();
+                    ls.remove("b");
+                    if (ls.size() != 2 || ls.front() != "a" || ls.back() != "c" || pool->live_nodes() != 4)
+                        fail("splice between lists sharing a pool");
+                    ls.clear(); // other 的 header 仍在池中，只能逐个归还
+                    if (pool->live_nodes() != 2)
+                        fail("clear must not release a shared pool");
+                    ls = copied;
+                    if (ls.size() != copied.size() || ls.get_allocator() == copied.get_allocator())
+                        fail("copy assignment");
+                }
+                // 长链表走 gather_sort：基数排序、内联键归并、指针归并、并行归并四条路径都与 std::stable_sort 对照
+                template <typename T, typename Compare, typename Make>
+                static void SortPathDemo(const char *name, size_t n, Compare comp, Make make, bool parallel)
+                {
+                    std::mt19937 rng{unsigned(n)};
+                    std::vector<T> expected;
+                    List<T> ls;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        T v = make(int(rng() % (n / 4 + 1)), int(i));
+                        expected.push_back(v);
+                        ls.push_back(v);
+                    }
+                    auto probe = std::next(ls.begin(), n / 3);
+                    T probe_value = *probe;
+                    std::stable_sort(expected.begin(), expected.end(), comp);
+                    if (parallel)
+                        ls.parallel_sort(comp);
+                    else
+                        ls.sort(comp);
+                    if (ls.size() != n || !std::equal(ls.begin(), ls.end(), expected.begin(), expected.end()) ||
+                        !std::equal(ls.rbegin(), ls.rend(), expected.rbegin(), expected.rend()))
+                        throw std::runtime_error(std::string("List sort fail: ") + name + " differs from std::stable_sort");
+                    if (!(*probe == probe_value))
+                        throw std::runtime_error(std::string("List sort fail: ") + name + " moved an element payload");
+                }
+                static void SortDemo()
+                {
+                    struct Keyed
+                    {
+                        int key, order;
+                        bool operator==(const Keyed &) const = default;
+                    };
+                    auto by_key = [](const Keyed &a, const Keyed &b)
+                    { return a.key < b.key; };
+                    for (size_t n : {size_t(50), size_t(300), size_t(5000), size_t(50000)})
+                    {
+                        SortPathDemo<int>("radix", n, std::less<int>{}, [n](int v, int)
+                                          { return v - int(n / 8); }, false);
+                        SortPathDemo<unsigned>("unsigned radix", n, std::less<>{}, [](int v, int)
+                                               { return unsigned(v) * 2654435761u; }, false);
+                        SortPathDemo<int>("greater", n, std::greater<int>{}, [](int v, int)
+                                          { return v; }, false);
+                        SortPathDemo<Keyed>("inline keys", n, by_key, [](int v, int i)
+                                            { return Keyed{v, i}; }, false);
+                        SortPathDemo<std::string>("node pointers", n, std::less<std::string>{}, [](int v, int)
+                                                  { return std::to_string(v); }, false);
+                        SortPathDemo<Keyed>("parallel inline keys", n, by_key, [](int v, int i)
+                                            { return Keyed{v, i}; }, true);
+                        SortPathDemo<std::string>("parallel node pointers", n, std::greater<std::string>{}, [](int v, int)
+                                                  { return std::to_string(v); }, true);
+                    }
+                    const size_t big = List<std::string>::gather_sort_threshold + 1;
+                    SortPathDemo<std::string>("node pointers", big, std::less<std::string>{}, [](int v, int)
+                                              { return std::to_string(v); }, false);
+                    SortPathDemo<std::string>("parallel node pointers", big, std::greater<std::string>{}, [](int v, int)
+                                              { return std::to_string(v); }, true);
+                }
                 static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
                 {
                     std::mt19937 rng{seed};
@@ -228,11 +328,36 @@ namespace DSA
                     }
                     return res;
                 }
+                // emplace 系列把值直接构造进节点，右值版本只移动一次
+                static void EmplaceDemo()
+                {
+                    struct Tracked
+                    {
+                        int *copies, *moves;
+                        std::string s;
+                        Tracked(int *c = nullptr, int *m = nullptr, std::string v = {}) : copies(c), moves(m), s(std::move(v)) {}
+                        Tracked(const Tracked &o) : copies(o.copies), moves(o.moves), s(o.s) { ++*copies; }
+                        Tracked(Tracked &&o) noexcept : copies(o.copies), moves(o.moves), s(std::move(o.s)) { ++*moves; }
+                    };
+                    int copies = 0, moves = 0;
+                    List<Tracked, NodePoolAllocator<Tracked>> ls;
+                    ls.emplace_back(&copies, &moves, "b");
+                    ls.emplace_front(&copies, &moves, "a");
+                    ls.emplace(std::next(ls.begin()), &copies, &moves, "ab");
+                    if (copies || moves || ls.front().s != "a" || ls.back().s != "b" || std::next(ls.begin())->s != "ab")
+                        throw std::runtime_error("List test fail: emplace should construct in place");
+                    ls.push_back(Tracked(&copies, &moves, "c"));
+                    ls.push_front(Tracked(&copies, &moves, "0"));
+                    ls.insert(ls.end(), Tracked(&copies, &moves, "d"));
+                    if (copies || moves != 3 || ls.size() != 6 || ls.back().s != "d" || ls.front().s != "0")
+                        throw std::runtime_error("List test fail: rvalue insertion should move exactly once");
+                }
                 static void Demo(const std::vector<operation> &ops)
                 {
                     auto instance = DemoList();
                     instance.ops = ops;
                     instance.ListDemo();
+                    instance.ListDemo<List<int, NodePoolAllocator<int>>>();
                 }
                 static void TestCases()
                 {
@@ -263,6 +388,12 @@ namespace DSA
                         Demo(RandomGen(5000, 300));
                         ++case_index;
                         Demo(RandomGen(5000, 500));
+                        ++case_index;
+                        PoolDemo();
+                        ++case_index;
+                        SortDemo();
+                        ++case_index;
+                        EmplaceDemo();
 
                         std::cout
                             << "List test passed" << std::endl;
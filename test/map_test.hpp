@@ -338,6 +338,318 @@ namespace DSA
                     }
                     return res;
                 }
+                // 统计拷贝与移动次数的值类型
+                struct Tracked
+                {
+                    static inline int copies = 0, moves = 0;
+                    std::string s;
+                    Tracked(std::string v = {}) : s(std::move(v)) {}
+                    Tracked(const Tracked &o) : s(o.s) { ++copies; }
+                    Tracked(Tracked &&o) noexcept : s(std::move(o.s)) { ++moves; }
+                    Tracked &operator=(const Tracked &o) { return ++copies, s = o.s, *this; }
+                    Tracked &operator=(Tracked &&o) noexcept { return ++moves, s = std::move(o.s), *this; }
+                    static void Reset() { copies = moves = 0; }
+                };
+                // emplace / try_emplace / insert(&&) 应当把值直接构造进节点，不产生多余的拷贝
+                template <template <typename, typename, typename, typename> class Implement>
+                static void EmplaceDemo()
+                {
+                    auto check = [](bool ok, const char *what)
+                    {
+                        if (!ok)
+                            throw std::runtime_error(std::string("Map test fail: ") + what);
+                    };
+                    Map<std::string, Tracked, std::less<std::string>, Implement> m;
+                    Tracked::Reset();
+                    check(m.try_emplace("a", std::string(100, 'a')).second, "try_emplace new key");
+                    check(Tracked::copies == 0 && Tracked::moves == 0, "try_emplace should construct in place");
+                    std::string payload(100, 'x');
+                    check(!m.try_emplace("a", std::move(payload)).second, "try_emplace existing key");
+                    check(payload.size() == 100 && m.find("a")->second.s == std::string(100, 'a'), "try_emplace must not consume args on existing key");
+                    check(m.emplace(std::piecewise_construct, std::forward_as_tuple("b"), std::forward_as_tuple("bb")).second, "emplace piecewise");
+                    check(!m.emplace("b", Tracked("zz")).second && m.find("b")->second.s == "bb", "emplace duplicate");
+                    check(Tracked::copies == 0, "emplace should not copy");
+                    Tracked::Reset();
+                    std::pair<const std::string, Tracked> v{"c", Tracked("cc")};
+                    Tracked::Reset();
+                    m.insert(std::move(v));
+                    check(Tracked::copies == 0 && Tracked::moves == 1, "insert(value_type&&) should move once");
+                    std::pair<const std::string, Tracked> dup{"c", Tracked("dup")};
+                    Tracked::Reset();
+                    m.insert(std::move(dup));
+                    check(Tracked::copies == 0 && Tracked::moves == 0 && m.find("c")->second.s == "cc", "insert(&&) of existing key should not construct a node");
+                    std::string key = "d";
+                    Tracked::Reset();
+                    m[std::move(key)].s = "dd";
+                    check(m["d"].s == "dd" && Tracked::copies == 0 && Tracked::moves == 0, "operator[] should default-construct in place");
+                    check(!m.insert_or_assign("d", Tracked("d2")).second && m["d"].s == "d2", "insert_or_assign existing");
+                    check(m.insert_or_assign("e", Tracked("ee")).second && m["e"].s == "ee", "insert_or_assign new");
+                    check(Tracked::copies == 0, "insert_or_assign should not copy");
+                    check(m.size() == 5 && m.checker(), "tree property after emplace");
+
+                    MultiMap<std::string, Tracked, std::less<std::string>, Implement> mm;
+                    Tracked::Reset();
+                    for (int i = 0; i < 3; ++i)
+                        mm.emplace(std::piecewise_construct, std::forward_as_tuple("k"), std::forward_as_tuple(std::to_string(i)));
+                    mm.insert(std::pair<const std::string, Tracked>{"k", Tracked("3")});
+                    check(Tracked::copies == 0 && mm.count("k") == 4 && mm.checker(), "multimap emplace");
+                    int i = 0;
+                    for (auto &[k, t] : mm)
+                        check(t.s == std::to_string(i++), "multimap emplace keeps insertion order of equal keys");
+                }
+                // 节点句柄：摘下、改键、插回以及两个容器之间的 merge 都不应拷贝或移动值
+                template <template <typename, typename, typename, typename> class Implement>
+                static void NodeHandleDemo()
+                {
+                    auto check = [](bool ok, const char *what)
+                    {
+                        if (!ok)
+                            throw std::runtime_error(std::string("Map test fail: ") + what);
+                    };
+                    using M = Map<int, Tracked, std::less<int>, Implement>;
+                    using MM = MultiMap<int, Tracked, std::less<int>, Implement>;
+                    M a, b;
+                    for (int i = 0; i < 64; ++i)
+                    {
+                        a.try_emplace(i, std::to_string(i));
+                        if (i % 3 == 0)
+                            b.try_emplace(i, "b" + std::to_string(i));
+                    }
+                    MM mm; // 头结点构造会拷贝一个默认值，放在计数之前
+                    Tracked::Reset();
+                    auto nh = a.extract(10);
+                    check(nh && nh.key() == 10 && nh.mapped().s == "10" && a.size() == 63 && a.checker(), "extract by key");
+                    check(a.extract(10).empty() && a.extract(a.end()).empty(), "extract of missing key should be empty");
+                    nh.key() = 100;
+                    auto res = a.insert(std::move(nh));
+                    check(res.inserted && res.node.empty() && res.position->first == 100 && a.checker(), "insert node handle with changed key");
+                    auto dup = a.extract(a.find(3));
+                    auto res2 = b.insert(std::move(dup));
+                    check(!res2.inserted && res2.node && res2.node.mapped().s == "3" && res2.position->second.s == "b3", "insert of duplicate returns the node");
+                    a.insert(std::move(res2.node));
+                    a.merge(b);
+                    check(a.size() == 64 && b.size() == 22 && a.checker() && b.checker(), "merge keeps duplicates in the source");
+                    for (auto &[k, t] : b)
+                        check(k % 3 == 0 && a.find(k) != a.end() && a.find(k)->second.s == std::to_string(k), "merge must not overwrite existing keys");
+                    mm.emplace(std::piecewise_construct, std::forward_as_tuple(0), std::forward_as_tuple("m0"));
+                    mm.merge(a);
+                    mm.merge(b);
+                    check(a.empty() && b.empty() && mm.size() == 87 && mm.count(0) == 3 && mm.checker(), "multimap merge takes every node");
+                    check(mm.lower_bound(0)->second.s == "m0", "multimap merge keeps existing equal keys first");
+                    auto mh = mm.extract(0);
+                    check(mh.mapped().s == "m0" && mm.count(0) == 2, "multimap extract takes the first equal key");
+                    mm.insert(std::move(mh));
+                    check(std::prev(mm.upper_bound(0))->second.s == "m0", "multimap node insert goes after equal keys");
+                    check(Tracked::copies == 0 && Tracked::moves == 0, "node handles must not copy or move values");
+                    // 与 std::map 的 extract/insert/merge 随机对照
+                    std::mt19937 rng{11};
+                    Map<int, int, std::less<int>, Implement> x, y;
+                    std::map<int, int> sx, sy;
+                    for (int step = 0; step < 3000; ++step)
+                    {
+                        int k = int(rng() % 200), op = int(rng() % 10);
+                        if (op < 5)
+                            x.insert({k, step}), sx.insert({k, step});
+                        else if (op < 7)
+                        {
+                            auto h = x.extract(k);
+                            auto sh = sx.extract(k);
+                            check(h.empty() == sh.empty(), "random extract");
+                            if (h)
+                            {
+                                auto r = y.insert(std::move(h));
+                                auto sr = sy.insert(std::move(sh));
+                                check(r.inserted == sr.inserted && r.position->second == sr.position->second, "random node insert");
+                            }
+                        }
+                        else if (op < 9)
+                            y.insert({k, -step}), sy.insert({k, -step});
+                        else
+                        {
+                            std::swap(x, y), std::swap(sx, sy);
+                            x.merge(y), sx.merge(sy);
+                        }
+                        check(x.checker() && y.checker() && std::equal(x.begin(), x.end(), sx.begin(), sx.end()) && std::equal(y.begin(), y.end(), sy.begin(), sy.end()), "random extract/merge differs from std::map");
+                    }
+                }
+                // 排行榜式查询：按分数的名次、第i名、分数区间内的人数
+                template <template <typename, typename, typename, typename> class Implement>
+                static void OrderStatisticDemo()
+                {
+                    MultiMap<int, int, std::greater<int>, Implement> board;
+                    Map<int, int, std::less<int>, Implement> byId;
+                    std::mt19937 rng{7};
+                    for (int id = 0; id < 2000; ++id)
+                    {
+                        int score = int(rng() % 500);
+                        board.emplace(score, id);
+                        byId.try_emplace(id, score);
+                    }
+                    std::vector<int> scores;
+                    for (auto &[id, score] : byId)
+                        scores.push_back(score);
+                    std::sort(scores.begin(), scores.end(), std::greater<int>());
+                    for (size_t i = 0; i < scores.size(); i += 37)
+                        if (board.select(i)->first != scores[i])
+                            throw std::runtime_error("Map test fail: select i-th score");
+                    for (int q = 0; q < 500; q += 13)
+                    {
+                        size_t better = size_t(std::count_if(scores.begin(), scores.end(), [&](int x)
+                                                             { return x > q; }));
+                        if (board.rank(q) != better || board.count(q) != size_t(std::count(scores.begin(), scores.end(), q)))
+                            throw std::runtime_error("Map test fail: rank/count by score");
+                        if (board.distance(board.lower_bound(q + 50), board.upper_bound(q)) != std::distance(board.lower_bound(q + 50), board.upper_bound(q)))
+                            throw std::runtime_error("Map test fail: distance");
+                    }
+                    for (int id = 0; id < 2000; id += 3)
+                        byId.erase(id);
+                    if (!byId.checker() || byId.rank(1000) != 666 || byId.select(666)->first != 1000 || byId.index_of(byId.find(1000)) != 666)
+                        throw std::runtime_error("Map test fail: rank/select after erase");
+                }
+                // 不满足交换律的幺半群，用来检查聚合按键序从左到右合并
+                struct ConcatMonoid
+                {
+                    using value_type = std::string;
+                    static std::string identity() { return {}; }
+                    static std::string combine(const std::string &a, const std::string &b) { return a + b; }
+                };
+                // 区间聚合：随机插入、删除、改值、摘下重插之后，与 std::map 上的线性累加对照
+                template <template <typename> class AggregateTree>
+                static void AggregateDemo()
+                {
+                    auto check = [](bool ok, const char *what)
+                    {
+                        if (!ok)
+                            throw std::runtime_error(std::string("Map test fail: ") + what);
+                    };
+                    Map<int, long long, std::less<int>, AggregateTree<SumMonoid<long long>>::template Linked> sum;
+                    MultiMap<int, int, std::less<int>, AggregateTree<MaxMonoid<int>>::template Linked> mx;
+                    Map<int, std::string, std::less<int>, AggregateTree<ConcatMonoid>::template Linked> cat;
+                    std::map<int, long long> ssum;
+                    std::multimap<int, int> smx;
+                    std::map<int, std::string> scat;
+                    std::mt19937 rng{48};
+                    for (int step = 0; step < 6000; ++step)
+                    {
+                        int k = int(rng() % 400), v = int(rng() % 1000) - 300, op = int(rng() % 8);
+                        if (op < 3)
+                        {
+                            // 两种写法都要让聚合随之更新
+                            if (step & 1)
+                                sum.insert_or_assign(k, v), ssum[k] = v;
+                            else
+                                sum[k] = v, ssum[k] = v;
+                            mx.emplace(k, v), smx.emplace(k, v);
+                            cat.insert_or_assign(k, std::string(1, char('a' + v % 26 + (v < 0 ? 26 : 0)))), scat[k] = std::string(1, char('a' + v % 26 + (v < 0 ? 26 : 0)));
+                        }
+                        else if (op < 5)
+                        {
+                            sum.erase(k), ssum.erase(k), cat.erase(k), scat.erase(k);
+                            if (auto it = mx.find(k); it != mx.end())
+                            {
+                                for (auto sit = smx.lower_bound(k);; ++sit)
+                                    if (sit->second == it->second)
+                                    {
+                                        smx.erase(sit);
+                                        break;
+                                    }
+                                mx.erase(it);
+                            }
+                        }
+                        else if (op < 6)
+                        {
+                            // 通过迭代器改值后手动 refresh
+                            if (auto it = sum.find(k); it != sum.end())
+                                it->second += 5, ssum[k] += 5, sum.refresh(it);
+                        }
+                        else if (op < 7)
+                        {
+                            // 摘下、改键、重插
+                            if (auto nh = sum.extract(k))
+                            {
+                                ssum.erase(k);
+                                nh.key() = k + 400;
+                                ssum.insert({k + 400, nh.mapped()});
+                                sum.insert(std::move(nh));
+                            }
+                        }
+                        else
+                            sum[k], ssum[k];
+                        if (step % 40)
+                            continue;
+                        check(sum.checker() && mx.checker() && cat.checker(), "aggregate trees stay valid");
+                        for (int t = 0; t < 20; ++t)
+                        {
+                            int lo = int(rng() % 900) - 50, hi = lo + int(rng() % 300);
+                            long long es = 0;
+                            int em = std::numeric_limits<int>::lowest();
+                            std::string ec;
+                            for (auto it = ssum.lower_bound(lo); it != ssum.end() && it->first < hi; ++it)
+                                es += it->second;
+                            for (auto it = smx.lower_bound(lo); it != smx.end() && it->first < hi; ++it)
+                                em = std::max(em, it->second);
+                            for (auto it = scat.lower_bound(lo); it != scat.end() && it->first < hi; ++it)
+                                ec += it->second;
+                            check(sum.aggregate(lo, hi) == es, "sum over key range");
+                            check(mx.aggregate(lo, hi) == em, "max over key range");
+                            check(cat.aggregate(lo, hi) == ec, "aggregation must follow key order");
+                        }
+                    }
+                    // operator[] 写入已有的键后，区间查询立即看到新值
+                    Map<int, long long, std::less<int>, AggregateTree<SumMonoid<long long>>::template Linked> m;
+                    for (int k = 0; k < 64; ++k)
+                        m[k] = k;
+                    m[10] = 1000;
+                    m[20] += 7;
+                    m[30] = m[10];
+                    const long long &v10 = m[10];
+                    check(v10 == 1000 && m.at(30) == 1000, "operator[] reads through the proxy");
+                    check(m.aggregate(0, 64) == 63 * 64 / 2 - 10 + 1000 + 7 - 30 + 1000, "operator[] assignment refreshes the aggregate");
+                    check(m.aggregate(15, 25) == 15 + 16 + 17 + 18 + 19 + 27 + 21 + 22 + 23 + 24, "operator[] += refreshes the aggregate");
+                    check(m.checker(), "aggregate tree stays valid after operator[]");
+                }
+                // 从无序的键值对批量建树：Map保留等价键中先出现的一项，MultiMap保持等价键的输入次序，聚合值自底向上算好
+                template <template <typename, typename, typename, typename> class Implement>
+                static void BulkBuildDemo()
+                {
+                    auto check = [](bool ok, const char *what)
+                    {
+                        if (!ok)
+                            throw std::runtime_error(std::string("Map test fail: ") + what);
+                    };
+                    std::mt19937 rng{50};
+                    std::vector<std::pair<int, int>> v(3000);
+                    for (size_t i = 0; i < v.size(); ++i)
+                        v[i] = {int(rng() % 1000), int(i)};
+                    std::map<int, int> sm(v.begin(), v.end());
+                    std::multimap<int, int> smm(v.begin(), v.end());
+                    Map<int, int, std::less<int>, Implement> m(v.begin(), v.end());
+                    MultiMap<int, int, std::less<int>, Implement> mm(v.begin(), v.end());
+                    check(m.checker() && mm.checker(), "bulk built tree invalid");
+                    check(std::equal(m.begin(), m.end(), sm.begin(), sm.end()), "Map keeps the first of equivalent keys");
+                    check(std::equal(mm.begin(), mm.end(), smm.begin(), smm.end()), "MultiMap keeps input order of equivalent keys");
+                    mm.assign_sorted(sm.begin(), sm.end());
+                    check(mm.checker() && std::equal(mm.begin(), mm.end(), sm.begin(), sm.end()), "assign_sorted");
+                }
+                template <template <typename> class AggregateTree>
+                static void BulkBuildAggregateDemo()
+                {
+                    std::vector<std::pair<int, long long>> v;
+                    for (int i = 0; i < 2000; ++i)
+                        v.push_back({(i * 7919) % 2003, i});
+                    Map<int, long long, std::less<int>, AggregateTree<SumMonoid<long long>>::template Linked> sum(v.begin(), v.end());
+                    std::map<int, long long> ssum(v.begin(), v.end());
+                    if (!sum.checker())
+                        throw std::runtime_error("Map test fail: bulk built aggregate tree invalid");
+                    for (int lo = -10; lo < 2100; lo += 97)
+                    {
+                        long long es = 0;
+                        for (auto it = ssum.lower_bound(lo); it != ssum.end() && it->first < lo + 500; ++it)
+                            es += it->second;
+                        if (sum.aggregate(lo, lo + 500) != es)
+                            throw std::runtime_error("Map test fail: aggregate of bulk built tree");
+                    }
+                }
                 static void Demo(const std::vector<operation> &ops)
                 {
                     auto instance = DemoMap();
@@ -372,6 +684,32 @@ namespace DSA
                         Demo(RandomGen(5000, 1000));
                         ++case_index;
                         Demo(RandomGen(5000, 3000));
+                        ++case_index;
+                        EmplaceDemo<RBTreeLinked>();
+                        ++case_index;
+                        EmplaceDemo<AVLTreeLinked>();
+                        ++case_index;
+                        NodeHandleDemo<RBTreeLinked>();
+                        ++case_index;
+                        NodeHandleDemo<AVLTreeLinked>();
+                        ++case_index;
+                        OrderStatisticDemo<OrderStatisticRBTreeLinked>();
+                        ++case_index;
+                        OrderStatisticDemo<OrderStatisticAVLTreeLinked>();
+                        ++case_index;
+                        AggregateDemo<AggregateRBTree>();
+                        ++case_index;
+                        AggregateDemo<AggregateAVLTree>();
+                        ++case_index;
+                        BulkBuildDemo<RBTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<AVLTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<BPlusTree>();
+                        ++case_index;
+                        BulkBuildAggregateDemo<AggregateRBTree>();
+                        ++case_index;
+                        BulkBuildAggregateDemo<AggregateAVLTree>();
 
                         std::cout
                             << "Map/MultiMap test passed" << std::endl;
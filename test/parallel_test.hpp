@@ -0,0 +1,178 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <iostream>
+#include "../parallel/work_stealing_deque.hpp"
+#include "../parallel/scheduler.hpp"
+namespace DSA
+{
+    namespace Parallel
+    {
+        struct DemoParallel
+        {
+            static void Fail(const std::string &msg)
+            {
+                throw std::runtime_error("Parallel test fail: " + msg);
+            }
+            // 所有者端后进先出，窃取端先进先出，扩容后内容不丢
+            static void DequeDemo()
+            {
+                WorkStealingDeque<int> dq(4);
+                for (int i = 0; i < 100; ++i)
+                    dq.push(i);
+                if (dq.steal() != 0 || dq.steal() != 1 || dq.pop() != 99 || dq.pop() != 98)
+                    Fail("deque ends");
+                int cnt = 0;
+                while (dq.pop())
+                    ++cnt;
+                if (cnt != 96 || dq.steal() || dq.pop())
+                    Fail("deque must be empty after draining");
+            }
+            // 所有者不断 push / pop，多个窃取者并发 steal：每个元素恰好被取走一次
+            static void StealStressDemo()
+            {
+                const int n = 200000, thieves = 3;
+                WorkStealingDeque<int> dq(8);
+                std::vector<std::atomic<int>> taken(n);
+                std::atomic<bool> done{false};
+                std::vector<std::thread> threads;
+                for (int k = 0; k < thieves; ++k)
+                    threads.emplace_back([&]
+                                         {
+                                             while (!done.load(std::memory_order_acquire) || !dq.empty_approx())
+                                                 if (auto x = dq.steal())
+                                                     ++taken[*x]; });
+                for (int i = 0; i < n; ++i)
+                {
+                    dq.push(i);
+                    if (i % 3 == 0)
+                        if (auto x = dq.pop())
+                            ++taken[*x];
+                }
+                while (auto x = dq.pop())
+                    ++taken[*x];
+                done.store(true, std::memory_order_release);
+                for (auto &th : threads)
+                    th.join();
+                for (int i = 0; i < n; ++i)
+                    if (taken[i] != 1)
+                        Fail("element " + std::to_string(i) + " taken " + std::to_string(taken[i]) + " times");
+            }
+            static long long Fib(Scheduler &s, int n)
+            {
+                if (n < 12)
+                    return n < 2 ? n : Fib(s, n - 1) + Fib(s, n - 2);
+                long long a = 0;
+                TaskGroup g(s);
+                g.spawn([&]
+                        { a = Fib(s, n - 1); });
+                long long b = Fib(s, n - 2);
+                g.sync();
+                return a + b;
+            }
+            static void SchedulerDemo()
+            {
+                Scheduler s(4);
+                // 嵌套的 spawn / sync
+                if (Fib(s, 24) != 46368)
+                    Fail("nested spawn/sync");
+                // parallel_for 恰好访问每个下标一次
+                std::vector<int> hits(100003);
+                parallel_for(0, hits.size(), 64, [&](size_t i)
+                             { hits[i] += int(i % 7); },
+                             s);
+                for (size_t i = 0; i < hits.size(); ++i)
+                    if (hits[i] != int(i % 7))
+                        Fail("parallel_for");
+                // parallel_reduce 的 combine 按区间顺序合并：拼接字符串检验顺序
+                long long sum = parallel_reduce(
+                    size_t(0), size_t(1000000), size_t(0), 0ll, [](size_t lo, size_t hi)
+                    {
+                        long long r = 0;
+                        for (size_t i = lo; i < hi; ++i)
+                            r += (long long)i;
+                        return r; },
+                    [](long long a, long long b)
+                    { return a + b; },
+                    s);
+                if (sum != 1000000ll * 999999 / 2)
+                    Fail("parallel_reduce sum");
+                std::string digits = parallel_reduce(
+                    size_t(0), size_t(500), size_t(3), std::string(), [](size_t lo, size_t hi)
+                    {
+                        std::string r;
+                        for (size_t i = lo; i < hi; ++i)
+                            r += char('0' + i % 10);
+                        return r; },
+                    [](std::string a, const std::string &b)
+                    { return a + b; },
+                    s);
+                for (size_t i = 0; i < 500; ++i)
+                    if (digits.size() != 500 || digits[i] != char('0' + i % 10))
+                        Fail("parallel_reduce must combine in order");
+                // 子任务的异常在 sync 中重新抛出
+                bool caught = false;
+                try
+                {
+                    TaskGroup g(s);
+                    for (int i = 0; i < 8; ++i)
+                        g.spawn([i]
+                                { if (i == 5) throw std::logic_error("task failed"); });
+                    g.sync();
+                }
+                catch (const std::logic_error &)
+                {
+                    caught = true;
+                }
+                if (!caught)
+                    Fail("exception from a task must be rethrown by sync");
+                // 构造任务时抛出的异常直接从 spawn 抛出，不能让 sync 永远等待一个没有入队的任务
+                struct ThrowOnCopy
+                {
+                    std::atomic<int> *runs;
+                    ThrowOnCopy(std::atomic<int> *r) : runs(r) {}
+                    ThrowOnCopy(const ThrowOnCopy &) { throw std::runtime_error("copy failed"); }
+                    void operator()() const { ++*runs; }
+                };
+                std::atomic<int> runs{0};
+                {
+                    TaskGroup g(s);
+                    g.spawn([&runs]
+                            { ++runs; });
+                    ThrowOnCopy bad(&runs);
+                    caught = false;
+                    try
+                    {
+                        g.spawn(bad);
+                    }
+                    catch (const std::runtime_error &)
+                    {
+                        caught = true;
+                    }
+                    g.sync();
+                    if (!caught || runs.load() != 1)
+                        Fail("spawn must undo its pending count when the task cannot be created");
+                }
+            }
+            static void TestCases()
+            {
+                try
+                {
+                    DequeDemo();
+                    StealStressDemo();
+                    SchedulerDemo();
+                    std::cout
+                        << "Parallel test passed" << std::endl;
+                }
+                catch (const std::exception &ex)
+                {
+                    std::cerr << ex.what() << std::endl;
+                }
+            }
+        };
+    }
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include "../collections/ring_buffer.hpp"
+#include "../collections/queue_stack.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            struct DemoRingBuffer
+            {
+                struct operation
+                {
+                    int opt, key, value;
+                    friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                    {
+                        switch (op.opt)
+                        {
+                        case 0:
+                        {
+                            os << "(push_back:" << op.value << ")";
+                            break;
+                        }
+                        case 1:
+                        {
+                            os << "(push_front:" << op.value << ")";
+                            break;
+                        }
+                        case 2:
+                        {
+                            os << "(pop_front)";
+                            break;
+                        }
+                        case 3:
+                        {
+                            os << "(push_n:" << op.key << ")";
+                            break;
+                        }
+                        case 4:
+                        {
+                            os << "(pop_n:" << op.key << ")";
+                            break;
+                        }
+                        default:
+                        {
+                            os << "(reserve:" << op.key << ")";
+                            break;
+                        }
+                        }
+                        return os;
+                    }
+                };
+                std::vector<operation> ops;
+                template <typename T>
+                static void Print(const std::vector<T> &v, std::ostream &os)
+                {
+                    os << "[ ";
+                    for (auto i : v)
+                        os << i << ", ";
+                    os << "]";
+                }
+                void Fail(int cnt, const std::string &msg) const
+                {
+                    std::ostringstream ss;
+                    ss << "RingBuffer test fail on the " << cnt << " operation :\n";
+                    ss << msg;
+                    ss << "\ntotal operations:";
+                    auto tmp = ops;
+                    tmp.resize(cnt);
+                    Print(tmp, ss);
+                    throw std::runtime_error(ss.str());
+                }
+                // 与 std::deque 逐步对照：int 走 memcpy 重定位，std::string 走逐个移动
+                template <typename T, typename Make>
+                void RingBufferDemo(Make make)
+                {
+                    std::deque<T> st;
+                    RingBuffer<T> rb;
+                    int cnt = 0;
+                    for (auto oo : ops)
+                    {
+                        ++cnt;
+                        switch (oo.opt)
+                        {
+                        case 0:
+                            st.push_back(make(oo.value));
+                            rb.push_back(make(oo.value));
+                            break;
+                        case 1:
+                            st.push_front(make(oo.value));
+                            rb.push_front(make(oo.value));
+                            break;
+                        case 2:
+                            if (!st.empty())
+                            {
+                                st.pop_front();
+                                rb.pop_front();
+                            }
+                            break;
+                        case 3:
+                        {
+                            std::vector<T> src;
+                            for (int i = 0; i < oo.key; ++i)
+                                src.push_back(make(oo.value + i));
+                            st.insert(st.end(), src.begin(), src.end());
+                            rb.push_n(src.data(), src.size());
+                            break;
+                        }
+                        case 4:
+                        {
+                            std::vector<T> dst(size_t(oo.key));
+                            size_t k = rb.pop_n(dst.data(), dst.size());
+                            if (k != std::min(st.size(), dst.size()) || !std::equal(dst.begin(), dst.begin() + k, st.begin()))
+                                Fail(cnt, "pop_n returned wrong elements");
+                            st.erase(st.begin(), st.begin() + k);
+                            break;
+                        }
+                        default:
+                            rb.reserve(size_t(oo.key));
+                            if (rb.capacity() < size_t(oo.key) || (rb.capacity() & (rb.capacity() - 1)))
+                                Fail(cnt, "capacity must be a power of two not less than the reservation");
+                            break;
+                        }
+                        if (rb.size() != st.size() || !std::equal(rb.begin(), rb.end(), st.begin(), st.end()))
+                            Fail(cnt, "content differs from std::deque");
+                        if (!st.empty() && (rb.front() != st.front() || rb.back() != st.back() || rb[st.size() / 2] != st[st.size() / 2]))
+                            Fail(cnt, "front/back/operator[] differs from std::deque");
+                    }
+                    RingBuffer<T> copied(rb);
+                    RingBuffer<T> moved(std::move(copied));
+                    if (!(moved == rb) || !copied.empty())
+                        Fail(cnt, "copy and move constructors");
+                    copied = moved;
+                    rb.clear();
+                    rb.swap(copied);
+                    if (!(rb == moved) || !copied.empty())
+                        Fail(cnt, "copy assignment and swap");
+                }
+                // 作为 Queue 的底层容器：按容量循环时不再扩容
+                void QueueDemo()
+                {
+                    RingQueue<int> q;
+                    q.reserve(100);
+                    std::deque<int> st;
+                    for (auto oo : ops)
+                    {
+                        if (oo.opt < 3 || st.size() >= 100)
+                        {
+                            if (!st.empty())
+                            {
+                                if (q.front() != st.front())
+                                    Fail(int(ops.size()), "RingQueue order");
+                                q.pop();
+                                st.pop_front();
+                            }
+                        }
+                        else
+                        {
+                            q.push(oo.value);
+                            st.push_back(oo.value);
+                        }
+                    }
+                    if (q.size() != st.size())
+                        Fail(int(ops.size()), "RingQueue size");
+                }
+                static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+                {
+                    std::mt19937 rng{seed};
+                    std::vector<operation> res(n);
+                    auto odist = std::uniform_int_distribution<int>(0, 9);
+                    auto vdist = std::uniform_int_distribution<int>(0, w);
+                    for (int i = 0; i < n; i++)
+                    {
+                        int tmp = odist(rng);
+                        res[i].opt = (tmp < 3 ? 0 : (tmp < 4 ? 1 : (tmp < 6 ? 2 : (tmp < 7 ? 3 : (tmp < 9 ? 4 : 5)))));
+                        res[i].key = vdist(rng);
+                        res[i].value = vdist(rng);
+                    }
+                    return res;
+                }
+                static void Demo(const std::vector<operation> &ops)
+                {
+                    auto instance = DemoRingBuffer();
+                    instance.ops = ops;
+                    instance.RingBufferDemo<int>([](int v)
+                                                 { return v; });
+                    instance.RingBufferDemo<std::string>([](int v)
+                                                         { return std::to_string(v) + std::string(20, 'x'); });
+                    instance.QueueDemo();
+                }
+                static void TestCases()
+                {
+
+                    int case_index = 0;
+                    try
+                    {
+
+                        ++case_index;
+                        Demo(RandomGen(5, 2));
+                        ++case_index;
+                        Demo(RandomGen(25, 4));
+                        ++case_index;
+                        Demo(RandomGen(100, 10));
+                        ++case_index;
+                        Demo(RandomGen(500, 40));
+                        ++case_index;
+                        Demo(RandomGen(2000, 100));
+
+                        std::cout
+                            << "RingBuffer test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << "RingBuffer test case " << case_index << " fail\n"
+                                  << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
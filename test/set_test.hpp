@@ -330,6 +330,134 @@ namespace DSA
                     }
                     return res;
                 }
+                // 重复键的 emplace 不应保留新节点；右值插入把值移动进节点
+                static void EmplaceDemo()
+                {
+                    Set<std::string> st;
+                    std::string big(64, 'q');
+                    if (!st.emplace(3, 'a').second || st.emplace("aaa").second || !st.insert(std::move(big)).second)
+                        throw std::runtime_error("Set test fail: emplace/insert result");
+                    if (!big.empty() || st.size() != 2 || !st.checker())
+                        throw std::runtime_error("Set test fail: insert(&&) should move the value into the node");
+                    MultiSet<std::string> ms;
+                    ms.emplace(2, 'z');
+                    ms.emplace("zz");
+                    ms.insert(std::string("zz"));
+                    if (ms.count("zz") != 3 || !ms.checker())
+                        throw std::runtime_error("Set test fail: multiset emplace");
+                }
+                // extract 摘下的节点在 Set/MultiSet 之间转移，元素地址保持不变（没有重新分配）
+                static void NodeHandleDemo()
+                {
+                    Set<std::string> a, b;
+                    for (int i = 0; i < 40; ++i)
+                        a.insert(std::to_string(i)), b.insert(std::to_string(i * 2));
+                    const std::string *addr = &*a.find("7");
+                    auto nh = a.extract("7");
+                    if (!nh || nh.value() != "7" || a.count("7") || !a.checker())
+                        throw std::runtime_error("Set test fail: extract");
+                    nh.value() = "77";
+                    auto res = a.insert(std::move(nh));
+                    if (!res.inserted || &*res.position != addr || *res.position != "77" || !a.checker())
+                        throw std::runtime_error("Set test fail: node handle should be relinked without reallocation");
+                    a.merge(b);
+                    if (a.size() != 60 || b.size() != 20 || !a.checker() || !b.checker())
+                        throw std::runtime_error("Set test fail: merge");
+                    MultiSet<std::string> ms;
+                    ms.merge(a);
+                    ms.merge(b);
+                    ms.insert(a.extract(a.begin()));
+                    if (!a.empty() || !b.empty() || ms.size() != 80 || ms.count("2") != 2 || !ms.checker())
+                        throw std::runtime_error("Set test fail: multiset merge");
+                    a.merge(ms);
+                    if (a.size() != 60 || ms.size() != 20 || !a.checker() || !ms.checker())
+                        throw std::runtime_error("Set test fail: merge multiset into set");
+                }
+                // 顺序统计：rank/select/count/distance 与 std::multiset 上的线性扫描对照
+                template <template <typename, typename, typename> class Implement>
+                static void OrderStatisticDemo()
+                {
+                    Set<int, std::less<int>, Implement> s;
+                    MultiSet<int, std::less<int>, Implement> ms;
+                    std::set<int> ss;
+                    std::multiset<int> sms;
+                    std::mt19937 rng{47};
+                    for (int step = 0; step < 4000; ++step)
+                    {
+                        int k = int(rng() % 300);
+                        if (rng() % 3)
+                            s.insert(k), ss.insert(k), ms.insert(k), sms.insert(k);
+                        else
+                        {
+                            s.erase(k), ss.erase(k);
+                            if (auto it = ms.find(k); it != ms.end())
+                                ms.erase(it), sms.erase(sms.find(k));
+                        }
+                        if (step % 50)
+                            continue;
+                        if (!s.checker() || !ms.checker())
+                            throw std::runtime_error("Set test fail: subtree sizes broken");
+                        for (int q = -1; q <= 300; q += 7)
+                        {
+                            if (s.rank(q) != size_t(std::distance(ss.begin(), ss.lower_bound(q))) ||
+                                ms.rank(q) != size_t(std::distance(sms.begin(), sms.lower_bound(q))) ||
+                                ms.count(q) != sms.count(q))
+                                throw std::runtime_error("Set test fail: rank/count");
+                        }
+                        auto it = sms.begin();
+                        for (size_t i = 0; i < sms.size(); ++i, ++it)
+                            if (*ms.select(i) != *it || ms.index_of(ms.select(i)) != i)
+                                throw std::runtime_error("Set test fail: select/index_of");
+                        if (ms.select(ms.size()) != ms.end() || ms.index_of(ms.end()) != ms.size() ||
+                            s.distance(s.lower_bound(100), s.upper_bound(200)) != std::distance(ss.lower_bound(100), ss.upper_bound(200)))
+                            throw std::runtime_error("Set test fail: select/distance bounds");
+                    }
+                }
+                // 区间构造与assign：有序、无序、含重复键、单遍输入迭代器、以本身为输入，建好的树必须合法且之后仍可正常增删
+                template <template <typename, typename, typename> class Implement>
+                static void BulkBuildDemo()
+                {
+                    auto check = [](bool ok, const char *what)
+                    {
+                        if (!ok)
+                            throw std::runtime_error(std::string("Set test fail: ") + what);
+                    };
+                    std::mt19937 rng{50};
+                    for (size_t n : {0, 1, 2, 3, 7, 8, 100, 1000, 4097})
+                    {
+                        std::vector<int> v(n);
+                        for (auto &x : v)
+                            x = int(rng() % (n + 1));
+                        std::vector<int> sorted_v = v;
+                        std::sort(sorted_v.begin(), sorted_v.end());
+                        std::set<int> ss(v.begin(), v.end());
+                        std::multiset<int> sms(v.begin(), v.end());
+
+                        Set<int, std::less<int>, Implement> s(v.begin(), v.end());
+                        MultiSet<int, std::less<int>, Implement> ms(sorted_v.begin(), sorted_v.end());
+                        check(s.checker() && ms.checker(), "bulk built tree invalid");
+                        check(std::equal(s.begin(), s.end(), ss.begin(), ss.end()) && std::equal(ms.begin(), ms.end(), sms.begin(), sms.end()), "bulk built content");
+                        std::ostringstream os;
+                        for (int x : v)
+                            os << x << ' ';
+                        std::istringstream is(os.str());
+                        ms.assign(std::istream_iterator<int>(is), std::istream_iterator<int>());
+                        s.assign(s.begin(), s.end());
+                        check(s.checker() && ms.checker() && s.size() == ss.size() && ms.size() == sms.size(), "assign from input iterator / self");
+                        s.assign_sorted(sorted_v.begin(), sorted_v.end());
+                        check(s.checker() && std::equal(s.begin(), s.end(), ss.begin(), ss.end()), "assign_sorted");
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            int k = int(rng() % (n + 1));
+                            if (rng() % 2)
+                                s.insert(k), ss.insert(k), ms.insert(k), sms.insert(k);
+                            else
+                                s.erase(k), ss.erase(k), ms.erase(k), sms.erase(k);
+                        }
+                        check(s.checker() && ms.checker(), "tree invalid after modifying a bulk built tree");
+                        check(std::equal(s.begin(), s.end(), ss.begin(), ss.end()) && std::equal(ms.begin(), ms.end(), sms.begin(), sms.end()), "content after modifying");
+                    }
+                }
                 static void Demo(const std::vector<operation> &ops)
                 {
                     auto instance = DemoSet();
@@ -364,6 +492,22 @@ namespace DSA
                         Demo(RandomGen(5000, 1000));
                         ++case_index;
                         Demo(RandomGen(5000, 3000));
+                        ++case_index;
+                        EmplaceDemo();
+                        ++case_index;
+                        NodeHandleDemo();
+                        ++case_index;
+                        OrderStatisticDemo<OrderStatisticRBTreeLinked>();
+                        ++case_index;
+                        OrderStatisticDemo<OrderStatisticAVLTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<RBTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<AVLTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<OrderStatisticRBTreeLinked>();
+                        ++case_index;
+                        BulkBuildDemo<BPlusTree>();
 
                         std::cout
                             << "Set/MultiSet test passed" << std::endl;
@@ -7,6 +7,7 @@ namespace DSA
             struct DemoShortestPath
             {
                 WGraph<int> g;
+                WGraph<int, GraphWeighted::SmallAdjList<int>> small_g; // 同一张图，使用小缓冲区邻接表
                 int start_v, end_v;
                 int actual_ans;
                 bool fail_with_negative = false;
@@ -114,6 +115,9 @@ namespace DSA
                 {
                     std::vector<int> dis;
                     bool fail_neg = SingleSource::Dijkstra<int>(g, start_v, dis);
+                    std::vector<int> small_dis;
+                    if (SingleSource::Dijkstra<int>(small_g, start_v, small_dis) != fail_neg || (!fail_neg && small_dis != dis))
+                        throw std::runtime_error("Dijkstra test fail\nSmallAdjList graph disagrees with vector graph");
                     if (fail_neg != fail_with_negative)
                     {
                         std::ostringstream ss;
@@ -147,6 +151,7 @@ namespace DSA
                 {
                     auto instance = DemoShortestPath();
                     instance.g = WGraph<int>(n, edges);
+                    instance.small_g = WGraph<int, GraphWeighted::SmallAdjList<int>>(n, edges);
                     instance.start_v = start_v;
                     instance.end_v = end_v;
                     instance.actual_ans = actual_ans;
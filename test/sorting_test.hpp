@@ -1,5 +1,6 @@
 #pragma once
 #include "../sorting/sorting.hpp"
+#include "../sorting/parallel_sorting.hpp"
 namespace DSA
 {
     namespace Sorting
@@ -88,6 +89,31 @@ namespace DSA
                     throw std::runtime_error(ss.str());
                 }
             }
+            // 带比较器的稳定排序：降序，以及只按高位比较时相等元素保持原有顺序
+            void ComparatorSortDemo()
+            {
+                auto check = [&](const char *name, auto sort)
+                {
+                    auto tmp = input;
+                    sort(tmp.begin(), tmp.end(), std::greater<int>{});
+                    if (!std::equal(tmp.begin(), tmp.end(), output.rbegin(), output.rend()))
+                        throw std::runtime_error(std::string(name) + " with std::greater fail");
+                    std::vector<std::pair<int, int>> keyed, expected;
+                    for (int i = 0; i < int(input.size()); ++i)
+                        keyed.push_back({input[i] / 16, i});
+                    expected = keyed;
+                    auto by_key = [](const std::pair<int, int> &a, const std::pair<int, int> &b)
+                    { return a.first < b.first; };
+                    std::stable_sort(expected.begin(), expected.end(), by_key);
+                    sort(keyed.begin(), keyed.end(), by_key);
+                    if (keyed != expected)
+                        throw std::runtime_error(std::string(name) + " is not stable");
+                };
+                check("MergeSort", [](auto first, auto last, auto comp)
+                      { MergeSort(first, last, comp); });
+                check("ParallelMergeSort", [](auto first, auto last, auto comp)
+                      { ParallelMergeSort(first, last, comp); });
+            }
             void IntRadixSortDemo()
             {
                 auto tmp = input;
@@ -133,6 +159,7 @@ namespace DSA
                 instance.InsertionSortDemo();
                 instance.IntRadixSortDemo();
                 instance.MergeSortDemo();
+                instance.ComparatorSortDemo();
                 instance.QuickSortDemo();
                 instance.SelectionSortDemo();
                 instance.ShellSortDemo();
@@ -164,6 +191,7 @@ namespace DSA
                 instance.IntRadixSortDemo();
                 instance.MergeSortDemo();
                 instance.QuickSortDemo();
+                instance.ComparatorSortDemo();
             }
             static void TestCases()
             {
@@ -0,0 +1,298 @@
+#pragma once
+#include <list>
+#include <string>
+#include <vector>
+#include <random>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include "../collections/unrolled_list.hpp"
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ListOrForwardlist
+        {
+            struct DemoUnrolledList
+            {
+                struct operation
+                {
+                    int opt, key, value;
+                    friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                    {
+                        static const char *names[] = {"push_back", "push_front", "insert", "erase", "erase_range", "pop", "splice", "remove_if", "unique", "sort", "merge", "reverse"};
+                        os << "(" << names[op.opt] << ":" << op.key << "," << op.value << ")";
+                        return os;
+                    }
+                };
+                std::vector<operation> ops;
+                template <typename T>
+                static void Print(const std::vector<T> &v, std::ostream &os)
+                {
+                    os << "[ ";
+                    for (auto i : v)
+                        os << i << ", ";
+                    os << "]";
+                }
+                void Fail(int cnt, const std::string &msg) const
+                {
+                    std::ostringstream ss;
+                    ss << "UnrolledList test fail on the " << cnt << " operation :\n";
+                    ss << msg;
+                    ss << "\ntotal operations:";
+                    auto tmp = ops;
+                    tmp.resize(cnt);
+                    Print(tmp, ss);
+                    throw std::runtime_error(ss.str());
+                }
+                template <typename Ls, typename Sl>
+                static auto At(Ls &ls, Sl &st, size_t k)
+                {
+                    return std::make_pair(std::next(ls.begin(), k), std::next(st.begin(), k));
+                }
+                // 与 std::list 逐步对照
+                template <typename T, size_t K, typename Make>
+                void UnrolledListDemo(Make make)
+                {
+                    std::list<T> st;
+                    UnrolledList<T, K> ls;
+                    int cnt = 0;
+                    for (auto oo : ops)
+                    {
+                        ++cnt;
+                        size_t n = st.size();
+                        size_t k = n ? size_t(oo.key) % n : 0;
+                        switch (oo.opt)
+                        {
+                        case 0:
+                            st.push_back(make(oo.value));
+                            ls.push_back(make(oo.value));
+                            break;
+                        case 1:
+                            st.push_front(make(oo.value));
+                            ls.push_front(make(oo.value));
+                            break;
+                        case 2:
+                        {
+                            k = size_t(oo.key) % (n + 1);
+                            auto [li, si] = At(ls, st, k);
+                            if (*ls.insert(li, make(oo.value)) != *st.insert(si, make(oo.value)))
+                                Fail(cnt, "insert returned wrong iterator");
+                            break;
+                        }
+                        case 3:
+                        {
+                            if (!n)
+                                break;
+                            auto [li, si] = At(ls, st, k);
+                            auto lr = ls.erase(li);
+                            auto sr = st.erase(si);
+                            if ((sr == st.end()) != (lr == ls.end()) || (sr != st.end() && *sr != *lr))
+                                Fail(cnt, "erase returned wrong iterator");
+                            break;
+                        }
+                        case 4:
+                        {
+                            size_t len = std::min<size_t>(size_t(oo.value) % 16, n - k);
+                            auto [lf, sf] = At(ls, st, k);
+                            auto lr = ls.erase(lf, std::next(lf, len));
+                            auto sr = st.erase(sf, std::next(sf, len));
+                            if ((sr == st.end()) != (lr == ls.end()) || (sr != st.end() && *sr != *lr))
+                                Fail(cnt, "range erase returned wrong iterator");
+                            break;
+                        }
+                        case 5:
+                            if (n)
+                            {
+                                if (oo.value & 1)
+                                    st.pop_back(), ls.pop_back();
+                                else
+                                    st.pop_front(), ls.pop_front();
+                            }
+                            break;
+                        case 6:
+                        {
+                            // 另一个链表整体、单个元素、一段元素拼接进来，以及链表内部的区间移动
+                            std::list<T> so;
+                            UnrolledList<T, K> lo;
+                            for (int i = 0; i < oo.value % 12; ++i)
+                                so.push_back(make(oo.value + i)), lo.push_back(make(oo.value + i));
+                            k = size_t(oo.key) % (n + 1);
+                            int mode = oo.value % 3;
+                            auto [li, si] = At(ls, st, k);
+                            if (mode == 0 || so.empty())
+                            {
+                                st.splice(si, so);
+                                ls.splice(li, lo);
+                            }
+                            else if (mode == 1)
+                            {
+                                size_t j = size_t(oo.key) % so.size();
+                                st.splice(si, so, std::next(so.begin(), j));
+                                ls.splice(li, lo, std::next(lo.begin(), j));
+                            }
+                            else
+                            {
+                                size_t j = size_t(oo.key) % so.size();
+                                st.splice(si, so, std::next(so.begin(), j), so.end());
+                                ls.splice(li, lo, std::next(lo.begin(), j), lo.end());
+                            }
+                            if (lo.size() != so.size() || !std::equal(lo.begin(), lo.end(), so.begin(), so.end()))
+                                Fail(cnt, "splice source differs from std::list");
+                            if (n >= 2)
+                            {
+                                // 把 [a, b) 移到开头或末尾
+                                size_t a = size_t(oo.key) % n, b = a + 1 + size_t(oo.value) % (n - a);
+                                bool to_front = oo.key & 1;
+                                if (!(to_front && a == 0) && !(!to_front && b == n))
+                                {
+                                    auto [la, sa] = At(ls, st, a);
+                                    auto [lb, sb] = At(ls, st, b);
+                                    st.splice(to_front ? st.begin() : st.end(), st, sa, sb);
+                                    ls.splice(to_front ? ls.begin() : ls.end(), ls, la, lb);
+                                }
+                            }
+                            break;
+                        }
+                        case 7:
+                        {
+                            auto pred = [&](const T &x)
+                            { return x < make(oo.value); };
+                            if (st.remove_if(pred) != ls.remove_if(pred))
+                                Fail(cnt, "remove_if count");
+                            break;
+                        }
+                        case 8:
+                            if (st.unique() != ls.unique())
+                                Fail(cnt, "unique count");
+                            break;
+                        case 9:
+                            st.sort();
+                            ls.sort();
+                            break;
+                        case 10:
+                        {
+                            std::list<T> so;
+                            UnrolledList<T, K> lo;
+                            for (int i = 0; i < oo.value % 40; ++i)
+                                so.push_back(make(oo.value * 7 % 50 + i)), lo.push_back(make(oo.value * 7 % 50 + i));
+                            st.sort();
+                            ls.sort();
+                            so.sort();
+                            lo.sort();
+                            st.merge(so);
+                            size_t nodes = ls.node_count() + lo.node_count();
+                            ls.merge(lo);
+                            if (!lo.empty())
+                                Fail(cnt, "merge should empty the other list");
+                            if (ls.node_count() != nodes)
+                                Fail(cnt, "merge should only relink existing nodes");
+                            break;
+                        }
+                        default:
+                            st.reverse();
+                            ls.reverse();
+                            break;
+                        }
+                        if (ls.size() != st.size() || !std::equal(ls.begin(), ls.end(), st.begin(), st.end()))
+                            Fail(cnt, "content differs from std::list");
+                        if (!std::equal(ls.rbegin(), ls.rend(), st.rbegin(), st.rend()))
+                            Fail(cnt, "reverse iteration differs from std::list");
+                        if (!st.empty() && (ls.front() != st.front() || ls.back() != st.back()))
+                            Fail(cnt, "front/back differs from std::list");
+                        if (ls.node_count() > ls.size())
+                            Fail(cnt, "empty node left in the chain");
+                    }
+                    UnrolledList<T, K> copied(ls);
+                    UnrolledList<T, K> moved(std::move(copied));
+                    if (!(moved == ls) || !copied.empty())
+                        Fail(cnt, "copy and move constructors");
+                    copied = moved;
+                    ls.clear();
+                    ls.swap(copied);
+                    if (!(ls == moved) || !copied.empty())
+                        Fail(cnt, "copy assignment and swap");
+                }
+                // 顺序插入后节点应当是满的，遍历只需 size() / K 个节点
+                static void DensityDemo()
+                {
+                    UnrolledList<int, 16> ls;
+                    for (int i = 0; i < 1600; ++i)
+                        ls.push_back(i);
+                    if (ls.node_count() != 100)
+                        throw std::runtime_error("UnrolledList test fail: push_back should fill nodes completely");
+                    ls.remove_if([](int x)
+                                 { return x % 2; });
+                    if (ls.node_count() != 50)
+                        throw std::runtime_error("UnrolledList test fail: remove_if should compact half-empty nodes");
+                    // 值域不交错的归并只重新链接节点，指向 other 中元素的引用保持有效
+                    UnrolledList<int, 16> lo;
+                    for (int i = 2000; i < 2100; ++i)
+                        lo.push_back(i);
+                    const int *first = &lo.front();
+                    ls.merge(lo);
+                    if (first != &*std::find(ls.begin(), ls.end(), 2000) || ls.node_count() != 57)
+                        throw std::runtime_error("UnrolledList test fail: merge of disjoint ranges should relink nodes");
+                }
+                static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+                {
+                    std::mt19937 rng{seed};
+                    std::vector<operation> res(n);
+                    auto odist = std::uniform_int_distribution<int>(0, 39);
+                    auto vdist = std::uniform_int_distribution<int>(0, w);
+                    for (int i = 0; i < n; i++)
+                    {
+                        // 以插入为主，其余操作各占少量比例
+                        int tmp = odist(rng);
+                        res[i].opt = tmp < 10 ? 0 : (tmp < 14 ? 1 : (tmp < 22 ? 2 : (tmp < 26 ? 3 : (tmp < 28 ? 4 : (tmp < 30 ? 5 : (tmp < 33 ? 6 : 7 + (tmp - 33) % 5))))));
+                        res[i].key = vdist(rng);
+                        res[i].value = vdist(rng);
+                    }
+                    return res;
+                }
+                static void Demo(const std::vector<operation> &ops)
+                {
+                    auto instance = DemoUnrolledList();
+                    instance.ops = ops;
+                    auto make_int = [](int v)
+                    { return v; };
+                    auto make_string = [](int v)
+                    { return std::to_string(v) + std::string(20, 'x'); };
+                    instance.UnrolledListDemo<int, 2>(make_int);
+                    instance.UnrolledListDemo<int, 4>(make_int);
+                    instance.UnrolledListDemo<int, unrolled_node_capacity<int>>(make_int);
+                    instance.UnrolledListDemo<std::string, 5>(make_string);
+                }
+                static void TestCases()
+                {
+
+                    int case_index = 0;
+                    try
+                    {
+
+                        ++case_index;
+                        Demo(RandomGen(5, 2));
+                        ++case_index;
+                        Demo(RandomGen(25, 4));
+                        ++case_index;
+                        Demo(RandomGen(100, 10));
+                        ++case_index;
+                        Demo(RandomGen(500, 40));
+                        ++case_index;
+                        Demo(RandomGen(2000, 100));
+                        ++case_index;
+                        DensityDemo();
+
+                        std::cout
+                            << "UnrolledList test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << "UnrolledList test case " << case_index << " fail\n"
+                                  << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
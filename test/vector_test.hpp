@@ -0,0 +1,475 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include "../collections/vector.hpp"
+#include "../collections/small_vector.hpp"
+#if defined(__linux__)
+#include <filesystem>
+#include "../collections/mmap_allocator.hpp"
+#endif
+namespace DSA
+{
+    namespace Collections
+    {
+        namespace ArrayLike
+        {
+            struct DemoVector
+            {
+                struct operation
+                {
+                    int opt, key, value;
+                    friend std::ostream &operator<<(std::ostream &os, const operation &op)
+                    {
+                        switch (op.opt)
+                        {
+                        case 0:
+                        {
+                            os << "(push_back:" << op.value << ")";
+                            break;
+                        }
+                        case 1:
+                        {
+                            os << "(emplace:" << op.key << "," << op.value << ")";
+                            break;
+                        }
+                        case 2:
+                        {
+                            os << "(insert range:" << op.key << "," << op.value << ")";
+                            break;
+                        }
+                        case 3:
+                        {
+                            os << "(erase:" << op.key << ")";
+                            break;
+                        }
+                        default:
+                        {
+                            os << "(move and output)";
+                            break;
+                        }
+                        }
+                        return os;
+                    }
+                };
+                // 带编号、所有传播标志都为 true 的有状态分配器，用来检查 propagate_on_container_* 的处理
+                template <typename U>
+                struct TaggedAllocator
+                {
+                    using value_type = U;
+                    using propagate_on_container_copy_assignment = std::true_type;
+                    using propagate_on_container_move_assignment = std::true_type;
+                    using propagate_on_container_swap = std::true_type;
+                    int id = 0;
+                    TaggedAllocator() = default;
+                    explicit TaggedAllocator(int id) : id(id) {}
+                    template <typename V>
+                    TaggedAllocator(const TaggedAllocator<V> &other) : id(other.id) {}
+                    U *allocate(size_t n) { return std::allocator<U>{}.allocate(n); }
+                    void deallocate(U *p, size_t n) { std::allocator<U>{}.deallocate(p, n); }
+                    bool operator==(const TaggedAllocator &other) const { return id == other.id; }
+                };
+                std::vector<operation> ops;
+                template <typename T>
+                static void Print(const std::vector<T> &v, std::ostream &os)
+                {
+                    os << "[ ";
+                    for (auto i : v)
+                        os << i << ", ";
+                    os << "]";
+                }
+                // 小缓冲区容量取 4，使随机操作序列反复跨越内联与堆两种状态
+                template <typename U>
+                using SmallVector4 = SmallVector<U, 4>;
+                // SmallVector 与 Vector 共用增长策略
+                template <typename U>
+                using SmallVector4SizeClass = SmallVector<U, 4, SizeClassGrowth<OneAndHalfGrowth>>;
+                std::string name = "Vector";
+                void Fail(int cnt, const std::string &msg) const
+                {
+                    std::ostringstream ss;
+                    ss << name << " test fail on the " << cnt << " operation :\n";
+                    ss << msg;
+                    ss << "\ntotal operations:";
+                    auto tmp = ops;
+                    tmp.resize(cnt);
+                    Print(tmp, ss);
+                    throw std::runtime_error(ss.str());
+                }
+                template <template <typename> class Vec>
+                void VectorDemo()
+                {
+                    // 用 std::string 作为元素，覆盖拷贝、移动和就地构造三种路径
+                    Vec<std::string> vec;
+                    std::vector<std::string> st;
+                    int cnt = 0;
+                    for (auto oo : ops)
+                    {
+                        ++cnt;
+                        std::string s = "value#" + std::to_string(oo.value);
+                        size_t pos = st.empty() ? 0 : size_t(oo.key) % (st.size() + 1);
+                        switch (oo.opt)
+                        {
+                        case 0:
+                        {
+                            // 偶数时压入容器自身的元素，检验扩容时的自引用
+                            if (oo.value % 2 == 0 && !st.empty())
+                            {
+                                st.push_back(std::string(st.front()));
+                                vec.push_back(vec.front());
+                            }
+                            else
+                            {
+                                st.push_back(s);
+                                vec.push_back(std::move(s));
+                            }
+                            break;
+                        }
+                        case 1:
+                        {
+                            size_t n = size_t(oo.value) % 20;
+                            st.emplace(st.begin() + pos, n, 'x');
+                            vec.emplace(vec.cbegin() + pos, n, 'x');
+                            vec.emplace_back(s);
+                            st.emplace_back(s);
+                            break;
+                        }
+                        case 2:
+                        {
+                            std::vector<std::string> src{s, s + "!", s + "?"};
+                            st.insert(st.begin() + pos, src.begin(), src.end());
+                            vec.insert(vec.cbegin() + pos, std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+                            break;
+                        }
+                        case 3:
+                        {
+                            if (!st.empty())
+                            {
+                                pos = size_t(oo.key) % st.size();
+                                st.erase(st.begin() + pos);
+                                vec.erase(vec.cbegin() + pos);
+                            }
+                            break;
+                        }
+                        default:
+                        {
+                            // 移动构造与移动赋值只转移缓冲区，不碰元素；SmallVector 的内联元素只能逐个移动
+                            bool stealable = true;
+                            if constexpr (requires { vec.is_inline(); })
+                                stealable = !vec.is_inline();
+                            auto *data = vec.data();
+                            Vec<std::string> moved(std::move(vec));
+                            if ((stealable && moved.data() != data) || !vec.empty())
+                                Fail(cnt, "move constructor did not steal the buffer");
+                            vec = std::move(moved);
+                            if ((stealable && vec.data() != data) || !moved.empty())
+                                Fail(cnt, "move assignment did not steal the buffer");
+                            Vec<std::string> copied(vec);
+                            copied.swap(moved);
+                            vec.shrink_to_fit();
+                            if (!copied.empty() || !std::equal(moved.begin(), moved.end(), st.begin(), st.end()))
+                                Fail(cnt, "copy constructor produced different elements");
+                            break;
+                        }
+                        }
+                        if (!std::equal(vec.begin(), vec.end(), st.begin(), st.end()))
+                        {
+                            std::vector<std::string> got(vec.begin(), vec.end());
+                            std::ostringstream ss;
+                            ss << "content ; expected ";
+                            Print(st, ss);
+                            ss << ", but got ";
+                            Print(got, ss);
+                            Fail(cnt, ss.str());
+                        }
+                    }
+                }
+                template <template <typename> class Vec>
+                void RelocatableDemo()
+                {
+                    // int 走 realloc 路径，unique_ptr 走 memcpy / memmove 路径
+                    static_assert(Vec<int>::relocatable && Vec<std::unique_ptr<int>>::relocatable && !Vec<std::string>::relocatable);
+                    Vec<int> vec;
+                    Vec<std::unique_ptr<int>> pvec;
+                    std::vector<int> st;
+                    int cnt = 0;
+                    for (auto oo : ops)
+                    {
+                        ++cnt;
+                        size_t pos = st.empty() ? 0 : size_t(oo.key) % (st.size() + 1);
+                        switch (oo.opt)
+                        {
+                        case 0:
+                        {
+                            st.push_back(oo.value);
+                            vec.push_back(oo.value);
+                            pvec.push_back(std::make_unique<int>(oo.value));
+                            break;
+                        }
+                        case 1:
+                        {
+                            // 插入容器自身元素的多份拷贝
+                            size_t n = size_t(oo.value) % 5;
+                            int v = st.empty() ? oo.value : st.front();
+                            st.insert(st.begin() + pos, n, v);
+                            if (vec.empty())
+                                vec.insert(vec.cbegin() + pos, n, oo.value);
+                            else
+                                vec.insert(vec.cbegin() + pos, n, vec.front());
+                            for (size_t i = 0; i < n; ++i)
+                                pvec.emplace(pvec.cbegin() + pos, std::make_unique<int>(v));
+                            break;
+                        }
+                        case 2:
+                        {
+                            int src[] = {oo.value, oo.value + 1, oo.value + 2};
+                            st.insert(st.begin() + pos, src, src + 3);
+                            vec.insert(vec.cbegin() + pos, src, src + 3);
+                            for (int i = 2; i >= 0; --i)
+                                pvec.insert(pvec.cbegin() + pos, std::make_unique<int>(src[i]));
+                            break;
+                        }
+                        case 3:
+                        {
+                            if (!st.empty())
+                            {
+                                pos = size_t(oo.key) % st.size();
+                                size_t last = std::min(st.size(), pos + size_t(oo.value) % 3);
+                                st.erase(st.begin() + pos, st.begin() + last);
+                                vec.erase(vec.cbegin() + pos, vec.cbegin() + last);
+                                pvec.erase(pvec.cbegin() + pos, pvec.cbegin() + last);
+                                if (!st.empty() && oo.value % 2)
+                                {
+                                    st.erase(st.begin());
+                                    vec.erase(vec.cbegin());
+                                    pvec.erase(pvec.cbegin());
+                                }
+                            }
+                            break;
+                        }
+                        default:
+                        {
+                            vec.shrink_to_fit();
+                            pvec.shrink_to_fit();
+                            break;
+                        }
+                        }
+                        bool ok = std::equal(vec.begin(), vec.end(), st.begin(), st.end()) && pvec.size() == st.size();
+                        for (size_t i = 0; ok && i < st.size(); ++i)
+                            ok = *pvec[i] == st[i];
+                        if (!ok)
+                        {
+                            std::vector<int> got(vec.begin(), vec.end());
+                            std::ostringstream ss;
+                            ss << "relocatable content ; expected ";
+                            Print(st, ss);
+                            ss << ", but got ";
+                            Print(got, ss);
+                            Fail(cnt, ss.str());
+                        }
+                    }
+                }
+                void AllocatorDemo()
+                {
+                    std::vector<std::string> st;
+                    for (auto oo : ops)
+                        st.push_back("a string long enough to need the heap #" + std::to_string(oo.value));
+                    // pmr：元素与容器都从同一个内存池分配，上游是 null_memory_resource，池子用完会直接抛异常
+                    std::vector<std::byte> buffer(st.size() * 512 + 4096);
+                    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+                    pmr::Vector<std::pmr::string> vec(&arena);
+                    for (auto &x : st)
+                        vec.emplace_back(x);
+                    for (auto &x : vec)
+                    {
+                        if (x.get_allocator().resource() != &arena)
+                            Fail(int(ops.size()), "pmr element not allocated from the arena");
+                    }
+                    // 拷贝构造回到默认内存资源，移动赋值到不同资源的容器时逐个移动元素
+                    auto same = [](const std::pmr::string &x, const std::string &y)
+                    { return std::string_view(x) == std::string_view(y); };
+                    pmr::Vector<std::pmr::string> copied(vec);
+                    std::pmr::unsynchronized_pool_resource pool;
+                    pmr::Vector<std::pmr::string> other(&pool);
+                    other = std::move(vec);
+                    if (copied.get_allocator().resource() != std::pmr::get_default_resource() || other.get_allocator().resource() != &pool ||
+                        !std::equal(other.begin(), other.end(), st.begin(), st.end(), same) || !std::equal(copied.begin(), copied.end(), st.begin(), st.end(), same))
+                        Fail(int(ops.size()), "pmr copy / move assignment");
+                    // 可传播的分配器随拷贝赋值、移动赋值、swap 一起转移
+                    Vector<int, TaggedAllocator<int>> a(TaggedAllocator<int>(1)), b(TaggedAllocator<int>(2)), c(TaggedAllocator<int>(3));
+                    for (auto oo : ops)
+                        b.push_back(oo.value);
+                    a = b;
+                    c.swap(b);
+                    if (a.get_allocator().id != 2 || b.get_allocator().id != 3 || c.get_allocator().id != 2 || a.size() != ops.size() || c.size() != ops.size())
+                        Fail(int(ops.size()), "allocator propagation");
+                    b = std::move(a);
+                    if (b.get_allocator().id != 2 || b.size() != ops.size())
+                        Fail(int(ops.size()), "allocator propagation on move assignment");
+
+                    // 增长策略
+                    Vector<int, std::allocator<int>, OneAndHalfGrowth> grow;
+                    Vector<double, std::allocator<double>, PageRoundedGrowth<>> paged;
+                    Vector<int, std::allocator<int>, SizeClassGrowth<>> classed;
+                    for (size_t i = 0; i < ops.size() * 10; ++i)
+                    {
+                        size_t before = grow.capacity();
+                        grow.push_back(int(i));
+                        if (grow.capacity() != before && grow.capacity() != std::max(before * 3 / 2, grow.size()))
+                            Fail(int(ops.size()), "1.5x growth policy");
+                        paged.push_back(double(i));
+                        if (paged.capacity() * sizeof(double) >= 4096 && paged.capacity() * sizeof(double) % 4096 != 0)
+                            Fail(int(ops.size()), "page rounded growth policy");
+                        classed.push_back(int(i));
+                        size_t bytes = classed.capacity() * sizeof(int);
+                        if (SizeClassGrowth<>::size_class(bytes) != bytes && SizeClassGrowth<>::size_class(bytes) - bytes >= sizeof(int))
+                            Fail(int(ops.size()), "size class growth policy");
+                    }
+                    if (SizeClassGrowth<>::size_class(100) != 112 || SizeClassGrowth<>::size_class(129) != 160 || SizeClassGrowth<>::size_class(5000) != 5120)
+                        Fail(int(ops.size()), "jemalloc size classes");
+                }
+                void DefaultInitDemo()
+                {
+                    // 默认初始化构造：先写后读，内容应与 std::vector 一致
+                    size_t n = ops.size() * 37 + 1;
+                    Vector<int> buf(n, default_init);
+                    if (buf.size() != n)
+                        Fail(int(ops.size()), "default_init constructor size");
+                    std::vector<int> st(n);
+                    for (size_t i = 0; i < n; ++i)
+                        st[i] = buf[i] = int(i * 7 + 3);
+                    // 扩大时保留已有前缀；强制 4 个线程做 first-touch
+                    buf.resize_for_overwrite(n * 3, 4);
+                    if (buf.size() != n * 3 || !std::equal(st.begin(), st.end(), buf.begin()))
+                        Fail(int(ops.size()), "resize_for_overwrite must keep the prefix");
+                    st.resize(n * 3);
+                    for (size_t i = n; i < n * 3; ++i)
+                        st[i] = buf[i] = -int(i);
+                    buf.resize_for_overwrite(n / 2 + 1, 1);
+                    st.resize(n / 2 + 1);
+                    if (!std::equal(buf.begin(), buf.end(), st.begin(), st.end()))
+                        Fail(int(ops.size()), "resize_for_overwrite shrink");
+                }
+#if defined(__linux__)
+                void MmapDemo()
+                {
+                    // 匿名映射 + 透明大页，扩容走 mremap
+                    std::vector<long long> st;
+                    Vector<long long, MmapAllocator<long long>, PageRoundedGrowth<>> vec(MmapAllocator<long long>(MmapOptions{true, false}));
+                    for (auto oo : ops)
+                    {
+                        for (int i = 0; i < 50; ++i)
+                        {
+                            st.push_back(oo.value * 100ll + i);
+                            vec.push_back(oo.value * 100ll + i);
+                        }
+                        if (oo.opt == 3 && !st.empty())
+                        {
+                            size_t pos = size_t(oo.key) % st.size();
+                            st.erase(st.begin() + pos);
+                            vec.erase(vec.cbegin() + pos);
+                        }
+                    }
+                    vec.shrink_to_fit();
+                    if (!std::equal(vec.begin(), vec.end(), st.begin(), st.end()))
+                        Fail(int(ops.size()), "anonymous mmap vector content");
+                    // 文件模式：写入、析构（文件被截断为有效长度，而不是容量），再零拷贝地重新映射回来
+                    auto path = (std::filesystem::temp_directory_path() / ("dsa_vector_" + std::to_string(::getpid()) + ".bin")).string();
+                    std::filesystem::remove(path);
+                    {
+                        Vector<long long, MmapAllocator<long long>> persisted(MmapAllocator<long long>{path});
+                        for (auto v : st)
+                            persisted.push_back(v);
+                        Vector<long long, MmapAllocator<long long>> copied(persisted);
+                        if (copied.get_allocator().file || !std::equal(copied.begin(), copied.end(), st.begin(), st.end()))
+                            Fail(int(ops.size()), "copy of a file backed vector must be anonymous");
+                    }
+                    if (std::filesystem::file_size(path) != st.size() * sizeof(long long))
+                        Fail(int(ops.size()), "file backed vector has wrong file size");
+                    {
+                        // 在已有文件上打开一个空 Vector 并分配少量空间，不能截断文件中已有的数据
+                        Vector<long long, MmapAllocator<long long>> fresh(MmapAllocator<long long>{path});
+                        fresh.reserve(1);
+                        if (std::filesystem::file_size(path) != st.size() * sizeof(long long))
+                            Fail(int(ops.size()), "allocating on an existing file must not truncate it");
+                        // 析构时文件长度跟随这个 Vector 的 size()
+                        for (auto v : st)
+                            fresh.push_back(v);
+                    }
+                    {
+                        Vector<long long, MmapAllocator<long long>> reloaded(adopt_storage, MmapAllocator<long long>{path});
+                        if (!std::equal(reloaded.begin(), reloaded.end(), st.begin(), st.end()))
+                            Fail(int(ops.size()), "reloaded file backed vector content");
+                        // 重新加载后可以继续增长
+                        reloaded.push_back(-1);
+                        if (reloaded.back() != -1 || reloaded.size() != st.size() + 1)
+                            Fail(int(ops.size()), "growing a reloaded vector");
+                    }
+                    std::filesystem::remove(path);
+                }
+#endif
+                static std::vector<operation> RandomGen(int n, int w, unsigned int seed = 0)
+                {
+                    std::mt19937 rng{seed};
+                    std::vector<operation> res(n);
+                    auto odist = std::uniform_int_distribution<int>(0, 9);
+                    auto vdist = std::uniform_int_distribution<int>(0, w);
+                    for (int i = 0; i < n; i++)
+                    {
+                        int tmp = odist(rng);
+                        res[i].opt = (tmp < 4 ? 0 : (tmp < 6 ? 1 : (tmp < 7 ? 2 : (tmp < 9 ? 3 : 4))));
+                        res[i].key = vdist(rng);
+                        res[i].value = vdist(rng);
+                    }
+                    return res;
+                }
+                static void Demo(const std::vector<operation> &ops)
+                {
+                    auto instance = DemoVector();
+                    instance.ops = ops;
+                    instance.VectorDemo<Vector>();
+                    instance.RelocatableDemo<Vector>();
+                    instance.AllocatorDemo();
+                    instance.DefaultInitDemo();
+#if defined(__linux__)
+                    instance.MmapDemo();
+#endif
+                    instance.name = "SmallVector";
+                    instance.VectorDemo<SmallVector4>();
+                    instance.RelocatableDemo<SmallVector4>();
+                    instance.name = "SmallVector-SizeClass";
+                    instance.VectorDemo<SmallVector4SizeClass>();
+                }
+                static void TestCases()
+                {
+
+                    int case_index = 0;
+                    try
+                    {
+
+                        ++case_index;
+                        Demo(RandomGen(5, 2));
+                        ++case_index;
+                        Demo(RandomGen(25, 4));
+                        ++case_index;
+                        Demo(RandomGen(100, 10));
+                        ++case_index;
+                        Demo(RandomGen(500, 40));
+                        ++case_index;
+                        Demo(RandomGen(2000, 1000));
+
+                        std::cout
+                            << "Vector test passed" << std::endl;
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cerr << "Vector test case " << case_index << " fail\n"
+                                  << ex.what() << std::endl;
+                    }
+                }
+            };
+        }
+    }
+}
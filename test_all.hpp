@@ -7,4 +7,13 @@
 #include "test/sorting_test.hpp"
 #include "test/topological_sorting_test.hpp"
 #include "test/shortest_path_test.hpp"
-#include "test/minimun_spanning_tree_test.hpp"
\ No newline at end of file
+#include "test/minimun_spanning_tree_test.hpp"
+#include "test/hashtable_test.hpp"
+#include "test/vector_test.hpp"
+#include "test/deque_test.hpp"
+#include "test/ring_buffer_test.hpp"
+#include "test/concurrent_queue_test.hpp"
+#include "test/parallel_test.hpp"
+#include "test/unrolled_list_test.hpp"
+#include "test/intrusive_test.hpp"
+#include "test/bplus_tree_test.hpp"
\ No newline at end of file
@@ -0,0 +1,1081 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../../sorting/sorting.hpp"
+#include "../../utils.hpp"
+namespace DSA
+{
+    namespace Tree
+    {
+        namespace BTree
+        {
+            using DSA::Utils::IdentityKeyOfValue;
+            // 每个节点约占 4 个缓存行；叶子与内部节点至少容纳 8 项
+            inline constexpr size_t bplus_node_bytes = 256;
+            template <typename T>
+            inline constexpr size_t bplus_leaf_capacity = std::max<size_t>(8, bplus_node_bytes / sizeof(T));
+            template <typename KeyT>
+            inline constexpr size_t bplus_inner_capacity = std::max<size_t>(8, bplus_node_bytes / (sizeof(KeyT) + sizeof(void *)));
+
+            template <typename T, typename KeyT, typename Compare, typename KeyOfValue>
+            struct BPlusTree;
+
+            namespace detail
+            {
+                // 叶子与内部节点的公共部分；count 对叶子是元素个数，对内部节点是键的个数（孩子比键多一个）
+                struct BPlusNodeBase
+                {
+                    BPlusNodeBase *parent = nullptr;
+                    size_t count = 0;
+                    bool is_leaf = true;
+                };
+                // 叶子之间双向链接成环，树的 header 也是一个 BPlusLeafLink，count 恒为 0
+                struct BPlusLeafLink : BPlusNodeBase
+                {
+                    BPlusLeafLink *next = nullptr;
+                    BPlusLeafLink *prev = nullptr;
+                };
+                // 元素连续存放在 [0, count) 中
+                template <typename T, size_t K>
+                struct BPlusLeaf : BPlusLeafLink
+                {
+                    using value_type = T;
+                    alignas(T) std::byte storage[K * sizeof(T)];
+                    T *data() { return std::launder(reinterpret_cast<T *>(storage)); }
+                    const T *data() const { return std::launder(reinterpret_cast<const T *>(storage)); }
+                };
+                // 键 keys[0, count) 连续存放；children[i] 子树中的键都不大于 keys[i]，children[i + 1] 子树中的键都不小于 keys[i]
+                template <typename KeyT, size_t K>
+                struct BPlusInner : BPlusNodeBase
+                {
+                    BPlusInner() { this->is_leaf = false; }
+                    KeyT keys[K];
+                    BPlusNodeBase *children[K + 1];
+                };
+
+                /**
+                 * @brief BPlusTree 的双向迭代器：叶子指针加叶子内下标，沿叶子链表移动。
+                 * 与 UnrolledList 的迭代器一致；end() 为 (header, 0)。
+                 */
+                template <typename Leaf, bool IsConst>
+                class BPlusTreeIterator
+                {
+                public:
+                    using value_type = typename Leaf::value_type;
+                    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+                    using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+                    using difference_type = std::ptrdiff_t;
+                    using iterator_category = std::bidirectional_iterator_tag;
+
+                    BPlusTreeIterator() = default;
+                    BPlusTreeIterator(const BPlusLeafLink *n, size_t i) : node_ptr_(const_cast<BPlusLeafLink *>(n)), index_(i) {}
+                    // 允许从可变迭代器构造常量迭代器
+                    template <bool FromConst = IsConst>
+                        requires FromConst
+                    BPlusTreeIterator(const BPlusTreeIterator<Leaf, false> &other)
+                        : node_ptr_(other.node_ptr_), index_(other.index_)
+                    {
+                    }
+
+                    reference operator*() const { return static_cast<Leaf *>(node_ptr_)->data()[index_]; }
+                    pointer operator->() const { return &**this; }
+
+                    BPlusTreeIterator &operator++()
+                    {
+                        if (++index_ == node_ptr_->count)
+                        {
+                            node_ptr_ = node_ptr_->next;
+                            index_ = 0;
+                        }
+                        return *this;
+                    }
+                    BPlusTreeIterator operator++(int)
+                    {
+                        auto tmp = *this;
+                        ++(*this);
+                        return tmp;
+                    }
+                    BPlusTreeIterator &operator--()
+                    {
+                        if (index_ == 0)
+                        {
+                            node_ptr_ = node_ptr_->prev;
+                            index_ = node_ptr_->count;
+                        }
+                        --index_;
+                        return *this;
+                    }
+                    BPlusTreeIterator operator--(int)
+                    {
+                        auto tmp = *this;
+                        --(*this);
+                        return tmp;
+                    }
+
+                    bool operator==(const BPlusTreeIterator &other) const { return node_ptr_ == other.node_ptr_ && index_ == other.index_; }
+                    bool operator!=(const BPlusTreeIterator &other) const { return !(*this == other); }
+
+                protected:
+                    BPlusLeafLink *node_ptr_ = nullptr;
+                    size_t index_ = 0;
+                    friend BPlusTreeIterator<Leaf, true>;
+                    template <typename, typename, typename, typename>
+                    friend struct BTree::BPlusTree;
+                };
+            }
+
+            /**
+             * @brief BPlusTree 的节点句柄：持有从树中摘下的值。
+             * 值存放在叶子的连续数组中，摘下与插回都会移动一次值（与树节点的句柄不同，地址不保持）。
+             */
+            template <typename T>
+            class BPlusTreeNodeHandle
+            {
+            public:
+                using value_type = T;
+
+                constexpr BPlusTreeNodeHandle() = default;
+                BPlusTreeNodeHandle(BPlusTreeNodeHandle &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                    : slot(std::move(other.slot))
+                {
+                    other.slot.reset();
+                }
+                BPlusTreeNodeHandle &operator=(BPlusTreeNodeHandle &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+                {
+                    if (this != &other)
+                    {
+                        slot.reset();
+                        if (other.slot)
+                            slot.emplace(std::move(*other.slot));
+                        other.slot.reset();
+                    }
+                    return *this;
+                }
+
+                bool empty() const { return !slot.has_value(); }
+                explicit operator bool() const { return slot.has_value(); }
+                value_type &value() const { return *slot; }
+                // map 类的 pair 值：值脱离树时允许修改键，再插回时按新键定位
+                auto &key() const
+                    requires requires(value_type &v) { v.first; }
+                {
+                    return const_cast<std::remove_const_t<typename value_type::first_type> &>(slot->first);
+                }
+                auto &mapped() const
+                    requires requires(value_type &v) { v.second; }
+                {
+                    return slot->second;
+                }
+                void swap(BPlusTreeNodeHandle &other)
+                {
+                    BPlusTreeNodeHandle tmp(std::move(other));
+                    other = std::move(*this);
+                    *this = std::move(tmp);
+                }
+                friend void swap(BPlusTreeNodeHandle &x, BPlusTreeNodeHandle &y) { x.swap(y); }
+
+            private:
+                mutable std::optional<T> slot;
+                explicit BPlusTreeNodeHandle(T &&v) : slot(std::in_place, std::move(v)) {}
+                template <typename, typename, typename, typename>
+                friend struct BPlusTree;
+            };
+
+            /**
+             * @brief B+ 树：值连续存放在叶子中，叶子双向链接；内部节点只存分隔键与孩子指针。
+             *
+             * - 与 RBTreeLinked / AVLTreeLinked 的模板签名和接口一致，可以直接作为 Set / Map / MultiSet / MultiMap 的 Implement；
+             * - 节点大小约为几个缓存行，一次查找只访问 O(log_B n) 个节点，节点内的键连续存放：
+             *   键是算术类型、比较器是 std::less / std::greater 时用无分支的计数循环（编译器可以向量化为 SIMD 比较），其余情况二分；
+             * - 遍历与区间扫描沿叶子链表进行，每个叶子只跳一次指针；
+             * - assign_unique / assign_multi 与 assign_sorted_unique / assign_sorted_multi 从序列自底向上批量建树，叶子全部填满；
+             *   输入有序时 O(n)，否则先用归并排序（稳定）排序。
+             *
+             * 与结点树不同，插入、删除会在叶子内移动元素：修改操作使同一叶子（分裂、合并时还包括相邻叶子）中的迭代器失效。
+             * 值的移动构造应当不抛出异常。内部节点保存键的副本，因此键类型需要能默认构造和赋值。
+             */
+            template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+            struct BPlusTree
+            {
+                using value_type = T;
+                using key_type = KeyT;
+                using size_type = size_t;
+                using difference_type = std::ptrdiff_t;
+                using reference = T &;
+                using const_reference = const T &;
+                using pointer = T *;
+                using const_pointer = const T *;
+                static constexpr size_type leaf_capacity = bplus_leaf_capacity<T>;
+                static constexpr size_type inner_capacity = bplus_inner_capacity<KeyT>;
+                // 除根以外，节点至少半满
+                static constexpr size_type leaf_min = leaf_capacity / 2;
+                static constexpr size_type inner_min = inner_capacity / 2;
+                using NodeBase = detail::BPlusNodeBase;
+                using LeafLink = detail::BPlusLeafLink;
+                using Leaf = detail::BPlusLeaf<T, leaf_capacity>;
+                using Inner = detail::BPlusInner<KeyT, inner_capacity>;
+                using iterator = detail::BPlusTreeIterator<Leaf, false>;
+                using const_iterator = detail::BPlusTreeIterator<Leaf, true>;
+                using node_type = BPlusTreeNodeHandle<T>;
+                // insert(node_type&&) 的返回值：插入失败时 node 把值原样交还给调用者
+                struct insert_return_type
+                {
+                    iterator position;
+                    bool inserted;
+                    node_type node;
+                };
+
+                explicit BPlusTree(const Compare &cmp = Compare{}) : comp(cmp) { reset_header(); }
+                BPlusTree(const BPlusTree &other) : BPlusTree(other.comp)
+                {
+                    build_sorted(other.begin(), other.end(), false);
+                }
+                BPlusTree(BPlusTree &&other) : BPlusTree(other.comp) { this->swap(other); }
+                ~BPlusTree() { clear(); }
+                // 拷贝并交换（Copy-and-Swap），强异常安全
+                BPlusTree &operator=(const BPlusTree &other)
+                {
+                    if (this != std::addressof(other))
+                    {
+                        BPlusTree tmp(other);
+                        this->swap(tmp);
+                    }
+                    return *this;
+                }
+                BPlusTree &operator=(BPlusTree &&other)
+                {
+                    this->swap(other);
+                    return *this;
+                }
+
+                iterator begin() { return iterator{header.next, 0}; }
+                const_iterator begin() const { return const_iterator{header.next, 0}; }
+                iterator end() { return iterator{&header, 0}; }
+                const_iterator end() const { return const_iterator{&header, 0}; }
+                bool empty() const { return size_r == 0; }
+                size_type size() const { return size_r; }
+                Compare &comparer() { return comp; }
+                const Compare &comparer() const { return comp; }
+
+                void clear()
+                {
+                    // 内部节点从根递归释放（需要读孩子的 is_leaf，所以先于叶子），叶子沿链表释放
+                    if (root_ && !root_->is_leaf)
+                        destroy_inner_recursive(as_inner(root_));
+                    for (LeafLink *p = header.next; p != &header;)
+                    {
+                        LeafLink *next = p->next;
+                        destroy_leaf(static_cast<Leaf *>(p));
+                        p = next;
+                    }
+                    root_ = nullptr;
+                    size_r = 0;
+                    reset_header();
+                }
+                void swap(BPlusTree &other)
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    LeafLink *f1 = empty() ? nullptr : header.next, *l1 = header.prev;
+                    LeafLink *f2 = other.empty() ? nullptr : other.header.next, *l2 = other.header.prev;
+                    adopt_chain(f2, l2);
+                    other.adopt_chain(f1, l1);
+                    using std::swap;
+                    swap(root_, other.root_);
+                    swap(size_r, other.size_r);
+                    swap(comp, other.comp);
+                }
+
+                iterator find(const key_type &k) { return make_iterator(find_position(k)); }
+                const_iterator find(const key_type &k) const { return make_const_iterator(find_position(k)); }
+                iterator lower_bound(const key_type &k) { return make_iterator(normalize(lower_position(k))); }
+                const_iterator lower_bound(const key_type &k) const { return make_const_iterator(normalize(lower_position(k))); }
+                iterator upper_bound(const key_type &k) { return make_iterator(normalize(upper_position(k))); }
+                const_iterator upper_bound(const key_type &k) const { return make_const_iterator(normalize(upper_position(k))); }
+                std::pair<iterator, iterator> equal_range_unique(const key_type &k)
+                {
+                    iterator first = lower_bound(k);
+                    if (first != end() && !comp(k, skey(*first)))
+                        return {first, std::next(first)};
+                    return {first, first};
+                }
+                std::pair<const_iterator, const_iterator> equal_range_unique(const key_type &k) const
+                {
+                    const_iterator first = lower_bound(k);
+                    if (first != end() && !comp(k, skey(*first)))
+                        return {first, std::next(first)};
+                    return {first, first};
+                }
+                std::pair<iterator, iterator> equal_range_multi(const key_type &k) { return {lower_bound(k), upper_bound(k)}; }
+                std::pair<const_iterator, const_iterator> equal_range_multi(const key_type &k) const { return {lower_bound(k), upper_bound(k)}; }
+                size_type count_unique(const key_type &k) const { return size_type(find(k) != end()); }
+                size_type count_multi(const key_type &k) const
+                {
+                    auto rg = equal_range_multi(k);
+                    return size_type(std::distance(rg.first, rg.second));
+                }
+
+                std::pair<iterator, bool> insert_unique(const T &v)
+                {
+                    Position pos = lower_position(skey(v));
+                    if (Position hit = normalize(pos); hit.leaf != &header && !comp(skey(v), skey(value_at(hit))))
+                        return {make_iterator(hit), false};
+                    return {emplace_at(pos, v), true};
+                }
+                std::pair<iterator, bool> insert_unique(T &&v)
+                {
+                    // 键的引用只在查找阶段使用，之后才把 v 移动进叶子
+                    return try_emplace_unique(skey(v), std::move(v));
+                }
+                // 值只有构造出来才能取得键，所以先在栈上构造，再移动进叶子
+                template <typename... Args>
+                std::pair<iterator, bool> emplace_unique(Args &&...args)
+                {
+                    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+                        return insert_unique(std::forward<Args>(args)...);
+                    else
+                        return insert_unique(T(std::forward<Args>(args)...));
+                }
+                // 先按键k查找，只有k不存在时才用实参在叶子中原地构造值（实参构造出的值的键必须等价于k）。
+                template <typename... Args>
+                std::pair<iterator, bool> try_emplace_unique(const key_type &k, Args &&...args)
+                {
+                    Position pos = lower_position(k);
+                    if (Position hit = normalize(pos); hit.leaf != &header && !comp(k, skey(value_at(hit))))
+                        return {make_iterator(hit), false};
+                    return {emplace_at(pos, std::forward<Args>(args)...), true};
+                }
+                // 等价键插在已有元素之后
+                iterator insert_multi(const T &v)
+                {
+                    return emplace_at(upper_position(skey(v)), v);
+                }
+                iterator insert_multi(T &&v) { return emplace_at(upper_position(skey(v)), std::move(v)); }
+                template <typename... Args>
+                iterator emplace_multi(Args &&...args)
+                {
+                    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+                        return insert_multi(std::forward<Args>(args)...);
+                    else
+                        return insert_multi(T(std::forward<Args>(args)...));
+                }
+
+                // 返回被删除元素的下一个元素
+                iterator erase(const_iterator pos)
+                {
+                    if (pos == end())
+                        return end();
+                    return make_iterator(erase_at({pos.node_ptr_, pos.index_}));
+                }
+                size_type erase_unique(const key_type &k)
+                {
+                    const_iterator it = find(k);
+                    if (it == end())
+                        return 0;
+                    erase(it);
+                    return 1;
+                }
+                size_type erase_multi(const key_type &k)
+                {
+                    size_type res = 0;
+                    for (iterator it = lower_bound(k); it != end() && !comp(k, skey(*it)); ++res)
+                        it = erase(it);
+                    return res;
+                }
+
+                // 把 pos 处的值移动到节点句柄中，并从树中删除
+                node_type extract(const_iterator pos)
+                {
+                    if (pos == end())
+                        return node_type{};
+                    node_type nh{std::move(const_cast<T &>(*pos))};
+                    erase(pos);
+                    return nh;
+                }
+                node_type extract_unique(const key_type &k) { return extract(find(k)); }
+                // 摘下第一个键等价于k的元素
+                node_type extract_multi(const key_type &k)
+                {
+                    const_iterator it = lower_bound(k);
+                    if (it == end() || comp(k, skey(*it)))
+                        return node_type{};
+                    return extract(it);
+                }
+                insert_return_type insert_unique(node_type &&nh)
+                {
+                    if (nh.empty())
+                        return {end(), false, node_type{}};
+                    auto res = try_emplace_unique(skey(*nh.slot), std::move(*nh.slot));
+                    if (!res.second)
+                        return {res.first, false, std::move(nh)};
+                    nh.slot.reset();
+                    return {res.first, true, node_type{}};
+                }
+                iterator insert_multi(node_type &&nh)
+                {
+                    if (nh.empty())
+                        return end();
+                    iterator res = insert_multi(std::move(*nh.slot));
+                    nh.slot.reset();
+                    return res;
+                }
+                // 把other中键在本树中不存在的元素移动过来；重复键的元素留在other中
+                void merge_unique(BPlusTree &other)
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    for (iterator it = other.begin(); it != other.end();)
+                    {
+                        Position pos = lower_position(skey(*it));
+                        if (Position hit = normalize(pos); hit.leaf != &header && !comp(skey(*it), skey(value_at(hit))))
+                            ++it;
+                        else
+                        {
+                            emplace_at(pos, std::move(*it));
+                            it = other.erase(it);
+                        }
+                    }
+                }
+                // 把other的全部元素移动到本树，等价键排在本树已有元素之后
+                void merge_multi(BPlusTree &other)
+                {
+                    if (this == std::addressof(other))
+                        return;
+                    for (T &v : other)
+                        emplace_at(upper_position(skey(v)), std::move(v));
+                    other.clear();
+                }
+                // 叶子中的值不参与任何增强数据，通过迭代器修改mapped值后无需刷新；提供此函数是为了与结点树接口一致
+                void refresh(const_iterator) {}
+
+                // 用区间[first, last)替换全部内容：输入已按键有序时直接批量建树，O(n)；否则先稳定排序，O(nlogn)。
+                // unique版本在等价键中保留先出现的元素，与逐个插入的结果一致。
+                template <typename InputIt>
+                void assign_unique(InputIt first, InputIt last) { assign_range(first, last, true, false); }
+                template <typename InputIt>
+                void assign_multi(InputIt first, InputIt last) { assign_range(first, last, false, false); }
+                // 同上，但由调用者保证输入已按键有序，不再检测
+                template <typename InputIt>
+                void assign_sorted_unique(InputIt first, InputIt last) { assign_range(first, last, true, true); }
+                template <typename InputIt>
+                void assign_sorted_multi(InputIt first, InputIt last) { assign_range(first, last, false, true); }
+
+                bool checker_unique() const { return check(true); }
+                bool checker_multi() const { return check(false); }
+
+            protected:
+                LeafLink header;
+                NodeBase *root_ = nullptr;
+                size_type size_r = 0;
+                Compare comp{};
+
+                // 叶子中的位置；index 可以等于 count，表示“下一个叶子的第一个元素”
+                struct Position
+                {
+                    LeafLink *leaf;
+                    size_type index;
+                };
+                friend iterator;
+                friend const_iterator;
+
+                static const key_type &skey(const T &v) { return KeyOfValue{}(v); }
+                static Leaf *as_leaf(LeafLink *p) { return static_cast<Leaf *>(p); }
+                static Leaf *as_leaf(NodeBase *p) { return static_cast<Leaf *>(p); }
+                static Inner *as_inner(NodeBase *p) { return static_cast<Inner *>(p); }
+                static T &value_at(const Position &pos) { return as_leaf(pos.leaf)->data()[pos.index]; }
+                iterator make_iterator(const Position &pos) { return iterator{pos.leaf, pos.index}; }
+                const_iterator make_const_iterator(const Position &pos) const { return const_iterator{pos.leaf, pos.index}; }
+                Position normalize(Position pos) const
+                {
+                    if (!pos.leaf)
+                        return {const_cast<LeafLink *>(&header), 0};
+                    if (pos.index == pos.leaf->count)
+                        return {pos.leaf->next, 0};
+                    return pos;
+                }
+
+                // 键是算术类型、比较器是 less / greater 时，节点内查找用无分支的计数循环（可向量化），否则二分查找。
+                // before(i) 关于 i 单调：前一段为真、后一段为假，返回为真的个数。
+                static constexpr bool linear_search =
+                    std::is_arithmetic_v<key_type> &&
+                    (std::is_same_v<Compare, std::less<key_type>> || std::is_same_v<Compare, std::greater<key_type>> ||
+                     std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::greater<>>);
+                template <typename Before>
+                static size_type partition_point(size_type n, Before &&before)
+                {
+                    if constexpr (linear_search)
+                    {
+                        size_type res = 0;
+                        for (size_type i = 0; i < n; ++i)
+                            res += size_type(before(i));
+                        return res;
+                    }
+                    else
+                    {
+                        size_type lo = 0;
+                        while (n > 0)
+                        {
+                            size_type half = n / 2;
+                            if (before(lo + half))
+                                lo += half + 1, n -= half + 1;
+                            else
+                                n = half;
+                        }
+                        return lo;
+                    }
+                }
+                // 沿lower_bound（upper为真时沿upper_bound）的路径下降到叶子
+                Position descend(const key_type &k, bool upper) const
+                {
+                    NodeBase *p = root_;
+                    if (!p)
+                        return {nullptr, 0};
+                    while (!p->is_leaf)
+                    {
+                        const Inner *n = as_inner(p);
+                        size_type i = upper ? partition_point(n->count, [&](size_type j)
+                                                              { return !comp(k, n->keys[j]); })
+                                            : partition_point(n->count, [&](size_type j)
+                                                              { return comp(n->keys[j], k); });
+                        p = n->children[i];
+                    }
+                    const T *d = as_leaf(p)->data();
+                    size_type i = upper ? partition_point(p->count, [&](size_type j)
+                                                          { return !comp(k, skey(d[j])); })
+                                        : partition_point(p->count, [&](size_type j)
+                                                          { return comp(skey(d[j]), k); });
+                    return {static_cast<LeafLink *>(as_leaf(p)), i};
+                }
+                Position lower_position(const key_type &k) const { return descend(k, false); }
+                Position upper_position(const key_type &k) const { return descend(k, true); }
+                Position find_position(const key_type &k) const
+                {
+                    Position pos = normalize(lower_position(k));
+                    if (pos.leaf == &header || comp(k, skey(value_at(pos))))
+                        return {const_cast<LeafLink *>(&header), 0};
+                    return pos;
+                }
+
+                // 把 [from, from + n) 搬到 [to, to + n)，源位置不再持有对象；两段可以重叠
+                static void relocate(T *from, size_type n, T *to)
+                {
+                    if constexpr (std::is_trivially_copyable_v<T>)
+                    {
+                        if (n)
+                            std::memmove(static_cast<void *>(to), static_cast<const void *>(from), n * sizeof(T));
+                    }
+                    else if (std::less<T *>{}(to, from))
+                    {
+                        for (size_type i = 0; i < n; ++i)
+                        {
+                            std::construct_at(to + i, std::move(from[i]));
+                            std::destroy_at(from + i);
+                        }
+                    }
+                    else
+                    {
+                        for (size_type i = n; i-- > 0;)
+                        {
+                            std::construct_at(to + i, std::move(from[i]));
+                            std::destroy_at(from + i);
+                        }
+                    }
+                }
+
+                Leaf *create_leaf() { return new Leaf; }
+                void destroy_leaf(Leaf *leaf)
+                {
+                    std::destroy_n(leaf->data(), leaf->count);
+                    delete leaf;
+                }
+                Inner *create_inner() { return new Inner; }
+                void destroy_inner_recursive(Inner *n)
+                {
+                    for (size_type i = 0; i <= n->count; ++i)
+                        if (!n->children[i]->is_leaf)
+                            destroy_inner_recursive(as_inner(n->children[i]));
+                    delete n;
+                }
+                void reset_header()
+                {
+                    header.next = header.prev = &header;
+                    header.count = 0;
+                }
+                // 把 [first, last] 这条叶子链挂到 header 上；first 为空表示空链
+                void adopt_chain(LeafLink *first, LeafLink *last)
+                {
+                    if (!first)
+                    {
+                        reset_header();
+                        return;
+                    }
+                    header.next = first;
+                    header.prev = last;
+                    first->prev = last->next = &header;
+                }
+                static void link_after(LeafLink *pos, LeafLink *leaf)
+                {
+                    leaf->prev = pos;
+                    leaf->next = pos->next;
+                    pos->next->prev = leaf;
+                    pos->next = leaf;
+                }
+                static void unlink(LeafLink *leaf)
+                {
+                    leaf->prev->next = leaf->next;
+                    leaf->next->prev = leaf->prev;
+                }
+                static size_type child_index(const Inner *p, const NodeBase *child)
+                {
+                    size_type i = 0;
+                    while (p->children[i] != child)
+                        ++i;
+                    return i;
+                }
+                static void set_child(Inner *p, size_type i, NodeBase *child)
+                {
+                    p->children[i] = child;
+                    child->parent = p;
+                }
+
+                // 在 pos 处用实参构造新元素；叶子满了先对半分裂。
+                // 实参可能引用目标叶子中的元素（如 m.try_emplace(2, m.at(3))），挪动或分裂叶子会使其失效，
+                // 所以先在栈上构造好新值，再改动叶子，最后把新值移动进去
+                template <typename... Args>
+                iterator emplace_at(Position pos, Args &&...args)
+                {
+                    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<Args, T> && ...))
+                        return emplace_value(pos, std::forward<Args>(args)...);
+                    else
+                    {
+                        T tmp(std::forward<Args>(args)...);
+                        return emplace_value(pos, std::move(tmp));
+                    }
+                }
+                iterator emplace_value(Position pos, T &&v)
+                {
+                    Leaf *leaf;
+                    size_type idx = pos.index;
+                    if (!pos.leaf)
+                    {
+                        leaf = create_leaf();
+                        link_after(&header, leaf);
+                        root_ = leaf;
+                        idx = 0;
+                    }
+                    else
+                    {
+                        leaf = as_leaf(pos.leaf);
+                        if (leaf->count == leaf_capacity)
+                        {
+                            Leaf *right = split_leaf(leaf);
+                            if (idx > leaf->count)
+                            {
+                                idx -= leaf->count;
+                                leaf = right;
+                            }
+                        }
+                    }
+                    T *d = leaf->data();
+                    relocate(d + idx, leaf->count - idx, d + idx + 1);
+                    try
+                    {
+                        std::construct_at(d + idx, std::move(v));
+                    }
+                    catch (...)
+                    {
+                        relocate(d + idx + 1, leaf->count - idx, d + idx);
+                        if (leaf->count == 0)
+                            erase_empty_root(leaf);
+                        throw;
+                    }
+                    ++leaf->count;
+                    ++size_r;
+                    return iterator{leaf, idx};
+                }
+                // 只有新建的根叶子可能在构造失败后为空
+                void erase_empty_root(Leaf *leaf)
+                {
+                    unlink(leaf);
+                    destroy_leaf(leaf);
+                    root_ = nullptr;
+                }
+                // 左半保留 leaf_capacity / 2 个元素，其余搬到新的右邻叶子，并把右叶子的首键插入父节点
+                Leaf *split_leaf(Leaf *leaf)
+                {
+                    Leaf *right = create_leaf();
+                    size_type mid = leaf->count / 2;
+                    relocate(leaf->data() + mid, leaf->count - mid, right->data());
+                    right->count = leaf->count - mid;
+                    leaf->count = mid;
+                    link_after(leaf, right);
+                    insert_into_parent(leaf, skey(right->data()[0]), right);
+                    return right;
+                }
+                // 在 left 右侧插入分隔键 sep 与新孩子 right；父节点满了就分裂并把中间的键上推
+                void insert_into_parent(NodeBase *left, const key_type &sep, NodeBase *right)
+                {
+                    if (left == root_)
+                    {
+                        Inner *r = create_inner();
+                        r->keys[0] = sep;
+                        r->count = 1;
+                        set_child(r, 0, left);
+                        set_child(r, 1, right);
+                        root_ = r;
+                        return;
+                    }
+                    Inner *p = as_inner(left->parent);
+                    size_type i = child_index(p, left);
+                    if (p->count < inner_capacity)
+                    {
+                        for (size_type j = p->count; j > i; --j)
+                        {
+                            p->keys[j] = std::move(p->keys[j - 1]);
+                            p->children[j + 1] = p->children[j];
+                        }
+                        p->keys[i] = sep;
+                        set_child(p, i + 1, right);
+                        ++p->count;
+                        return;
+                    }
+                    // 先在临时数组里排好 inner_capacity + 1 个键，再一分为二
+                    key_type keys[inner_capacity + 1];
+                    NodeBase *children[inner_capacity + 2];
+                    for (size_type j = 0, from = 0; j <= inner_capacity; ++j)
+                        keys[j] = (j == i) ? sep : std::move(p->keys[from++]);
+                    for (size_type j = 0, from = 0; j <= inner_capacity + 1; ++j)
+                        children[j] = (j == i + 1) ? right : p->children[from++];
+                    size_type m = (inner_capacity + 1) / 2;
+                    Inner *q = create_inner();
+                    p->count = m;
+                    for (size_type j = 0; j < m; ++j)
+                        p->keys[j] = std::move(keys[j]);
+                    for (size_type j = 0; j <= m; ++j)
+                        set_child(p, j, children[j]);
+                    q->count = inner_capacity - m;
+                    for (size_type j = 0; j < q->count; ++j)
+                        q->keys[j] = std::move(keys[m + 1 + j]);
+                    for (size_type j = 0; j <= q->count; ++j)
+                        set_child(q, j, children[m + 1 + j]);
+                    insert_into_parent(p, keys[m], q);
+                }
+                // 删除父节点中的第 ki 个键和第 ci 个孩子
+                static void remove_from_inner(Inner *p, size_type ki, size_type ci)
+                {
+                    for (size_type j = ki; j + 1 < p->count; ++j)
+                        p->keys[j] = std::move(p->keys[j + 1]);
+                    for (size_type j = ci; j < p->count; ++j)
+                        p->children[j] = p->children[j + 1];
+                    --p->count;
+                }
+
+                // 删除 pos 处的元素，返回下一个元素的位置；叶子过空时向兄弟借一个元素或与兄弟合并
+                Position erase_at(Position pos)
+                {
+                    Leaf *leaf = as_leaf(pos.leaf);
+                    T *d = leaf->data();
+                    std::destroy_at(d + pos.index);
+                    relocate(d + pos.index + 1, leaf->count - pos.index - 1, d + pos.index);
+                    --leaf->count;
+                    --size_r;
+                    rebalance_leaf(leaf, pos);
+                    return normalize(pos);
+                }
+                // next 是删除点之后的位置，元素在叶子间移动时随之修正
+                void rebalance_leaf(Leaf *leaf, Position &next)
+                {
+                    if (leaf == root_)
+                    {
+                        if (leaf->count == 0)
+                        {
+                            erase_empty_root(leaf);
+                            next = {&header, 0};
+                        }
+                        return;
+                    }
+                    if (leaf->count >= leaf_min)
+                        return;
+                    Inner *p = as_inner(leaf->parent);
+                    size_type i = child_index(p, leaf);
+                    Leaf *left = i > 0 ? as_leaf(p->children[i - 1]) : nullptr;
+                    Leaf *right = i < p->count ? as_leaf(p->children[i + 1]) : nullptr;
+                    if (left && left->count > leaf_min)
+                    {
+                        relocate(leaf->data(), leaf->count, leaf->data() + 1);
+                        relocate(left->data() + left->count - 1, 1, leaf->data());
+                        --left->count;
+                        ++leaf->count;
+                        p->keys[i - 1] = skey(leaf->data()[0]);
+                        ++next.index;
+                        return;
+                    }
+                    if (right && right->count > leaf_min)
+                    {
+                        relocate(right->data(), 1, leaf->data() + leaf->count);
+                        relocate(right->data() + 1, right->count - 1, right->data());
+                        --right->count;
+                        ++leaf->count;
+                        p->keys[i] = skey(right->data()[0]);
+                        return;
+                    }
+                    if (left)
+                    {
+                        next = {left, left->count + next.index};
+                        merge_leaves(left, leaf, p, i - 1);
+                    }
+                    else
+                        merge_leaves(leaf, right, p, i);
+                    rebalance_inner(p);
+                }
+                // 把 right 并入左邻 left，删除父节点中两者之间的第 ki 个键
+                void merge_leaves(Leaf *left, Leaf *right, Inner *p, size_type ki)
+                {
+                    relocate(right->data(), right->count, left->data() + left->count);
+                    left->count += right->count;
+                    right->count = 0;
+                    unlink(right);
+                    remove_from_inner(p, ki, ki + 1);
+                    destroy_leaf(right);
+                }
+                void rebalance_inner(Inner *node)
+                {
+                    if (node == root_)
+                    {
+                        // 根只剩一个孩子时降低树高
+                        if (node->count == 0)
+                        {
+                            root_ = node->children[0];
+                            root_->parent = nullptr;
+                            delete node;
+                        }
+                        return;
+                    }
+                    if (node->count >= inner_min)
+                        return;
+                    Inner *p = as_inner(node->parent);
+                    size_type i = child_index(p, node);
+                    Inner *left = i > 0 ? as_inner(p->children[i - 1]) : nullptr;
+                    Inner *right = i < p->count ? as_inner(p->children[i + 1]) : nullptr;
+                    if (left && left->count > inner_min)
+                    {
+                        // 经父节点右旋：父节点的分隔键下移到 node 最前，left 的最后一个键上移
+                        for (size_type j = node->count; j > 0; --j)
+                            node->keys[j] = std::move(node->keys[j - 1]);
+                        for (size_type j = node->count + 1; j > 0; --j)
+                            node->children[j] = node->children[j - 1];
+                        node->keys[0] = std::move(p->keys[i - 1]);
+                        set_child(node, 0, left->children[left->count]);
+                        p->keys[i - 1] = std::move(left->keys[left->count - 1]);
+                        --left->count;
+                        ++node->count;
+                        return;
+                    }
+                    if (right && right->count > inner_min)
+                    {
+                        node->keys[node->count] = std::move(p->keys[i]);
+                        set_child(node, node->count + 1, right->children[0]);
+                        p->keys[i] = std::move(right->keys[0]);
+                        remove_from_inner(right, 0, 0);
+                        ++node->count;
+                        return;
+                    }
+                    if (left)
+                        merge_inners(left, node, p, i - 1);
+                    else
+                        merge_inners(node, right, p, i);
+                    rebalance_inner(p);
+                }
+                // 把 right 连同父节点中的分隔键并入 left
+                void merge_inners(Inner *left, Inner *right, Inner *p, size_type ki)
+                {
+                    left->keys[left->count] = std::move(p->keys[ki]);
+                    for (size_type j = 0; j < right->count; ++j)
+                        left->keys[left->count + 1 + j] = std::move(right->keys[j]);
+                    for (size_type j = 0; j <= right->count; ++j)
+                        set_child(left, left->count + 1 + j, right->children[j]);
+                    left->count += right->count + 1;
+                    remove_from_inner(p, ki, ki + 1);
+                    delete right;
+                }
+
+                template <typename InputIt>
+                void assign_range(InputIt first, InputIt last, bool unique, bool sorted)
+                {
+                    // 在临时树中建好再交换：构造失败时本树不变，输入区间也可以来自本树
+                    BPlusTree tmp(comp);
+                    auto value_less = [this](const T &a, const T &b)
+                    { return comp(skey(a), skey(b)); };
+                    if constexpr (std::forward_iterator<InputIt>)
+                        sorted = sorted || std::is_sorted(first, last, value_less);
+                    if (sorted)
+                        tmp.build_sorted(first, last, unique);
+                    else
+                    {
+                        std::vector<T> buf(first, last);
+                        if (std::is_sorted(buf.begin(), buf.end(), value_less))
+                            tmp.build_sorted(std::make_move_iterator(buf.begin()), std::make_move_iterator(buf.end()), unique);
+                        else
+                        {
+                            // 值（如map的pair<const K, V>）不一定能赋值，所以对指针做稳定排序，再按顺序把值移出来
+                            std::vector<T *> order;
+                            order.reserve(buf.size());
+                            for (T &v : buf)
+                                order.push_back(std::addressof(v));
+                            Sorting::MergeSort(order.begin(), order.end(), [this](const T *a, const T *b)
+                                               { return comp(skey(*a), skey(*b)); });
+                            std::vector<T> sorted_buf;
+                            sorted_buf.reserve(buf.size());
+                            for (T *p : order)
+                                sorted_buf.push_back(std::move(*p));
+                            tmp.build_sorted(std::make_move_iterator(sorted_buf.begin()), std::make_move_iterator(sorted_buf.end()), unique);
+                        }
+                    }
+                    this->swap(tmp);
+                }
+                // 在空树上自底向上建树：先把元素依次填满叶子，再逐层把 inner_capacity + 1 个节点归为一组建父节点。
+                // 最后一个叶子（或最后一组）不足半满时与前一个平分，保证除根以外都至少半满。
+                template <typename InputIt>
+                void build_sorted(InputIt first, InputIt last, bool unique)
+                {
+                    std::vector<NodeBase *> level;
+                    std::vector<key_type> mins; // 每个节点子树中的最小键，作为父节点中的分隔键
+                    try
+                    {
+                        Leaf *cur = nullptr;
+                        for (; first != last; ++first)
+                        {
+                            if (unique && cur && !comp(skey(*std::prev(end())), skey(*first)))
+                                continue;
+                            if (!cur || cur->count == leaf_capacity)
+                            {
+                                cur = create_leaf();
+                                link_after(header.prev, cur);
+                                level.push_back(cur);
+                            }
+                            std::construct_at(cur->data() + cur->count, *first);
+                            ++cur->count;
+                            ++size_r;
+                            if (cur->count == 1)
+                                mins.push_back(skey(cur->data()[0]));
+                        }
+                    }
+                    catch (...)
+                    {
+                        clear();
+                        throw;
+                    }
+                    if (level.size() >= 2 && level.back()->count < leaf_min)
+                    {
+                        Leaf *prev = as_leaf(level[level.size() - 2]), *tail = as_leaf(level.back());
+                        size_type k = (prev->count + tail->count) / 2 - tail->count;
+                        relocate(tail->data(), tail->count, tail->data() + k);
+                        relocate(prev->data() + prev->count - k, k, tail->data());
+                        prev->count -= k;
+                        tail->count += k;
+                        mins.back() = skey(tail->data()[0]);
+                    }
+                    constexpr size_type fan = inner_capacity + 1;
+                    while (level.size() > 1)
+                    {
+                        std::vector<NodeBase *> up;
+                        std::vector<key_type> up_mins;
+                        size_type n = level.size();
+                        for (size_type i = 0; i < n;)
+                        {
+                            size_type take = std::min(fan, n - i);
+                            if (n - i > fan && n - i - fan < inner_min + 1)
+                                take = (n - i) / 2;
+                            Inner *node = create_inner();
+                            set_child(node, 0, level[i]);
+                            for (size_type j = 1; j < take; ++j)
+                            {
+                                node->keys[j - 1] = std::move(mins[i + j]);
+                                set_child(node, j, level[i + j]);
+                            }
+                            node->count = take - 1;
+                            up.push_back(node);
+                            up_mins.push_back(std::move(mins[i]));
+                            i += take;
+                        }
+                        level.swap(up);
+                        mins.swap(up_mins);
+                    }
+                    root_ = level.empty() ? nullptr : level[0];
+                    if (root_)
+                        root_->parent = nullptr;
+                }
+
+                // 检查：叶子等深、除根外半满、父指针正确、键落在分隔键给出的范围内、叶子链表与树的中序一致且有序
+                bool check(bool unique) const
+                {
+                    std::vector<const NodeBase *> leaves;
+                    size_type depth = 0, total = 0;
+                    if (root_ && !check_node(root_, nullptr, nullptr, 0, depth, leaves, total))
+                        return false;
+                    if (total != size_r || (root_ && root_->parent))
+                        return false;
+                    const LeafLink *p = header.next;
+                    for (const NodeBase *leaf : leaves)
+                    {
+                        if (p != leaf || p->next->prev != p)
+                            return false;
+                        p = p->next;
+                    }
+                    if (p != &header)
+                        return false;
+                    for (const_iterator it = begin(), nx; it != end(); it = nx)
+                    {
+                        nx = std::next(it);
+                        if (nx != end() && (unique ? !comp(skey(*it), skey(*nx)) : comp(skey(*nx), skey(*it))))
+                            return false;
+                    }
+                    return true;
+                }
+                bool check_node(const NodeBase *p, const key_type *lo, const key_type *hi, size_type d, size_type &leaf_depth,
+                                std::vector<const NodeBase *> &leaves, size_type &total) const
+                {
+                    bool is_root = p == root_;
+                    if (p->is_leaf)
+                    {
+                        if (p->count > leaf_capacity || (!is_root && p->count < leaf_min) || p->count == 0)
+                            return false;
+                        if (leaves.empty())
+                            leaf_depth = d;
+                        else if (leaf_depth != d)
+                            return false;
+                        const T *data = static_cast<const Leaf *>(p)->data();
+                        for (size_type i = 0; i < p->count; ++i)
+                            if ((lo && comp(skey(data[i]), *lo)) || (hi && comp(*hi, skey(data[i]))))
+                                return false;
+                        leaves.push_back(p);
+                        total += p->count;
+                        return true;
+                    }
+                    const Inner *n = static_cast<const Inner *>(p);
+                    if (n->count > inner_capacity || (!is_root && n->count < inner_min) || n->count == 0)
+                        return false;
+                    for (size_type i = 0; i <= n->count; ++i)
+                    {
+                        const key_type *clo = i == 0 ? lo : &n->keys[i - 1];
+                        const key_type *chi = i == n->count ? hi : &n->keys[i];
+                        if (n->children[i]->parent != p || (clo && chi && comp(*chi, *clo)))
+                            return false;
+                        if (!check_node(n->children[i], clo, chi, d + 1, leaf_depth, leaves, total))
+                            return false;
+                    }
+                    return true;
+                }
+            };
+        }
+    }
+}
@@ -23,7 +23,9 @@ namespace DSA
                         };
                         // update函数是此策略的核心。它在节点的孩子发生变化后被调用，
                         // 用来根据左右子树的高度重新计算并更新当前节点的高度。
-                        static void update(Data *node_data, const Data *left_data, const Data *right_data)
+                        // NodeData是实际传入的节点类型，原样转发给OtherAugment，使其能访问节点中存储的值。
+                        template <typename NodeData>
+                        static void update(NodeData *node_data, const NodeData *left_data, const NodeData *right_data)
                         {
                             set_height(node_data, std::max(get_height(left_data), get_height(right_data)) + 1);
                             // if constexpr 确保了只有当OtherAugment也需要更新时，才会编译其update调用。
@@ -38,6 +40,8 @@ namespace DSA
                         // 这个编译时标志告诉基类BST，在插入或删除后，
                         // 必须沿着路径向上调用update函数，从而确保所有祖先节点的高度都被正确更新。
                         static constexpr bool require_path_update = true;
+                        // 子树大小等能力由被组合的OtherAugment决定
+                        static constexpr bool subtree_size_implemented = OtherAugment::subtree_size_implemented;
                     };
                     // AVL树的节点类型，它通过继承和模板参数，将SubtreeHeightAugment策略应用到BST节点上。
                     template <typename T, typename AugmentPolicy = DefaultNodeAugmentation>
@@ -127,10 +131,11 @@ namespace DSA
                             while (parent != this->end_ptr())
                             {
                                 int pbf = get_balance_factor(parent); // pbf: parent's balance factor
-                                // 如果当前节点是平衡的，其高度已在之前的may_update_path或rotate中被更新。
-                                // 我们只需继续向上检查父节点即可。
+                                // 如果当前节点是平衡的，只需重算它的高度并继续向上检查父节点。
+                                // may_update_path在旋转之前就算好了祖先的高度，下方的旋转可能让子树变矮，所以这里不能省。
                                 if (std::abs(pbf) <= 1)
                                 {
+                                    AugmentPolicy::update(parent, parent->left(), parent->right());
                                     parent = parent->parent;
                                     continue;
                                 }
@@ -167,9 +172,9 @@ namespace DSA
                         // 在插入或删除一个节点后，基类会调用这些钩子，从而触发我们的平衡恢复逻辑。
                         void insert_hook(Node *p) override { return height_rebalance(p->parent); }
                         void erase_hook(Node *p) override { return height_rebalance(p->parent); }
-                        Node *createNodeInternal(const T &v) override
+                        Node *initNodeInternal(Node *p) override
                         {
-                            return set_height(Base::createNodeInternal(v), 1);
+                            return set_height(Base::initNodeInternal(p), 1);
                         }
                         // 检查全树是否满足AVL属性的辅助函数，用于调试和验证。
                         bool check_avl() const
@@ -194,6 +199,16 @@ namespace DSA
                             return new AVLTreeLinked(*this);
                         }
                     };
+                    // 同时维护高度与子树大小的AVL树（顺序统计树），可直接作为Set/Map的Implement使用
+                    template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+                    using OrderStatisticAVLTreeLinked = AVLTreeLinked<T, KeyT, Compare, KeyOfValue, SubtreeSizeAugment<>>;
+                    // 同时维护高度与子树聚合的AVL树，AggregateAVLTree<Monoid>::Linked 可作为Map的Implement使用
+                    template <typename Monoid, typename OtherAugment = DefaultNodeAugmentation>
+                    struct AggregateAVLTree
+                    {
+                        template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+                        using Linked = AVLTreeLinked<T, KeyT, Compare, KeyOfValue, SubtreeAggregateAugment<Monoid, OtherAugment>>;
+                    };
 
                 }
             }
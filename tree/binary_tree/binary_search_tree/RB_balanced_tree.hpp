@@ -34,75 +34,35 @@ namespace DSA
                         swap_node(static_cast<node_base &>(x), static_cast<node_base &>(y));
                         std::swap(x.color, y.color);
                     }
-                    // 红黑树的主类。
-                    template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>, typename AugmentPolicy = DefaultNodeAugmentation>
-                    struct RBTreeLinked : BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, RBTreeNodeLinked<T, AugmentPolicy>>
+                    // 红黑树的再平衡算法只依赖节点的 parent / children / color 与哨兵头节点（header->left()==root()，颜色为黑），
+                    // RBTreeLinked 与侵入式的 IntrusiveRBTree 共用这里的实现；rotate(node, to_right) 由树提供，以便顺带维护增强数据。
+                    namespace detail
                     {
-                        using value_type = T;
-                        using key_type = KeyT;
-                        using NodeType = RBTreeNodeLinked<T, AugmentPolicy>;
-                        using Base = BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, NodeType>;
-                        using iterator = Base::iterator;
-                        using const_iterator = Base::const_iterator;
-                        using pointer = Base::pointer;
-                        using const_pointer = Base::const_pointer;
-                        using reference = Base::reference;
-                        using const_reference = Base::const_reference;
-                        using difference_type = Base::difference_type;
-                        using size_type = Base::size_type;
-                        using Node = typename Base::Node;
-                        using BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, NodeType>::BinarySearchTreeLinked;
-                        bool checker_unique() const override
-                        {
-                            if (!check_rb())
-                                return false;
-                            return Base::checker_unique();
-                        }
-                        bool checker_multi() const override
-                        {
-                            if (!check_rb())
-                                return false;
-                            return Base::checker_multi();
-                        }
-                        explicit RBTreeLinked(const RBTreeLinked &other) = default;
-
-                        RBTreeLinked &operator=(const RBTreeLinked &other) = default;
-                        std::unique_ptr<RBTreeLinked> clone() const
-                        {
-                            return std::unique_ptr<RBTreeLinked>(clone_unsafe());
-                        }
-
-                        
-                    virtual void swap(RBTreeLinked &other) 
-                    {
-                        this->Base::swap(other);
-                    }
-                    void swap(Base&other)override{
-                        if(typeid(*this)!=typeid(other))return;
-                        this->Base::swap(other);
-                    }
-
-                    protected:
                         // 辅助函数，将空指针(NIL节点)视为黑色，这是红黑树算法的基础。
-                        static bool is_red(Node *p) { return p ? (p->color == RED) : false; }
-                        static bool is_black(Node *p) { return p ? (p->color == BLACK) : true; }
-                        static Node *set_red(Node *p) { return (p && (p->color = RED)), p; }
-                        static Node *set_black(Node *p) { return (p && (p->color = BLACK)), p; }
+                        template <typename NodeType>
+                        bool is_red(NodeType *p) { return p ? (p->color == RED) : false; }
+                        template <typename NodeType>
+                        bool is_black(NodeType *p) { return p ? (p->color == BLACK) : true; }
+                        template <typename NodeType>
+                        NodeType *set_red(NodeType *p) { return (p && (p->color = RED)), p; }
+                        template <typename NodeType>
+                        NodeType *set_black(NodeType *p) { return (p && (p->color = BLACK)), p; }
                         // 插入操作后的再平衡函数。
-                        void insert_rebalance(Node *node)
+                        template <typename NodeType, typename Rotate>
+                        void insert_rebalance(NodeType *header, NodeType *node, Rotate &&rotate)
                         {
                             // 算法开始，新插入的节点总是红色（根除外，最后处理）。
                             set_red(node);
-                            Node *parent = node->parent;
-                            Node *grand = parent->parent;
+                            NodeType *parent = node->parent;
+                            NodeType *grand = parent->parent;
                             // 循环条件：只要存在“红-红”冲突 (parent节点是红色)，就需要调整。
                             // 由于根的parent节点(header)是黑色的，此循环对根节点不会执行。
                             while (is_red(parent)) // root and header (root's parent) and null are always black
                             {
                                 // node,parent,grand are within tree, and grand is black
-                                bool is_right_n = this->is_right(node);
-                                bool is_right_p = this->is_right(parent);
-                                Node *psibling = grand->children[!is_right_p]; // psibling=parent's sibling
+                                bool is_right_n = BinaryTree::detail::is_right(node);
+                                bool is_right_p = BinaryTree::detail::is_right(parent);
+                                NodeType *psibling = grand->children[!is_right_p]; // psibling=parent's sibling
                                 // Case 1: parent's sibling是红色。
                                 if (is_red(psibling))
                                 {
@@ -110,7 +70,7 @@ namespace DSA
                                     set_black(parent);
                                     set_black(psibling);
                                     // 如果祖先是根，它必须保持黑色，循环结束。
-                                    if (grand == this->root())
+                                    if (grand == header->left())
                                         break;
                                     set_red(grand);
                                     // 问题被“推”到了祖先节点，继续向上检查。
@@ -126,33 +86,32 @@ namespace DSA
                                     if (is_right_n != is_right_p)
                                     {
                                         // 对parent节点进行一次旋转，将其转换为“直线”情况。
-                                        this->rotate(parent, to_right = !is_right_n);
+                                        rotate(parent, to_right = !is_right_n);
                                         // 交换node和parent指针，因为它们的角色互换了。
                                         std::swap(node, parent);
                                     }
                                     // Subcase 2.2: “直线”情况 (e.g., LL or RR)。
                                     set_black(parent);
                                     set_red(grand);
-                                    this->rotate(grand, !is_right_p);
+                                    rotate(grand, !is_right_p);
                                     // 调整后，不会再有“红-红”冲突，可以退出循环。
                                     break;
                                 }
                             }
                             // 最终强制确保根节点是黑色，满足红黑树属性2。
-                            set_black(this->root());
+                            set_black(header->left());
                             return;
                         }
-                        void insert_hook(Node *p) override { return insert_rebalance(p); }
-
                         // 删除操作后的再平衡函数。
                         // 它的核心任务是修复因删除黑色节点而导致的“各路径黑高必须相等”被破坏的问题。
                         // 这个函数通过一系列旋转和重新着色，为黑高不足的路径增加一个黑色节点，或将问题上移。
                         // parent:  当前存在黑高不一致问题的子树的根节点。
                         // at_right: 黑高不足的路径位于`parent`的右子树中吗？
-                        void erase_rebalance(Node *parent, bool at_right)
+                        template <typename NodeType, typename Rotate>
+                        void erase_rebalance(NodeType *header, NodeType *parent, bool at_right, Rotate &&rotate)
                         {
                             // `node`是黑高不足路径的起始节点。算法通过追踪`node`来标记问题所在的位置。
-                            Node *node = parent->children[at_right];
+                            NodeType *node = parent->children[at_right];
                             // 如果`node`是红色，情况很简单。
                             // 我们只需将`node`染黑，就能完全弥补因删除而失去的那个黑色节点，黑高恢复。
                             if (is_red(node))
@@ -163,16 +122,16 @@ namespace DSA
                             bool to_right;
                             // 循环直到`node`不再是黑高问题的标记（即问题被解决或推到根部）。
                             // 当`node`为红色或成为根时，循环终止。
-                            while (node != this->root())
+                            while (node != header->left())
                             {
-                                Node *sibling = parent->children[!at_right];
+                                NodeType *sibling = parent->children[!at_right];
                                 // Case 1: sibling节点是红色。
                                 if (is_red(sibling))
                                 {
                                     // 目标：将情况转化为sibling节点是黑色的后续情况。
                                     // 策略：对`parent`进行旋转，并交换`parent`和`sibling`的颜色。
                                     // 这一步之后，`node`仍然存在黑高不足的问题，但它面对的新sibling节点一定是黑色的。
-                                    this->rotate(parent, to_right = at_right);
+                                    rotate(parent, to_right = at_right);
                                     set_black(sibling);
                                     set_red(parent);
                                     // 更新sibling节点
@@ -196,7 +155,7 @@ namespace DSA
                                     // 否则继续循环
                                     node = parent;
                                     parent = node->parent;
-                                    at_right = this->is_right(node);
+                                    at_right = BinaryTree::detail::is_right(node);
                                 }
                                 else // Case 3 & 4: sibling是黑色，且至少有一个红色孩子。
                                 {
@@ -206,7 +165,7 @@ namespace DSA
                                     if (is_black(sibling->children[!at_right]))
                                     {
                                         // 通过一次旋转和着色，将其转化为Case 4的“直线”情况。
-                                        this->rotate(sibling, to_right = !at_right);
+                                        rotate(sibling, to_right = !at_right);
                                         set_red(sibling);
                                         sibling = sibling->parent;
                                         set_black(sibling);
@@ -214,16 +173,90 @@ namespace DSA
                                     // Case 4: “直线”情况（sibling的离node远侧孩子是红色）。
                                     // 对`parent`进行最终旋转，并精心设置颜色，使得黑高恢复平衡。
                                     sibling->color = parent->color;
-                                    this->rotate(parent, to_right = at_right);
+                                    rotate(parent, to_right = at_right);
                                     set_black(sibling->left());
                                     set_black(sibling->right());
                                     break;
                                 }
                             }
                             //确保根节点是黑色
-                            set_black(this->root());
+                            set_black(header->left());
                             return;
                         }
+                    }
+                    // 红黑树的主类。
+                    template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>, typename AugmentPolicy = DefaultNodeAugmentation>
+                    struct RBTreeLinked : BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, RBTreeNodeLinked<T, AugmentPolicy>>
+                    {
+                        using value_type = T;
+                        using key_type = KeyT;
+                        using NodeType = RBTreeNodeLinked<T, AugmentPolicy>;
+                        using Base = BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, NodeType>;
+                        using iterator = Base::iterator;
+                        using const_iterator = Base::const_iterator;
+                        using pointer = Base::pointer;
+                        using const_pointer = Base::const_pointer;
+                        using reference = Base::reference;
+                        using const_reference = Base::const_reference;
+                        using difference_type = Base::difference_type;
+                        using size_type = Base::size_type;
+                        using Node = typename Base::Node;
+                        using BinarySearchTreeLinked<T, KeyT, Compare, KeyOfValue, AugmentPolicy, NodeType>::BinarySearchTreeLinked;
+                        bool checker_unique() const override
+                        {
+                            if (!check_rb())
+                                return false;
+                            return Base::checker_unique();
+                        }
+                        bool checker_multi() const override
+                        {
+                            if (!check_rb())
+                                return false;
+                            return Base::checker_multi();
+                        }
+                        explicit RBTreeLinked(const RBTreeLinked &other) = default;
+
+                        RBTreeLinked &operator=(const RBTreeLinked &other) = default;
+                        std::unique_ptr<RBTreeLinked> clone() const
+                        {
+                            return std::unique_ptr<RBTreeLinked>(clone_unsafe());
+                        }
+
+                        
+                    virtual void swap(RBTreeLinked &other) 
+                    {
+                        this->Base::swap(other);
+                    }
+                    void swap(Base&other)override{
+                        if(typeid(*this)!=typeid(other))return;
+                        this->Base::swap(other);
+                    }
+
+                    protected:
+                        static bool is_red(Node *p) { return detail::is_red(p); }
+                        static bool is_black(Node *p) { return detail::is_black(p); }
+                        static Node *set_red(Node *p) { return detail::set_red(p); }
+                        static Node *set_black(Node *p) { return detail::set_black(p); }
+                        // 批量建树得到的树除最深一层外都是满的：最深一层染红、其余染黑，所有路径黑高相同且没有红-红相邻。
+                        void build_hook(Node *p, size_type depth, size_type max_depth) override
+                        {
+                            p->color = (depth > 0 && depth == max_depth) ? RED : BLACK;
+                        }
+                        // 插入操作后的再平衡函数。
+                        void insert_rebalance(Node *node)
+                        {
+                            detail::insert_rebalance(this->end_ptr(), node, [this](Node *p, bool to_right)
+                                                     { this->rotate(p, to_right); });
+                        }
+                        void insert_hook(Node *p) override { return insert_rebalance(p); }
+
+                        // 删除操作后的再平衡函数。parent 的 at_right 一侧黑高少 1
+                        void erase_rebalance(Node *parent, bool at_right)
+                        {
+                            detail::erase_rebalance(this->end_ptr(), parent, at_right, [this](Node *p, bool to_right)
+                                                    { this->rotate(p, to_right); });
+                        }
+
                         // 删除操作的钩子函数。
                         void erase_hook(Node *p) override
                         {
@@ -244,9 +277,9 @@ namespace DSA
                             }
                         }
                         //需要set_black,因为哨兵节点需要被当成黑色的nil
-                        Node *createNodeInternal(const T &v) override
+                        Node *initNodeInternal(Node *p) override
                         {
-                            return set_black(Base::createNodeInternal(v));
+                            return set_black(Base::initNodeInternal(p));
                         }
                         //性质检查，用于debug
                         bool check_rb() const
@@ -293,6 +326,16 @@ namespace DSA
                             return new RBTreeLinked(*this);
                         }
                     };
+                    // 维护子树大小的红黑树（顺序统计树），可直接作为Set/Map的Implement使用
+                    template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+                    using OrderStatisticRBTreeLinked = RBTreeLinked<T, KeyT, Compare, KeyOfValue, SubtreeSizeAugment<>>;
+                    // 维护子树聚合的红黑树，AggregateRBTree<Monoid>::Linked 可作为Map的Implement使用
+                    template <typename Monoid, typename OtherAugment = DefaultNodeAugmentation>
+                    struct AggregateRBTree
+                    {
+                        template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>>
+                        using Linked = RBTreeLinked<T, KeyT, Compare, KeyOfValue, SubtreeAggregateAugment<Monoid, OtherAugment>>;
+                    };
                 }
             }
         }
@@ -3,7 +3,14 @@
 #include <algorithm>
 #include <type_traits>
 #include <concepts>
+#include <utility>
+#include <cstddef>
+#include <limits>
+#include <bit>
+#include <iterator>
+#include <vector>
 #include "../binary_tree_basic.hpp"
+#include "../../../sorting/sorting.hpp"
 #include "../../../utils.hpp"
 namespace DSA
 {
@@ -28,6 +35,86 @@ namespace DSA
                     // 一个编译时标志，用于指示是否实现了子树大小的快速计算。
                     static constexpr bool subtree_size_implemented = false;
                 };
+                // 子树大小增强：每个节点记录以自身为根的子树中的元素个数，从而支持O(logN)的rank/select/计数。
+                // 可以层层组合，例如 AVL 树的 SubtreeHeightAugment<SubtreeSizeAugment<>>；红黑树的颜色存放在节点中，直接使用即可。
+                template <typename OtherAugment = DefaultNodeAugmentation>
+                struct SubtreeSizeAugment
+                {
+                    struct Data : OtherAugment::Data
+                    {
+                        // 新节点是只含自身的子树
+                        std::size_t subtree_size = 1;
+                    };
+                    template <typename NodeData>
+                    static void update(NodeData *node_data, const NodeData *left_data, const NodeData *right_data)
+                    {
+                        node_data->subtree_size = get_size(left_data) + get_size(right_data) + 1;
+                        if constexpr (requires { OtherAugment::update(node_data, left_data, right_data); })
+                        {
+                            OtherAugment::update(node_data, left_data, right_data);
+                        }
+                    }
+                    static std::size_t get_size(const Data *node_data) { return node_data ? node_data->subtree_size : 0; }
+                    static constexpr bool require_path_update = true;
+                    static constexpr bool subtree_size_implemented = true;
+                };
+                // 区间聚合用的幺半群：identity()是单位元，combine(a, b)满足结合律（不要求交换律，按中序从左到右合并）。
+                template <typename T>
+                struct SumMonoid
+                {
+                    using value_type = T;
+                    static T identity() { return T{}; }
+                    static T combine(const T &a, const T &b) { return a + b; }
+                };
+                template <typename T>
+                struct MaxMonoid
+                {
+                    using value_type = T;
+                    static T identity() { return std::numeric_limits<T>::lowest(); }
+                    static T combine(const T &a, const T &b) { return std::max(a, b); }
+                };
+                template <typename T>
+                struct MinMonoid
+                {
+                    using value_type = T;
+                    static T identity() { return std::numeric_limits<T>::max(); }
+                    static T combine(const T &a, const T &b) { return std::min(a, b); }
+                };
+                // 节点参与聚合的部分：map类的pair值取mapped值，否则取值本身。
+                template <typename V>
+                const auto &aggregate_operand(const V &v)
+                {
+                    if constexpr (requires { v.second; })
+                        return v.second;
+                    else
+                        return v;
+                }
+                // 子树聚合增强：每个节点记录其子树中所有元素（按中序）经Monoid合并的结果，从而支持O(logN)的区间聚合查询。
+                // 与SubtreeSizeAugment一样可以组合进AVL树的SubtreeHeightAugment，旋转时由update重新计算。
+                template <typename Monoid, typename OtherAugment = DefaultNodeAugmentation>
+                struct SubtreeAggregateAugment
+                {
+                    using aggregate_type = typename Monoid::value_type;
+                    struct Data : OtherAugment::Data
+                    {
+                        // 通过节点类型可以找回所用的幺半群
+                        using aggregate_monoid = Monoid;
+                        aggregate_type aggregate = Monoid::identity();
+                    };
+                    template <typename NodeData>
+                    static void update(NodeData *node_data, const NodeData *left_data, const NodeData *right_data)
+                    {
+                        node_data->aggregate = Monoid::combine(Monoid::combine(get_aggregate(left_data), aggregate_type(aggregate_operand(node_data->value))),
+                                                               get_aggregate(right_data));
+                        if constexpr (requires { OtherAugment::update(node_data, left_data, right_data); })
+                        {
+                            OtherAugment::update(node_data, left_data, right_data);
+                        }
+                    }
+                    static aggregate_type get_aggregate(const Data *node_data) { return node_data ? node_data->aggregate : Monoid::identity(); }
+                    static constexpr bool require_path_update = true;
+                    static constexpr bool subtree_size_implemented = OtherAugment::subtree_size_implemented;
+                };
                 // BST的节点，继承自基础二叉树节点，并应用了“增强策略”。
                 // AugmentPolicy: 这是一个策略模式的应用，允许我们“注入”额外的数据和行为到节点中。
                 template <typename T, typename NodeType, typename AugmentPolicy = DefaultNodeAugmentation>
@@ -67,6 +154,59 @@ namespace DSA
                     using BinarySearchTreeNodeLinked<T, BinarySearchTreeNodeLinkedBasic<T, AugmentPolicy>, AugmentPolicy>::BinarySearchTreeNodeLinked;
                 };
 
+                /**
+                 * @brief 节点句柄：独占一个从树中摘下的节点（extract 的结果），可以不分配、不拷贝值地插回同类型的树。
+                 * 节点由 BinaryTreeLinked 默认的 createNodeInternal 用 new 创建，句柄析构时用 delete 释放仍持有的节点。
+                 */
+                template <typename NodeType>
+                class BinarySearchTreeNodeHandle
+                {
+                public:
+                    using value_type = typename NodeType::value_type;
+
+                    constexpr BinarySearchTreeNodeHandle() = default;
+                    BinarySearchTreeNodeHandle(BinarySearchTreeNodeHandle &&other) noexcept : node(std::exchange(other.node, nullptr)) {}
+                    BinarySearchTreeNodeHandle &operator=(BinarySearchTreeNodeHandle &&other) noexcept
+                    {
+                        if (this != &other)
+                        {
+                            reset();
+                            node = std::exchange(other.node, nullptr);
+                        }
+                        return *this;
+                    }
+                    ~BinarySearchTreeNodeHandle() { reset(); }
+
+                    bool empty() const { return node == nullptr; }
+                    explicit operator bool() const { return node != nullptr; }
+                    value_type &value() const { return node->value; }
+                    // map 类的 pair 值：节点脱离树时允许修改键，再插回时按新键定位
+                    auto &key() const
+                        requires requires(value_type &v) { v.first; }
+                    {
+                        return const_cast<std::remove_const_t<typename value_type::first_type> &>(node->value.first);
+                    }
+                    auto &mapped() const
+                        requires requires(value_type &v) { v.second; }
+                    {
+                        return node->value.second;
+                    }
+                    void swap(BinarySearchTreeNodeHandle &other) noexcept { std::swap(node, other.node); }
+                    friend void swap(BinarySearchTreeNodeHandle &x, BinarySearchTreeNodeHandle &y) noexcept { x.swap(y); }
+
+                private:
+                    NodeType *node = nullptr;
+                    explicit BinarySearchTreeNodeHandle(NodeType *p) : node(p) {}
+                    NodeType *release() { return std::exchange(node, nullptr); }
+                    void reset()
+                    {
+                        delete node;
+                        node = nullptr;
+                    }
+                    template <typename, typename, typename, typename, typename, typename>
+                    friend struct BinarySearchTreeLinked;
+                };
+
                 // KeyOfValue: 一个函数对象，用于从值类型T中提取出键类型KeyT。
                 // 例如，对于std::map<Key, Value>，T是std::pair<const Key, Value>，KeyOfValue会提取出其中的Key。
                 // 对于std::set<Key>，T就是Key，KeyOfValue直接返回自身即可（通过IdentityKeyOfValue实现）。
@@ -98,6 +238,14 @@ namespace DSA
                     using difference_type = Base::difference_type;
                     using Node = typename Base::Node;
                     using CNode = const Node;
+                    using node_type = BinarySearchTreeNodeHandle<NodeType>;
+                    // insert(node_type&&) 的返回值：插入失败时 node 把节点原样交还给调用者
+                    struct insert_return_type
+                    {
+                        iterator position;
+                        bool inserted;
+                        node_type node;
+                    };
                     using BinaryTreeLinked<T, NodeType>::BinaryTreeLinked;
                     explicit BinarySearchTreeLinked(const Compare &cmp = Compare{}) : BinaryTreeLinked<T, NodeType>(), comp(cmp), size_r(0) {}
 
@@ -170,12 +318,32 @@ namespace DSA
                         return const_iterator{upper_bound_pointer(k)};
                     }
                     // 插入唯一键。返回一个pair，包含指向元素或已存在元素的迭代器，以及一个指示插入是否成功的bool值。
-                    // 这与std::map::insert的行为一致。
+                    // 这与std::map::insert的行为一致。键已存在时不会构造新节点。
                     std::pair<iterator, bool> insert_unique(const T &v)
                     {
                         std::pair<Node *, bool> res = insert_unique_pointer(v);
                         return {iterator{res.first}, res.second};
                     }
+                    // 右值版本：值被移动进新节点，键已存在时 v 保持不变。
+                    std::pair<iterator, bool> insert_unique(T &&v)
+                    {
+                        std::pair<Node *, bool> res = insert_unique_pointer(std::move(v));
+                        return {iterator{res.first}, res.second};
+                    }
+                    // 用实参在新节点中原地构造值，再按其键插入；键已存在时新节点被销毁。
+                    template <typename... Args>
+                    std::pair<iterator, bool> emplace_unique(Args &&...args)
+                    {
+                        std::pair<Node *, bool> res = emplace_unique_pointer(std::forward<Args>(args)...);
+                        return {iterator{res.first}, res.second};
+                    }
+                    // 先按键k查找，只有k不存在时才用实参原地构造值（实参构造出的值的键必须等价于k）。
+                    template <typename... Args>
+                    std::pair<iterator, bool> try_emplace_unique(const key_type &k, Args &&...args)
+                    {
+                        std::pair<Node *, bool> res = try_emplace_unique_pointer(k, std::forward<Args>(args)...);
+                        return {iterator{res.first}, res.second};
+                    }
 
                     // 插入可重复键。总是插入新元素，并返回指向新元素的迭代器。
                     // 这与std::multimap::insert的行为一致。
@@ -183,13 +351,82 @@ namespace DSA
                     {
                         return iterator{insert_multi_pointer(v)};
                     }
+                    iterator insert_multi(T &&v)
+                    {
+                        return iterator{emplace_multi_pointer(std::move(v))};
+                    }
+                    template <typename... Args>
+                    iterator emplace_multi(Args &&...args)
+                    {
+                        return iterator{emplace_multi_pointer(std::forward<Args>(args)...)};
+                    }
                     iterator erase(const_iterator iter)
                     {
-                        if (iter == this->end_ptr())
-                            return this->end_ptr();
                         Node *p = this->getNode(iter);
+                        if (p == this->end_ptr())
+                            return this->end();
                         return iterator{erase_pointer(p)};
                     }
+                    // 把 pos 指向的节点从树中摘下（不释放、不拷贝），交给节点句柄
+                    node_type extract(const_iterator pos)
+                    {
+                        Node *p = this->getNode(pos);
+                        return p == this->end_ptr() ? node_type{} : node_type{extract_pointer(p)};
+                    }
+                    node_type extract_unique(const key_type &k)
+                    {
+                        Node *p = find_pointer(k);
+                        return p == this->end_ptr() ? node_type{} : node_type{extract_pointer(p)};
+                    }
+                    // 摘下第一个键等价于k的节点
+                    node_type extract_multi(const key_type &k)
+                    {
+                        Node *p = lower_bound_pointer(k);
+                        if (p == this->end_ptr() || comp(k, skey(p)))
+                            return node_type{};
+                        return node_type{extract_pointer(p)};
+                    }
+                    // 把句柄中的节点直接链接进树，不分配内存；键已存在时节点留在返回值的 node 中
+                    insert_return_type insert_unique(node_type &&nh)
+                    {
+                        if (nh.empty())
+                            return {this->end(), false, node_type{}};
+                        InsertPosition pos = insert_unique_position(skey(nh.node));
+                        if (pos.exists)
+                            return {iterator{pos.p}, false, std::move(nh)};
+                        return {iterator{link_new_node(pos, reuse_node(nh.release()))}, true, node_type{}};
+                    }
+                    iterator insert_multi(node_type &&nh)
+                    {
+                        if (nh.empty())
+                            return this->end();
+                        Node *node = nh.release();
+                        return iterator{link_new_node(insert_multi_position(skey(node)), reuse_node(node))};
+                    }
+                    // 把other中键在本树中不存在的节点逐个摘下并链接进本树，不分配、不拷贝；重复键的节点留在other中
+                    void merge_unique(BinarySearchTreeLinked &other)
+                    {
+                        if (this == &other)
+                            return;
+                        for (Node *p = other.begin_ptr(), *next; p != other.end_ptr(); p = next)
+                        {
+                            next = other.next(p);
+                            InsertPosition pos = insert_unique_position(skey(p));
+                            if (!pos.exists)
+                                link_new_node(pos, reuse_node(other.extract_pointer(p)));
+                        }
+                    }
+                    // 把other的全部节点转移到本树，等价键排在本树已有元素之后
+                    void merge_multi(BinarySearchTreeLinked &other)
+                    {
+                        if (this == &other)
+                            return;
+                        for (Node *p = other.begin_ptr(), *next; p != other.end_ptr(); p = next)
+                        {
+                            next = other.next(p);
+                            link_new_node(insert_multi_position(skey(p)), reuse_node(other.extract_pointer(p)));
+                        }
+                    }
                     // 返回一个迭代器对，表示键值为k的元素范围[first, last)。
                     size_type erase_unique(const key_type &k)
                     {
@@ -219,6 +456,59 @@ namespace DSA
                         std::pair<Node *, Node *> res = equal_range_multi_pointer(k);
                         return {const_iterator{res.first}, const_iterator{res.second}};
                     }
+                    // 顺序统计：要求增强策略维护子树大小（见SubtreeSizeAugment），复杂度均为O(logN)。
+                    // 键严格小于k的元素个数，即lower_bound(k)的下标。
+                    size_type rank(const key_type &k) const
+                        requires AugmentPolicy::subtree_size_implemented
+                    {
+                        return rank_pointer(k, false);
+                    }
+                    // 中序第i个（从0开始）元素，i越界时返回end()。
+                    iterator select(size_type i)
+                        requires AugmentPolicy::subtree_size_implemented
+                    {
+                        return iterator{select_pointer(i)};
+                    }
+                    const_iterator select(size_type i) const
+                        requires AugmentPolicy::subtree_size_implemented
+                    {
+                        return const_iterator{select_pointer(i)};
+                    }
+                    // 迭代器的中序下标，end()的下标为size()。
+                    size_type index_of(const_iterator pos) const
+                        requires AugmentPolicy::subtree_size_implemented
+                    {
+                        return index_pointer(this->getNode(pos));
+                    }
+                    difference_type distance(const_iterator first, const_iterator last) const
+                        requires AugmentPolicy::subtree_size_implemented
+                    {
+                        return difference_type(index_of(last)) - difference_type(index_of(first));
+                    }
+                    // 区间聚合：要求节点携带SubtreeAggregateAugment，返回键在[lo, hi)中的元素按中序合并的结果，复杂度O(logN)。
+                    auto aggregate(const key_type &lo, const key_type &hi) const
+                        requires requires { typename NodeType::aggregate_monoid; }
+                    {
+                        return aggregate_pointer(lo, hi);
+                    }
+                    // 通过迭代器修改了参与聚合的值之后，需要调用此函数重新计算从该节点到根的增强数据。
+                    void refresh(const_iterator pos)
+                    {
+                        Node *p = this->getNode(pos);
+                        if (p != this->end_ptr())
+                            may_update_path(p);
+                    }
+                    // 用区间[first, last)替换全部内容：先为每个元素构造节点，检测是否已按键有序，无序时用归并排序（稳定）排序节点指针，
+                    // 再自底向上建成完全平衡的树。有序输入O(N)，否则O(NlogN)；unique版本在等价键中保留先出现的元素，与逐个插入的结果一致。
+                    template <typename InputIt>
+                    void assign_unique(InputIt first, InputIt last) { assign_range(first, last, true, false); }
+                    template <typename InputIt>
+                    void assign_multi(InputIt first, InputIt last) { assign_range(first, last, false, false); }
+                    // 同上，但由调用者保证输入已按键有序，不再检测，O(N)
+                    template <typename InputIt>
+                    void assign_sorted_unique(InputIt first, InputIt last) { assign_range(first, last, true, true); }
+                    template <typename InputIt>
+                    void assign_sorted_multi(InputIt first, InputIt last) { assign_range(first, last, false, true); }
                     Compare &comparer() { return comp; }
                     const Compare &comparer() const { return comp; }
 
@@ -342,27 +632,123 @@ namespace DSA
                     {
                         if (this->empty())
                             return 0;
+                        // 如果节点增强策略实现了子树大小统计，用两次rank相减，复杂度为O(logN)。
+                        if constexpr (AugmentPolicy::subtree_size_implemented)
+                        {
+                            return rank_pointer(k, true) - rank_pointer(k, false);
+                        }
+                        else
+                        {
+                            // 默认实现：计算equal_range返回的范围内的元素个数。复杂度为O(logN + count)。
+                            auto rg = equal_range_multi_pointer(k);
+                            return std::distance(iterator{rg.first}, iterator{rg.second});
+                        }
+                    }
+                    // 以下顺序统计的指针实现只在增强策略维护子树大小时才会被实例化。
+                    static size_type subtree_size(const Node *p) { return p ? p->subtree_size : 0; }
+                    // 键小于k（inclusive为真时为不大于k）的元素个数：沿查找路径累加走向右子树时跳过的左子树与节点本身。
+                    size_type rank_pointer(const key_type &k, bool inclusive) const
+                    {
+                        size_type res = 0;
+                        Node *node = this->root();
+                        while (node)
+                        {
+                            if (inclusive ? !comp(k, skey(node)) : comp(skey(node), k))
+                            {
+                                res += subtree_size(node->left()) + 1;
+                                node = node->right();
+                            }
+                            else
+                                node = node->left();
+                        }
+                        return res;
+                    }
+                    Node *select_pointer(size_type i) const
+                    {
+                        if (i >= size_r)
+                            return this->end_ptr();
                         Node *node = this->root();
-                        //     // 如果节点增强策略实现了子树大小统计，这里可以有一个O(logN)的实现。
-                        // if constexpr ((AugmentPolicy::subtree_size_implemented) && (requires { node.size; }))
-                        // {
-                        //     size_type res=0;
-                        //     throw std::logic_error("fast count not implementd yet");
-                        // }
-                        // else
-                        // {
-                        // 默认实现：计算equal_range返回的范围内的元素个数。复杂度为O(logN + count)。
-                        auto rg = equal_range_multi_pointer(k);
-                        return std::distance(iterator{rg.first}, iterator{rg.second});
-                        // }
+                        while (true)
+                        {
+                            size_type left_size = subtree_size(node->left());
+                            if (i < left_size)
+                                node = node->left();
+                            else if (i == left_size)
+                                return node;
+                            else
+                            {
+                                i -= left_size + 1;
+                                node = node->right();
+                            }
+                        }
                     }
-                    virtual std::pair<Node *, bool> insert_unique_pointer(const T &v)
+                    // 先找到lo与hi查找路径分叉的节点，再分别沿左、右两条路径收集完整落在区间内的子树。
+                    // 不需要幺半群有逆元，因此max/min这类聚合同样适用。
+                    auto aggregate_pointer(const key_type &lo, const key_type &hi) const
                     {
-                        if (this->empty())
+                        using Monoid = typename NodeType::aggregate_monoid;
+                        using aggregate_type = typename Monoid::value_type;
+                        auto agg = [](const Node *p)
+                        { return p ? p->aggregate : Monoid::identity(); };
+                        auto self = [](const Node *p)
+                        { return aggregate_type(aggregate_operand(p->value)); };
+                        Node *split = this->root();
+                        while (split)
                         {
-                            return {insert_root(v), true};
+                            if (comp(skey(split), lo))
+                                split = split->right();
+                            else if (!comp(skey(split), hi))
+                                split = split->left();
+                            else
+                                break;
+                        }
+                        if (!split)
+                            return Monoid::identity();
+                        // 左路径上找到的部分总是位于之前收集的部分的左侧
+                        aggregate_type left = Monoid::identity(), right = Monoid::identity();
+                        for (Node *p = split->left(); p;)
+                        {
+                            if (comp(skey(p), lo))
+                                p = p->right();
+                            else
+                            {
+                                left = Monoid::combine(Monoid::combine(self(p), agg(p->right())), left);
+                                p = p->left();
+                            }
+                        }
+                        for (Node *p = split->right(); p;)
+                        {
+                            if (comp(skey(p), hi))
+                            {
+                                right = Monoid::combine(right, Monoid::combine(agg(p->left()), self(p)));
+                                p = p->right();
+                            }
+                            else
+                                p = p->left();
                         }
-                        const key_type &vk = skey(v);
+                        return Monoid::combine(Monoid::combine(left, self(split)), right);
+                    }
+                    // 从p向上走到根，每次从右侧上来时加上父节点及其左子树的大小。
+                    size_type index_pointer(Node *p) const
+                    {
+                        if (p == this->end_ptr())
+                            return size_r;
+                        size_type res = subtree_size(p->left());
+                        for (; p != this->root(); p = p->parent)
+                            if (p == p->parent->right())
+                                res += subtree_size(p->parent->left()) + 1;
+                        return res;
+                    }
+                    // 插入位置的查找结果：exists 为真时 p 就是已有的等价元素；
+                    // 否则新节点应挂在 p 的 insert_right 一侧，p 为空表示树为空、新节点成为根。
+                    struct InsertPosition
+                    {
+                        Node *p;
+                        bool insert_right;
+                        bool exists;
+                    };
+                    InsertPosition insert_unique_position(const key_type &vk) const
+                    {
                         Node *node = this->root(), *p = nullptr;
                         bool insert_right = true;
                         while (node)
@@ -374,22 +760,12 @@ namespace DSA
                             else if (this->comp(vk, pk))
                                 node = p->left();
                             else
-                                return {p, false};
+                                return {p, false, true};
                         }
-                        node = insert_to(insert_right, v, p);
-                        // 如果需要，向上更新路径上的增强数据
-                        may_update_path(node);
-                        // 为派生类（如红黑树）提供插入后的处理钩子（如重新平衡）
-                        insert_hook(node);
-                        return {node, true};
+                        return {p, insert_right, false};
                     }
-                    virtual Node *insert_multi_pointer(const T &v)
+                    InsertPosition insert_multi_position(const key_type &vk) const
                     {
-                        if (this->empty())
-                        {
-                            return insert_root(v);
-                        }
-                        const key_type &vk = skey(v);
                         Node *node = this->root(), *p = nullptr;
                         bool insert_right = true;
                         while (node)
@@ -404,52 +780,111 @@ namespace DSA
                             else
                                 node = p->left();
                         }
-                        node = insert_to(insert_right, v, p);
-                        // 如果需要，向上更新路径上的增强数据
-                        may_update_path(node);
-                        // 为派生类（如红黑树）提供插入后的处理钩子（如重新平衡）
-                        insert_hook(node);
-                        return node;
+                        return {p, insert_right, false};
                     }
-                    Node *insert_root(const T &v)
+                    virtual std::pair<Node *, bool> insert_unique_pointer(const T &v)
                     {
-                        size_r = 1;
-                        Node *p = this->createNodeInternal(v);
-                        this->solo_root(p);
-                        return p;
+                        return try_emplace_unique_pointer(skey(v), v);
                     }
-                    Node *insert_to(const bool insert_right, const T &v, Node *p)
+                    virtual std::pair<Node *, bool> insert_unique_pointer(T &&v)
+                    {
+                        // 键的引用只在查找阶段使用，之后才移动构造新节点
+                        return try_emplace_unique_pointer(skey(v), std::move(v));
+                    }
+                    template <typename... Args>
+                    std::pair<Node *, bool> try_emplace_unique_pointer(const key_type &k, Args &&...args)
+                    {
+                        InsertPosition pos = insert_unique_position(k);
+                        if (pos.exists)
+                            return {pos.p, false};
+                        return {link_new_node(pos, this->emplaceNodeInternal(std::forward<Args>(args)...)), true};
+                    }
+                    template <typename... Args>
+                    std::pair<Node *, bool> emplace_unique_pointer(Args &&...args)
+                    {
+                        // 实参恰好是一个值时，可以先查找再构造，重复键不必分配节点
+                        if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+                            return insert_unique_pointer(std::forward<Args>(args)...);
+                        else
+                        {
+                            Node *node = this->emplaceNodeInternal(std::forward<Args>(args)...);
+                            InsertPosition pos = insert_unique_position(skey(node));
+                            if (pos.exists)
+                            {
+                                this->destroyNodeInternal(node);
+                                return {pos.p, false};
+                            }
+                            return {link_new_node(pos, node), true};
+                        }
+                    }
+                    virtual Node *insert_multi_pointer(const T &v)
+                    {
+                        return emplace_multi_pointer(v);
+                    }
+                    template <typename... Args>
+                    Node *emplace_multi_pointer(Args &&...args)
+                    {
+                        Node *node = this->emplaceNodeInternal(std::forward<Args>(args)...);
+                        return link_new_node(insert_multi_position(skey(node)), node);
+                    }
+                    // 把已构造好的新节点挂到 pos 指定的位置，维护缓存的leftmost/rightmost与增强数据，并调用插入钩子
+                    Node *link_new_node(const InsertPosition &pos, Node *node)
                     {
                         ++size_r;
-                        Node *node = this->createNodeInternal(v);
-                        this->link_to(insert_right, node, p);
+                        if (!pos.p)
+                        {
+                            this->solo_root(node);
+                            // 单节点的增强数据（如子树聚合）同样需要由自身的值算出
+                            may_update_path(node);
+                            return node;
+                        }
+                        this->link_to(pos.insert_right, node, pos.p);
                         // 插入后，需要检查并更新缓存的leftmost和rightmost指针
-                        if (insert_right)
+                        if (pos.insert_right)
                         {
-                            if (p == this->rightmost())
+                            if (pos.p == this->rightmost())
                                 this->rightmost() = node;
                         }
                         else
                         {
-                            if (p == this->leftmost())
+                            if (pos.p == this->leftmost())
                                 this->leftmost() = node;
                         }
+                        // 如果需要，向上更新路径上的增强数据
+                        may_update_path(node);
+                        // 为派生类（如红黑树）提供插入后的处理钩子（如重新平衡）
+                        insert_hook(node);
                         return node;
                     }
                     Node *erase_pointer(Node *p)
                     {
                         if (!p || p == this->end_ptr())
                             return this->end_ptr();
+                        // 返回指向被删除元素下一个元素的指针
+                        Node *np = this->next(p);
+                        // 摘下节点后释放节点内存
+                        this->destroyNodeInternal(extract_pointer(p));
+                        return np;
+                    }
+                    // 把节点p从树中摘下但不释放：拓扑删除、更新路径、删除钩子（再平衡）之后，清空p的指针
+                    Node *extract_pointer(Node *p)
+                    {
                         // 核心删除逻辑在tree_remove中，它负责处理拓扑关系
-                        Node *np = tree_remove(p);
+                        tree_remove(p);
                         // 向上更新路径
                         may_update_path(p->parent);
                         // 为派生类提供删除后的处理钩子
                         erase_hook(p);
-                        // 释放节点内存
-                        this->destroyNodeInternal(p);
-                        // 返回指向被删除元素下一个元素的指针
-                        return np;
+                        // tree_remove在p的指针中留下的删除上下文已经用完
+                        p->parent = p->children[0] = p->children[1] = nullptr;
+                        return p;
+                    }
+                    // 摘下的节点重新链接前恢复为新建节点的状态：增强数据清零，再经过派生树的初始化钩子
+                    Node *reuse_node(Node *p)
+                    {
+                        using AugmentData = AugmentPolicy::Data;
+                        static_cast<AugmentData &>(*p) = AugmentData{};
+                        return this->initNodeInternal(p);
                     }
                     size_type erase_unique_pointer(const key_type &k)
                     {
@@ -543,65 +978,84 @@ namespace DSA
                         // 返回p的后继者，作为erase的返回值。
                         return res;
                     }
-                    // 左旋操作。
-                    void rotate_left(Node *node)
+                    // 旋转的链接部分由 BinaryTree::detail::rotate 完成（侵入式红黑树共用），这里只负责更新增强数据。
+                    // to_right 为真时右旋，否则左旋。
+                    void rotate(Node *node, const bool to_right)
                     {
-                        Node *nparent = node->parent;
-                        Node *nright = node->right();
-                        bool link_right;
-                        // 步骤1: nright的左孩子成为node的右孩子
-                        this->link_to(link_right = true, nright->left(), node);
-                        // 步骤2: node成为nright的左孩子
-                        this->link_to(link_right = false, node, nright);
-                        // 步骤3: nright取代node的位置
-                        if (node == this->root())
-                        {
-                            this->link_root(nright);
-                        }
-                        else
-                        {
-                            link_right = (node == nparent->right());
-                            this->link_to(link_right, nright, nparent);
-                        }
-                        // 步骤4: 如果有增强数据，更新受影响的节点（先node后nright）
+                        Node *child = BinaryTree::detail::rotate(this->end_ptr(), node, to_right);
+                        // 如果有增强数据，更新受影响的节点（先node后上升的child）
                         if constexpr (requires { AugmentPolicy::update(node, node->left(), node->right()); })
                         {
                             AugmentPolicy::update(node, node->left(), node->right());
-                            AugmentPolicy::update(nright, nright->left(), nright->right());
+                            AugmentPolicy::update(child, child->left(), child->right());
                         }
                     }
-                    
-                    // 右旋操作。
-                    void rotate_right(Node *node)
+                    void rotate_left(Node *node) { rotate(node, false); }
+                    void rotate_right(Node *node) { rotate(node, true); }
+                    // 批量建树钩子函数。基类中为空。派生类（如红黑树）可以重写此函数，按节点深度直接设定平衡信息。
+                    // depth为节点的深度（根为0），max_depth为最深节点的深度；除最深一层外各层都是满的。
+                    virtual void build_hook(Node * /*p*/, size_type /*depth*/, size_type /*max_depth*/) {}
+                    template <typename InputIt>
+                    void assign_range(InputIt first, InputIt last, bool unique, bool sorted)
                     {
-                        Node *nparent = node->parent;
-                        Node *nleft = node->left();
-                        bool link_right;
-                        // 步骤1: nleft的右孩子成为node的左孩子
-                        this->link_to(link_right = false, nleft->right(), node);
-                        // 步骤2: node成为nleft的右孩子
-                        this->link_to(link_right = true, node, nleft);
-                        // 步骤3: nleft取代node的位置
-                        if (node == this->root())
+                        std::vector<Node *> nodes;
+                        auto node_less = [this](Node *a, Node *b)
+                        { return comp(skey(a), skey(b)); };
+                        // 节点全部建好之后才清空原来的树：构造失败时原树不变，输入区间也可以来自本树
+                        try
                         {
-                            this->link_root(nleft);
+                            for (; first != last; ++first)
+                            {
+                                nodes.push_back(nullptr);
+                                nodes.back() = this->emplaceNodeInternal(*first);
+                            }
+                            if (!sorted && !std::is_sorted(nodes.begin(), nodes.end(), node_less))
+                                Sorting::MergeSort(nodes.begin(), nodes.end(), node_less);
                         }
-                        else
+                        catch (...)
                         {
-                            link_right = (node == nparent->right());
-                            this->link_to(link_right, nleft, nparent);
+                            for (Node *p : nodes)
+                                if (p)
+                                    this->destroyNodeInternal(p);
+                            throw;
                         }
-
-                        // 步骤4: 如果有增强数据，更新受影响的节点（先node后nleft）
-                        if constexpr (requires { AugmentPolicy::update(node, node->left(), node->right()); })
+                        if (unique)
                         {
-                            AugmentPolicy::update(node, node->left(), node->right());
-                            AugmentPolicy::update(nleft, nleft->left(), nleft->right());
+                            // 有序序列中等价键相邻，每段只保留第一个
+                            size_type k = 0;
+                            for (Node *p : nodes)
+                            {
+                                if (k && !comp(skey(nodes[k - 1]), skey(p)))
+                                    this->destroyNodeInternal(p);
+                                else
+                                    nodes[k++] = p;
+                            }
+                            nodes.resize(k);
                         }
+                        clear();
+                        size_r = nodes.size();
+                        if (nodes.empty())
+                            return;
+                        this->root() = build_balanced(nodes, 0, nodes.size(), this->end_ptr(), 0, std::bit_width(nodes.size()) - 1);
+                        this->leftmost() = nodes.front();
+                        this->rightmost() = nodes.back();
                     }
-                    void rotate(Node *node, const bool to_right)
+                    // 以中点为根递归建左右子树，左右子树大小至多差1；孩子建好后计算增强数据（高度、子树大小、聚合值等）
+                    Node *build_balanced(const std::vector<Node *> &nodes, size_type lo, size_type hi, Node *parent, size_type depth, size_type max_depth)
                     {
-                        return to_right ? rotate_right(node) : rotate_left(node);
+                        if (lo == hi)
+                            return nullptr;
+                        size_type mid = lo + (hi - lo) / 2;
+                        Node *p = nodes[mid];
+                        p->parent = parent;
+                        p->left() = build_balanced(nodes, lo, mid, p, depth + 1, max_depth);
+                        p->right() = build_balanced(nodes, mid + 1, hi, p, depth + 1, max_depth);
+                        if constexpr (requires { AugmentPolicy::update(p, p->left(), p->right()); })
+                        {
+                            AugmentPolicy::update(p, p->left(), p->right());
+                        }
+                        build_hook(p, depth, max_depth);
+                        return p;
                     }
                     // 插入钩子函数。基类中为空。派生类（如红黑树）可以重写此函数，在插入后进行再平衡。
                     virtual void insert_hook(Node *p) {}
@@ -622,6 +1076,11 @@ namespace DSA
                             return false;
                         if (!check_multi(node->right(), node, limr))
                             return false;
+                        if constexpr (AugmentPolicy::subtree_size_implemented)
+                        {
+                            if (subtree_size(node) != subtree_size(node->left()) + subtree_size(node->right()) + 1)
+                                return false;
+                        }
                         return true;
                     }
                     // 递归检查函数，用于验证树是否满足唯一键的BST性质。
@@ -637,6 +1096,11 @@ namespace DSA
                             return false;
                         if (!check_unique(node->right(), node, limr))
                             return false;
+                        if constexpr (AugmentPolicy::subtree_size_implemented)
+                        {
+                            if (subtree_size(node) != subtree_size(node->left()) + subtree_size(node->right()) + 1)
+                                return false;
+                        }
                         return true;
                     }
                     BinarySearchTreeLinked *clone_unsafe() const override
@@ -0,0 +1,527 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "RB_balanced_tree.hpp"
+namespace DSA
+{
+    namespace Tree
+    {
+        namespace BinaryTree
+        {
+            namespace BinarySearchTree
+            {
+                namespace RBTree
+                {
+                    /**
+                     * @brief 侵入式红黑树的挂钩：嵌入在用户对象中（作为基类），树直接链接对象本身，不分配节点也不拷贝对象。
+                     *
+                     * 同一个对象要同时挂在多棵树（或同时挂在链表上）时，为每个容器使用不同的 Tag 继承多个挂钩。
+                     * 拷贝对象不会拷贝挂接状态，新对象总是未挂接的。
+                     */
+                    template <typename Tag = void>
+                    struct RBTreeHook
+                    {
+                        RBTreeHook *parent = nullptr;
+                        RBTreeHook *children[2] = {nullptr, nullptr};
+                        RBTreeColor color = BLACK;
+
+                        RBTreeHook() = default;
+                        RBTreeHook(const RBTreeHook &) {}
+                        RBTreeHook &operator=(const RBTreeHook &) { return *this; }
+
+                        RBTreeHook *&left() { return children[0]; }
+                        RBTreeHook *&right() { return children[1]; }
+                        RBTreeHook *left() const { return children[0]; }
+                        RBTreeHook *right() const { return children[1]; }
+                        // 挂在树上的节点 parent 总是非空（根的 parent 是哨兵头节点）
+                        bool is_linked() const { return parent != nullptr; }
+                    };
+                    // 供 BinaryTree::detail::swap_topology 使用：交换挂钩的拓扑信息与颜色
+                    template <typename Tag>
+                    void swap_node(RBTreeHook<Tag> &x, RBTreeHook<Tag> &y)
+                    {
+                        std::swap(x.parent, y.parent);
+                        std::swap(x.children, y.children);
+                        std::swap(x.color, y.color);
+                    }
+
+                    template <typename T, typename KeyT, typename Compare, typename KeyOfValue, typename Tag>
+                    struct IntrusiveRBTree;
+
+                    namespace detail
+                    {
+                        template <typename T, typename Tag, bool IsConst>
+                        class IntrusiveRBTreeIterator
+                        {
+                        public:
+                            using value_type = T;
+                            using reference = std::conditional_t<IsConst, const T &, T &>;
+                            using pointer = std::conditional_t<IsConst, const T *, T *>;
+                            using difference_type = std::ptrdiff_t;
+                            using iterator_category = std::bidirectional_iterator_tag;
+                            using Hook = RBTreeHook<Tag>;
+
+                            IntrusiveRBTreeIterator() = default;
+                            explicit IntrusiveRBTreeIterator(const Hook *h) : hook_ptr_(const_cast<Hook *>(h)) {}
+                            // 允许从可变迭代器构造常量迭代器
+                            template <bool FromConst = IsConst>
+                                requires FromConst
+                            IntrusiveRBTreeIterator(const IntrusiveRBTreeIterator<T, Tag, false> &other) : hook_ptr_(other.hook_ptr_)
+                            {
+                            }
+
+                            reference operator*() const { return *static_cast<T *>(hook_ptr_); }
+                            pointer operator->() const { return static_cast<T *>(hook_ptr_); }
+
+                            IntrusiveRBTreeIterator &operator++()
+                            {
+                                hook_ptr_ = BinaryTree::detail::successor(hook_ptr_);
+                                return *this;
+                            }
+                            IntrusiveRBTreeIterator operator++(int)
+                            {
+                                auto tmp = *this;
+                                ++(*this);
+                                return tmp;
+                            }
+                            IntrusiveRBTreeIterator &operator--()
+                            {
+                                hook_ptr_ = BinaryTree::detail::predecessor(hook_ptr_);
+                                return *this;
+                            }
+                            IntrusiveRBTreeIterator operator--(int)
+                            {
+                                auto tmp = *this;
+                                --(*this);
+                                return tmp;
+                            }
+
+                            bool operator==(const IntrusiveRBTreeIterator &other) const { return hook_ptr_ == other.hook_ptr_; }
+                            bool operator!=(const IntrusiveRBTreeIterator &other) const { return !(*this == other); }
+
+                        protected:
+                            Hook *hook_ptr_ = nullptr;
+                            friend IntrusiveRBTreeIterator<T, Tag, true>;
+                            template <typename, typename, typename, typename, typename>
+                            friend struct RBTree::IntrusiveRBTree;
+                        };
+                    }
+
+                    /**
+                     * @brief 侵入式红黑树：T 必须继承 RBTreeHook<Tag>，树只负责链接与再平衡，不拥有、不分配也不析构元素。
+                     *
+                     * 接口与 RBTreeLinked 保持一致（insert_unique/insert_multi/find/lower_bound/...），插入的参数是对象的引用。
+                     * - 元素地址在整个生命周期内不变，插入没有内存分配；
+                     * - 通过对象本身即可定位：iterator_to(obj) 是 O(1)，erase(obj) 省掉了按键查找，只剩 O(log n) 的再平衡；
+                     * - 挂在树上时不得修改对象的键；元素在析构前必须先从树中移除，树析构或 clear() 时会把所有元素恢复为未挂接状态。
+                     *
+                     * 再平衡算法与 RBTreeLinked 相同：插入处理“红-红”冲突，删除时先与后继交换拓扑位置（而不是交换值），再修复黑高。
+                     */
+                    template <typename T, typename KeyT = T, typename Compare = std::less<KeyT>, typename KeyOfValue = IdentityKeyOfValue<T>, typename Tag = void>
+                    struct IntrusiveRBTree
+                    {
+                        using Hook = RBTreeHook<Tag>;
+                        static_assert(std::is_base_of_v<Hook, T>, "T must inherit RBTreeHook<Tag>");
+                        static_assert(
+                            std::is_same<const KeyT &, std::invoke_result_t<KeyOfValue, const T &>>::value,
+                            "KeyOfValue::operator()(Value) must return Key");
+
+                        using value_type = T;
+                        using key_type = KeyT;
+                        using reference = T &;
+                        using const_reference = const T &;
+                        using pointer = T *;
+                        using const_pointer = const T *;
+                        using iterator = detail::IntrusiveRBTreeIterator<T, Tag, false>;
+                        using const_iterator = detail::IntrusiveRBTreeIterator<T, Tag, true>;
+                        using size_type = size_t;
+                        using difference_type = std::ptrdiff_t;
+
+                        explicit IntrusiveRBTree(const Compare &cmp = Compare{}) : comp(cmp) { reset_header(); }
+                        IntrusiveRBTree(const IntrusiveRBTree &) = delete;
+                        IntrusiveRBTree &operator=(const IntrusiveRBTree &) = delete;
+                        IntrusiveRBTree(IntrusiveRBTree &&other) noexcept : comp(other.comp)
+                        {
+                            reset_header();
+                            swap(other);
+                        }
+                        IntrusiveRBTree &operator=(IntrusiveRBTree &&other) noexcept
+                        {
+                            if (this != &other)
+                            {
+                                clear();
+                                swap(other);
+                            }
+                            return *this;
+                        }
+                        ~IntrusiveRBTree() { clear(); }
+
+                        iterator begin() { return iterator(leftmost()); }
+                        const_iterator begin() const { return const_iterator(leftmost()); }
+                        const_iterator cbegin() const { return begin(); }
+                        iterator end() { return iterator(end_ptr()); }
+                        const_iterator end() const { return const_iterator(end_ptr()); }
+                        const_iterator cend() const { return end(); }
+
+                        size_type size() const { return size_r; }
+                        bool empty() const { return size_r == 0; }
+                        Compare &comparer() { return comp; }
+                        const Compare &comparer() const { return comp; }
+
+                        // 由对象本身得到指向它的迭代器，O(1)；对象必须挂在本树上
+                        static iterator iterator_to(reference obj) { return iterator(static_cast<Hook *>(&obj)); }
+                        static const_iterator iterator_to(const_reference obj) { return const_iterator(static_cast<const Hook *>(&obj)); }
+
+                        iterator find(const key_type &k) { return iterator(find_pointer(k)); }
+                        const_iterator find(const key_type &k) const { return const_iterator(find_pointer(k)); }
+                        iterator lower_bound(const key_type &k) { return iterator(lower_bound_pointer(k)); }
+                        const_iterator lower_bound(const key_type &k) const { return const_iterator(lower_bound_pointer(k)); }
+                        iterator upper_bound(const key_type &k) { return iterator(upper_bound_pointer(k)); }
+                        const_iterator upper_bound(const key_type &k) const { return const_iterator(upper_bound_pointer(k)); }
+                        std::pair<iterator, iterator> equal_range(const key_type &k)
+                        {
+                            return {lower_bound(k), upper_bound(k)};
+                        }
+                        std::pair<const_iterator, const_iterator> equal_range(const key_type &k) const
+                        {
+                            return {lower_bound(k), upper_bound(k)};
+                        }
+                        size_type count(const key_type &k) const
+                        {
+                            auto rg = equal_range(k);
+                            return size_type(std::distance(rg.first, rg.second));
+                        }
+
+                        // 插入唯一键。键已存在时不插入，返回指向已有元素的迭代器与false；obj 必须未挂接。
+                        std::pair<iterator, bool> insert_unique(reference obj)
+                        {
+                            const key_type &vk = skey(obj);
+                            Hook *node = root(), *p = end_ptr();
+                            bool insert_right = false;
+                            while (node)
+                            {
+                                p = node;
+                                const key_type &pk = skey(p);
+                                if ((insert_right = comp(pk, vk)))
+                                    node = p->right();
+                                else if (comp(vk, pk))
+                                    node = p->left();
+                                else
+                                    return {iterator(p), false};
+                            }
+                            return {iterator(insert_at(insert_right, static_cast<Hook *>(&obj), p)), true};
+                        }
+                        // 插入可重复键，等价的键插在已有键的右侧，保持插入顺序。
+                        iterator insert_multi(reference obj)
+                        {
+                            const key_type &vk = skey(obj);
+                            Hook *node = root(), *p = end_ptr();
+                            bool insert_right = false;
+                            while (node)
+                            {
+                                p = node;
+                                if ((insert_right = !comp(vk, skey(p))))
+                                    node = p->right();
+                                else
+                                    node = p->left();
+                            }
+                            return iterator(insert_at(insert_right, static_cast<Hook *>(&obj), p));
+                        }
+                        // 摘下 pos 指向的元素，返回其后继
+                        iterator erase(const_iterator pos)
+                        {
+                            if (pos == end())
+                                return end();
+                            return iterator(tree_remove(pos.hook_ptr_));
+                        }
+                        // 通过对象本身摘下，不需要按键查找
+                        iterator erase(reference obj) { return erase(iterator_to(obj)); }
+                        iterator erase(const_iterator first, const_iterator last)
+                        {
+                            while (first != last)
+                                first = erase(first);
+                            return iterator(last.hook_ptr_);
+                        }
+                        size_type erase_unique(const key_type &k)
+                        {
+                            Hook *p = find_pointer(k);
+                            if (p == end_ptr())
+                                return 0;
+                            tree_remove(p);
+                            return 1;
+                        }
+                        size_type erase_multi(const key_type &k)
+                        {
+                            size_type res = 0;
+                            for (auto rg = equal_range(k); rg.first != rg.second; ++res)
+                                rg.first = erase(rg.first);
+                            return res;
+                        }
+                        // 摘下后再对对象调用 disposer（例如 delete），用于树实际上管理着元素生命周期的场合
+                        template <typename Disposer>
+                        iterator erase_and_dispose(const_iterator pos, Disposer disposer)
+                        {
+                            T *obj = static_cast<T *>(pos.hook_ptr_);
+                            iterator res = erase(pos);
+                            disposer(obj);
+                            return res;
+                        }
+                        void clear()
+                        {
+                            clear_and_dispose([](T *) {});
+                        }
+                        // 整棵树一次性拆掉，不做再平衡；每个元素先恢复为未挂接状态，再交给 disposer
+                        template <typename Disposer>
+                        void clear_and_dispose(Disposer disposer)
+                        {
+                            dispose_recursive(root(), disposer);
+                            reset_header();
+                        }
+
+                        void swap(IntrusiveRBTree &other)
+                        {
+                            using std::swap;
+                            // 头节点嵌在容器里，交换后需要把根的 parent 重新指向新的头节点
+                            swap(header.parent, other.header.parent);
+                            swap(header.children, other.header.children);
+                            fix_header();
+                            other.fix_header();
+                            swap(size_r, other.size_r);
+                            swap(comp, other.comp);
+                        }
+                        friend void swap(IntrusiveRBTree &x, IntrusiveRBTree &y) { x.swap(y); }
+
+                        // 检查树是否满足唯一键/多重键的BST性质以及红黑树性质。用于调试。
+                        bool checker_unique() const { return check_rb() && check_order(true); }
+                        bool checker_multi() const { return check_rb() && check_order(false); }
+
+                    protected:
+                        Hook header; // 哨兵头节点，颜色为黑，充当根的黑色 parent
+                        size_type size_r = 0;
+                        Compare comp{};
+
+                        static const key_type &skey(const T &v) { return KeyOfValue{}(v); }
+                        static const key_type &skey(Hook *h) { return KeyOfValue{}(*static_cast<T *>(h)); }
+
+                        Hook *end_ptr() const { return const_cast<Hook *>(&header); }
+                        Hook *&root() { return header.left(); }
+                        Hook *root() const { return header.left(); }
+                        Hook *&leftmost() { return header.right(); }
+                        Hook *leftmost() const { return header.right(); }
+                        Hook *&rightmost() { return header.parent; }
+                        Hook *rightmost() const { return header.parent; }
+
+                        void reset_header()
+                        {
+                            header.color = BLACK;
+                            root() = nullptr;
+                            leftmost() = rightmost() = end_ptr();
+                            size_r = 0;
+                        }
+                        void fix_header()
+                        {
+                            if (root())
+                                root()->parent = end_ptr();
+                            else
+                                leftmost() = rightmost() = end_ptr();
+                        }
+
+                        static bool is_red(Hook *p) { return detail::is_red(p); }
+                        static bool is_black(Hook *p) { return detail::is_black(p); }
+                        static Hook *set_red(Hook *p) { return detail::set_red(p); }
+                        static Hook *set_black(Hook *p) { return detail::set_black(p); }
+                        static bool is_right(Hook *p) { return BinaryTree::detail::is_right(p); }
+                        static void link_to(const bool link_right, Hook *node, Hook *p) { BinaryTree::detail::link_to(link_right, node, p); }
+                        void link_root(Hook *p) { BinaryTree::detail::link_root(end_ptr(), p); }
+
+                        Hook *find_pointer(const key_type &k) const
+                        {
+                            Hook *p = root();
+                            while (p)
+                            {
+                                const key_type &pk = skey(p);
+                                if (comp(k, pk))
+                                    p = p->left();
+                                else if (comp(pk, k))
+                                    p = p->right();
+                                else
+                                    return p;
+                            }
+                            return end_ptr();
+                        }
+                        Hook *lower_bound_pointer(const key_type &k) const
+                        {
+                            Hook *node = root(), *res = end_ptr();
+                            while (node)
+                            {
+                                if (!comp(skey(node), k))
+                                    res = node, node = node->left();
+                                else
+                                    node = node->right();
+                            }
+                            return res;
+                        }
+                        Hook *upper_bound_pointer(const key_type &k) const
+                        {
+                            Hook *node = root(), *res = end_ptr();
+                            while (node)
+                            {
+                                if (comp(k, skey(node)))
+                                    res = node, node = node->left();
+                                else
+                                    node = node->right();
+                            }
+                            return res;
+                        }
+
+                        // 把 node 挂到 p 的一侧（p 为头节点时成为根），维护 leftmost/rightmost 后再平衡
+                        Hook *insert_at(bool insert_right, Hook *node, Hook *p)
+                        {
+                            ++size_r;
+                            node->children[0] = node->children[1] = nullptr;
+                            if (p == end_ptr())
+                            {
+                                link_root(node);
+                                leftmost() = rightmost() = node;
+                                set_black(node);
+                                return node;
+                            }
+                            link_to(insert_right, node, p);
+                            if (insert_right)
+                            {
+                                if (p == rightmost())
+                                    rightmost() = node;
+                            }
+                            else
+                            {
+                                if (p == leftmost())
+                                    leftmost() = node;
+                            }
+                            insert_rebalance(node);
+                            return node;
+                        }
+                        // 旋转、再平衡与拓扑交换都与 RBTreeLinked 共用同一份实现，只是作用在挂钩上
+                        void rotate(Hook *node, const bool to_right) { BinaryTree::detail::rotate(end_ptr(), node, to_right); }
+                        void insert_rebalance(Hook *node)
+                        {
+                            detail::insert_rebalance(end_ptr(), node, [this](Hook *p, bool to_right)
+                                                     { rotate(p, to_right); });
+                        }
+                        // parent 的 at_right 一侧黑高少 1
+                        void erase_rebalance(Hook *parent, bool at_right)
+                        {
+                            detail::erase_rebalance(end_ptr(), parent, at_right, [this](Hook *p, bool to_right)
+                                                    { rotate(p, to_right); });
+                        }
+                        // 交换两个节点在树中的拓扑位置（连同颜色），leftmost/rightmost 由 tree_remove 事先维护
+                        void tree_swap(Hook *x, Hook *y) { BinaryTree::detail::swap_topology(end_ptr(), x, y); }
+                        // 摘下 p 并再平衡，返回 p 的后继；p 恢复为未挂接状态
+                        Hook *tree_remove(Hook *p)
+                        {
+                            --size_r;
+                            Hook *res = BinaryTree::detail::successor(p);
+                            if (leftmost() == p && rightmost() == p)
+                            {
+                                reset_header();
+                                unhook(p);
+                                return res;
+                            }
+                            if (p == leftmost())
+                                leftmost() = res;
+                            if (p == rightmost())
+                                rightmost() = BinaryTree::detail::predecessor(p);
+                            // 有两个孩子时，先与后继交换拓扑位置，转化为最多一个孩子的情况
+                            if (p->left() && p->right())
+                                tree_swap(p, res);
+                            Hook *t = p->left() ? p->left() : p->right();
+                            Hook *parent = p->parent;
+                            bool at_right = false;
+                            if (p == root())
+                                link_root(t); // 只剩一个孩子时它一定是红色叶子
+                            else
+                                link_to(at_right = is_right(p), t, parent);
+                            // 删掉的是黑色节点时，parent 的 at_right 一侧黑高少 1
+                            if (is_black(p))
+                            {
+                                if (t == root())
+                                    set_black(t);
+                                else
+                                    erase_rebalance(parent, at_right);
+                            }
+                            unhook(p);
+                            return res;
+                        }
+                        static void unhook(Hook *p)
+                        {
+                            p->parent = p->children[0] = p->children[1] = nullptr;
+                            p->color = BLACK;
+                        }
+                        template <typename Disposer>
+                        static void dispose_recursive(Hook *p, Disposer &disposer)
+                        {
+                            if (!p)
+                                return;
+                            dispose_recursive(p->left(), disposer);
+                            dispose_recursive(p->right(), disposer);
+                            unhook(p);
+                            disposer(static_cast<T *>(p));
+                        }
+
+                        bool check_rb() const
+                        {
+                            if (!is_black(root()))
+                                return false;
+                            int bcnt = -1;
+                            std::function<bool(Hook *, int)> func;
+                            func = [&](Hook *p, int curb) -> bool
+                            {
+                                if (!p)
+                                {
+                                    if (bcnt == -1)
+                                        bcnt = curb;
+                                    return curb == bcnt;
+                                }
+                                if (is_red(p) && (!is_black(p->left()) || !is_black(p->right())))
+                                    return false;
+                                if (is_black(p))
+                                    ++curb;
+                                for (Hook *c : p->children)
+                                    if (c && c->parent != p)
+                                        return false;
+                                return func(p->left(), curb) && func(p->right(), curb);
+                            };
+                            return func(root(), 0);
+                        }
+                        // 中序遍历检查键的顺序，以及缓存的 leftmost/rightmost 与 size
+                        bool check_order(bool unique) const
+                        {
+                            if (!root())
+                                return size_r == 0 && leftmost() == end_ptr() && rightmost() == end_ptr();
+                            if (root()->parent != end_ptr())
+                                return false;
+                            Hook *lm = root(), *rm = root();
+                            while (lm->left())
+                                lm = lm->left();
+                            while (rm->right())
+                                rm = rm->right();
+                            if (lm != leftmost() || rm != rightmost())
+                                return false;
+                            size_type cnt = 0;
+                            for (auto it = begin(), prev = end(); it != end(); prev = it++, ++cnt)
+                            {
+                                if (prev == end())
+                                    continue;
+                                if (unique ? !comp(skey(*prev), skey(*it)) : comp(skey(*it), skey(*prev)))
+                                    return false;
+                            }
+                            return cnt == size_r;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
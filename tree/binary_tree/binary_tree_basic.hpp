@@ -2,6 +2,8 @@
 #include <type_traits>
 #include <functional>
 #include <queue>
+#include <utility>
+#include <concepts>
 #include "../../utils.hpp"
 namespace DSA
 {
@@ -36,6 +38,11 @@ namespace DSA
                         std::is_base_of<BinaryTreeNodeLinked<T, NodeType>, NodeType>::value,
                         "NodeType must inherit from BinaryTreeNodeLinked<T, NodeType>");
                 }
+                // 用任意实参原地构造 value，避免先构造临时对象再拷贝进节点
+                template <typename... Args>
+                explicit BinaryTreeNodeLinked(std::in_place_t, Args &&...args) : value(std::forward<Args>(args)...)
+                {
+                }
                 virtual ~BinaryTreeNodeLinked() = default;
             };
             // 一个辅助函数，仅交换两个节点的指针成员，用于 tree_swap 的内部实现。
@@ -56,6 +63,14 @@ namespace DSA
                 : std::is_base_of<BinaryTreeNodeLinked<T, NodeType>, NodeType>
             {
             };
+            // 只要求节点具有 parent / children / left() / right()，侵入式树的挂钩也满足，用于与拓扑相关的通用算法
+            template <typename NodeType>
+            concept binary_tree_links = requires(NodeType *p) {
+                { p->parent } -> std::convertible_to<NodeType *>;
+                { p->children[0] } -> std::convertible_to<NodeType *>;
+                { p->left() } -> std::convertible_to<NodeType *>;
+                { p->right() } -> std::convertible_to<NodeType *>;
+            };
             // 从指定节点开始，查找其所在子树的最左节点。
             template <typename NodeType>
             NodeType *binary_leftmost(NodeType *node)
@@ -77,6 +92,10 @@ namespace DSA
                 return node;
             }
 
+            // 迭代器把 node_ptr_ 开放给树本身（不是 detail 中的同名类）
+            template <typename T, typename NodeType>
+            struct BinaryTreeLinked;
+
             namespace detail
             {
                 // 查找一个节点在中序遍历中的后继节点。
@@ -85,8 +104,8 @@ namespace DSA
                 template <typename NodeType>
                 NodeType *successor(NodeType *node)
                 {
-                    static_assert(is_binary_tree_node_linked<NodeType>::value,
-                                  "successor() only accepts NodeType inheriting BinaryTreeNodeLinked");
+                    static_assert(binary_tree_links<NodeType>,
+                                  "successor() only accepts NodeType with parent/children/left()/right()");
                     // below is for header->left()==root(),header->right()==leftmost(),header->parent==rightmost(),root()->parent==header
                     // 规则1: 如果节点有右子树，其后继是右子树中的最左节点。
                     if (node->right())
@@ -119,8 +138,8 @@ namespace DSA
                 template <typename NodeType>
                 NodeType *predecessor(NodeType *node)
                 {
-                    static_assert(is_binary_tree_node_linked<NodeType>::value,
-                                  "predecessor() only accepts NodeType inheriting BinaryTreeNodeLinked");
+                    static_assert(binary_tree_links<NodeType>,
+                                  "predecessor() only accepts NodeType with parent/children/left()/right()");
                     // If 'node' is the header, its predecessor is the maximum element.
                     // 规则1: 如果节点有左子树，其前驱是左子树中的最右节点。
                     // 特殊情况: 如果 node 是 header (end()迭代器)，它的左子树是 root，
@@ -146,8 +165,93 @@ namespace DSA
                     return p;
                 }
 
-                template <typename T, typename NodeType>
-                struct BinaryTreeLinked;
+                // 以下拓扑操作只依赖 parent / children 成员与同样的哨兵设计，
+                // BinaryTreeLinked 的节点和侵入式树的挂钩（如 RBTree::RBTreeHook）共用同一份实现。
+                template <typename NodeType>
+                bool is_right(NodeType *p)
+                {
+                    return p == p->parent->right();
+                }
+                template <typename NodeType>
+                void link_to(const bool link_right, NodeType *node, NodeType *p)
+                {
+                    node && (node->parent = p);
+                    p->children[link_right] = node;
+                }
+                template <typename NodeType>
+                void link_root(NodeType *header, NodeType *p)
+                {
+                    header->left() = p;
+                    p->parent = header;
+                }
+                // to_right 为真时右旋（左孩子上升），否则左旋（右孩子上升）；返回上升的孩子
+                template <typename NodeType>
+                NodeType *rotate(NodeType *header, NodeType *node, const bool to_right)
+                {
+                    const bool up = !to_right; // 上升的孩子所在的一侧
+                    NodeType *nparent = node->parent;
+                    NodeType *child = node->children[up];
+                    // 步骤1: child 靠近 node 一侧的子树过继给 node
+                    link_to(up, child->children[to_right], node);
+                    // 步骤2: child 取代 node 的位置（node 是根时 nparent 为 header，不能用 is_right 判断）
+                    if (nparent == header)
+                        link_root(header, child);
+                    else
+                        link_to(node == nparent->right(), child, nparent);
+                    // 步骤3: node 成为 child 的孩子
+                    link_to(to_right, node, child);
+                    return child;
+                }
+                /*
+                    to keep iterator consistent, instead of swapping the node value, we swap the tree info
+                */
+                // 交换两个节点在树中的拓扑位置，而不是交换它们的值，这样指向它们的迭代器不会失效。
+                // 节点上的附加信息（颜色、高度等）由 swap_node 一并交换，派生节点类型重载 swap_node 即可；
+                // 缓存在 header 中的 leftmost/rightmost 由调用者维护。
+                template <typename NodeType>
+                void swap_topology(NodeType *header, NodeType *x, NodeType *y)
+                {
+                    if (x == y)
+                        return;
+                    bool xright = is_right(x);
+                    bool yright = is_right(y);
+                    // case 1: x 和 y 是直接亲子关系，swap_node 会导致临时的自引用，紧接着修复
+                    if (x->parent == y)
+                    {
+                        swap_node(*x, *y);
+                        y->parent = x;
+                        x->children[xright] = y;
+                    }
+                    else if (y->parent == x)
+                    {
+                        swap_node(*x, *y);
+                        x->parent = y;
+                        y->children[yright] = x;
+                    }
+                    else // case 2: x 和 y 没有直接的亲子关系
+                        swap_node(*x, *y);
+                    // 更新 parent 和 x,y 的关系
+                    if (header->left() == x)
+                    {
+                        link_root(header, y);
+                        link_to(yright, x, x->parent);
+                    }
+                    else if (header->left() == y)
+                    {
+                        link_root(header, x);
+                        link_to(xright, y, y->parent);
+                    }
+                    else
+                    {
+                        link_to(yright, x, x->parent);
+                        link_to(xright, y, y->parent);
+                    }
+                    // 更新 x,y 和子节点的的关系
+                    link_to(false, x->left(), x);
+                    link_to(true, x->right(), x);
+                    link_to(false, y->left(), y);
+                    link_to(true, y->right(), y);
+                }
 
                 template <typename T, typename NodeType>
                 class ConstInOrderIterator;
@@ -319,7 +423,8 @@ namespace DSA
                 BinaryTreeLinked &operator=(const BinaryTreeLinked &other)
                 {
                     BinaryTreeLinked tmp(other);
-                    this->swap(tmp);
+                    // 派生树重写的 swap 会拒绝与基类对象交换，这里只需交换头节点
+                    this->BinaryTreeLinked::swap(tmp);
                     return *this;
                 }
                 bool empty() const { return root() == nullptr; }
@@ -461,7 +566,18 @@ namespace DSA
                 }
                 virtual Node *createNodeInternal(const T &v = T{})
                 {
-                    return new Node{v};
+                    return emplaceNodeInternal(v);
+                }
+                // 用实参原地构造节点的值（只构造一次），再交给 initNodeInternal 完成派生树需要的初始化
+                template <typename... Args>
+                Node *emplaceNodeInternal(Args &&...args)
+                {
+                    return initNodeInternal(new Node(std::in_place, std::forward<Args>(args)...));
+                }
+                // 新节点的初始化钩子，派生树（如红黑树染黑、AVL 设置高度）重写此函数
+                virtual Node *initNodeInternal(Node *p)
+                {
+                    return p;
                 }
                 virtual Node *copyNodeInternal(const Node &node)
                 {
@@ -470,13 +586,11 @@ namespace DSA
 
                 static void link_to(const bool link_right, Node *node, Node *p)
                 {
-                    node && (node->parent = p);
-                    p->children[link_right] = node;
+                    detail::link_to(link_right, node, p);
                 }
                 void link_root(Node *p)
                 {
-                    root() = p;
-                    p->parent = end_ptr();
+                    detail::link_root(end_ptr(), p);
                 }
                 void solo_root(Node *p)
                 {
@@ -496,64 +610,11 @@ namespace DSA
                 // 用于交换两个节点在树中的拓扑位置，而不是交换它们的值。
                 // 这样做是为了在不使迭代器失效（仍然指向同一个节点对象）的情况下，改变树的逻辑顺序。
                 // 这是实现简化子类 erase 逻辑的核心。
-                /*
-                    to keep iterator consistent, instead of swapping the node value, we swap the tree info
-                */
                 void tree_swap(Node *x, Node *y)
                 {
                     if (x == y)
                         return;
-                    bool xright = is_right(x);
-                    bool yright = is_right(y);
-                    bool link_right;
-                    // case 1: x 和 y 是直接亲子关系
-                    if (x->parent == y || y->parent == x)
-                    {
-                        // 注意swap_node需要放在if分支里
-                        if (x->parent == y)
-                        {
-                            swap_node(*x, *y); // 会导致临时的自引用，下一句立刻修复
-                            y->parent = x;
-                            x->children[xright] = y;
-                        }
-                        else
-                        {
-                            swap_node(*x, *y); // 会导致临时的自引用，下一句立刻修复
-                            x->parent = y;
-                            y->children[yright] = x;
-                        }
-                    }
-                    else
-                    {
-                        // case 2: x 和 y 没有直接的亲子关系
-                        swap_node(*x, *y);
-                    }
-
-                    // 更新 parent 和 x,y 的关系
-                    if (x == root() || y == root())
-                    {
-                        if (x == root())
-                        {
-                            link_root(y);
-                            link_to(link_right = yright, x, x->parent);
-                        }
-                        else
-                        {
-                            link_root(x);
-                            link_to(link_right = xright, y, y->parent);
-                        }
-                    }
-                    else
-                    {
-                        link_to(link_right = yright, x, x->parent);
-                        link_to(link_right = xright, y, y->parent);
-                    }
-                    // 更新 x,y 和子节点的的关系
-                    link_to(link_right = false, x->left(), x);
-                    link_to(link_right = true, x->right(), x);
-                    link_to(link_right = false, y->left(), y);
-                    link_to(link_right = true, y->right(), y);
-
+                    detail::swap_topology(end_ptr(), x, y);
                     // 如果交换的节点是 leftmost 或 rightmost，则更新 header 中的缓存指针
                     if (x == leftmost() || y == leftmost())
                     {
@@ -588,7 +649,7 @@ namespace DSA
                 }
                 static bool is_right(Node *p)
                 {
-                    return p == p->parent->right();
+                    return detail::is_right(p);
                 }
                 static Node *getNode(const_iterator iter)
                 {